@@ -1,21 +1,324 @@
 #include "application.h"
 #include "utilities.h"
+#include "lending_rules.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <ctime>
 #include <vector>
 #include <string>
+#include <cstdio>
 
 using namespace std;
+
+// Text tables for the compact fields; getters hand out references into these
+
+namespace {
+    const string STATUS_NAMES[] = {
+        "submitted", "approved", "rejected",
+        "C1", "C2", "C3",
+        "incomplete_personal", "incomplete_financial",
+        "incomplete_references", "incomplete_documents"
+    };
+    const string EMPLOYMENT_NAMES[] = { "", "Self-employed", "Salaried", "Retired", "Unemployed" };
+    const string MARITAL_NAMES[] = { "", "Single", "Married", "Divorced", "Widowed" };
+    const string GENDER_NAMES[] = { "", "Male", "Female", "Other" };
+    const string SECTION_NAMES[] = { "personal", "financial", "references", "documents" };
+
+    // Every spelling of a loan type the UI has stored so far
+    struct LoanTypeSpelling {
+        string text;
+        LoanKind kind;
+    };
+    const LoanTypeSpelling LOAN_TYPE_SPELLINGS[] = {
+        { "", LoanKind::NONE },
+        { "home", LoanKind::HOME },
+        { "car", LoanKind::CAR },
+        { "scooter", LoanKind::SCOOTER },
+        { "personal", LoanKind::PERSONAL },
+        { "Home Loan", LoanKind::HOME },
+        { "Car Loan", LoanKind::CAR },
+        { "Scooter Loan", LoanKind::SCOOTER },
+        { "Personal Loan", LoanKind::PERSONAL },
+        { "Unknown", LoanKind::UNKNOWN }
+    };
+    const uint8_t LOAN_TYPE_COUNT = sizeof(LOAN_TYPE_SPELLINGS) / sizeof(LOAN_TYPE_SPELLINGS[0]);
+    const uint8_t LOAN_TYPE_CUSTOM = 0xFF;
+
+    /// <summary>
+    /// Builds the 16 possible completed-section lists once
+    /// </summary>
+    const string* buildSectionTexts() {
+        static string texts[16];
+        for (int mask = 0; mask < 16; mask++) {
+            for (int bit = 0; bit < 4; bit++) {
+                if (mask & (1 << bit)) {
+                    if (!texts[mask].empty()) texts[mask] += ",";
+                    texts[mask] += SECTION_NAMES[bit];
+                }
+            }
+        }
+        return texts;
+    }
+
+    /// <summary>
+    /// Loan type names accepted by the income-for-type rules (home, car, scooter, personal)
+    /// </summary>
+    LoanKind getRuleLoanKind(const string& loanType) {
+        if (loanType == "home") return LoanKind::HOME;
+        if (loanType == "car") return LoanKind::CAR;
+        if (loanType == "scooter") return LoanKind::SCOOTER;
+        if (loanType == "personal") return LoanKind::PERSONAL;
+        return LoanKind::NONE;
+    }
+
+    template <typename Code, size_t Count>
+    bool tryParseCode(const string (&names)[Count], const string& text, Code& value) {
+        for (size_t i = 0; i < Count; i++) {
+            if (names[i] == text) {
+                value = static_cast<Code>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+const string& getStatusName(ApplicationStatus status) {
+    return STATUS_NAMES[static_cast<int>(status)];
+}
+
+bool tryParseStatus(const string& text, ApplicationStatus& status) {
+    return tryParseCode(STATUS_NAMES, text, status);
+}
+
+bool isIncompleteStatus(ApplicationStatus status) {
+    return status != ApplicationStatus::SUBMITTED &&
+        status != ApplicationStatus::APPROVED &&
+        status != ApplicationStatus::REJECTED;
+}
+
+bool isDecidedStatus(ApplicationStatus status) {
+    return status == ApplicationStatus::APPROVED || status == ApplicationStatus::REJECTED;
+}
+
+const string& getEmploymentStatusName(EmploymentStatus value) {
+    return EMPLOYMENT_NAMES[static_cast<int>(value)];
+}
+
+bool tryParseEmploymentStatus(const string& text, EmploymentStatus& value) {
+    return tryParseCode(EMPLOYMENT_NAMES, text, value);
+}
+
+const string& getMaritalStatusName(MaritalStatus value) {
+    return MARITAL_NAMES[static_cast<int>(value)];
+}
+
+bool tryParseMaritalStatus(const string& text, MaritalStatus& value) {
+    return tryParseCode(MARITAL_NAMES, text, value);
+}
+
+const string& getGenderName(Gender value) {
+    return GENDER_NAMES[static_cast<int>(value)];
+}
+
+bool tryParseGender(const string& text, Gender& value) {
+    return tryParseCode(GENDER_NAMES, text, value);
+}
+
+uint8_t getSectionFlag(const string& section) {
+    for (int bit = 0; bit < 4; bit++) {
+        if (SECTION_NAMES[bit] == section) return static_cast<uint8_t>(1 << bit);
+    }
+    return 0;
+}
+
+const string& getCompletedSectionsText(uint8_t mask) {
+    static const string* texts = buildSectionTexts();
+    return texts[mask & 0x0F];
+}
+
+// Validation messages, indexed by ValidationCode; %d is the entry's index
+namespace {
+    const char* const VALIDATION_MESSAGES[] = {
+        "",
+        "Full name is required",
+        "Father's name is required",
+        "Postal address is required",
+        "Contact number is required",
+        "Email address is required",
+        "CNIC is required",
+        "CNIC expiry date is required",
+        "Employment status is required",
+        "Marital status is required",
+        "Gender is required",
+        "Number of dependents cannot be negative",
+        "CNIC must be exactly 13 digits",
+        "CNIC must contain only digits",
+        "Invalid email format",
+        "Annual income cannot be negative",
+        "Average electricity bill cannot be negative",
+        "Current electricity bill cannot be negative",
+        "Electricity bills cannot be negative",
+        "Annual income seems unusually high",
+        "Average electricity bill seems unusually high",
+        "Current electricity bill seems unusually high",
+        "Applicant is unemployed but has reported income",
+        "Reported income seems low for employment status",
+        "Current electricity bill is unusually high compared to average",
+        "Many dependents with relatively low income",
+        "Invalid data in existing loan #%d",
+        "Loan %d: Amount returned + amount due should equal total amount",
+        "Loan %d: Amount returned cannot exceed total loan amount",
+        "Loan %d: Amount due cannot exceed total loan amount",
+        "Loan %d: Invalid loan data",
+        "Invalid data for reference %d",
+        "References must have different CNIC numbers",
+        "CNIC front image is required",
+        "CNIC back image is required",
+        "Electricity bill image is required",
+        "Salary slip or bank statement is required",
+        "Income insufficient for requested loan amount",
+        "High debt-to-income ratio detected"
+    };
+    static_assert(sizeof(VALIDATION_MESSAGES) / sizeof(VALIDATION_MESSAGES[0]) ==
+        static_cast<size_t>(ValidationCode::CODE_COUNT), "Every ValidationCode needs a message");
+}
+
+void ValidationResult::push(const ValidationEntry& entry) {
+    if (entryCount < INLINE_CAPACITY) {
+        inlineEntries[entryCount] = entry;
+    }
+    else {
+        overflowEntries.push_back(entry);
+    }
+    entryCount++;
+
+    if (!entry.isWarning) {
+        errorCount++;
+        isValid = false;
+    }
+}
+
+void ValidationResult::addError(ValidationCode code, int index) {
+    ValidationEntry entry = { static_cast<uint16_t>(code), false, static_cast<uint16_t>(index), 0 };
+    push(entry);
+}
+
+void ValidationResult::addWarning(ValidationCode code, int index) {
+    ValidationEntry entry = { static_cast<uint16_t>(code), true, static_cast<uint16_t>(index), 0 };
+    push(entry);
+}
+
+void ValidationResult::addError(const string& error) {
+    ValidationEntry entry = { static_cast<uint16_t>(ValidationCode::CUSTOM_MESSAGE), false, 0,
+        static_cast<int32_t>(customMessages.size()) };
+    customMessages.push_back(error);
+    push(entry);
+}
+
+void ValidationResult::addWarning(const string& warning) {
+    ValidationEntry entry = { static_cast<uint16_t>(ValidationCode::CUSTOM_MESSAGE), true, 0,
+        static_cast<int32_t>(customMessages.size()) };
+    customMessages.push_back(warning);
+    push(entry);
+}
+
+void ValidationResult::addEntry(const ValidationEntry& entry) {
+    push(entry);
+}
+
+void ValidationResult::appendErrors(const ValidationResult& other) {
+    for (size_t i = 0; i < other.getEntryCount(); i++) {
+        const ValidationEntry& entry = other.getEntry(i);
+        if (entry.isWarning) continue;
+
+        if (entry.code == static_cast<uint16_t>(ValidationCode::CUSTOM_MESSAGE)) {
+            addError(other.customMessages[entry.value]);
+        }
+        else {
+            push(entry);
+        }
+    }
+}
+
+void ValidationResult::clear() {
+    isValid = true;
+    entryCount = 0;
+    errorCount = 0;
+    overflowEntries.clear();
+    customMessages.clear();
+}
+
+string ValidationResult::getMessage(const ValidationEntry& entry) const {
+    if (entry.code == static_cast<uint16_t>(ValidationCode::CUSTOM_MESSAGE)) {
+        return customMessages[entry.value];
+    }
+    return getCodedMessage(entry);
+}
+
+string ValidationResult::getCodedMessage(const ValidationEntry& entry) {
+    if (entry.code >= LENDING_RULE_CODE_BASE) {
+        return LendingRules::getActive().formatMessage(entry.code - LENDING_RULE_CODE_BASE, entry.value);
+    }
+    if (entry.code == static_cast<uint16_t>(ValidationCode::CUSTOM_MESSAGE) ||
+        entry.code >= static_cast<uint16_t>(ValidationCode::CODE_COUNT)) {
+        return "Unknown validation code " + to_string(entry.code);
+    }
+
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), VALIDATION_MESSAGES[entry.code], static_cast<int>(entry.index));
+    return buffer;
+}
+
+vector<string> ValidationResult::getErrors() const {
+    vector<string> messages;
+    for (size_t i = 0; i < entryCount; i++) {
+        if (!getEntry(i).isWarning) messages.push_back(getMessage(getEntry(i)));
+    }
+    return messages;
+}
+
+vector<string> ValidationResult::getWarnings() const {
+    vector<string> messages;
+    for (size_t i = 0; i < entryCount; i++) {
+        if (getEntry(i).isWarning) messages.push_back(getMessage(getEntry(i)));
+    }
+    return messages;
+}
+
+string ValidationResult::getReport() const {
+    string report;
+    if (!isValid) {
+        report += "VALIDATION FAILED:\n";
+        for (size_t i = 0; i < entryCount; i++) {
+            if (getEntry(i).isWarning) continue;
+            report += "  - ";
+            report += getMessage(getEntry(i));
+            report += '\n';
+        }
+    }
+    for (size_t i = 0; i < entryCount; i++) {
+        if (!getEntry(i).isWarning) continue;
+        report += "  [WARNING] ";
+        report += getMessage(getEntry(i));
+        report += '\n';
+    }
+    if (isValid && getWarningCount() == 0) {
+        report += "All validations passed!\n";
+    }
+    return report;
+}
+
 /// <summary>
 /// Default constructor for LoanApplication
 /// </summary>
 
 LoanApplication::LoanApplication() {
     applicationId = "";
-    status = "submitted";
+    status = ApplicationStatus::SUBMITTED;
     submissionDate = "";
+    completedSections = 0;
     fullName = "";
     fathersName = "";
     postalAddress = "";
@@ -23,9 +326,9 @@ LoanApplication::LoanApplication() {
     emailAddress = "";
     cnicNumber = "";
     cnicExpiryDate = "";
-    employmentStatus = "";
-    maritalStatus = "";
-    gender = "";
+    employmentStatus = EmploymentStatus::NONE;
+    maritalStatus = MaritalStatus::NONE;
+    gender = Gender::NONE;
     numberOfDependents = 0;
     annualIncome = 0;
     avgElectricityBill = 0;
@@ -34,7 +337,7 @@ LoanApplication::LoanApplication() {
     cnicBackImagePath = "";
     electricityBillImagePath = "";
     salarySlipImagePath = "";
-    loanType = "";
+    loanTypeCode = 0;
     loanCategory = "";
     loanAmount = 0;
     downPayment = 0;
@@ -46,32 +349,40 @@ LoanApplication::LoanApplication() {
 }
 
 // Getters implementation
-string LoanApplication::getApplicationId() const { return applicationId; }
-string LoanApplication::getStatus() const { return status; }
-string LoanApplication::getSubmissionDate() const { return submissionDate; }
-string LoanApplication::getFullName() const { return fullName; }
-string LoanApplication::getFathersName() const { return fathersName; }
-string LoanApplication::getPostalAddress() const { return postalAddress; }
-string LoanApplication::getContactNumber() const { return contactNumber; }
-string LoanApplication::getEmailAddress() const { return emailAddress; }
-string LoanApplication::getCnicNumber() const { return cnicNumber; }
-string LoanApplication::getCnicExpiryDate() const { return cnicExpiryDate; }
-string LoanApplication::getEmploymentStatus() const { return employmentStatus; }
-string LoanApplication::getMaritalStatus() const { return maritalStatus; }
-string LoanApplication::getGender() const { return gender; }
+const string& LoanApplication::getApplicationId() const { return applicationId; }
+const string& LoanApplication::getStatus() const { return getStatusName(status); }
+ApplicationStatus LoanApplication::getStatusCode() const { return status; }
+const string& LoanApplication::getSubmissionDate() const { return submissionDate; }
+const string& LoanApplication::getFullName() const { return fullName; }
+const string& LoanApplication::getFathersName() const { return fathersName; }
+const string& LoanApplication::getPostalAddress() const { return postalAddress; }
+const string& LoanApplication::getContactNumber() const { return contactNumber; }
+const string& LoanApplication::getEmailAddress() const { return emailAddress; }
+const string& LoanApplication::getCnicNumber() const { return cnicNumber; }
+const string& LoanApplication::getCnicExpiryDate() const { return cnicExpiryDate; }
+const string& LoanApplication::getEmploymentStatus() const { return getEmploymentStatusName(employmentStatus); }
+EmploymentStatus LoanApplication::getEmploymentStatusCode() const { return employmentStatus; }
+const string& LoanApplication::getMaritalStatus() const { return getMaritalStatusName(maritalStatus); }
+const string& LoanApplication::getGender() const { return getGenderName(gender); }
 int LoanApplication::getNumberOfDependents() const { return numberOfDependents; }
 long long LoanApplication::getAnnualIncome() const { return annualIncome; }
 long long LoanApplication::getAvgElectricityBill() const { return avgElectricityBill; }
 long long LoanApplication::getCurrentElectricityBill() const { return currentElectricityBill; }
-vector<ExistingLoan> LoanApplication::getExistingLoans() const { return existingLoans; }
-Reference LoanApplication::getReference1() const { return reference1; }
-Reference LoanApplication::getReference2() const { return reference2; }
-string LoanApplication::getCnicFrontImagePath() const { return cnicFrontImagePath; }
-string LoanApplication::getCnicBackImagePath() const { return cnicBackImagePath; }
-string LoanApplication::getElectricityBillImagePath() const { return electricityBillImagePath; }
-string LoanApplication::getSalarySlipImagePath() const { return salarySlipImagePath; }
-string LoanApplication::getLoanType() const { return loanType; }
-string LoanApplication::getLoanCategory() const { return loanCategory; }
+const vector<ExistingLoan>& LoanApplication::getExistingLoans() const { return existingLoans; }
+const Reference& LoanApplication::getReference1() const { return reference1; }
+const Reference& LoanApplication::getReference2() const { return reference2; }
+const string& LoanApplication::getCnicFrontImagePath() const { return cnicFrontImagePath; }
+const string& LoanApplication::getCnicBackImagePath() const { return cnicBackImagePath; }
+const string& LoanApplication::getElectricityBillImagePath() const { return electricityBillImagePath; }
+const string& LoanApplication::getSalarySlipImagePath() const { return salarySlipImagePath; }
+const string& LoanApplication::getLoanType() const {
+    return (loanTypeCode == LOAN_TYPE_CUSTOM) ? loanTypeText : LOAN_TYPE_SPELLINGS[loanTypeCode].text;
+}
+
+LoanKind LoanApplication::getLoanKind() const {
+    return (loanTypeCode == LOAN_TYPE_CUSTOM) ? LoanKind::UNKNOWN : LOAN_TYPE_SPELLINGS[loanTypeCode].kind;
+}
+const string& LoanApplication::getLoanCategory() const { return loanCategory; }
 long long LoanApplication::getLoanAmount() const { return loanAmount; }
 long long LoanApplication::getDownPayment() const { return downPayment; }
 int LoanApplication::getInstallmentMonths() const { return installmentMonths; }
@@ -82,82 +393,70 @@ int LoanApplication::getInstallmentStartYear() const { return installmentStartYe
 void LoanApplication::setInstallmentStartYear(int year) { installmentStartYear = year; }
 
 // Setters implementation 
-void LoanApplication::setApplicationId(const string& id) {
+void LoanApplication::setApplicationId(string id) {
     if (id.empty()) {
         throw ValidationException("Application ID cannot be empty");
     }
-    applicationId = id;
+    applicationId = move(id);
 }
 
 void LoanApplication::setStatus(const string& stat) {
     // Allow both final statuses and checkpoint statuses
-    vector<string> validStatuses = {
-        "submitted", "approved", "rejected",
-        "C1", "C2", "C3",
-        "incomplete_personal", "incomplete_financial",
-        "incomplete_references", "incomplete_documents"
-    };
-
-    bool valid = false;
-    for (const auto& s : validStatuses) {
-        if (s == stat) {
-            valid = true;
-            break;
-        }
-    }
-
-    if (!valid) {
+    if (!tryParseStatus(stat, status)) {
         throw ValidationException("Invalid status value: " + stat);
     }
+}
+
+void LoanApplication::setStatus(ApplicationStatus stat) {
     status = stat;
 }
 
-void LoanApplication::setSubmissionDate(const string& date) {
+void LoanApplication::setSubmissionDate(string date) {
     if (date.length() != 10 || date[2] != '-' || date[5] != '-') {
         throw ValidationException("Submission date must be in DD-MM-YYYY format");
     }
-    submissionDate = date;
+    submissionDate = move(date);
 }
 
-void LoanApplication::setFullName(const string& name) {
+void LoanApplication::setFullName(string name) {
     if (name.empty()) {
         throw ValidationException("Full name cannot be empty");
     }
     if (name.length() > 100) {
         throw ValidationException("Full name too long");
     }
-    fullName = name;
+    fullName = move(name);
 }
 
-void LoanApplication::setFathersName(const string& name) {
+void LoanApplication::setFathersName(string name) {
     if (name.empty()) {
         throw ValidationException("Father's name cannot be empty");
     }
-    fathersName = name;
+    fathersName = move(name);
 }
 
-void LoanApplication::setPostalAddress(const string& address) {
+void LoanApplication::setPostalAddress(string address) {
     if (address.empty()) {
         throw ValidationException("Postal address cannot be empty");
     }
-    postalAddress = address;
+    postalAddress = move(address);
 }
 
-void LoanApplication::setContactNumber(const string& number) {
+void LoanApplication::setContactNumber(string number) {
     if (number.length() < 10 || number.length() > 15) {
         throw ValidationException("Phone number must be 10-15 digits");
     }
-    contactNumber = number;
+    contactNumber = move(number);
 }
 
-void LoanApplication::setEmailAddress(const string& email) {
+void LoanApplication::setEmailAddress(string email) {
     if (email.find('@') == string::npos || email.find('.') == string::npos) {
         throw ValidationException("Invalid email format");
     }
-    emailAddress = email;
+    emailAddress = move(email);
 }
 
-void LoanApplication::setCnicNumber(const string& cnic) {
+void LoanApplication::setCnicNumber(string cnic) {
     if (cnic.length() != 13) {
         throw ValidationException("CNIC must be 13 digits");
     }
@@ -166,53 +465,38 @@ void LoanApplication::setCnicNumber(const string& cnic) {
             throw ValidationException("CNIC must contain only digits");
         }
     }
-    cnicNumber = cnic;
+    cnicNumber = move(cnic);
 }
 
-void LoanApplication::setCnicExpiryDate(const string& date) {
+void LoanApplication::setCnicExpiryDate(string date) {
     if (date.length() != 10 || date[2] != '-' || date[5] != '-') {
         throw ValidationException("CNIC expiry date must be in DD-MM-YYYY format");
     }
-    cnicExpiryDate = date;
+    cnicExpiryDate = move(date);
 }
 
 void LoanApplication::setEmploymentStatus(const string& status) {
-    vector<string> validStatuses = { "Self-employed", "Salaried", "Retired", "Unemployed" };
-    bool valid = false;
-    for (const auto& s : validStatuses) {
-        if (s == status) {
-            valid = true;
-            break;
-        }
+    EmploymentStatus parsed;
+    if (status.empty() || !tryParseEmploymentStatus(status, parsed)) {
+        throw ValidationException("Invalid employment status");
     }
-    if (!valid) throw ValidationException("Invalid employment status");
-    employmentStatus = status;
+    employmentStatus = parsed;
 }
 
 void LoanApplication::setMaritalStatus(const string& status) {
-    vector<string> validStatuses = { "Single", "Married", "Divorced", "Widowed" };
-    bool valid = false;
-    for (const auto& s : validStatuses) {
-        if (s == status) {
-            valid = true;
-            break;
-        }
+    MaritalStatus parsed;
+    if (status.empty() || !tryParseMaritalStatus(status, parsed)) {
+        throw ValidationException("Invalid marital status");
     }
-    if (!valid) throw ValidationException("Invalid marital status");
-    maritalStatus = status;
+    maritalStatus = parsed;
 }
 
 void LoanApplication::setGender(const string& gen) {
-    vector<string> validGenders = { "Male", "Female", "Other" };
-    bool valid = false;
-    for (const auto& g : validGenders) {
-        if (g == gen) {
-            valid = true;
-            break;
-        }
+    Gender parsed;
+    if (gen.empty() || !tryParseGender(gen, parsed)) {
+        throw ValidationException("Invalid gender");
     }
-    if (!valid) throw ValidationException("Invalid gender");
-    gender = gen;
+    gender = parsed;
 }
 
 void LoanApplication::setNumberOfDependents(int dependents) {
@@ -246,45 +530,55 @@ void LoanApplication::setCurrentElectricityBill(long long amount) {
     currentElectricityBill = amount;
 }
 
-void LoanApplication::setReference1(const Reference& ref) {
+void LoanApplication::setReference1(Reference ref) {
     if (ref.name.empty()) {
         throw ValidationException("Reference 1 name cannot be empty");
     }
-    reference1 = ref;
+    reference1 = move(ref);
 }
 
-void LoanApplication::setReference2(const Reference& ref) {
+void LoanApplication::setReference2(Reference ref) {
     if (ref.name.empty()) {
         throw ValidationException("Reference 2 name cannot be empty");
     }
-    reference2 = ref;
+    reference2 = move(ref);
 }
 
-void LoanApplication::setCnicFrontImagePath(const string& path) {
-    cnicFrontImagePath = path;
+void LoanApplication::setCnicFrontImagePath(string path) {
+    cnicFrontImagePath = move(path);
 }
 
-void LoanApplication::setCnicBackImagePath(const string& path) {
-    cnicBackImagePath = path;
+void LoanApplication::setCnicBackImagePath(string path) {
+    cnicBackImagePath = move(path);
 }
 
-void LoanApplication::setElectricityBillImagePath(const string& path) {
-    electricityBillImagePath = path;
+void LoanApplication::setElectricityBillImagePath(string path) {
+    electricityBillImagePath = move(path);
 }
 
-void LoanApplication::setSalarySlipImagePath(const string& path) {
-    salarySlipImagePath = path;
+void LoanApplication::setSalarySlipImagePath(string path) {
+    salarySlipImagePath = move(path);
 }
 
-void LoanApplication::setLoanType(const string& type) { loanType = type; }
-void LoanApplication::setLoanCategory(const string& category) { loanCategory = category; }
+void LoanApplication::setLoanType(string type) {
+    for (uint8_t i = 0; i < LOAN_TYPE_COUNT; i++) {
+        if (LOAN_TYPE_SPELLINGS[i].text == type) {
+            loanTypeCode = i;
+            loanTypeText.clear();
+            return;
+        }
+    }
+    loanTypeCode = LOAN_TYPE_CUSTOM;
+    loanTypeText = move(type);
+}
+void LoanApplication::setLoanCategory(string category) { loanCategory = move(category); }
 void LoanApplication::setLoanAmount(long long amount) { loanAmount = amount; }
 void LoanApplication::setDownPayment(long long payment) { downPayment = payment; }
 void LoanApplication::setInstallmentMonths(int months) { installmentMonths = months; }
 void LoanApplication::setMonthlyPayment(long long payment) { monthlyPayment = payment; }
 
-void LoanApplication::addExistingLoan(const ExistingLoan& loan) {
-    existingLoans.push_back(loan);
+void LoanApplication::addExistingLoan(ExistingLoan loan) {
+    existingLoans.push_back(move(loan));
 }
 
 /// <summary>
@@ -313,19 +607,19 @@ ValidationResult LoanApplication::validateExistingLoans() const {
         const ExistingLoan& loan = existingLoans[i];
 
         if (loan.amountReturned + loan.amountDue != loan.totalAmount) {
-            result.addError("Loan " + to_string(i + 1) + ": Amount returned + amount due should equal total amount");
+            result.addError(ValidationCode::LOAN_TOTAL_MISMATCH, static_cast<int>(i + 1));
         }
 
         if (loan.amountReturned > loan.totalAmount) {
-            result.addError("Loan " + to_string(i + 1) + ": Amount returned cannot exceed total loan amount");
+            result.addError(ValidationCode::LOAN_RETURNED_EXCEEDS_TOTAL, static_cast<int>(i + 1));
         }
 
         if (loan.amountDue > loan.totalAmount) {
-            result.addError("Loan " + to_string(i + 1) + ": Amount due cannot exceed total loan amount");
+            result.addError(ValidationCode::LOAN_DUE_EXCEEDS_TOTAL, static_cast<int>(i + 1));
         }
 
         if (!loan.validate()) {
-            result.addError("Loan " + to_string(i + 1) + ": Invalid loan data");
+            result.addError(ValidationCode::LOAN_DATA_INVALID, static_cast<int>(i + 1));
         }
     }
 
@@ -340,26 +634,16 @@ ValidationResult LoanApplication::validateExistingLoans() const {
 /// <param name="result">Validation result to update</param>
 /// <returns>True if ratio is valid, false otherwise</returns>
 bool LoanApplication::validateDebtToIncomeRatio(ValidationResult& result) const {
-    if (annualIncome <= 0) {
-        result.addError("Annual income must be positive to calculate debt ratio");
-        return false;
-    }
-
-    long long totalExistingDebt = 0;
+    RuleInputs inputs;
+    inputs.annualIncome = annualIncome;
     for (const auto& loan : existingLoans) {
         if (loan.isActive) {
-            totalExistingDebt += loan.amountDue;
+            inputs.activeDebt += loan.amountDue;
         }
     }
 
-    double debtRatio = static_cast<double>(totalExistingDebt) / annualIncome;
-
-    if (debtRatio > 0.5) {
-        result.addWarning("High debt-to-income ratio: " + to_string(static_cast<int>(debtRatio * 100)) + "%");
-        return false;
-    }
-
-    return true;
+    // Thresholds live in LendingRules.txt (debt_ratio group)
+    return LendingRules::getActive().evaluate(RuleGroup::DEBT_TO_INCOME, inputs, result);
 }
 
 /// <summary>
@@ -369,23 +653,12 @@ bool LoanApplication::validateDebtToIncomeRatio(ValidationResult& result) const
 ValidationResult LoanApplication::validateCompleteApplication() const {
     ValidationResult result;
 
-    if (fullName.empty()) result.addError("Full name is required");
-    if (cnicNumber.empty()) result.addError("CNIC is required");
-    if (contactNumber.empty()) result.addError("Contact number is required");
-
-    ValidationResult loansValidation = validateExistingLoans();
-    if (!loansValidation.isValid) {
-        for (const auto& error : loansValidation.errors) {
-            result.addError(error);
-        }
-    }
+    if (fullName.empty()) result.addError(ValidationCode::FULL_NAME_REQUIRED);
+    if (cnicNumber.empty()) result.addError(ValidationCode::CNIC_REQUIRED);
+    if (contactNumber.empty()) result.addError(ValidationCode::CONTACT_NUMBER_REQUIRED);
 
-    ValidationResult refsValidation = validateReferences();
-    if (!refsValidation.isValid) {
-        for (const auto& error : refsValidation.errors) {
-            result.addError(error);
-        }
-    }
+    result.appendErrors(validateExistingLoans());
+    result.appendErrors(validateReferences());
 
     validateDebtToIncomeRatio(result);
 
@@ -399,32 +672,32 @@ ValidationResult LoanApplication::validateCompleteApplication() const {
 ValidationResult LoanApplication::validateEmploymentAndFinancialInfo() const {
     ValidationResult result;
 
-    if (employmentStatus.empty()) {
-        result.addError("Employment status is required");
+    if (employmentStatus == EmploymentStatus::NONE) {
+        result.addError(ValidationCode::EMPLOYMENT_STATUS_REQUIRED);
     }
 
-    if (employmentStatus == "Unemployed" && annualIncome > 0) {
-        result.addWarning("Applicant is unemployed but has reported income");
+    if (employmentStatus == EmploymentStatus::UNEMPLOYED && annualIncome > 0) {
+        result.addWarning(ValidationCode::UNEMPLOYED_WITH_INCOME);
     }
 
-    if (employmentStatus != "Unemployed" && annualIncome < 200000) {
-        result.addWarning("Reported income seems low for employment status");
+    if (employmentStatus != EmploymentStatus::UNEMPLOYED && annualIncome < 200000) {
+        result.addWarning(ValidationCode::INCOME_LOW_FOR_EMPLOYMENT);
     }
 
     if (avgElectricityBill < 0 || currentElectricityBill < 0) {
-        result.addError("Electricity bills cannot be negative");
+        result.addError(ValidationCode::BILLS_NEGATIVE);
     }
 
     if (currentElectricityBill > avgElectricityBill * 3) {
-        result.addWarning("Current electricity bill is unusually high compared to average");
+        result.addWarning(ValidationCode::CURRENT_BILL_ABOVE_AVERAGE);
     }
 
     if (numberOfDependents < 0) {
-        result.addError("Number of dependents cannot be negative");
+        result.addError(ValidationCode::DEPENDENTS_NEGATIVE);
     }
 
     if (numberOfDependents > 10 && annualIncome < 1000000) {
-        result.addWarning("Many dependents with relatively low income");
+        result.addWarning(ValidationCode::MANY_DEPENDENTS_LOW_INCOME);
     }
 
     return result;
@@ -438,55 +711,33 @@ ValidationResult LoanApplication::validateEmploymentAndFinancialInfo() const {
 /// <param name="result">Validation result to update</param>
 /// <returns>True if income is sufficient, false otherwise</returns>
 bool LoanApplication::validateIncomeForLoanType(const string& loanType, long long loanAmount, ValidationResult& result) const {
-    if (annualIncome <= 0) {
-        result.addError("Annual income must be positive");
-        return false;
-    }
+    RuleInputs inputs;
+    inputs.annualIncome = annualIncome;
+    inputs.loanAmount = loanAmount;
+    inputs.loanKind = getRuleLoanKind(loanType);
+    inputs.employmentStatus = employmentStatus;
 
-    double incomeToLoanRatio = static_cast<double>(loanAmount) / annualIncome;
-
-    if (loanType == "home" && incomeToLoanRatio > 5.0) {
-        result.addError("Home loan amount cannot exceed 5 times annual income");
-        return false;
-    }
-    else if (loanType == "car" && incomeToLoanRatio > 2.0) {
-        result.addError("Car loan amount cannot exceed 2 times annual income");
-        return false;
-    }
-    else if (loanType == "personal" && incomeToLoanRatio > 1.0) {
-        result.addError("Personal loan amount cannot exceed annual income");
-        return false;
-    }
-
-    if (employmentStatus == "Unemployed" && loanAmount > 500000) {
-        result.addError("Loan amount too high for unemployed applicant");
-        return false;
-    }
-
-    if (employmentStatus == "Retired" && loanAmount > 1000000) {
-        result.addWarning("Large loan amount for retired applicant");
-    }
-
-    return true;
+    // Thresholds live in LendingRules.txt (income_for_type group)
+    return LendingRules::getActive().evaluate(RuleGroup::INCOME_FOR_LOAN_TYPE, inputs, result);
 }
-string LoanApplication::getRejectionReason() const {
+const string& LoanApplication::getRejectionReason() const {
     return rejectionReason;
 }
 
-void LoanApplication::setRejectionReason(const string& reason) {
-    rejectionReason = reason;
+void LoanApplication::setRejectionReason(string reason) {
+    rejectionReason = move(reason);
 }
 
 
 bool LoanApplication::isSectionCompleted(const string& section) const {
-    return completedSections.find(section) != string::npos;
+    uint8_t flag = getSectionFlag(section);
+    return flag != 0 && (completedSections & flag) != 0;
 }
 
 vector<string> LoanApplication::getIncompleteSections() const {
-    vector<string> sections = { "personal", "financial", "references", "documents" };
     vector<string> incomplete;
 
-    for (const auto& section : sections) {
+    for (const auto& section : SECTION_NAMES) {
         if (!isSectionCompleted(section)) {
             incomplete.push_back(section);
         }
@@ -497,38 +748,45 @@ vector<string> LoanApplication::getIncompleteSections() const {
 
 
 
-string LoanApplication::getCompletedSections() const {
+const string& LoanApplication::getCompletedSections() const {
+    return getCompletedSectionsText(completedSections);
+}
+
+uint8_t LoanApplication::getCompletedSectionMask() const {
     return completedSections;
 }
 
 void LoanApplication::setCompletedSections(const string& sections) {
-    completedSections = sections;
+    completedSections = 0;
+    for (const auto& section : splitString(sections, ',')) {
+        completedSections |= getSectionFlag(section);
+    }
 }
 
 // Validation methods for each section
 ValidationResult LoanApplication::validatePersonalInfo() const {
     ValidationResult result;
 
-    if (fullName.empty()) result.addError("Full name is required");
-    if (fathersName.empty()) result.addError("Father's name is required");
-    if (postalAddress.empty()) result.addError("Postal address is required");
-    if (contactNumber.empty()) result.addError("Contact number is required");
-    if (emailAddress.empty()) result.addError("Email address is required");
-    if (cnicNumber.empty()) result.addError("CNIC is required");
-    if (cnicExpiryDate.empty()) result.addError("CNIC expiry date is required");
-    if (employmentStatus.empty()) result.addError("Employment status is required");
-    if (maritalStatus.empty()) result.addError("Marital status is required");
-    if (gender.empty()) result.addError("Gender is required");
-    if (numberOfDependents < 0) result.addError("Number of dependents cannot be negative");
+    if (fullName.empty()) result.addError(ValidationCode::FULL_NAME_REQUIRED);
+    if (fathersName.empty()) result.addError(ValidationCode::FATHERS_NAME_REQUIRED);
+    if (postalAddress.empty()) result.addError(ValidationCode::POSTAL_ADDRESS_REQUIRED);
+    if (contactNumber.empty()) result.addError(ValidationCode::CONTACT_NUMBER_REQUIRED);
+    if (emailAddress.empty()) result.addError(ValidationCode::EMAIL_REQUIRED);
+    if (cnicNumber.empty()) result.addError(ValidationCode::CNIC_REQUIRED);
+    if (cnicExpiryDate.empty()) result.addError(ValidationCode::CNIC_EXPIRY_REQUIRED);
+    if (employmentStatus == EmploymentStatus::NONE) result.addError(ValidationCode::EMPLOYMENT_STATUS_REQUIRED);
+    if (maritalStatus == MaritalStatus::NONE) result.addError(ValidationCode::MARITAL_STATUS_REQUIRED);
+    if (gender == Gender::NONE) result.addError(ValidationCode::GENDER_REQUIRED);
+    if (numberOfDependents < 0) result.addError(ValidationCode::DEPENDENTS_NEGATIVE);
 
     // CNIC validation
     if (cnicNumber.length() != 13) {
-        result.addError("CNIC must be exactly 13 digits");
+        result.addError(ValidationCode::CNIC_LENGTH_INVALID);
     }
     else {
         for (char c : cnicNumber) {
             if (!isdigit(static_cast<unsigned char>(c))) {
-                result.addError("CNIC must contain only digits");
+                result.addError(ValidationCode::CNIC_NOT_DIGITS);
                 break;
             }
         }
@@ -536,7 +794,7 @@ ValidationResult LoanApplication::validatePersonalInfo() const {
 
     // Email validation
     if (emailAddress.find('@') == string::npos || emailAddress.find('.') == string::npos) {
-        result.addError("Invalid email format");
+        result.addError(ValidationCode::EMAIL_FORMAT_INVALID);
     }
 
     return result;
@@ -545,19 +803,19 @@ ValidationResult LoanApplication::validatePersonalInfo() const {
 ValidationResult LoanApplication::validateFinancialInfo() const {
     ValidationResult result;
 
-    if (annualIncome < 0) result.addError("Annual income cannot be negative");
-    if (avgElectricityBill < 0) result.addError("Average electricity bill cannot be negative");
-    if (currentElectricityBill < 0) result.addError("Current electricity bill cannot be negative");
+    if (annualIncome < 0) result.addError(ValidationCode::INCOME_NEGATIVE);
+    if (avgElectricityBill < 0) result.addError(ValidationCode::AVG_BILL_NEGATIVE);
+    if (currentElectricityBill < 0) result.addError(ValidationCode::CURRENT_BILL_NEGATIVE);
 
-    if (annualIncome > 1000000000) result.addWarning("Annual income seems unusually high");
-    if (avgElectricityBill > 100000) result.addWarning("Average electricity bill seems unusually high");
-    if (currentElectricityBill > 100000) result.addWarning("Current electricity bill seems unusually high");
+    if (annualIncome > 1000000000) result.addWarning(ValidationCode::INCOME_UNUSUALLY_HIGH);
+    if (avgElectricityBill > 100000) result.addWarning(ValidationCode::AVG_BILL_UNUSUALLY_HIGH);
+    if (currentElectricityBill > 100000) result.addWarning(ValidationCode::CURRENT_BILL_UNUSUALLY_HIGH);
 
     // Validate existing loans
     for (size_t i = 0; i < existingLoans.size(); i++) {
         const ExistingLoan& loan = existingLoans[i];
         if (!loan.validate()) {
-            result.addError("Invalid data in existing loan #" + to_string(i + 1));
+            result.addError(ValidationCode::EXISTING_LOAN_INVALID, static_cast<int>(i + 1));
         }
     }
 
@@ -568,13 +826,13 @@ ValidationResult LoanApplication::validateReferences() const {
     ValidationResult result;
 
     if (!reference1.validate()) {
-        result.addError("Invalid data for reference 1");
+        result.addError(ValidationCode::REFERENCE_INVALID, 1);
     }
     if (!reference2.validate()) {
-        result.addError("Invalid data for reference 2");
+        result.addError(ValidationCode::REFERENCE_INVALID, 2);
     }
     if (reference1.cnic == reference2.cnic) {
-        result.addError("References must have different CNIC numbers");
+        result.addError(ValidationCode::REFERENCE_CNIC_DUPLICATE);
     }
 
     return result;
@@ -583,10 +841,10 @@ ValidationResult LoanApplication::validateReferences() const {
 ValidationResult LoanApplication::validateDocuments() const {
     ValidationResult result;
 
-    if (cnicFrontImagePath.empty()) result.addError("CNIC front image is required");
-    if (cnicBackImagePath.empty()) result.addError("CNIC back image is required");
-    if (electricityBillImagePath.empty()) result.addError("Electricity bill image is required");
-    if (salarySlipImagePath.empty()) result.addError("Salary slip or bank statement is required");
+    if (cnicFrontImagePath.empty()) result.addError(ValidationCode::CNIC_FRONT_REQUIRED);
+    if (cnicBackImagePath.empty()) result.addError(ValidationCode::CNIC_BACK_REQUIRED);
+    if (electricityBillImagePath.empty()) result.addError(ValidationCode::ELECTRICITY_BILL_REQUIRED);
+    if (salarySlipImagePath.empty()) result.addError(ValidationCode::SALARY_SLIP_REQUIRED);
 
     return result;
 }
@@ -594,55 +852,44 @@ ValidationResult LoanApplication::validateForLoanType(const string& loanType, lo
     ValidationResult result;
 
     if (!validateIncomeForLoanType(loanType, loanAmount, result)) {
-        result.addError("Income insufficient for requested loan amount");
+        result.addError(ValidationCode::INCOME_INSUFFICIENT_FOR_LOAN);
     }
 
     if (!validateDebtToIncomeRatio(result)) {
-        result.addWarning("High debt-to-income ratio detected");
+        result.addWarning(ValidationCode::HIGH_DEBT_RATIO_DETECTED);
     }
 
     return result;
 }
 bool LoanApplication::validateIncomeToLoanRatio(long long loanAmount, ValidationResult& result) const {
-    if (annualIncome <= 0) {
-        result.addError("Annual income must be positive");
-        return false;
-    }
+    RuleInputs inputs;
+    inputs.annualIncome = annualIncome;
+    inputs.loanAmount = loanAmount;
 
-    double ratio = static_cast<double>(loanAmount) / annualIncome;
-
-    if (ratio > 5.0) {
-        result.addError("Loan amount cannot exceed 5 times annual income");
-        return false;
-    }
-
-    if (ratio > 3.0) {
-        result.addWarning("Loan amount is high relative to income");
-    }
-
-    return true;
+    // Thresholds live in LendingRules.txt (income_to_loan group)
+    return LendingRules::getActive().evaluate(RuleGroup::INCOME_TO_LOAN, inputs, result);
 }
 
 
 bool LoanApplication::isApplicationComplete() const {
-    vector<string> completeStatuses = { "submitted", "approved", "rejected" };
-    for (const auto& s : completeStatuses) {
-        if (status == s) return true;
-    }
-    return false;
+    return status == ApplicationStatus::SUBMITTED ||
+        status == ApplicationStatus::APPROVED ||
+        status == ApplicationStatus::REJECTED;
 }
 
 string LoanApplication::getNextIncompleteSection() const {
-    if (status == "C1" || status == "incomplete_personal" || !isSectionCompleted("personal")) {
+    if (status == ApplicationStatus::C1 || status == ApplicationStatus::INCOMPLETE_PERSONAL ||
+        !(completedSections & SECTION_PERSONAL)) {
         return "personal";
     }
-    if (status == "C2" || status == "incomplete_financial" || !isSectionCompleted("financial")) {
+    if (status == ApplicationStatus::C2 || status == ApplicationStatus::INCOMPLETE_FINANCIAL ||
+        !(completedSections & SECTION_FINANCIAL)) {
         return "financial";
     }
-    if (status == "C3" || !isSectionCompleted("references")) {
+    if (status == ApplicationStatus::C3 || !(completedSections & SECTION_REFERENCES)) {
         return "references";
     }
-    if (status == "incomplete_documents" || !isSectionCompleted("documents")) {
+    if (status == ApplicationStatus::INCOMPLETE_DOCUMENTS || !(completedSections & SECTION_DOCUMENTS)) {
         return "documents";
     }
     return "complete";
@@ -652,25 +899,21 @@ string LoanApplication::getNextIncompleteSection() const {
 /// </summary>
 /// <param name="section">The section to mark as completed</param>
 void LoanApplication::markSectionCompleted(const string& section) {
-    if (!isSectionCompleted(section)) {
-        if (!completedSections.empty()) {
-            completedSections += ",";
-        }
-        completedSections += section;
-    }
+    uint8_t flag = getSectionFlag(section);
+    completedSections |= flag;
 
     // Update status based on checkpoints
-    if (section == "personal") {
-        status = "C2"; // Checkpoint 2 - Financial info needed
+    if (flag == SECTION_PERSONAL) {
+        status = ApplicationStatus::C2; // Checkpoint 2 - Financial info needed
     }
-    else if (section == "financial") {
-        status = "C3"; // Checkpoint 3 - References needed
+    else if (flag == SECTION_FINANCIAL) {
+        status = ApplicationStatus::C3; // Checkpoint 3 - References needed
     }
-    else if (section == "references") {
-        status = "incomplete_documents"; // Documents needed
+    else if (flag == SECTION_REFERENCES) {
+        status = ApplicationStatus::INCOMPLETE_DOCUMENTS; // Documents needed
     }
-    else if (section == "documents") {
-        status = "submitted"; // Fully submitted
+    else if (flag == SECTION_DOCUMENTS) {
+        status = ApplicationStatus::SUBMITTED; // Fully submitted
         if (submissionDate.empty()) {
             submissionDate = getCurrentDate();
         }
@@ -5,6 +5,7 @@
 #include <vector>
 #include <stdexcept>
 #include <sstream>
+#include <cstdint>
 using namespace std;
 
 // SE PRINCIPLE: Exception Handling
@@ -30,50 +31,148 @@ public:
 };
 
 
+/// <summary>
+/// Codes for the messages the LoanApplication validators can report
+/// The text is only produced when a result is rendered (see validation message table)
+/// </summary>
+enum class ValidationCode : uint16_t {
+    CUSTOM_MESSAGE,                 // Free text passed to addError/addWarning(string)
+
+    // Personal information
+    FULL_NAME_REQUIRED, FATHERS_NAME_REQUIRED, POSTAL_ADDRESS_REQUIRED,
+    CONTACT_NUMBER_REQUIRED, EMAIL_REQUIRED, CNIC_REQUIRED, CNIC_EXPIRY_REQUIRED,
+    EMPLOYMENT_STATUS_REQUIRED, MARITAL_STATUS_REQUIRED, GENDER_REQUIRED,
+    DEPENDENTS_NEGATIVE, CNIC_LENGTH_INVALID, CNIC_NOT_DIGITS, EMAIL_FORMAT_INVALID,
+
+    // Financial information
+    INCOME_NEGATIVE, AVG_BILL_NEGATIVE, CURRENT_BILL_NEGATIVE, BILLS_NEGATIVE,
+    INCOME_UNUSUALLY_HIGH, AVG_BILL_UNUSUALLY_HIGH, CURRENT_BILL_UNUSUALLY_HIGH,
+    UNEMPLOYED_WITH_INCOME, INCOME_LOW_FOR_EMPLOYMENT, CURRENT_BILL_ABOVE_AVERAGE,
+    MANY_DEPENDENTS_LOW_INCOME,
+
+    // Existing loans (index = loan number)
+    EXISTING_LOAN_INVALID, LOAN_TOTAL_MISMATCH, LOAN_RETURNED_EXCEEDS_TOTAL,
+    LOAN_DUE_EXCEEDS_TOTAL, LOAN_DATA_INVALID,
+
+    // References (index = reference number)
+    REFERENCE_INVALID, REFERENCE_CNIC_DUPLICATE,
+
+    // Documents
+    CNIC_FRONT_REQUIRED, CNIC_BACK_REQUIRED, ELECTRICITY_BILL_REQUIRED, SALARY_SLIP_REQUIRED,
+
+    // Loan type summary
+    INCOME_INSUFFICIENT_FOR_LOAN, HIGH_DEBT_RATIO_DETECTED,
+
+    CODE_COUNT
+};
+
+/// <summary>
+/// Codes from this value upwards are rows of the active lending rules table
+/// </summary>
+const uint16_t LENDING_RULE_CODE_BASE = 0x100;
+
+/// <summary>
+/// One finding of a validator: what was found, where, and the number shown in its message
+/// </summary>
+struct ValidationEntry {
+    uint16_t code;          // ValidationCode, or LENDING_RULE_CODE_BASE + rule row
+    bool isWarning;
+    uint16_t index;         // Loan/reference number for messages that name one
+    int32_t value;          // Rule percentage, or customMessages slot for CUSTOM_MESSAGE
+};
+
 /// <summary>
 /// Stores validation results with errors and warnings
+/// Findings are kept as compact entries in an inline buffer (spilling to the heap
+/// only past INLINE_CAPACITY) and turned into text only when a report is rendered,
+/// so passing checks allocate nothing.
 /// </summary>
-struct ValidationResult {
+class ValidationResult {
+public:
+    static const size_t INLINE_CAPACITY = 8;
+
     bool isValid;
-    vector<string> errors;
-    vector<string> warnings;
 
-    ValidationResult() : isValid(true) {}
+private:
+    ValidationEntry inlineEntries[INLINE_CAPACITY];
+    size_t entryCount;
+    vector<ValidationEntry> overflowEntries;
+    vector<string> customMessages;  // Text for CUSTOM_MESSAGE entries
+    size_t errorCount;
+
+    void push(const ValidationEntry& entry);
+
+public:
+    ValidationResult() : isValid(true), entryCount(0), errorCount(0) {}
 
     /// <summary>
-    /// Adds an error message and marks validation as failed
+    /// Adds a coded error and marks validation as failed
     /// </summary>
-    void addError(const string& error) {
-        errors.push_back(error);
-        isValid = false;
-    }
+    /// <param name="code">What failed</param>
+    /// <param name="index">Loan/reference number the message names (if any)</param>
+    void addError(ValidationCode code, int index = 0);
 
     /// <summary>
-    /// Adds a warning message without failing validation
+    /// Adds a coded warning without failing validation
     /// </summary>
-    void addWarning(const string& warning) {
-        warnings.push_back(warning);
+    void addWarning(ValidationCode code, int index = 0);
+
+    /// <summary>
+    /// Adds a free-text error (allocates; validators use codes instead)
+    /// </summary>
+    void addError(const string& error);
+
+    /// <summary>
+    /// Adds a free-text warning (allocates; validators use codes instead)
+    /// </summary>
+    void addWarning(const string& warning);
+
+    /// <summary>
+    /// Adds an entry as-is (used by the lending rules); errors fail validation
+    /// </summary>
+    void addEntry(const ValidationEntry& entry);
+
+    /// <summary>
+    /// Copies the errors (not warnings) of another result into this one
+    /// </summary>
+    void appendErrors(const ValidationResult& other);
+
+    /// <summary>
+    /// Resets the result for reuse, keeping any allocated capacity
+    /// </summary>
+    void clear();
+
+    size_t getEntryCount() const { return entryCount; }
+    const ValidationEntry& getEntry(size_t i) const {
+        return (i < INLINE_CAPACITY) ? inlineEntries[i] : overflowEntries[i - INLINE_CAPACITY];
     }
+    size_t getErrorCount() const { return errorCount; }
+    size_t getWarningCount() const { return entryCount - errorCount; }
+
+    /// <summary>
+    /// Renders the message text for one entry
+    /// </summary>
+    string getMessage(const ValidationEntry& entry) const;
+
+    /// <summary>
+    /// Renders a coded (non-custom) entry; needs no result object
+    /// </summary>
+    static string getCodedMessage(const ValidationEntry& entry);
+
+    /// <summary>
+    /// Rendered error messages, in the order they were added
+    /// </summary>
+    vector<string> getErrors() const;
+
+    /// <summary>
+    /// Rendered warning messages, in the order they were added
+    /// </summary>
+    vector<string> getWarnings() const;
 
     /// <summary>
     /// Generates a formatted report of all errors and warnings
     /// </summary>
-    string getReport() const {
-        stringstream ss;
-        if (!isValid) {
-            ss << "VALIDATION FAILED:" << endl;
-            for (const auto& error : errors) {
-                ss << "  - " << error << endl;
-            }
-        }
-        for (const auto& warning : warnings) {
-            ss << "  [WARNING] " << warning << endl;
-        }
-        if (isValid && warnings.empty()) {
-            ss << "All validations passed!" << endl;
-        }
-        return ss.str();
-    }
+    string getReport() const;
 };
 
 /// <summary>
@@ -130,6 +229,78 @@ struct Reference {
     }
 };
 
+// Compact codes for low-cardinality fields
+
+/// <summary>
+/// Application lifecycle status (stored in one byte)
+/// </summary>
+enum class ApplicationStatus : uint8_t {
+    SUBMITTED, APPROVED, REJECTED,
+    C1, C2, C3,
+    INCOMPLETE_PERSONAL, INCOMPLETE_FINANCIAL,
+    INCOMPLETE_REFERENCES, INCOMPLETE_DOCUMENTS
+};
+
+enum class EmploymentStatus : uint8_t { NONE, SELF_EMPLOYED, SALARIED, RETIRED, UNEMPLOYED };
+enum class MaritalStatus : uint8_t { NONE, SINGLE, MARRIED, DIVORCED, WIDOWED };
+enum class Gender : uint8_t { NONE, MALE, FEMALE, OTHER };
+
+/// <summary>
+/// Product family of a loan, independent of how the type was spelled
+/// </summary>
+enum class LoanKind : uint8_t { NONE, HOME, CAR, SCOOTER, PERSONAL, UNKNOWN };
+
+/// <summary>
+/// Bits of the completed-sections mask
+/// </summary>
+enum SectionFlag : uint8_t {
+    SECTION_PERSONAL = 1,
+    SECTION_FINANCIAL = 2,
+    SECTION_REFERENCES = 4,
+    SECTION_DOCUMENTS = 8
+};
+
+/// <summary>
+/// Gets the stored text for a status code
+/// </summary>
+const string& getStatusName(ApplicationStatus status);
+
+/// <summary>
+/// Parses stored status text
+/// </summary>
+/// <param name="text">Status as written in applications.txt</param>
+/// <param name="status">Output: parsed code (unchanged if unknown)</param>
+/// <returns>True if the text is a known status</returns>
+bool tryParseStatus(const string& text, ApplicationStatus& status);
+
+/// <summary>
+/// True for the in-progress statuses (C1-C3 and incomplete_*)
+/// </summary>
+bool isIncompleteStatus(ApplicationStatus status);
+
+/// <summary>
+/// True once the lender has approved or rejected the application
+/// </summary>
+bool isDecidedStatus(ApplicationStatus status);
+
+const string& getEmploymentStatusName(EmploymentStatus value);
+bool tryParseEmploymentStatus(const string& text, EmploymentStatus& value);
+const string& getMaritalStatusName(MaritalStatus value);
+bool tryParseMaritalStatus(const string& text, MaritalStatus& value);
+const string& getGenderName(Gender value);
+bool tryParseGender(const string& text, Gender& value);
+
+/// <summary>
+/// Maps a section name (personal, financial, references, documents) to its flag
+/// </summary>
+/// <returns>Section flag, or 0 for an unknown name</returns>
+uint8_t getSectionFlag(const string& section);
+
+/// <summary>
+/// Gets the comma-separated list for a completed-sections mask
+/// </summary>
+const string& getCompletedSectionsText(uint8_t mask);
+
 // Encapsulates all loan application data and behavior
 
 /// <summary>
@@ -144,12 +315,18 @@ class LoanApplication {
 private:
     // Application metadata
     string applicationId;
-    string status;
     string submissionDate;
-    string completedSections;  
+
+    // Compact codes (see enums above); text is served from static tables
+    ApplicationStatus status;
+    EmploymentStatus employmentStatus;
+    MaritalStatus maritalStatus;
+    Gender gender;
+    uint8_t completedSections;      // SectionFlag bits
+    uint8_t loanTypeCode;           // Index into the known loan type spellings
+    string loanTypeText;            // Only used for spellings outside the table
 
     // Loan details
-    string loanType;
     string loanCategory;
     long long loanAmount;
     long long downPayment;
@@ -167,10 +344,7 @@ private:
     string cnicNumber;
     string cnicExpiryDate;
 
-    // Employment and family
-    string employmentStatus;
-    string maritalStatus;
-    string gender;
+    // Family
     int numberOfDependents;
 
     // Financial information
@@ -204,54 +378,67 @@ public:
     /// Gets unique application identifier
     /// </summary>
     /// <returns>Application ID string</returns>
-    string getApplicationId() const;
+    const string& getApplicationId() const;
 
     /// <summary>
     /// Gets current application status
     /// Possible values: submitted, approved, rejected, C1, C2, C3, incomplete_*
     /// </summary>
     /// <returns>Status string</returns>
-    string getStatus() const;
-
-    string getSubmissionDate() const;
-    string getFullName() const;
-    string getFathersName() const;
-    string getPostalAddress() const;
-    string getContactNumber() const;
-    string getEmailAddress() const;
-    string getCnicNumber() const;
-    string getCnicExpiryDate() const;
-    string getEmploymentStatus() const;
-    string getMaritalStatus() const;
-    string getGender() const;
+    const string& getStatus() const;
+
+    /// <summary>
+    /// Gets the status code (cheap to compare)
+    /// </summary>
+    ApplicationStatus getStatusCode() const;
+
+    const string& getSubmissionDate() const;
+    const string& getFullName() const;
+    const string& getFathersName() const;
+    const string& getPostalAddress() const;
+    const string& getContactNumber() const;
+    const string& getEmailAddress() const;
+    const string& getCnicNumber() const;
+    const string& getCnicExpiryDate() const;
+    const string& getEmploymentStatus() const;
+    const string& getMaritalStatus() const;
+    const string& getGender() const;
+    EmploymentStatus getEmploymentStatusCode() const;
     int getNumberOfDependents() const;
     long long getAnnualIncome() const;
     long long getAvgElectricityBill() const;
     long long getCurrentElectricityBill() const;
-    vector<ExistingLoan> getExistingLoans() const;
-    Reference getReference1() const;
-    Reference getReference2() const;
-    string getCnicFrontImagePath() const;
-    string getCnicBackImagePath() const;
-    string getElectricityBillImagePath() const;
-    string getSalarySlipImagePath() const;
-    string getLoanType() const;
-    string getLoanCategory() const;
+    const vector<ExistingLoan>& getExistingLoans() const;
+    const Reference& getReference1() const;
+    const Reference& getReference2() const;
+    const string& getCnicFrontImagePath() const;
+    const string& getCnicBackImagePath() const;
+    const string& getElectricityBillImagePath() const;
+    const string& getSalarySlipImagePath() const;
+    const string& getLoanType() const;
+
+    /// <summary>
+    /// Gets the loan family, whichever spelling of the type was stored
+    /// </summary>
+    LoanKind getLoanKind() const;
+
+    const string& getLoanCategory() const;
     long long getLoanAmount() const;
     long long getDownPayment() const;
     int getInstallmentMonths() const;
     long long getMonthlyPayment() const;
     int getInstallmentStartMonth() const;
     int getInstallmentStartYear() const;
-    string getRejectionReason() const;
-    string getCompletedSections() const;
+    const string& getRejectionReason() const;
+    const string& getCompletedSections() const;
+    uint8_t getCompletedSectionMask() const;
 
     /// <summary>
     /// Sets application ID with validation
     /// </summary>
     /// <param name="id">Unique application identifier</param>
     /// <exception cref="ValidationException">Thrown if ID is empty</exception>
-    void setApplicationId(const string& id);
+    void setApplicationId(string id);
 
     /// <summary>
     /// Sets application status with validation
@@ -260,46 +447,47 @@ public:
     /// <param name="stat">Status string</param>
     /// <exception cref="ValidationException">Thrown if status is invalid</exception>
     void setStatus(const string& stat);
+    void setStatus(ApplicationStatus stat);
 
     /// <summary>
     /// Sets submission date with format validation
     /// </summary>
     /// <param name="date">Date in DD-MM-YYYY format</param>
     /// <exception cref="ValidationException">Thrown if format is invalid</exception>
-    void setSubmissionDate(const string& date);
+    void setSubmissionDate(string date);
 
     /// <summary>
     /// Sets applicant's full name with length validation
     /// </summary>
     /// <param name="name">Full name (1-100 characters)</param>
     /// <exception cref="ValidationException">Thrown if name is empty or too long</exception>
-    void setFullName(const string& name);
+    void setFullName(string name);
 
-    void setFathersName(const string& name);
-    void setPostalAddress(const string& address);
+    void setFathersName(string name);
+    void setPostalAddress(string address);
 
     /// <summary>
     /// Sets contact number with length validation
     /// </summary>
     /// <param name="number">Phone number (10-15 digits)</param>
     /// <exception cref="ValidationException">Thrown if length is invalid</exception>
-    void setContactNumber(const string& number);
+    void setContactNumber(string number);
 
     /// <summary>
     /// Sets email with format validation
     /// </summary>
     /// <param name="email">Email address</param>
     /// <exception cref="ValidationException">Thrown if format is invalid</exception>
-    void setEmailAddress(const string& email);
+    void setEmailAddress(string email);
 
     /// <summary>
     /// Sets CNIC with strict validation
     /// </summary>
     /// <param name="cnic">13-digit CNIC without dashes</param>
     /// <exception cref="ValidationException">Thrown if not 13 digits or contains non-digits</exception>
-    void setCnicNumber(const string& cnic);
+    void setCnicNumber(string cnic);
 
-    void setCnicExpiryDate(const string& date);
+    void setCnicExpiryDate(string date);
     void setEmploymentStatus(const string& status);
     void setMaritalStatus(const string& status);
     void setGender(const string& gen);
@@ -307,21 +495,21 @@ public:
     void setAnnualIncome(long long income);
     void setAvgElectricityBill(long long amount);
     void setCurrentElectricityBill(long long amount);
-    void setReference1(const Reference& ref);
-    void setReference2(const Reference& ref);
-    void setCnicFrontImagePath(const string& path);
-    void setCnicBackImagePath(const string& path);
-    void setElectricityBillImagePath(const string& path);
-    void setSalarySlipImagePath(const string& path);
-    void setLoanType(const string& type);
-    void setLoanCategory(const string& category);
+    void setReference1(Reference ref);
+    void setReference2(Reference ref);
+    void setCnicFrontImagePath(string path);
+    void setCnicBackImagePath(string path);
+    void setElectricityBillImagePath(string path);
+    void setSalarySlipImagePath(string path);
+    void setLoanType(string type);
+    void setLoanCategory(string category);
     void setLoanAmount(long long amount);
     void setDownPayment(long long payment);
     void setInstallmentMonths(int months);
     void setMonthlyPayment(long long payment);
     void setInstallmentStartMonth(int month);
     void setInstallmentStartYear(int year);
-    void setRejectionReason(const string& reason);
+    void setRejectionReason(string reason);
     void setCompletedSections(const string& sections);
 
   
@@ -330,7 +518,7 @@ public:
     /// Adds an existing loan to the application
     /// </summary>
     /// <param name="loan">Existing loan to add</param>
-    void addExistingLoan(const ExistingLoan& loan);
+    void addExistingLoan(ExistingLoan loan);
 
     /// <summary>
     /// Removes all existing loans
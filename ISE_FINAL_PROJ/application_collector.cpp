@@ -1,11 +1,12 @@
 ﻿#include "application_collector.h"
+#include "screen_buffer.h"
 #include <iomanip>
 #include <sstream>
 #include<fstream>
 
 LoanApplication ApplicationCollector::collectApplicationForLoan(const string& loanType, const string& loanDetails) {
-    cout << Config::CHATBOT_NAME << ": " << "Starting " << loanType << " loan application process..." << endl;
-    cout << "Loan Type: " << loanDetails << endl << endl;
+    screen << Config::CHATBOT_NAME << ": " << "Starting " << loanType << " loan application process..." << '\n';
+    screen << "Loan Type: " << loanDetails << '\n' << '\n';
 
     LoanApplication application;
 
@@ -49,7 +50,7 @@ LoanApplication ApplicationCollector::collectApplicationForLoan(const string& lo
 
     }
     catch (const exception& e) {
-        cout << Config::CHATBOT_NAME << ": " << "Error collecting application: " << e.what() << endl;
+        screen << Config::CHATBOT_NAME << ": " << "Error collecting application: " << e.what() << '\n';
         throw;
     }
 
@@ -57,7 +58,7 @@ LoanApplication ApplicationCollector::collectApplicationForLoan(const string& lo
 }
 
 bool ApplicationCollector::collectPersonalInfo(LoanApplication& application) {
-    cout << "=== PERSONAL INFORMATION ===" << endl;
+    screen << "=== PERSONAL INFORMATION ===" << '\n';
 
     try {
         string fullName = getValidatedString(
@@ -95,24 +96,24 @@ bool ApplicationCollector::collectPersonalInfo(LoanApplication& application) {
         string cnicExpiry = getValidatedCNICExpiryDate("Please enter your CNIC expiry date (DD-MM-YYYY): ");  
         application.setCnicExpiryDate(cnicExpiry);
 
-        cout << Config::CHATBOT_NAME << ": Personal information collected successfully!" << endl;
+        screen << Config::CHATBOT_NAME << ": Personal information collected successfully!" << '\n';
         return true;
     }
     catch (const ValidationException& e) {
-        cout << Config::CHATBOT_NAME << ": " << e.what() << endl;
+        screen << Config::CHATBOT_NAME << ": " << e.what() << '\n';
         return false;
     }
     catch (const exception& e) {
-        cout << Config::CHATBOT_NAME << ": Error in personal information: " << e.what() << endl;
+        screen << Config::CHATBOT_NAME << ": Error in personal information: " << e.what() << '\n';
         return false;
     }
 }
 
 bool ApplicationCollector::collectEmploymentAndFinancialInfo(LoanApplication& application) {
-    cout << endl << "=== EMPLOYMENT & FINANCIAL INFORMATION ===" << endl;
+    screen << '\n' << "=== EMPLOYMENT & FINANCIAL INFORMATION ===" << '\n';
 
     try {
-        cout << Config::CHATBOT_NAME << ": " << "Let's collect your employment and financial details." << endl;
+        screen << Config::CHATBOT_NAME << ": " << "Let's collect your employment and financial details." << '\n';
 
         vector<string> employmentOptions = {
             "Self-employed",
@@ -141,7 +142,7 @@ bool ApplicationCollector::collectEmploymentAndFinancialInfo(LoanApplication& ap
             );
         }
 
-        cout << endl << "--- Personal Details ---" << endl;
+        screen << '\n' << "--- Personal Details ---" << '\n';
 
         vector<string> maritalOptions = { "Single", "Married", "Divorced", "Widowed" };
         string maritalStatus = getSelectionFromOptions(
@@ -161,7 +162,7 @@ bool ApplicationCollector::collectEmploymentAndFinancialInfo(LoanApplication& ap
         int dependents = 0;
 
         while (!validDependents) {
-            cout << Config::CHATBOT_NAME << ": " << "Please enter the number of people who depend on you financially: ";
+            screen << Config::CHATBOT_NAME << ": " << "Please enter the number of people who depend on you financially: ";
             string dependentsInput;
             getline(cin, dependentsInput);
             dependentsInput = trim(dependentsInput);
@@ -172,21 +173,21 @@ bool ApplicationCollector::collectEmploymentAndFinancialInfo(LoanApplication& ap
                     validDependents = true;
                 }
                 else {
-                    cout << Config::CHATBOT_NAME << ": " << "Please enter a number between 0 and 20." << endl;
+                    screen << Config::CHATBOT_NAME << ": " << "Please enter a number between 0 and 20." << '\n';
                 }
             }
             catch (const exception&) {
-                cout << Config::CHATBOT_NAME << ": " << "Invalid number. Please enter a valid number (0-20): ";
+                screen << Config::CHATBOT_NAME << ": " << "Invalid number. Please enter a valid number (0-20): ";
             }
         }
         application.setNumberOfDependents(dependents);
 
-        cout << endl << "--- Financial Information ---" << endl;
-        cout << Config::CHATBOT_NAME << ": " << "Now let's collect your financial information." << endl;
+        screen << '\n' << "--- Financial Information ---" << '\n';
+        screen << Config::CHATBOT_NAME << ": " << "Now let's collect your financial information." << '\n';
 
         long long annualIncome = 0;
         if (employmentStatus == "Unemployed") {
-            cout << Config::CHATBOT_NAME << ": " << "Since you're unemployed, please enter your household income or other sources of income." << endl;
+            screen << Config::CHATBOT_NAME << ": " << "Since you're unemployed, please enter your household income or other sources of income." << '\n';
             annualIncome = getValidatedNumeric(
                "Annual household/support income (PKR without commas): ",
                 "Annual income",
@@ -203,11 +204,11 @@ bool ApplicationCollector::collectEmploymentAndFinancialInfo(LoanApplication& ap
         application.setAnnualIncome(annualIncome);
 
         if (employmentStatus != "Unemployed" && annualIncome < 200000) {
-            cout << Config::CHATBOT_NAME << ": " << "Note: Your income seems low for your employment status." << endl;
+            screen << Config::CHATBOT_NAME << ": " << "Note: Your income seems low for your employment status." << '\n';
         }
 
-        cout << endl << "--- Utility Bill Information ---" << endl;
-        cout << Config::CHATBOT_NAME << ": " << "We need information about your electricity bills for address verification." << endl;
+        screen << '\n' << "--- Utility Bill Information ---" << '\n';
+        screen << Config::CHATBOT_NAME << ": " << "We need information about your electricity bills for address verification." << '\n';
 
         long long avgElectricityBill = getValidatedNumeric(
             Config::CHATBOT_NAME + ": Average monthly electricity bill for last 12 months (PKR without commas): ",
@@ -224,11 +225,11 @@ bool ApplicationCollector::collectEmploymentAndFinancialInfo(LoanApplication& ap
         application.setCurrentElectricityBill(currentElectricityBill);
 
         if (currentElectricityBill > avgElectricityBill * 2) {
-            cout << Config::CHATBOT_NAME << ": " << "Note: Your current bill is significantly higher than your average." << endl;
+            screen << Config::CHATBOT_NAME << ": " << "Note: Your current bill is significantly higher than your average." << '\n';
         }
 
         if (annualIncome > 1000000) {
-            cout << endl << "--- Additional Financial Details ---" << endl;
+            screen << '\n' << "--- Additional Financial Details ---" << '\n';
 
             vector<string> incomeSourceOptions = {
                 "Salary/Wages",
@@ -244,41 +245,41 @@ bool ApplicationCollector::collectEmploymentAndFinancialInfo(LoanApplication& ap
             );
         }
 
-        cout << endl << "--- Summary ---" << endl;
-        cout << Config::CHATBOT_NAME << ": " << "Let me confirm your employment and financial details:" << endl;
-        cout << "  Employment Status: " << employmentStatus << endl;
-        cout << "  Marital Status: " << maritalStatus << endl;
-        cout << "  Gender: " << gender << endl;
-        cout << "  Dependents: " << dependents << endl;
-        cout << "  Annual Income: PKR " << annualIncome << endl;
-        cout << "  Avg Electricity Bill: PKR " << avgElectricityBill << endl;
-        cout << "  Current Electricity Bill: PKR " << currentElectricityBill << endl;
+        screen << '\n' << "--- Summary ---" << '\n';
+        screen << Config::CHATBOT_NAME << ": " << "Let me confirm your employment and financial details:" << '\n';
+        screen << "  Employment Status: " << employmentStatus << '\n';
+        screen << "  Marital Status: " << maritalStatus << '\n';
+        screen << "  Gender: " << gender << '\n';
+        screen << "  Dependents: " << dependents << '\n';
+        screen << "  Annual Income: PKR " << annualIncome << '\n';
+        screen << "  Avg Electricity Bill: PKR " << avgElectricityBill << '\n';
+        screen << "  Current Electricity Bill: PKR " << currentElectricityBill << '\n';
 
-        cout << Config::CHATBOT_NAME << ": " << "Is this information correct? (yes/no): ";
+        screen << Config::CHATBOT_NAME << ": " << "Is this information correct? (yes/no): ";
         string confirmation;
         getline(cin, confirmation);
         confirmation = toLower(trim(confirmation));
 
         if (confirmation == "yes" || confirmation == "y") {
-            cout << Config::CHATBOT_NAME << ": " << "Employment and financial information collected successfully!" << endl;
+            screen << Config::CHATBOT_NAME << ": " << "Employment and financial information collected successfully!" << '\n';
             return true;
         }
         else {
-            cout << Config::CHATBOT_NAME << ": " << "Let's collect this information again." << endl;
+            screen << Config::CHATBOT_NAME << ": " << "Let's collect this information again." << '\n';
             return collectEmploymentAndFinancialInfo(application);
         }
     }
     catch (const exception& e) {
-        cout << Config::CHATBOT_NAME << ": " << "Error in employment information: " << e.what() << endl;
+        screen << Config::CHATBOT_NAME << ": " << "Error in employment information: " << e.what() << '\n';
         return false;
     }
 }
 
 bool ApplicationCollector::collectExistingLoansInfo(LoanApplication& application) {
-    cout << endl << "=== EXISTING LOANS INFORMATION ===" << endl;
+    screen << '\n' << "=== EXISTING LOANS INFORMATION ===" << '\n';
 
     try {
-        cout << Config::CHATBOT_NAME << ": " << "Do you have any existing loans from banks or financial institutions? (yes/no): ";
+        screen << Config::CHATBOT_NAME << ": " << "Do you have any existing loans from banks or financial institutions? (yes/no): ";
         string hasLoans;
         getline(cin, hasLoans);
         hasLoans = toLower(trim(hasLoans));
@@ -291,7 +292,7 @@ bool ApplicationCollector::collectExistingLoansInfo(LoanApplication& application
                 loanCount++;
                 ExistingLoan loan;
 
-                cout << endl << "--- Existing Loan #" << loanCount << " ---" << endl;
+                screen << '\n' << "--- Existing Loan #" << loanCount << " ---" << '\n';
 
                 vector<string> activeOptions = { "Yes, this loan is currently active", "No, this loan is closed" };
                 string activeChoice = getSelectionFromOptions("Is this loan currently active?: ", activeOptions);  
@@ -304,16 +305,16 @@ bool ApplicationCollector::collectExistingLoansInfo(LoanApplication& application
                     loan.amountDue = getValidatedNumeric(Config::CHATBOT_NAME + ": Remaining amount to pay (PKR): ", "Amount due", 0, loan.totalAmount);
 
                     if (loan.amountReturned + loan.amountDue != loan.totalAmount) {
-                        cout << Config::CHATBOT_NAME << ": " << "Note: The amounts don't add up correctly." << endl;
-                        cout << "Total: " << loan.totalAmount << " = Paid: " << loan.amountReturned << " + Due: " << loan.amountDue << endl;
-                        cout << "Auto-calculating due amount as: " << (loan.totalAmount - loan.amountReturned) << endl;
+                        screen << Config::CHATBOT_NAME << ": " << "Note: The amounts don't add up correctly." << '\n';
+                        screen << "Total: " << loan.totalAmount << " = Paid: " << loan.amountReturned << " + Due: " << loan.amountDue << '\n';
+                        screen << "Auto-calculating due amount as: " << (loan.totalAmount - loan.amountReturned) << '\n';
                         loan.amountDue = loan.totalAmount - loan.amountReturned;
                     }
                 }
                 else {
                     loan.amountReturned = loan.totalAmount;
                     loan.amountDue = 0;
-                    cout << Config::CHATBOT_NAME << ": " << "Marking as fully paid since loan is closed." << endl;
+                    screen << Config::CHATBOT_NAME << ": " << "Marking as fully paid since loan is closed." << '\n';
                 }
 
                 loan.bankName = getValidatedString(Config::CHATBOT_NAME + ": Bank or financial institution name: ", "Bank name", 2, 100);
@@ -322,45 +323,45 @@ bool ApplicationCollector::collectExistingLoansInfo(LoanApplication& application
                 loan.loanCategory = getSelectionFromOptions(Config::CHATBOT_NAME + ": Type of loan: ", loanCategories);
 
                 if (!loan.validate()) {
-                    cout << Config::CHATBOT_NAME << ": " << "Invalid loan information. Please re-enter this loan." << endl;
+                    screen << Config::CHATBOT_NAME << ": " << "Invalid loan information. Please re-enter this loan." << '\n';
                     loanCount--;
                     continue;
                 }
 
-                application.addExistingLoan(loan);
-                cout << Config::CHATBOT_NAME << ": " << " Loan #" << loanCount << " recorded successfully!" << endl;
+                application.addExistingLoan(move(loan));
+                screen << Config::CHATBOT_NAME << ": " << " Loan #" << loanCount << " recorded successfully!" << '\n';
 
                 if (loanCount < 10) {
-                    cout << Config::CHATBOT_NAME << ": " << "Do you have another existing loan to add? (yes/no): ";
+                    screen << Config::CHATBOT_NAME << ": " << "Do you have another existing loan to add? (yes/no): ";
                     string anotherLoan;
                     getline(cin, anotherLoan);
                     addMoreLoans = (toLower(trim(anotherLoan)) == "yes" || toLower(trim(anotherLoan)) == "y");
                 }
                 else {
-                    cout << Config::CHATBOT_NAME << ": " << "Maximum of 10 loans reached." << endl;
+                    screen << Config::CHATBOT_NAME << ": " << "Maximum of 10 loans reached." << '\n';
                     addMoreLoans = false;
                 }
             }
 
-            cout << Config::CHATBOT_NAME << ": " << "Total " << loanCount << " loan(s) recorded." << endl;
+            screen << Config::CHATBOT_NAME << ": " << "Total " << loanCount << " loan(s) recorded." << '\n';
         }
         else {
-            cout << Config::CHATBOT_NAME << ": " << "No existing loans recorded." << endl;
+            screen << Config::CHATBOT_NAME << ": " << "No existing loans recorded." << '\n';
         }
 
-        cout << Config::CHATBOT_NAME << ": " << " Existing loans information completed!" << endl;
+        screen << Config::CHATBOT_NAME << ": " << " Existing loans information completed!" << '\n';
         return true;
     }
     catch (const exception& e) {
-        cout << Config::CHATBOT_NAME << ": " << "Error in existing loans information: " << e.what() << endl;
+        screen << Config::CHATBOT_NAME << ": " << "Error in existing loans information: " << e.what() << '\n';
         return false;
     }
 }
 bool ApplicationCollector::collectReferencesInfo(LoanApplication& application) {
-    cout << endl << "=== REFERENCES INFORMATION ===" << endl;
+    screen << '\n' << "=== REFERENCES INFORMATION ===" << '\n';
 
     try {
-        cout << "We need information for two references." << endl;
+        screen << "We need information for two references." << '\n';
 
         bool referencesValid = false;
         int attemptCount = 0;
@@ -370,10 +371,10 @@ bool ApplicationCollector::collectReferencesInfo(LoanApplication& application) {
             attemptCount++;
 
             if (attemptCount > 1) {
-                cout << endl << "--- Please correct the reference information ---" << endl;
+                screen << '\n' << "--- Please correct the reference information ---" << '\n';
             }
 
-            cout << endl << "--- Reference 1 ---" << endl;
+            screen << '\n' << "--- Reference 1 ---" << '\n';
             Reference ref1;
             ref1.name = getValidatedString("Reference 1 full name: ", "Reference name", 1, 100);
             ref1.cnic = getValidatedCNIC(Config::CHATBOT_NAME + ": Reference 1 CNIC (13 digits without dashes): ");
@@ -381,7 +382,7 @@ bool ApplicationCollector::collectReferencesInfo(LoanApplication& application) {
             ref1.phoneNumber = getValidatedPhone(Config::CHATBOT_NAME + ": Reference 1 phone number: ");
             ref1.email = getValidatedEmail(Config::CHATBOT_NAME + ": Reference 1 email address: ");
 
-            cout << endl << "--- Reference 2 ---" << endl;
+            screen << '\n' << "--- Reference 2 ---" << '\n';
             Reference ref2;
             ref2.name = getValidatedString(Config::CHATBOT_NAME + ": Reference 2 full name: ", "Reference name", 1, 100);
 
@@ -390,11 +391,11 @@ bool ApplicationCollector::collectReferencesInfo(LoanApplication& application) {
                 ref2.cnic = getValidatedCNIC(Config::CHATBOT_NAME + ": Reference 2 CNIC (13 digits without dashes): ");
 
                 if (ref2.cnic == ref1.cnic) {
-                    cout << endl << "VALIDATION FAILED:" << endl;
-                    cout << "Reference 2 CNIC cannot be the same as Reference 1 CNIC!" << endl;
-                    cout << "Reference 1 CNIC: " << ref1.cnic << endl;
-                    cout << "Reference 2 CNIC: " << ref2.cnic << endl;
-                    cout << "Please enter a different CNIC for Reference 2." << endl << endl;
+                    screen << '\n' << "VALIDATION FAILED:" << '\n';
+                    screen << "Reference 2 CNIC cannot be the same as Reference 1 CNIC!" << '\n';
+                    screen << "Reference 1 CNIC: " << ref1.cnic << '\n';
+                    screen << "Reference 2 CNIC: " << ref2.cnic << '\n';
+                    screen << "Please enter a different CNIC for Reference 2." << '\n' << '\n';
                 }
                 else {
                     ref2CnicValid = true;
@@ -409,30 +410,30 @@ bool ApplicationCollector::collectReferencesInfo(LoanApplication& application) {
             bool ref2Valid = ref2.validate();
 
             if (!ref1Valid || !ref2Valid) {
-                cout << endl << "VALIDATION FAILED:" << endl;
+                screen << '\n' << "VALIDATION FAILED:" << '\n';
                 if (!ref1Valid) {
-                    cout << "Reference 1 has invalid data." << endl;
+                    screen << "Reference 1 has invalid data." << '\n';
                 }
                 if (!ref2Valid) {
-                    cout << "Reference 2 has invalid data." << endl;
+                    screen << "Reference 2 has invalid data." << '\n';
                 }
 
                 if (attemptCount < MAX_ATTEMPTS) {
-                    cout << "Please correct the reference information." << endl;
+                    screen << "Please correct the reference information." << '\n';
                     continue;
                 }
                 else {
-                    cout << "Maximum attempts reached. Please try again later." << endl;
+                    screen << "Maximum attempts reached. Please try again later." << '\n';
                     return false;
                 }
             }
-            application.setReference1(ref1);
-            application.setReference2(ref2);
+            application.setReference1(move(ref1));
+            application.setReference2(move(ref2));
             referencesValid = true;
         }
 
         if (referencesValid) {
-            cout << Config::CHATBOT_NAME << ": References information collected successfully!" << endl;
+            screen << Config::CHATBOT_NAME << ": References information collected successfully!" << '\n';
             return true;
         }
         else {
@@ -440,52 +441,52 @@ bool ApplicationCollector::collectReferencesInfo(LoanApplication& application) {
         }
     }
     catch (const ValidationException& e) {
-        cout << Config::CHATBOT_NAME << ": " << e.what() << endl;
+        screen << Config::CHATBOT_NAME << ": " << e.what() << '\n';
         return false;
     }
     catch (const exception& e) {
-        cout << Config::CHATBOT_NAME << ": Error in references information: " << e.what() << endl;
+        screen << Config::CHATBOT_NAME << ": Error in references information: " << e.what() << '\n';
         return false;
     }
 }
 
 
 bool ApplicationCollector::confirmApplication(const LoanApplication& application) {
-    cout << endl << "=== APPLICATION SUMMARY ===" << endl;
-    cout << "Please review your information:" << endl << endl;
-
-    cout << "PERSONAL INFORMATION:" << endl;
-    cout << "  Full Name: " << application.getFullName() << endl;
-    cout << "  Father's Name: " << application.getFathersName() << endl;
-    cout << "  CNIC: " << application.getCnicNumber() << endl;
-    cout << "  Contact: " << application.getContactNumber() << endl;
-    cout << "  Email: " << application.getEmailAddress() << endl;
-    cout << "  Address: " << application.getPostalAddress() << endl;
-
-    cout << endl << "EMPLOYMENT & FINANCIAL INFORMATION:" << endl;
-    cout << "  Employment Status: " << application.getEmploymentStatus() << endl;
-    cout << "  Marital Status: " << application.getMaritalStatus() << endl;
-    cout << "  Gender: " << application.getGender() << endl;
-    cout << "  Dependents: " << application.getNumberOfDependents() << endl;
-    cout << "  Annual Income: PKR " << application.getAnnualIncome() << endl;
-    cout << "  Avg Electricity Bill: PKR " << application.getAvgElectricityBill() << endl;
-    cout << "  Current Electricity Bill: PKR " << application.getCurrentElectricityBill() << endl;
-
-    cout << endl << "EXISTING LOANS: " << application.getExistingLoansCount() << " loan(s)" << endl;
-    auto existingLoans = application.getExistingLoans();
+    screen << '\n' << "=== APPLICATION SUMMARY ===" << '\n';
+    screen << "Please review your information:" << '\n' << '\n';
+
+    screen << "PERSONAL INFORMATION:" << '\n';
+    screen << "  Full Name: " << application.getFullName() << '\n';
+    screen << "  Father's Name: " << application.getFathersName() << '\n';
+    screen << "  CNIC: " << application.getCnicNumber() << '\n';
+    screen << "  Contact: " << application.getContactNumber() << '\n';
+    screen << "  Email: " << application.getEmailAddress() << '\n';
+    screen << "  Address: " << application.getPostalAddress() << '\n';
+
+    screen << '\n' << "EMPLOYMENT & FINANCIAL INFORMATION:" << '\n';
+    screen << "  Employment Status: " << application.getEmploymentStatus() << '\n';
+    screen << "  Marital Status: " << application.getMaritalStatus() << '\n';
+    screen << "  Gender: " << application.getGender() << '\n';
+    screen << "  Dependents: " << application.getNumberOfDependents() << '\n';
+    screen << "  Annual Income: PKR " << application.getAnnualIncome() << '\n';
+    screen << "  Avg Electricity Bill: PKR " << application.getAvgElectricityBill() << '\n';
+    screen << "  Current Electricity Bill: PKR " << application.getCurrentElectricityBill() << '\n';
+
+    screen << '\n' << "EXISTING LOANS: " << application.getExistingLoansCount() << " loan(s)" << '\n';
+    const auto& existingLoans = application.getExistingLoans();
     for (size_t i = 0; i < existingLoans.size(); i++) {
-        cout << "  Loan " << (i + 1) << ": " << existingLoans[i].bankName
+        screen << "  Loan " << (i + 1) << ": " << existingLoans[i].bankName
             << " - PKR " << existingLoans[i].totalAmount
-            << " (" << (existingLoans[i].isActive ? "Active" : "Closed") << ")" << endl;
+            << " (" << (existingLoans[i].isActive ? "Active" : "Closed") << ")" << '\n';
     }
 
-    Reference ref1 = application.getReference1();
-    Reference ref2 = application.getReference2();
-    cout << endl << "REFERENCES:" << endl;
-    cout << "  Reference 1: " << ref1.name << " (" << ref1.phoneNumber << ")" << endl;
-    cout << "  Reference 2: " << ref2.name << " (" << ref2.phoneNumber << ")" << endl;
+    const Reference& ref1 = application.getReference1();
+    const Reference& ref2 = application.getReference2();
+    screen << '\n' << "REFERENCES:" << '\n';
+    screen << "  Reference 1: " << ref1.name << " (" << ref1.phoneNumber << ")" << '\n';
+    screen << "  Reference 2: " << ref2.name << " (" << ref2.phoneNumber << ")" << '\n';
 
-    cout << endl << Config::CHATBOT_NAME << ": " << "Do you confirm this information is correct and ready for submission? (yes/no): ";
+    screen << '\n' << Config::CHATBOT_NAME << ": " << "Do you confirm this information is correct and ready for submission? (yes/no): ";
     string confirmation;
     getline(cin, confirmation);
     confirmation = toLower(trim(confirmation));
@@ -495,18 +496,23 @@ bool ApplicationCollector::confirmApplication(const LoanApplication& application
 
 string ApplicationCollector::getValidatedString(const string& prompt, const string& fieldName, size_t minLength, size_t maxLength) {
     while (true) {
-        cout << Config::CHATBOT_NAME << ": " << prompt;
+        screen << Config::CHATBOT_NAME << ": " << prompt;
         string input;
         getline(cin, input);
         input = trim(input);
 
         if (input.length() < minLength) {
-            cout << Config::CHATBOT_NAME << ": " << fieldName << " cannot be empty. Please try again." << endl;
+            screen << Config::CHATBOT_NAME << ": " << fieldName << " cannot be empty. Please try again." << '\n';
             continue;
         }
 
         if (input.length() > maxLength) {
-            cout << Config::CHATBOT_NAME << ": " << fieldName << " is too long. Maximum " << maxLength << " characters allowed." << endl;
+            screen << Config::CHATBOT_NAME << ": " << fieldName << " is too long. Maximum " << maxLength << " characters allowed." << '\n';
+            continue;
+        }
+
+        if (!isStorableField(input)) {
+            screen << Config::CHATBOT_NAME << ": " << fieldName << " cannot contain '" << Config::DELIMITER << "'. Please try again." << '\n';
             continue;
         }
 
@@ -525,10 +531,10 @@ string ApplicationCollector::getValidatedString(const string& prompt, const stri
 
         if (!hasLetters) {
             if (hasOnlyNumbers && input.length() > 0) {
-                cout << Config::CHATBOT_NAME << ": " << fieldName << " cannot contain only numbers. Please enter a valid name." << endl;
+                screen << Config::CHATBOT_NAME << ": " << fieldName << " cannot contain only numbers. Please enter a valid name." << '\n';
             }
             else {
-                cout << Config::CHATBOT_NAME << ": " << fieldName << " must contain letters. Please enter a valid name." << endl;
+                screen << Config::CHATBOT_NAME << ": " << fieldName << " must contain letters. Please enter a valid name." << '\n';
             }
             continue;
         }
@@ -539,7 +545,7 @@ string ApplicationCollector::getValidatedString(const string& prompt, const stri
 
 long long ApplicationCollector::getValidatedNumeric(const string& prompt, const string& fieldName, long long minValue, long long maxValue) {
     while (true) {
-        cout << Config::CHATBOT_NAME << ": " << prompt;
+        screen << Config::CHATBOT_NAME << ": " << prompt;
         string input;
         getline(cin, input);
         input = removeCommas(trim(input));
@@ -552,17 +558,17 @@ long long ApplicationCollector::getValidatedNumeric(const string& prompt, const
             long long value = stoll(input);
 
             if (value < minValue) {
-                cout << Config::CHATBOT_NAME << ": " << fieldName << " cannot be less than " << minValue << ". Please try again." << endl;
+                screen << Config::CHATBOT_NAME << ": " << fieldName << " cannot be less than " << minValue << ". Please try again." << '\n';
                 continue;
             }
 
             if (value > maxValue) {
-                cout << Config::CHATBOT_NAME << ": " << fieldName << " cannot be more than " << maxValue << ". Please try again." << endl;
+                screen << Config::CHATBOT_NAME << ": " << fieldName << " cannot be more than " << maxValue << ". Please try again." << '\n';
                 continue;
             }
 
             if (fieldName.find("income") != string::npos && value > 0 && value < 10000) {
-                cout << Config::CHATBOT_NAME << ": " << "Income seems unusually low. Please confirm this is correct: ";
+                screen << Config::CHATBOT_NAME << ": " << "Income seems unusually low. Please confirm this is correct: ";
                 string confirm;
                 getline(cin, confirm);
                 if (toLower(trim(confirm)) != "yes" && toLower(trim(confirm)) != "y") {
@@ -573,20 +579,20 @@ long long ApplicationCollector::getValidatedNumeric(const string& prompt, const
             return value;
         }
         catch (const exception&) {
-            cout << Config::CHATBOT_NAME << ": " << "Invalid number format. Please enter a valid number without commas." << endl;
+            screen << Config::CHATBOT_NAME << ": " << "Invalid number format. Please enter a valid number without commas." << '\n';
         }
     }
 }
 
 string ApplicationCollector::getValidatedCNIC(const string& prompt) {
     while (true) {
-        cout << Config::CHATBOT_NAME << ": " << prompt;
+        screen << Config::CHATBOT_NAME << ": " << prompt;
         string input;
         getline(cin, input);
         input = removeCommas(trim(input));
 
         if (input.length() != 13) {
-            cout << Config::CHATBOT_NAME << ": " << "CNIC must be exactly 13 digits. Please try again." << endl;
+            screen << Config::CHATBOT_NAME << ": " << "CNIC must be exactly 13 digits. Please try again." << '\n';
             continue;
         }
 
@@ -599,7 +605,7 @@ string ApplicationCollector::getValidatedCNIC(const string& prompt) {
         }
 
         if (!allDigits) {
-            cout << Config::CHATBOT_NAME << ": " << "CNIC must contain only digits. Please try again." << endl;
+            screen << Config::CHATBOT_NAME << ": " << "CNIC must contain only digits. Please try again." << '\n';
             continue;
         }
 
@@ -609,13 +615,13 @@ string ApplicationCollector::getValidatedCNIC(const string& prompt) {
 
 string ApplicationCollector::getValidatedCNICIssueDate(const string& prompt) {
     while (true) {
-        cout << Config::CHATBOT_NAME << ": " << prompt;
+        screen << Config::CHATBOT_NAME << ": " << prompt;
         string input;
         getline(cin, input);
         input = trim(input);
 
         if (input.length() != 10 || input[2] != '-' || input[5] != '-') {
-            cout << Config::CHATBOT_NAME << ": Date must be in DD-MM-YYYY format. Please try again." << endl;
+            screen << Config::CHATBOT_NAME << ": Date must be in DD-MM-YYYY format. Please try again." << '\n';
             continue;
         }
 
@@ -625,17 +631,17 @@ string ApplicationCollector::getValidatedCNICIssueDate(const string& prompt) {
             int year = stoi(input.substr(6, 4));
 
             if (day < 1 || day > 31) {
-                cout << Config::CHATBOT_NAME << ": Day must be between 1-31. Please try again." << endl;
+                screen << Config::CHATBOT_NAME << ": Day must be between 1-31. Please try again." << '\n';
                 continue;
             }
 
             if (month < 1 || month > 12) {
-                cout << Config::CHATBOT_NAME << ": Month must be between 1-12. Please try again." << endl;
+                screen << Config::CHATBOT_NAME << ": Month must be between 1-12. Please try again." << '\n';
                 continue;
             }
 
             if (year < 1900 || year > 2100) {
-                cout << Config::CHATBOT_NAME << ": Year must be between 1900-2100. Please try again." << endl;
+                screen << Config::CHATBOT_NAME << ": Year must be between 1900-2100. Please try again." << '\n';
                 continue;
             }
 
@@ -643,28 +649,28 @@ string ApplicationCollector::getValidatedCNICIssueDate(const string& prompt) {
             int comparison = compareDates(input, currentDate);
 
             if (comparison > 0) {
-                cout << Config::CHATBOT_NAME << ":  Issue date cannot be in the future. Please enter a valid issue date." << endl;
-                cout << "Current date: " << currentDate << endl;
-                cout << "Please try again." << endl;
+                screen << Config::CHATBOT_NAME << ":  Issue date cannot be in the future. Please enter a valid issue date." << '\n';
+                screen << "Current date: " << currentDate << '\n';
+                screen << "Please try again." << '\n';
                 continue;
             }
 
             return input;
         }
         catch (const exception&) {
-            cout << Config::CHATBOT_NAME << ": Invalid date format. Please use DD-MM-YYYY." << endl;
+            screen << Config::CHATBOT_NAME << ": Invalid date format. Please use DD-MM-YYYY." << '\n';
         }
     }
 }
 string ApplicationCollector::getValidatedCNICExpiryDate(const string& prompt) {
     while (true) {
-        cout << Config::CHATBOT_NAME << ": " << prompt;
+        screen << Config::CHATBOT_NAME << ": " << prompt;
         string input;
         getline(cin, input);
         input = trim(input);
 
         if (input.length() != 10 || input[2] != '-' || input[5] != '-') {
-            cout << Config::CHATBOT_NAME << ": Date must be in DD-MM-YYYY format. Please try again." << endl;
+            screen << Config::CHATBOT_NAME << ": Date must be in DD-MM-YYYY format. Please try again." << '\n';
             continue;
         }
 
@@ -674,17 +680,17 @@ string ApplicationCollector::getValidatedCNICExpiryDate(const string& prompt) {
             int year = stoi(input.substr(6, 4));
 
             if (day < 1 || day > 31) {
-                cout << Config::CHATBOT_NAME << ": Day must be between 1-31. Please try again." << endl;
+                screen << Config::CHATBOT_NAME << ": Day must be between 1-31. Please try again." << '\n';
                 continue;
             }
 
             if (month < 1 || month > 12) {
-                cout << Config::CHATBOT_NAME << ": Month must be between 1-12. Please try again." << endl;
+                screen << Config::CHATBOT_NAME << ": Month must be between 1-12. Please try again." << '\n';
                 continue;
             }
 
             if (year < 1900 || year > 2100) {
-                cout << Config::CHATBOT_NAME << ": Year must be between 1900-2100. Please try again." << endl;
+                screen << Config::CHATBOT_NAME << ": Year must be between 1900-2100. Please try again." << '\n';
                 continue;
             }
 
@@ -692,36 +698,36 @@ string ApplicationCollector::getValidatedCNICExpiryDate(const string& prompt) {
             int comparison = compareDates(input, currentDate);
 
             if (comparison <= 0) {
-                cout << endl << "========================================" << endl;
-                cout << "   CNIC EXPIRED" << endl;
-                cout << "========================================" << endl;
-                cout << "Your CNIC has expired or is expired today." << endl;
-                cout << "Current date: " << currentDate << endl;
-                cout << "CNIC expiry date: " << input << endl;
-                cout << endl;
-                cout << "You must renew your CNIC before applying for a loan." << endl;
-                cout << "========================================" << endl;
-                cout << endl;
-
-                cout << Config::CHATBOT_NAME << ": Would you like to:" << endl;
-                cout << "  1. Enter a new expiry date (continue with corrected date)" << endl;
-                cout << "  2. Return to main menu (exit application)" << endl;
-                cout << Config::CHATBOT_NAME << ": Please choose (1 or 2): ";
+                screen << '\n' << "========================================" << '\n';
+                screen << "   CNIC EXPIRED" << '\n';
+                screen << "========================================" << '\n';
+                screen << "Your CNIC has expired or is expired today." << '\n';
+                screen << "Current date: " << currentDate << '\n';
+                screen << "CNIC expiry date: " << input << '\n';
+                screen << '\n';
+                screen << "You must renew your CNIC before applying for a loan." << '\n';
+                screen << "========================================" << '\n';
+                screen << '\n';
+
+                screen << Config::CHATBOT_NAME << ": Would you like to:" << '\n';
+                screen << "  1. Enter a new expiry date (continue with corrected date)" << '\n';
+                screen << "  2. Return to main menu (exit application)" << '\n';
+                screen << Config::CHATBOT_NAME << ": Please choose (1 or 2): ";
 
                 string choice;
                 getline(cin, choice);
                 choice = trim(choice);
 
                 if (choice == "1") {
-                    cout << endl << Config::CHATBOT_NAME << ": Please enter the correct CNIC expiry date:" << endl;
+                    screen << '\n' << Config::CHATBOT_NAME << ": Please enter the correct CNIC expiry date:" << '\n';
                     continue;
                 }
                 else if (choice == "2") {
-                    cout << endl << Config::CHATBOT_NAME << ": Returning to main menu..." << endl;
+                    screen << '\n' << Config::CHATBOT_NAME << ": Returning to main menu..." << '\n';
                     throw ValidationException("User chose to return to main menu due to expired CNIC.");
                 }
                 else {
-                    cout << Config::CHATBOT_NAME << ": Invalid choice. Please enter 1 or 2." << endl;
+                    screen << Config::CHATBOT_NAME << ": Invalid choice. Please enter 1 or 2." << '\n';
                     continue;
                 }
             }
@@ -732,20 +738,25 @@ string ApplicationCollector::getValidatedCNICExpiryDate(const string& prompt) {
             throw;
         }
         catch (const exception&) {
-            cout << Config::CHATBOT_NAME << ": Invalid date format. Please use DD-MM-YYYY." << endl;
+            screen << Config::CHATBOT_NAME << ": Invalid date format. Please use DD-MM-YYYY." << '\n';
         }
     }
 }
 
 string ApplicationCollector::getValidatedEmail(const string& prompt) {
     while (true) {
-        cout << Config::CHATBOT_NAME << ": " << prompt;
+        screen << Config::CHATBOT_NAME << ": " << prompt;
         string input;
         getline(cin, input);
         input = trim(input);
 
         if (input.find('@') == string::npos || input.find('.') == string::npos) {
-            cout << Config::CHATBOT_NAME << ": " << "Invalid email format. Please include '@' and '.'" << endl;
+            screen << Config::CHATBOT_NAME << ": " << "Invalid email format. Please include '@' and '.'" << '\n';
+            continue;
+        }
+
+        if (!isStorableField(input)) {
+            screen << Config::CHATBOT_NAME << ": " << "Email address cannot contain '" << Config::DELIMITER << "'. Please try again." << '\n';
             continue;
         }
 
@@ -755,13 +766,13 @@ string ApplicationCollector::getValidatedEmail(const string& prompt) {
 
 string ApplicationCollector::getSelectionFromOptions(const string& prompt, const vector<string>& options) {
     while (true) {
-        cout << Config::CHATBOT_NAME << ": " << prompt << endl;
+        screen << Config::CHATBOT_NAME << ": " << prompt << '\n';
 
         for (size_t i = 0; i < options.size(); i++) {
-            cout << "  " << (i + 1) << ". " << options[i] << endl;
+            screen << "  " << (i + 1) << ". " << options[i] << '\n';
         }
 
-        cout << "You: ";
+        screen << "You: ";
         string input;
         getline(cin, input);
         input = trim(input);
@@ -782,19 +793,19 @@ string ApplicationCollector::getSelectionFromOptions(const string& prompt, const
             }
         }
 
-        cout << Config::CHATBOT_NAME << ": " << "Invalid selection. Please choose from the available options." << endl;
+        screen << Config::CHATBOT_NAME << ": " << "Invalid selection. Please choose from the available options." << '\n';
     }
 }
 
 string ApplicationCollector::getValidatedDate(const string& prompt) {
     while (true) {
-        cout << Config::CHATBOT_NAME << ": " << prompt;
+        screen << Config::CHATBOT_NAME << ": " << prompt;
         string input;
         getline(cin, input);
         input = trim(input);
 
         if (input.length() != 10 || input[2] != '-' || input[5] != '-') {
-            cout << Config::CHATBOT_NAME << ": Date must be in DD-MM-YYYY format. Please try again." << endl;
+            screen << Config::CHATBOT_NAME << ": Date must be in DD-MM-YYYY format. Please try again." << '\n';
             continue;
         }
 
@@ -804,31 +815,31 @@ string ApplicationCollector::getValidatedDate(const string& prompt) {
             int year = stoi(input.substr(6, 4));
 
             if (day < 1 || day > 31) {
-                cout << Config::CHATBOT_NAME << ": Day must be between 1-31. Please try again." << endl;
+                screen << Config::CHATBOT_NAME << ": Day must be between 1-31. Please try again." << '\n';
                 continue;
             }
 
             if (month < 1 || month > 12) {
-                cout << Config::CHATBOT_NAME << ": Month must be between 1-12. Please try again." << endl;
+                screen << Config::CHATBOT_NAME << ": Month must be between 1-12. Please try again." << '\n';
                 continue;
             }
 
             if (year < 1900 || year > 2100) {
-                cout << Config::CHATBOT_NAME << ": Year must be between 1900-2100. Please try again." << endl;
+                screen << Config::CHATBOT_NAME << ": Year must be between 1900-2100. Please try again." << '\n';
                 continue;
             }
 
             return input;
         }
         catch (const exception&) {
-            cout << Config::CHATBOT_NAME << ": Invalid date format. Please use DD-MM-YYYY." << endl;
+            screen << Config::CHATBOT_NAME << ": Invalid date format. Please use DD-MM-YYYY." << '\n';
         }
     }
 }
 
 string ApplicationCollector::getValidatedPhone(const string& prompt) {
     while (true) {
-        cout << Config::CHATBOT_NAME << ": " << prompt;
+        screen << Config::CHATBOT_NAME << ": " << prompt;
         string input;
         getline(cin, input);
         input = trim(input);
@@ -841,8 +852,8 @@ string ApplicationCollector::getValidatedPhone(const string& prompt) {
         }
 
         if (cleaned.length() != 11) {
-            cout << Config::CHATBOT_NAME << ": Phone number must be exactly 11 digits. Please try again." << endl;
-            cout << "Example: 03001234567" << endl;
+            screen << Config::CHATBOT_NAME << ": Phone number must be exactly 11 digits. Please try again." << '\n';
+            screen << "Example: 03001234567" << '\n';
             continue;
         }
 
@@ -860,7 +871,7 @@ string ApplicationCollector::getValidatedPhone(const string& prompt) {
         }
 
         if (!valid) {
-            cout << Config::CHATBOT_NAME << ": Phone number can only contain digits. Please try again." << endl;
+            screen << Config::CHATBOT_NAME << ": Phone number can only contain digits. Please try again." << '\n';
             continue;
         }
 
@@ -869,7 +880,7 @@ string ApplicationCollector::getValidatedPhone(const string& prompt) {
 }
 
 void ApplicationCollector::collectLoanSpecificInfo(LoanApplication& application, const string& loanType, const string& loanDetails) {
-    cout << endl << "=== " << loanType << " LOAN SPECIFIC INFORMATION ===" << endl;
+    screen << '\n' << "=== " << loanType << " LOAN SPECIFIC INFORMATION ===" << '\n';
 
     if (loanType == "car") {
         string carMake = getValidatedString("Car make: ", "Car make", 1, 50);
@@ -883,16 +894,16 @@ void ApplicationCollector::collectLoanSpecificInfo(LoanApplication& application,
         string loanPurpose = getValidatedString("Loan purpose: ", "Loan purpose", 1, 100);
     }
 
-    cout << Config::CHATBOT_NAME << ": " << loanType << " specific information collected!" << endl;
+    screen << Config::CHATBOT_NAME << ": " << loanType << " specific information collected!" << '\n';
 }
 
 bool ApplicationCollector::collectImagePaths(LoanApplication& application) {
-    cout << endl << "=== DOCUMENT UPLOAD ===" << endl;
+    screen << '\n' << "=== DOCUMENT UPLOAD ===" << '\n';
 
     try {
-        cout << Config::CHATBOT_NAME << ": " << "Now we need the file paths for your document images." << endl;
-        cout << "Please make sure the image files exist at the paths you provide." << endl;
-        cout << "The images will be copied to the project's 'images' folder." << endl << endl;
+        screen << Config::CHATBOT_NAME << ": " << "Now we need the file paths for your document images." << '\n';
+        screen << "Please make sure the image files exist at the paths you provide." << '\n';
+        screen << "The images will be copied to the project's 'images' folder." << '\n' << '\n';
 
         bool documentsValid = false;
         int attemptCount = 0;
@@ -902,26 +913,26 @@ bool ApplicationCollector::collectImagePaths(LoanApplication& application) {
             attemptCount++;
 
             if (attemptCount > 1) {
-                cout << endl << "--- Attempt " << attemptCount << " - Please correct the document paths ---" << endl;
+                screen << '\n' << "--- Attempt " << attemptCount << " - Please correct the document paths ---" << '\n';
             }
 
             // CNIC Front Side
-            cout << "--- CNIC Front Side ---" << endl;
+            screen << "--- CNIC Front Side ---" << '\n';
             string cnicFrontPath = getImagePath("CNIC Front Side");
             application.setCnicFrontImagePath(cnicFrontPath);
 
             // CNIC Back Side
-            cout << "--- CNIC Back Side ---" << endl;
+            screen << "--- CNIC Back Side ---" << '\n';
             string cnicBackPath = getImagePath("CNIC Back Side");
             application.setCnicBackImagePath(cnicBackPath);
 
             // Electricity Bill
-            cout << "--- Electricity Bill ---" << endl;
+            screen << "--- Electricity Bill ---" << '\n';
             string electricityBillPath = getImagePath("Recent Electricity Bill");
             application.setElectricityBillImagePath(electricityBillPath);
 
             // Salary Slip/Bank Statement
-            cout << "--- Salary Slip/Bank Statement ---" << endl;
+            screen << "--- Salary Slip/Bank Statement ---" << '\n';
             string salarySlipPath = getImagePath("Salary Slip or Bank Statement");
             application.setSalarySlipImagePath(salarySlipPath);
 
@@ -931,25 +942,25 @@ bool ApplicationCollector::collectImagePaths(LoanApplication& application) {
                 application.getElectricityBillImagePath().empty() ||
                 application.getSalarySlipImagePath().empty()) {
 
-                cout << endl << "  VALIDATION FAILED:" << endl;
-                cout << "  • Some required documents are missing" << endl;
+                screen << '\n' << "  VALIDATION FAILED:" << '\n';
+                screen << "  • Some required documents are missing" << '\n';
 
                 if (application.getCnicFrontImagePath().empty())
-                    cout << "  • CNIC Front Side is required" << endl;
+                    screen << "  • CNIC Front Side is required" << '\n';
                 if (application.getCnicBackImagePath().empty())
-                    cout << "  • CNIC Back Side is required" << endl;
+                    screen << "  • CNIC Back Side is required" << '\n';
                 if (application.getElectricityBillImagePath().empty())
-                    cout << "  • Electricity Bill is required" << endl;
+                    screen << "  • Electricity Bill is required" << '\n';
                 if (application.getSalarySlipImagePath().empty())
-                    cout << "  • Salary Slip/Bank Statement is required" << endl;
+                    screen << "  • Salary Slip/Bank Statement is required" << '\n';
 
                 if (attemptCount < MAX_ATTEMPTS) {
-                    cout << endl << Config::CHATBOT_NAME << ": Please provide all required documents." << endl;
+                    screen << '\n' << Config::CHATBOT_NAME << ": Please provide all required documents." << '\n';
                     // Continue the loop to try again
                     continue;
                 }
                 else {
-                    cout << endl << Config::CHATBOT_NAME << ": Maximum attempts reached. Please complete documents later." << endl;
+                    screen << '\n' << Config::CHATBOT_NAME << ": Maximum attempts reached. Please complete documents later." << '\n';
                     // Don't mark as completed if documents are missing
                     return false;
                 }
@@ -959,17 +970,17 @@ bool ApplicationCollector::collectImagePaths(LoanApplication& application) {
         }
 
         if (documentsValid) {
-            cout << endl << Config::CHATBOT_NAME << ": " << "All documents uploaded successfully!" << endl;
+            screen << '\n' << Config::CHATBOT_NAME << ": " << "All documents uploaded successfully!" << '\n';
             application.markSectionCompleted("documents");
             return true;
         }
         else {
-            cout << endl << Config::CHATBOT_NAME << ": Document upload incomplete. You can complete it later." << endl;
+            screen << '\n' << Config::CHATBOT_NAME << ": Document upload incomplete. You can complete it later." << '\n';
             return false;
         }
     }
     catch (const exception& e) {
-        cout << Config::CHATBOT_NAME << ": " << "Error in document information: " << e.what() << endl;
+        screen << Config::CHATBOT_NAME << ": " << "Error in document information: " << e.what() << '\n';
         return false;
     }
 }
@@ -980,24 +991,24 @@ string ApplicationCollector::getImagePath(const string& imageType) {
     while (attemptCount < MAX_ATTEMPTS) {
         attemptCount++;
 
-        cout << endl;
-        cout << "========================================" << endl;
-        cout << "  " << imageType << " (Attempt " << attemptCount << " of " << MAX_ATTEMPTS << ")" << endl;
-        cout << "========================================" << endl;
-        cout << Config::CHATBOT_NAME << ": Please enter the file path for " << imageType << endl;
-        cout << endl;
-        cout << "  • This must be from your ORIGINAL location on your computer" << endl;
-        cout << "  • Example: C:\\Users\\YourName\\Pictures\\document.jpg" << endl;
-        cout << "  • Or: /home/user/documents/file.png" << endl;
-        cout << endl;
-        cout << "File path: ";
+        screen << '\n';
+        screen << "========================================" << '\n';
+        screen << "  " << imageType << " (Attempt " << attemptCount << " of " << MAX_ATTEMPTS << ")" << '\n';
+        screen << "========================================" << '\n';
+        screen << Config::CHATBOT_NAME << ": Please enter the file path for " << imageType << '\n';
+        screen << '\n';
+        screen << "  • This must be from your ORIGINAL location on your computer" << '\n';
+        screen << "  • Example: C:\\Users\\YourName\\Pictures\\document.jpg" << '\n';
+        screen << "  • Or: /home/user/documents/file.png" << '\n';
+        screen << '\n';
+        screen << "File path: ";
 
         string path;
         getline(cin, path);
         path = trim(path);
 
         if (path.empty()) {
-            cout << Config::CHATBOT_NAME << ": No path provided. Skipping this document." << endl;
+            screen << Config::CHATBOT_NAME << ": No path provided. Skipping this document." << '\n';
             return "";
         }
 
@@ -1006,18 +1017,31 @@ string ApplicationCollector::getImagePath(const string& imageType) {
             if (c == '\\') c = '/';
         }
 
+        // The path is stored in the record if the copy fails
+        if (!isStorableField(path)) {
+            screen << '\n' << "ERROR: File paths cannot contain '" << Config::DELIMITER << "'" << '\n';
+            if (attemptCount < MAX_ATTEMPTS) {
+                screen << "Please rename or move the file and try again." << '\n';
+                continue;
+            }
+            else {
+                screen << Config::CHATBOT_NAME << ": Maximum attempts reached. Skipping this document." << '\n';
+                return "";
+            }
+        }
+
         // Check if file exists
         ifstream testFile(path, ios::binary | ios::ate);
         if (!testFile.is_open()) {
-            cout << endl << "ERROR: Cannot find file at this location" << endl;
-            cout << "Path tried: " << path << endl;
+            screen << '\n' << "ERROR: Cannot find file at this location" << '\n';
+            screen << "Path tried: " << path << '\n';
 
             if (attemptCount < MAX_ATTEMPTS) {
-                cout << "Please check the path and try again." << endl;
+                screen << "Please check the path and try again." << '\n';
                 continue;
             }
             else {
-                cout << Config::CHATBOT_NAME << ": Maximum attempts reached. Skipping this document." << endl;
+                screen << Config::CHATBOT_NAME << ": Maximum attempts reached. Skipping this document." << '\n';
                 return "";
             }
         }
@@ -1026,18 +1050,18 @@ string ApplicationCollector::getImagePath(const string& imageType) {
         testFile.close();
 
         if (fileSize == 0) {
-            cout << endl << "ERROR: File is empty (0 bytes)" << endl;
+            screen << '\n' << "ERROR: File is empty (0 bytes)" << '\n';
             if (attemptCount < MAX_ATTEMPTS) {
-                cout << "Please select a file with content." << endl;
+                screen << "Please select a file with content." << '\n';
                 continue;
             }
             else {
-                cout << Config::CHATBOT_NAME << ": Maximum attempts reached. Skipping this document." << endl;
+                screen << Config::CHATBOT_NAME << ": Maximum attempts reached. Skipping this document." << '\n';
                 return "";
             }
         }
 
-        cout << endl << "File found and validated!" << endl;
+        screen << '\n' << "File found and validated!" << '\n';
         return path; // SUCCESS
     }
 
@@ -1046,30 +1070,29 @@ string ApplicationCollector::getImagePath(const string& imageType) {
 
 
 bool ApplicationCollector::collectFinancialDocuments(LoanApplication& application) {
-    cout << endl << "=== ADDITIONAL FINANCIAL DOCUMENTS ===" << endl;
+    screen << '\n' << "=== ADDITIONAL FINANCIAL DOCUMENTS ===" << '\n';
 
     try {
-        cout << Config::CHATBOT_NAME << ": " << "We need some additional financial documents for verification." << endl;
+        screen << Config::CHATBOT_NAME << ": " << "We need some additional financial documents for verification." << '\n';
 
-        cout << endl << "--- Bank Statement ---" << endl;
+        screen << '\n' << "--- Bank Statement ---" << '\n';
         string bankStatementPath = getImagePath("Bank Statement (Last 3 months)");
 
-        if (application.getEmploymentStatus() == "Salaried (Regular Job)" ||
-            application.getEmploymentStatus() == "Salaried") {
-            cout << endl << "--- Additional Salary Slips ---" << endl;
+        if (application.getEmploymentStatusCode() == EmploymentStatus::SALARIED) {
+            screen << '\n' << "--- Additional Salary Slips ---" << '\n';
             string additionalSalarySlips = getImagePath("Last 3 Salary Slips");
         }
 
-        if (application.getEmploymentStatus() == "Self-employed") {
-            cout << endl << "--- Business Documents ---" << endl;
+        if (application.getEmploymentStatusCode() == EmploymentStatus::SELF_EMPLOYED) {
+            screen << '\n' << "--- Business Documents ---" << '\n';
             string businessDocuments = getImagePath("Business Registration Documents");
         }
 
-        cout << Config::CHATBOT_NAME << ": " << "Financial documents recorded successfully!" << endl;
+        screen << Config::CHATBOT_NAME << ": " << "Financial documents recorded successfully!" << '\n';
         return true;
     }
     catch (const exception& e) {
-        cout << Config::CHATBOT_NAME << ": " << "Error in financial documents: " << e.what() << endl;
+        screen << Config::CHATBOT_NAME << ": " << "Error in financial documents: " << e.what() << '\n';
         return false;
     }
 }
@@ -1077,24 +1100,24 @@ bool ApplicationCollector::collectFinancialDocuments(LoanApplication& applicatio
 /// Collects installment start month and year from user
 /// </summary>
 void ApplicationCollector::collectInstallmentStartDate(LoanApplication& application) {
-    cout << endl << "=== INSTALLMENT START DATE ===" << endl;
-    cout << Config::CHATBOT_NAME << ": When would you like to start paying installments?" << endl;
+    screen << '\n' << "=== INSTALLMENT START DATE ===" << '\n';
+    screen << Config::CHATBOT_NAME << ": When would you like to start paying installments?" << '\n';
 
     // Get starting month
     int startMonth = 0;
     while (startMonth < 1 || startMonth > 12) {
-        cout << Config::CHATBOT_NAME << ": Enter starting month (1=January, 2=February, ..., 12=December): ";
+        screen << Config::CHATBOT_NAME << ": Enter starting month (1=January, 2=February, ..., 12=December): ";
         string monthInput;
         getline(cin, monthInput);
 
         try {
             startMonth = stoi(trim(monthInput));
             if (startMonth < 1 || startMonth > 12) {
-                cout << " Month must be between 1 and 12." << endl;
+                screen << " Month must be between 1 and 12." << '\n';
             }
         }
         catch (...) {
-            cout << " Invalid input. Please enter a number (1-12)." << endl;
+            screen << " Invalid input. Please enter a number (1-12)." << '\n';
             startMonth = 0;
         }
     }
@@ -1103,28 +1126,28 @@ void ApplicationCollector::collectInstallmentStartDate(LoanApplication& applicat
     // Get starting year
     int startYear = 0;
     while (startYear < 2024 || startYear > 2100) {
-        cout << Config::CHATBOT_NAME << ": Enter starting year (e.g., 2024, 2025): ";
+        screen << Config::CHATBOT_NAME << ": Enter starting year (e.g., 2024, 2025): ";
         string yearInput;
         getline(cin, yearInput);
 
         try {
             startYear = stoi(trim(yearInput));
             if (startYear < 2024 || startYear > 2100) {
-                cout << " Year must be between 2024 and 2100." << endl;
+                screen << " Year must be between 2024 and 2100." << '\n';
             }
         }
         catch (...) {
-            cout << " Invalid input. Please enter a valid year." << endl;
+            screen << " Invalid input. Please enter a valid year." << '\n';
             startYear = 0;
         }
     }
     application.setInstallmentStartYear(startYear);
 
-    cout << " Installment start date set to: " << getMonthName(startMonth) << " " << startYear << endl;
+    screen << " Installment start date set to: " << getMonthName(startMonth) << " " << startYear << '\n';
 }
 bool ApplicationCollector::getValidatedYesNo(const string& prompt) {
     while (true) {
-        cout << Config::CHATBOT_NAME << ": " << prompt;
+        screen << Config::CHATBOT_NAME << ": " << prompt;
         string input;
         getline(cin, input);
         input = toLower(trim(input));
@@ -1150,10 +1173,10 @@ bool ApplicationCollector::getValidatedYesNo(const string& prompt) {
             }
 
             if (isNumber) {
-                cout << Config::CHATBOT_NAME << ":  Invalid input. Please enter 'Y' for Yes or 'N' for No, not numbers." << endl;
+                screen << Config::CHATBOT_NAME << ":  Invalid input. Please enter 'Y' for Yes or 'N' for No, not numbers." << '\n';
             }
             else {
-                cout << Config::CHATBOT_NAME << ":  Invalid input. Please enter 'Y' for Yes or 'N' for No." << endl;
+                screen << Config::CHATBOT_NAME << ":  Invalid input. Please enter 'Y' for Yes or 'N' for No." << '\n';
             }
         }
     }
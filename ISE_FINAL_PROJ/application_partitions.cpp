@@ -0,0 +1,151 @@
+#include "application_partitions.h"
+#include "write_ahead_log.h"
+#include "utilities.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cerrno>
+#include <cctype>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+using namespace std;
+
+const string ApplicationPartitions::UNDATED_MONTH = "undated";
+
+namespace {
+    bool makeDirectory(const string& path) {
+#ifdef _WIN32
+        return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+        return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+    }
+
+    bool partitionMonthLess(const PartitionInfo& a, const PartitionInfo& b) {
+        return a.month < b.month;
+    }
+}
+
+ApplicationPartitions::ApplicationPartitions(const string& dataFile)
+    : directory(dataFile + ".parts"), manifestFile(dataFile + ".parts/manifest.txt"),
+    movingMarker(dataFile + ".parts/moving"), manifestSize(-1), manifestModified(-1) {
+}
+
+string ApplicationPartitions::monthOf(const string& submissionDate) {
+    string sortable;
+    if (!sortableDate(submissionDate, sortable)) return UNDATED_MONTH;
+    return sortable.substr(0, 4) + "-" + sortable.substr(4, 2);
+}
+
+bool ApplicationPartitions::sortableDate(const string& date, string& sortable) {
+    if (date.size() != 10 || date[2] != '-' || date[5] != '-') return false;
+    for (size_t i = 0; i < date.size(); i++) {
+        if (i != 2 && i != 5 && !isdigit(static_cast<unsigned char>(date[i]))) return false;
+    }
+    int month = (date[3] - '0') * 10 + (date[4] - '0');
+    if (month < 1 || month > 12) return false;
+
+    sortable = date.substr(6, 4) + date.substr(3, 2) + date.substr(0, 2);
+    return true;
+}
+
+void ApplicationPartitions::refresh() {
+    struct stat info;
+    if (stat(manifestFile.c_str(), &info) != 0) {
+        partitions.clear();
+        manifestSize = manifestModified = -1;
+        return;
+    }
+    if (info.st_size == manifestSize && static_cast<long long>(info.st_mtime) == manifestModified) return;
+
+    vector<PartitionInfo> loaded;
+    ifstream file(manifestFile);
+    string line;
+    while (getline(file, line)) {
+        vector<string> parts = splitString(trim(line), Config::DELIMITER);
+        PartitionInfo partition;
+        long long records = 0;
+        if (parts.size() < 3 || !tryParseNumber(parts[1], records) || !tryParseNumber(parts[2], partition.highestId)) {
+            continue;
+        }
+        partition.month = parts[0];
+        partition.records = static_cast<size_t>(records);
+        loaded.push_back(partition);
+    }
+    sort(loaded.begin(), loaded.end(), partitionMonthLess);
+
+    partitions.swap(loaded);
+    manifestSize = info.st_size;
+    manifestModified = static_cast<long long>(info.st_mtime);
+}
+
+const vector<PartitionInfo>& ApplicationPartitions::getPartitions() const {
+    return partitions;
+}
+
+const string& ApplicationPartitions::getManifestFile() const {
+    return manifestFile;
+}
+
+string ApplicationPartitions::segmentFile(const string& month) const {
+    return directory + "/" + month + ".seg";
+}
+
+vector<string> ApplicationPartitions::monthsBetween(const string& fromDate, const string& toDate) const {
+    vector<string> months;
+    string from = monthOf(fromDate);
+    string to = monthOf(toDate);
+    if (from == UNDATED_MONTH || to == UNDATED_MONTH) return months;
+
+    for (const auto& partition : partitions) {
+        if (partition.month != UNDATED_MONTH && partition.month >= from && partition.month <= to) {
+            months.push_back(partition.month);
+        }
+    }
+    return months;
+}
+
+void ApplicationPartitions::setPartition(const PartitionInfo& partition) {
+    auto existing = lower_bound(partitions.begin(), partitions.end(), partition, partitionMonthLess);
+    if (existing != partitions.end() && existing->month == partition.month) {
+        *existing = partition;
+    }
+    else {
+        partitions.insert(existing, partition);
+    }
+}
+
+bool ApplicationPartitions::saveManifest() {
+    stringstream manifest;
+    for (const auto& partition : partitions) {
+        manifest << partition.month << Config::DELIMITER << partition.records << Config::DELIMITER
+            << partition.highestId << '\n';
+    }
+    if (!replaceFileContents(manifestFile, manifest.str(), true)) return false;
+
+    // Our own write is not a change made by someone else
+    struct stat info;
+    if (stat(manifestFile.c_str(), &info) == 0) {
+        manifestSize = info.st_size;
+        manifestModified = static_cast<long long>(info.st_mtime);
+    }
+    return true;
+}
+
+bool ApplicationPartitions::isMoving() const {
+    struct stat info;
+    return stat(movingMarker.c_str(), &info) == 0;
+}
+
+bool ApplicationPartitions::beginMove() {
+    return makeDirectory(directory) && replaceFileContents(movingMarker, "", true);
+}
+
+void ApplicationPartitions::endMove() {
+    remove(movingMarker.c_str());
+}
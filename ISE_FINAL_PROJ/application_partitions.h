@@ -0,0 +1,99 @@
+#ifndef APPLICATION_PARTITIONS_H
+#define APPLICATION_PARTITIONS_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/// <summary>
+/// One month of applications in its own segment file
+/// </summary>
+struct PartitionInfo {
+    string month;           // YYYY-MM of the submission dates, or UNDATED_MONTH
+    size_t records;
+    long long highestId;    // Largest numeric application ID in the segment
+};
+
+/// <summary>
+/// Month partitions of the application store (applications.txt -> applications.txt.parts/)
+/// Records moved out of applications.txt live in one segment file per
+/// submission month (2025-11.seg, ...) next to a manifest listing the
+/// segments, so queries for a date range open only the months in it and a
+/// full scan can read the segments in parallel.
+/// A move in progress is marked by a file in the directory; if the marker is
+/// still there on startup the move is repeated (moves are idempotent).
+/// SE Principles:
+/// - Single Responsibility: segment naming, the manifest and the move marker;
+///   reading and writing records stays in FileManager
+/// - Information Hiding: the directory layout is private to this class
+/// </summary>
+class ApplicationPartitions {
+private:
+    string directory;
+    string manifestFile;
+    string movingMarker;
+    vector<PartitionInfo> partitions;   // Ordered by month
+    long long manifestSize;             // Manifest as last loaded, to notice other writers
+    long long manifestModified;
+
+public:
+    static const string UNDATED_MONTH;  // Segment for records without a valid DD-MM-YYYY date
+
+    /// <summary>
+    /// Names the partition directory for a data file (nothing is read)
+    /// </summary>
+    explicit ApplicationPartitions(const string& dataFile);
+
+    /// <summary>
+    /// YYYY-MM of a DD-MM-YYYY submission date, or UNDATED_MONTH
+    /// </summary>
+    static string monthOf(const string& submissionDate);
+
+    /// <summary>
+    /// YYYYMMDD for a DD-MM-YYYY date, so dates compare as strings
+    /// </summary>
+    /// <returns>False if the date is not DD-MM-YYYY</returns>
+    static bool sortableDate(const string& date, string& sortable);
+
+    /// <summary>
+    /// Re-reads the manifest if it changed since it was last read
+    /// </summary>
+    void refresh();
+
+    const vector<PartitionInfo>& getPartitions() const;
+    const string& getManifestFile() const;
+    string segmentFile(const string& month) const;
+
+    /// <summary>
+    /// Months whose segments can hold submission dates in [fromDate, toDate]
+    /// </summary>
+    vector<string> monthsBetween(const string& fromDate, const string& toDate) const;
+
+    /// <summary>
+    /// Records a segment's new size (adds the month if it is new)
+    /// </summary>
+    void setPartition(const PartitionInfo& partition);
+
+    /// <summary>
+    /// Writes the manifest durably
+    /// </summary>
+    bool saveManifest();
+
+    /// <summary>
+    /// True if a move was interrupted and has to be finished
+    /// </summary>
+    bool isMoving() const;
+
+    /// <summary>
+    /// Creates the directory and the move marker (durably)
+    /// </summary>
+    bool beginMove();
+
+    /// <summary>
+    /// Removes the move marker
+    /// </summary>
+    void endMove();
+};
+
+#endif
@@ -0,0 +1,692 @@
+#include "application_server.h"
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace ServerProtocol {
+    void writeStatusEvent(MessageWriter& writer, const StatusEvent& event) {
+        writer.writeString(event.applicationId);
+        writer.writeString(event.cnic);
+        writer.writeString(event.status);
+        writer.writeString(event.rejectionReason);
+    }
+
+    bool readStatusEvent(MessageReader& reader, StatusEvent& event) {
+        return reader.readString(event.applicationId) &&
+            reader.readString(event.cnic) &&
+            reader.readString(event.status) &&
+            reader.readString(event.rejectionReason);
+    }
+
+    void writeApplication(MessageWriter& writer, const FileManager& codec, const LoanApplication& application) {
+        writer.writeString(codec.formatApplicationRecord(application));
+    }
+
+    void writeApplicationList(MessageWriter& writer, const FileManager& codec, const vector<LoanApplication>& applications) {
+        writer.writeUInt32(static_cast<uint32_t>(applications.size()));
+        for (const auto& application : applications) {
+            writeApplication(writer, codec, application);
+        }
+    }
+
+    bool readApplication(MessageReader& reader, const FileManager& codec, LoanApplication& application) {
+        string record;
+        if (!reader.readString(record)) return false;
+
+        // Not-found results and applications awaiting an ID have an empty ID,
+        // which parseApplicationRecord reports as unusable; the fields still count
+        application = LoanApplication();
+        if (!record.empty()) {
+            codec.parseApplicationRecord(record, application, RecordSchema::current());
+        }
+        return true;
+    }
+
+    bool readApplicationList(MessageReader& reader, const FileManager& codec, vector<LoanApplication>& applications) {
+        uint32_t count = 0;
+        if (!reader.readUInt32(count)) return false;
+
+        // Every record has at least its length prefix, so a count the payload
+        // cannot hold is rejected before anything is reserved for it
+        if (count > reader.remaining() / 4) return false;
+
+        applications.clear();
+        applications.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            LoanApplication application;
+            if (!readApplication(reader, codec, application)) return false;
+            applications.push_back(move(application));
+        }
+        return true;
+    }
+}
+
+ApplicationServer::ApplicationServer(FileManager& applicationStore, const string& serverAddress)
+    : store(applicationStore), address(serverAddress), listener(INVALID_SOCKET_HANDLE),
+    lenderAddress(Network::lenderAddressFor(serverAddress)), lenderListener(INVALID_SOCKET_HANDLE), running(false),
+    consoleWatched(false), consoleClosed(false)
+#ifdef _WIN32
+    , loopActive(false)
+#endif
+{
+#ifndef _WIN32
+    wakePipe[0] = wakePipe[1] = -1;
+#endif
+}
+
+ApplicationServer::~ApplicationServer() {
+    stop();
+}
+
+const string& ApplicationServer::getAddress() const {
+    return address;
+}
+
+const string& ApplicationServer::getLenderAddress() const {
+    return lenderAddress;
+}
+
+size_t ApplicationServer::getConnectionCount() const {
+    return connections.size();
+}
+
+bool ApplicationServer::start() {
+    if (running) return true;
+
+    listener = Network::listenOn(address);
+    if (listener == INVALID_SOCKET_HANDLE) {
+        return false;
+    }
+    addressFileId = Network::socketFileId(address);
+    if (!Network::setNonBlocking(listener) || !loop.add(listener, EventLoop::WATCH_READ)) {
+        cerr << "Error: Could not watch the server socket" << endl;
+        Network::closeSocket(listener);
+        listener = INVALID_SOCKET_HANDLE;
+        Network::removeAddress(address, addressFileId);
+        return false;
+    }
+
+    if (!lenderAddress.empty()) {
+        lenderListener = Network::listenOn(lenderAddress, true);
+        if (lenderListener != INVALID_SOCKET_HANDLE) {
+            lenderAddressFileId = Network::socketFileId(lenderAddress);
+        }
+        if (lenderListener == INVALID_SOCKET_HANDLE || !Network::setNonBlocking(lenderListener) ||
+            !loop.add(lenderListener, EventLoop::WATCH_READ)) {
+            cerr << "Error: Could not open the lender socket " << lenderAddress << endl;
+            if (lenderListener != INVALID_SOCKET_HANDLE) {
+                Network::closeSocket(lenderListener);
+                lenderListener = INVALID_SOCKET_HANDLE;
+                Network::removeAddress(lenderAddress, lenderAddressFileId);
+            }
+            loop.remove(listener);
+            Network::closeSocket(listener);
+            listener = INVALID_SOCKET_HANDLE;
+            Network::removeAddress(address, addressFileId);
+            return false;
+        }
+    }
+    running = true;
+
+#ifdef _WIN32
+    loopActive = true;
+    loopThread = thread([this]() {
+        while (loopActive) {
+            // Held responses are checked every millisecond instead of being woken
+            pollOnce(holding.empty() ? 100 : 1, nullptr);
+        }
+    });
+#else
+    if (pipe(wakePipe) == 0) {
+        for (int end : wakePipe) {
+            fcntl(end, F_SETFL, fcntl(end, F_GETFL) | O_NONBLOCK);
+            fcntl(end, F_SETFD, FD_CLOEXEC);
+        }
+        loop.add(wakePipe[0], EventLoop::WATCH_READ);
+    }
+    else {
+        cerr << "Warning: Could not create the server wake pipe" << endl;
+    }
+
+    // A terminal or pipe can be watched; a regular file (stdin redirected) is always readable
+    consoleWatched = loop.add(STDIN_FILENO, EventLoop::WATCH_READ);
+#endif
+
+    store.setDurabilityListener([this]() { wake(); });
+    return true;
+}
+
+void ApplicationServer::stop() {
+    if (!running) return;
+
+    // Returns once the journal can no longer call wake()
+    store.setDurabilityListener(nullptr);
+
+#ifdef _WIN32
+    loopActive = false;
+    loopThread.join();
+#else
+    if (consoleWatched) {
+        loop.remove(STDIN_FILENO);
+        consoleWatched = false;
+    }
+    if (wakePipe[0] >= 0) {
+        loop.remove(wakePipe[0]);
+        close(wakePipe[0]);
+        close(wakePipe[1]);
+        wakePipe[0] = wakePipe[1] = -1;
+    }
+#endif
+
+    while (!connections.empty()) {
+        closeConnection(connections.begin()->first);
+    }
+    loop.remove(listener);
+    Network::closeSocket(listener);
+    listener = INVALID_SOCKET_HANDLE;
+    Network::removeAddress(address, addressFileId);
+    if (lenderListener != INVALID_SOCKET_HANDLE) {
+        loop.remove(lenderListener);
+        Network::closeSocket(lenderListener);
+        lenderListener = INVALID_SOCKET_HANDLE;
+        Network::removeAddress(lenderAddress, lenderAddressFileId);
+    }
+    running = false;
+}
+
+bool ApplicationServer::waitForConsoleLine(string& line) {
+#ifdef _WIN32
+    return static_cast<bool>(getline(cin, line));
+#else
+    if (!running) {
+        return static_cast<bool>(getline(cin, line));
+    }
+
+    while (true) {
+        size_t newline = consoleInput.find('\n');
+        if (newline != string::npos) {
+            line.assign(consoleInput, 0, newline);
+            consoleInput.erase(0, newline + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            return true;
+        }
+        if (consoleClosed) {
+            line = consoleInput;
+            consoleInput.clear();
+            return !line.empty();
+        }
+
+        if (!consoleWatched) {
+            readConsole();
+            serveFor(0);
+            continue;
+        }
+
+        bool consoleReady = false;
+        pollOnce(-1, &consoleReady);
+        if (consoleReady) {
+            readConsole();
+        }
+    }
+#endif
+}
+
+void ApplicationServer::serveFor(int milliseconds) {
+#ifdef _WIN32
+    this_thread::sleep_for(chrono::milliseconds(milliseconds));
+#else
+    if (!running) return;
+
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(milliseconds);
+    do {
+        auto remaining = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now());
+        pollOnce(remaining.count() > 0 ? static_cast<int>(remaining.count()) : 0, nullptr);
+    } while (chrono::steady_clock::now() < deadline);
+#endif
+}
+
+void ApplicationServer::readConsole() {
+#ifndef _WIN32
+    char buffer[4096];
+    ssize_t count = read(STDIN_FILENO, buffer, sizeof(buffer));
+    if (count > 0) {
+        consoleInput.append(buffer, static_cast<size_t>(count));
+    }
+    else if (count == 0 || (errno != EINTR && errno != EAGAIN)) {
+        consoleClosed = true;
+        if (consoleWatched) {
+            loop.remove(STDIN_FILENO);
+            consoleWatched = false;
+        }
+    }
+#endif
+}
+
+void ApplicationServer::wake() {
+#ifndef _WIN32
+    // A full pipe already has a wakeup pending
+    char signal = 1;
+    if (write(wakePipe[1], &signal, 1) < 0 && errno != EAGAIN) {
+        cerr << "Warning: Could not wake the server loop" << endl;
+    }
+#endif
+}
+
+void ApplicationServer::pollOnce(int timeoutMs, bool* consoleReady) {
+    // Changes made by the lender menu since the last pass
+    releaseDurableResponses();
+    deliverStatusEvents();
+
+    if (!loop.wait(events, timeoutMs)) {
+        cerr << "Error: Waiting for server events failed" << endl;
+        return;
+    }
+
+    for (const auto& event : events) {
+        if (event.handle == listener || event.handle == lenderListener) {
+            acceptClients(event.handle, event.handle == lenderListener);
+            continue;
+        }
+#ifndef _WIN32
+        if (event.handle == STDIN_FILENO && consoleWatched) {
+            if (consoleReady != nullptr) *consoleReady = true;
+            continue;
+        }
+        if (event.handle == wakePipe[0]) {
+            char drain[64];
+            while (read(wakePipe[0], drain, sizeof(drain)) > 0) {
+            }
+            continue;
+        }
+#endif
+
+        // May have been closed while handling an earlier event of this batch
+        auto found = connections.find(event.handle);
+        if (found == connections.end()) continue;
+
+        if (event.readable && !readFromClient(event.handle, found->second)) continue;
+        if (event.writable) flushToClient(event.handle, found->second);
+    }
+
+    // Responses and status changes whose journal records are now durable
+    releaseDurableResponses();
+    deliverStatusEvents();
+}
+
+void ApplicationServer::acceptClients(SocketHandle from, bool lender) {
+    while (true) {
+        SocketHandle client = Network::acceptClient(from);
+        if (client == INVALID_SOCKET_HANDLE) return;   // Backlog drained
+
+        if (!Network::setNonBlocking(client) || !loop.add(client, EventLoop::WATCH_READ)) {
+            Network::closeSocket(client);
+            continue;
+        }
+        connections[client] = Connection();
+        connections[client].lender = lender;
+    }
+}
+
+void ApplicationServer::closeConnection(SocketHandle client) {
+    auto found = connections.find(client);
+    if (found != connections.end()) {
+        for (const auto& key : found->second.subscriptions) {
+            auto entry = subscribers.find(key);
+            if (entry == subscribers.end()) continue;
+            entry->second.erase(client);
+            if (entry->second.empty()) subscribers.erase(entry);
+        }
+    }
+    holding.erase(client);
+
+    loop.remove(client);
+    Network::closeSocket(client);
+    connections.erase(client);
+}
+
+bool ApplicationServer::readFromClient(SocketHandle client, Connection& connection) {
+    char buffer[Config::SERVER_READ_CHUNK];
+
+    // Level-triggered: one read per wakeup keeps a busy client from starving the rest
+    long received = Network::receiveSome(client, buffer, sizeof(buffer));
+    if (received < 0) {
+        closeConnection(client);
+        return false;
+    }
+    connection.input.append(buffer, static_cast<size_t>(received));
+
+    if (!processRequests(client, connection)) {
+        closeConnection(client);
+        return false;
+    }
+    return flushToClient(client, connection);
+}
+
+bool ApplicationServer::processRequests(SocketHandle client, Connection& connection) {
+    size_t offset = 0;
+    MessageType type;
+    string request;
+    MessageWriter response;
+
+    while (connection.output.size() - connection.outputSent + connection.held.size() < Config::SERVER_OUTPUT_HIGH_WATER) {
+        FrameStatus status = Network::parseFrame(connection.input, offset, type, request, Config::SERVER_MAX_REQUEST_BYTES);
+        if (status == FrameStatus::INVALID) return false;
+        if (status == FrameStatus::INCOMPLETE) break;
+
+        response.clear();
+        uint64_t loggedBefore = FileManager::getLastLoggedSequence();
+        bool handled;
+        {
+            FileManager::DurabilityDeferral deferral;
+            handled = handleRequest(client, connection, type, request, response);
+        }
+        uint64_t logged = FileManager::getLastLoggedSequence();
+        if (response.data().size() > Config::SERVER_MAX_RESPONSE_BYTES) {
+            // Clients drop larger frames, so answer with an error they can read
+            response.clear();
+            response.writeString("Response too large");
+            handled = false;
+        }
+
+        // A change is acknowledged once durable; later responses keep their order behind it
+        bool hold = !connection.held.empty();
+        if (logged != loggedBefore && !store.isDurable(logged)) {
+            connection.heldSequence = logged;
+            hold = true;
+        }
+        Network::appendFrame(hold ? connection.held : connection.output,
+            handled ? MessageType::RESPONSE_OK : MessageType::RESPONSE_ERROR, response.data());
+        if (hold) holding.insert(client);
+    }
+
+    connection.input.erase(0, offset);
+    return true;
+}
+
+void ApplicationServer::releaseDurableResponses() {
+    if (holding.empty()) return;
+
+    // Flushing may answer more requests (and hold them again) or close connections
+    vector<SocketHandle> waiting(holding.begin(), holding.end());
+    for (SocketHandle client : waiting) {
+        auto found = connections.find(client);
+        if (found == connections.end()) {
+            holding.erase(client);
+            continue;
+        }
+        Connection& connection = found->second;
+        if (!store.isDurable(connection.heldSequence)) continue;
+
+        connection.output += connection.held;
+        connection.held.clear();
+        holding.erase(client);
+        flushToClient(client, connection);
+    }
+}
+
+bool ApplicationServer::flushToClient(SocketHandle client, Connection& connection) {
+    while (connection.outputSent < connection.output.size()) {
+        long sent = Network::sendSome(client, connection.output.data() + connection.outputSent,
+            connection.output.size() - connection.outputSent);
+        if (sent < 0) {
+            closeConnection(client);
+            return false;
+        }
+        if (sent == 0) break;
+        connection.outputSent += static_cast<size_t>(sent);
+    }
+
+    bool drained = (connection.outputSent == connection.output.size());
+    if (drained) {
+        connection.output.clear();
+        connection.outputSent = 0;
+
+        // Requests held back while output was over the high-water mark
+        if (!connection.input.empty()) {
+            if (!processRequests(client, connection)) {
+                closeConnection(client);
+                return false;
+            }
+            if (!connection.output.empty()) {
+                return flushToClient(client, connection);
+            }
+        }
+    }
+
+    // Stop reading from a client that is not taking its responses
+    size_t pending = connection.output.size() - connection.outputSent;
+    uint8_t interest = 0;
+    if (pending < Config::SERVER_OUTPUT_HIGH_WATER) interest |= EventLoop::WATCH_READ;
+    if (pending > 0) interest |= EventLoop::WATCH_WRITE;
+    loop.modify(client, interest);
+    return true;
+}
+
+string ApplicationServer::subscriptionKey(SubscriptionKind kind, const string& key) {
+    return (kind == SubscriptionKind::CNIC ? "C:" : "I:") + key;
+}
+
+bool ApplicationServer::subscribe(SocketHandle client, SubscriptionKind kind, const string& key) {
+    auto found = connections.find(client);
+    if (found == connections.end() || key.empty()) return false;
+
+    string subscription = subscriptionKey(kind, key);
+    if (subscribers[subscription].insert(client).second) {
+        found->second.subscriptions.push_back(subscription);
+    }
+    return true;
+}
+
+void ApplicationServer::unsubscribe(SocketHandle client, SubscriptionKind kind, const string& key) {
+    string subscription = subscriptionKey(kind, key);
+
+    auto entry = subscribers.find(subscription);
+    if (entry != subscribers.end()) {
+        entry->second.erase(client);
+        if (entry->second.empty()) subscribers.erase(entry);
+    }
+
+    auto found = connections.find(client);
+    if (found != connections.end()) {
+        vector<string>& keys = found->second.subscriptions;
+        keys.erase(std::remove(keys.begin(), keys.end(), subscription), keys.end());
+    }
+}
+
+void ApplicationServer::publishStatusChange(const LoanApplication& application) {
+    ServerProtocol::StatusEvent event;
+    event.applicationId = application.getApplicationId();
+    event.cnic = application.getCnicNumber();
+    event.status = application.getStatus();
+    event.rejectionReason = application.getRejectionReason();
+
+    // Called on the thread that made the change, right after it was journaled
+    uint64_t sequence = FileManager::getLastLoggedSequence();
+
+    lock_guard<mutex> lock(publishMutex);
+    publishedEvents.push_back(make_pair(sequence, move(event)));
+}
+
+void ApplicationServer::deliverStatusEvents() {
+    vector<ServerProtocol::StatusEvent> pending;
+    {
+        // Users hear about a decision only once it cannot be lost
+        lock_guard<mutex> lock(publishMutex);
+        size_t ready = 0;
+        while (ready < publishedEvents.size() && store.isDurable(publishedEvents[ready].first)) {
+            pending.push_back(move(publishedEvents[ready].second));
+            ready++;
+        }
+        publishedEvents.erase(publishedEvents.begin(), publishedEvents.begin() + ready);
+    }
+    if (pending.empty() || subscribers.empty()) return;
+
+    unordered_set<SocketHandle> notified;
+    unordered_set<SocketHandle> recipients;
+    MessageWriter payload;
+
+    for (const auto& event : pending) {
+        // A client watching both the ID and the CNIC still gets one event
+        recipients.clear();
+        auto byId = subscribers.find(subscriptionKey(SubscriptionKind::APPLICATION_ID, event.applicationId));
+        if (byId != subscribers.end()) recipients.insert(byId->second.begin(), byId->second.end());
+        auto byCnic = subscribers.find(subscriptionKey(SubscriptionKind::CNIC, event.cnic));
+        if (byCnic != subscribers.end()) recipients.insert(byCnic->second.begin(), byCnic->second.end());
+        if (recipients.empty()) continue;
+
+        payload.clear();
+        ServerProtocol::writeStatusEvent(payload, event);
+        for (SocketHandle client : recipients) {
+            Network::appendFrame(connections[client].output, MessageType::STATUS_EVENT, payload.data());
+            notified.insert(client);
+        }
+    }
+
+    // Flushing may close connections, so look each one up again
+    for (SocketHandle client : notified) {
+        auto found = connections.find(client);
+        if (found != connections.end()) {
+            flushToClient(client, found->second);
+        }
+    }
+}
+
+bool ApplicationServer::handleRequest(SocketHandle client, Connection& connection, MessageType type,
+    const string& request, MessageWriter& response) {
+    MessageReader reader(request);
+    LoanApplication application;
+    string first;
+    string second;
+    string third;
+    uint8_t kind = 0;
+
+    // A user connection works only on applications it created or proved it knows
+    auto owns = [&connection](const string& applicationId) {
+        return connection.lender || connection.ownedIds.count(applicationId) != 0;
+    };
+    auto deny = [&response]() {
+        response.writeString("Not permitted on a user connection");
+        return false;
+    };
+    // Users upload document content; only the lender may name files for the server to copy
+    auto namesFiles = [this, &connection](const LoanApplication& record) {
+        return !connection.lender &&
+            (store.needsDocumentCopy(record.getCnicFrontImagePath()) ||
+            store.needsDocumentCopy(record.getCnicBackImagePath()) ||
+            store.needsDocumentCopy(record.getElectricityBillImagePath()) ||
+            store.needsDocumentCopy(record.getSalarySlipImagePath()));
+    };
+
+    switch (type) {
+    case MessageType::GENERATE_ID:
+        first = store.generateApplicationId();
+        connection.ownedIds.insert(first);
+        response.writeString(first);
+        return true;
+
+    case MessageType::SAVE_APPLICATION:
+        // A record whose fields would not be stored as sent is malformed
+        if (!reader.readString(first) || !store.parseSubmittedRecord(first, application)) break;
+        if (!application.getApplicationId().empty() && !owns(application.getApplicationId())) return deny();
+        if (namesFiles(application)) return deny();
+        response.writeUInt8(store.saveApplication(application) ? 1 : 0);
+        if (!application.getApplicationId().empty()) {
+            connection.ownedIds.insert(application.getApplicationId());
+        }
+        ServerProtocol::writeApplication(response, store, application);
+        return true;
+
+    case MessageType::UPDATE_SECTION:
+        if (!reader.readString(first) || !store.parseSubmittedRecord(first, application) ||
+            !reader.readString(second)) break;
+        if (!owns(application.getApplicationId()) || namesFiles(application)) return deny();
+        response.writeUInt8(store.updateApplicationSection(application, second) ? 1 : 0);
+        return true;
+
+    case MessageType::UPLOAD_DOCUMENT:
+        if (!reader.readString(first) || !reader.readString(second) || !reader.readString(third)) break;
+        if (!owns(first)) return deny();
+        if (second != "cnic_front" && second != "cnic_back" && second != "electricity_bill" && second != "salary_slip") {
+            response.writeString("Unknown document type: " + second);
+            return false;
+        }
+        if (third.size() > Config::DOCUMENT_UPLOAD_MAX_BYTES) {
+            response.writeString("Document too large");
+            return false;
+        }
+        {
+            string storedPath;
+            string message;
+            if (!store.storeUploadedDocument(first, second, third, storedPath, message)) {
+                response.writeString(message);
+                return false;
+            }
+            response.writeString(storedPath);
+        }
+        return true;
+
+    case MessageType::UPDATE_STATUS:
+        if (!connection.lender) return deny();
+        if (!reader.readString(first) || !reader.readString(second) || !reader.readString(third)) break;
+        response.writeUInt8(store.updateApplicationStatus(first, second, third) ? 1 : 0);
+        return true;
+
+    case MessageType::FIND_BY_ID:
+        if (!reader.readString(first)) break;
+        // Someone else's application reads as not found
+        ServerProtocol::writeApplication(response, store, owns(first) ? store.findApplicationById(first) : application);
+        return true;
+
+    case MessageType::FIND_BY_CNIC:
+        if (!reader.readString(first)) break;
+        ServerProtocol::writeApplicationList(response, store, store.findApplicationsByCNIC(first));
+        return true;
+
+    case MessageType::FIND_INCOMPLETE:
+        if (!reader.readString(first) || !reader.readString(second)) break;
+        application = store.findIncompleteApplication(first, second);
+        if (!application.getApplicationId().empty()) {
+            connection.ownedIds.insert(application.getApplicationId());   // Resumed with its CNIC
+        }
+        ServerProtocol::writeApplication(response, store, application);
+        return true;
+
+    case MessageType::FIND_USER_INCOMPLETE:
+        if (!reader.readString(first)) break;
+        ServerProtocol::writeApplicationList(response, store, store.findUserIncompleteApplications(first));
+        return true;
+
+    case MessageType::LOAD_ALL:
+        if (!connection.lender) return deny();
+        ServerProtocol::writeApplicationList(response, store, store.loadAllApplications());
+        return true;
+
+    case MessageType::SUBSCRIBE:
+        if (!reader.readUInt8(kind) || kind > static_cast<uint8_t>(SubscriptionKind::CNIC) ||
+            !reader.readString(first)) break;
+        if (kind == static_cast<uint8_t>(SubscriptionKind::APPLICATION_ID) && !owns(first)) return deny();
+        if (!subscribe(client, static_cast<SubscriptionKind>(kind), first)) break;
+        return true;
+
+    case MessageType::UNSUBSCRIBE:
+        if (!reader.readUInt8(kind) || !reader.readString(first)) break;
+        unsubscribe(client, static_cast<SubscriptionKind>(kind), first);
+        return true;
+
+    default:
+        response.writeString("Unknown request type " + to_string(static_cast<int>(type)));
+        return false;
+    }
+
+    response.clear();
+    response.writeString("Malformed request");
+    return false;
+}
@@ -0,0 +1,238 @@
+#ifndef APPLICATION_SERVER_H
+#define APPLICATION_SERVER_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+#include <unordered_map>
+#include "file_manager.h"
+#include "network_utils.h"
+#include "event_loop.h"
+#include "utilities.h"
+
+using namespace std;
+
+/// <summary>
+/// Payload encoding shared by ApplicationServer and RemoteFileManager
+/// An application travels as its applications.txt record (length-prefixed),
+/// a list as a uint32 count followed by the records.
+/// </summary>
+namespace ServerProtocol {
+    /// <summary>
+    /// A status change pushed to subscribed clients (STATUS_EVENT payload)
+    /// </summary>
+    struct StatusEvent {
+        string applicationId;
+        string cnic;
+        string status;
+        string rejectionReason;
+    };
+
+    void writeStatusEvent(MessageWriter& writer, const StatusEvent& event);
+    bool readStatusEvent(MessageReader& reader, StatusEvent& event);
+
+    void writeApplication(MessageWriter& writer, const FileManager& codec, const LoanApplication& application);
+    void writeApplicationList(MessageWriter& writer, const FileManager& codec, const vector<LoanApplication>& applications);
+
+    /// <returns>False if the payload is truncated</returns>
+    bool readApplication(MessageReader& reader, const FileManager& codec, LoanApplication& application);
+    bool readApplicationList(MessageReader& reader, const FileManager& codec, vector<LoanApplication>& applications);
+}
+
+/// <summary>
+/// Local server that owns the application store and answers user clients
+/// A single-threaded reactor: the listener, every client connection and the
+/// lender's console are watched by one EventLoop. Sockets are non-blocking,
+/// each connection has its own receive/send buffers, and every complete
+/// request already received is answered in order (clients may pipeline).
+/// The lender menu reads its input through waitForConsoleLine, so clients are
+/// served whenever the menu is waiting for the lender to type.
+/// Clients may SUBSCRIBE to an application ID or CNIC; every status change
+/// reported through publishStatusChange is then pushed to them as a
+/// STATUS_EVENT frame instead of the client re-querying the store.
+/// Connections on the server address are user clients: they may not decide
+/// applications (UPDATE_STATUS) or download the store (LOAD_ALL), and they
+/// reach an application by ID only once it is theirs - generated on that
+/// connection, or found with its matching CNIC. Their documents arrive as
+/// UPLOAD_DOCUMENT content; a record naming a file to copy is refused, since
+/// the server would read it with its own rights. Lender tools connect to the
+/// lender socket next to it (Network::lenderAddressFor), which only the
+/// server's own user can open, and may do everything.
+/// Store changes are journaled with durability deferred: the response to a
+/// change (and every later response on that connection) is held until the
+/// journal reports the change durable, so requests from many clients are
+/// acknowledged after one shared fsync instead of one each. The journal's
+/// commit thread wakes the loop through a pipe when responses can go out.
+/// On Windows the console cannot be polled; the loop then runs on a
+/// background thread and the store's own locking keeps the two apart.
+/// SE Principles:
+/// - Single Responsibility: protocol dispatch only, storage stays in FileManager
+/// - Dependency Injection: the store is passed in (CachedFileManager when serving)
+/// </summary>
+class ApplicationServer {
+private:
+    struct Connection {
+        string input;               // Received bytes not yet handled
+        string output;              // Encoded responses not yet sent
+        size_t outputSent;          // Bytes of output already sent
+        vector<string> subscriptions;   // Keys into subscribers, removed on close
+        string held;                // Responses waiting for a journaled change to be durable
+        uint64_t heldSequence;      // Journal sequence the held responses wait for
+        bool lender;                // Accepted on the lender socket
+        unordered_set<string> ownedIds;     // Applications a user connection may read and change
+
+        Connection() : outputSent(0), heldSequence(0), lender(false) {}
+    };
+
+    FileManager& store;
+    string address;
+    SocketHandle listener;
+    string lenderAddress;           // Empty when there is no lender socket
+    SocketHandle lenderListener;
+    string addressFileId;           // Socket files this server created (Network::socketFileId)
+    string lenderAddressFileId;
+    EventLoop loop;
+    unordered_map<SocketHandle, Connection> connections;
+    vector<EventLoop::Event> events;
+    bool running;
+
+    // Subscription key ("I:" + application ID or "C:" + CNIC) -> subscribed clients
+    unordered_map<string, unordered_set<SocketHandle>> subscribers;
+
+    // Status changes waiting to be pushed (with the journal sequence that
+    // must be durable first); filled from any thread
+    mutex publishMutex;
+    vector<pair<uint64_t, ServerProtocol::StatusEvent>> publishedEvents;
+
+    unordered_set<SocketHandle> holding;    // Connections with held responses
+
+    string consoleInput;            // Console bytes read but not yet returned as lines
+    bool consoleWatched;            // False when stdin cannot be polled (always readable)
+    bool consoleClosed;
+
+#ifdef _WIN32
+    thread loopThread;
+    atomic<bool> loopActive;
+#else
+    int wakePipe[2];                // Written by the journal's commit thread
+#endif
+
+    /// <summary>
+    /// Wakes the loop from another thread (more journaled changes are durable)
+    /// </summary>
+    void wake();
+
+    /// <summary>
+    /// Sends the held responses whose journaled change is now durable
+    /// </summary>
+    void releaseDurableResponses();
+
+    /// <summary>
+    /// Waits for readiness once and handles everything that is ready
+    /// </summary>
+    /// <param name="consoleReady">Output (optional): stdin has data</param>
+    void pollOnce(int timeoutMs, bool* consoleReady);
+
+    /// <summary>
+    /// Accepts every waiting client of one listener
+    /// </summary>
+    /// <param name="lender">The listener is the lender socket</param>
+    void acceptClients(SocketHandle from, bool lender);
+    void closeConnection(SocketHandle client);
+
+    static string subscriptionKey(SubscriptionKind kind, const string& key);
+    bool subscribe(SocketHandle client, SubscriptionKind kind, const string& key);
+    void unsubscribe(SocketHandle client, SubscriptionKind kind, const string& key);
+
+    /// <summary>
+    /// Queues published status changes on every subscribed connection and flushes them
+    /// </summary>
+    void deliverStatusEvents();
+
+    /// <summary>
+    /// Reads what is available, answers every complete request, then flushes
+    /// </summary>
+    /// <returns>False if the connection was closed</returns>
+    bool readFromClient(SocketHandle client, Connection& connection);
+
+    /// <summary>
+    /// Answers complete requests until the buffer runs dry or too much output is queued
+    /// </summary>
+    /// <returns>False if the client sent an invalid frame</returns>
+    bool processRequests(SocketHandle client, Connection& connection);
+
+    /// <summary>
+    /// Sends queued output and adjusts write interest
+    /// </summary>
+    /// <returns>False if the connection was closed</returns>
+    bool flushToClient(SocketHandle client, Connection& connection);
+
+    /// <summary>
+    /// Reads available console bytes into consoleInput
+    /// </summary>
+    void readConsole();
+
+    /// <summary>
+    /// Runs one request against the store
+    /// </summary>
+    /// <param name="client">Connection the request came from (for subscriptions)</param>
+    /// <param name="response">Output: response payload (error message on failure)</param>
+    /// <returns>False if the request was malformed, unknown or not permitted</returns>
+    bool handleRequest(SocketHandle client, Connection& connection, MessageType type,
+        const string& request, MessageWriter& response);
+
+public:
+    /// <summary>
+    /// Creates a server over a store (not started)
+    /// </summary>
+    /// <param name="applicationStore">Store answering the requests</param>
+    /// <param name="serverAddress">Socket path or "tcp:PORT"</param>
+    ApplicationServer(FileManager& applicationStore, const string& serverAddress = Config::SERVER_ADDRESS);
+
+    /// <summary>
+    /// Stops the server if it is still running
+    /// </summary>
+    ~ApplicationServer();
+
+    ApplicationServer(const ApplicationServer&) = delete;
+    ApplicationServer& operator=(const ApplicationServer&) = delete;
+
+    /// <summary>
+    /// Starts listening on the server address and the lender socket
+    /// (clients are served from waitForConsoleLine / serveFor)
+    /// </summary>
+    /// <returns>False if either address could not be bound</returns>
+    bool start();
+
+    /// <summary>
+    /// Disconnects all clients and removes the socket files
+    /// </summary>
+    void stop();
+
+    /// <summary>
+    /// Serves clients until the lender enters a line on stdin
+    /// </summary>
+    /// <param name="line">Output: the line without its newline</param>
+    /// <returns>False once stdin is closed and no input is left</returns>
+    bool waitForConsoleLine(string& line);
+
+    /// <summary>
+    /// Serves clients for a while without reading the console
+    /// </summary>
+    void serveFor(int milliseconds);
+
+    /// <summary>
+    /// Reports a status change to subscribers of its application ID or CNIC
+    /// Safe to call from any thread; the event is pushed on the next loop pass.
+    /// </summary>
+    void publishStatusChange(const LoanApplication& application);
+
+    const string& getAddress() const;
+    const string& getLenderAddress() const;
+    size_t getConnectionCount() const;
+};
+
+#endif
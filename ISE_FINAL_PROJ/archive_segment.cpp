@@ -0,0 +1,303 @@
+#include "archive_segment.h"
+#include "block_codec.h"
+#include "bloom_filter.h"
+#include "checksum.h"
+#include "write_ahead_log.h"
+#include "utilities.h"
+#include <algorithm>
+#include <fstream>
+#include <sys/stat.h>
+
+using namespace std;
+
+namespace {
+    const char SEGMENT_MAGIC[4] = { 'L', 'S', 'E', 'G' };
+    const uint32_t SEGMENT_VERSION = 1;
+    const size_t TRAILER_BYTES = 16;        // footer offset, footer CRC, magic
+    const size_t BLOCK_ENTRY_BYTES = 24;
+
+    void appendUInt16(string& out, uint16_t value) {
+        for (int i = 0; i < 2; i++) out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    void appendUInt32(string& out, uint32_t value) {
+        for (int i = 0; i < 4; i++) out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    void appendUInt64(string& out, uint64_t value) {
+        for (int i = 0; i < 8; i++) out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    uint64_t getUInt(const char* in, int bytes) {
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) value |= static_cast<uint64_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+        return value;
+    }
+
+    /// <summary>
+    /// Reads little-endian fields from the footer without running past its end
+    /// </summary>
+    class FooterReader {
+    private:
+        const string& data;
+        size_t position;
+        bool failed;
+
+    public:
+        explicit FooterReader(const string& footer) : data(footer), position(0), failed(false) {}
+
+        uint64_t read(int bytes) {
+            if (failed || data.size() - position < static_cast<size_t>(bytes)) {
+                failed = true;
+                return 0;
+            }
+            uint64_t value = getUInt(data.data() + position, bytes);
+            position += bytes;
+            return value;
+        }
+
+        string readBytes(size_t length) {
+            if (failed || data.size() - position < length) {
+                failed = true;
+                return string();
+            }
+            string value = data.substr(position, length);
+            position += length;
+            return value;
+        }
+
+        bool ok() const { return !failed; }
+    };
+
+    /// <summary>
+    /// Bloom filter entry: IDs and CNICs share one filter, so the key type is part of it
+    /// </summary>
+    string filterKey(IndexKey key, const string& value) {
+        return static_cast<char>('0' + static_cast<int>(key)) + value;
+    }
+}
+
+ArchiveSegment::ArchiveSegment(const string& file)
+    : path(file), rawBytes(0), loaded(false), loadedSize(-1), loadedModified(-1), loadedInode(0) {
+}
+
+bool ArchiveSegment::write(const string& file, const vector<string>& lines, const KeyReader& keyOf) {
+    struct KeyedLine {
+        string key;
+        uint32_t block;
+        uint32_t record;
+    };
+
+    string contents;
+    string blockTable;
+    vector<KeyedLine> keyed[2];
+    BloomFilter keyFilter(lines.size() * 2, Config::BLOOM_FALSE_POSITIVE_RATE);
+    uint64_t textBytes = 0;
+    uint32_t blockCount = 0;
+
+    for (size_t first = 0; first < lines.size(); first += Config::ARCHIVE_BLOCK_RECORDS) {
+        size_t last = min(lines.size(), first + Config::ARCHIVE_BLOCK_RECORDS);
+        string text;
+        for (size_t i = first; i < last; i++) {
+            text += lines[i];
+            text += '\n';
+            for (int key = 0; key < 2; key++) {
+                IndexKey indexKey = static_cast<IndexKey>(key);
+                string value = keyOf(lines[i], indexKey);
+                keyFilter.add(filterKey(indexKey, value));
+                keyed[key].push_back({ move(value), blockCount, static_cast<uint32_t>(i - first) });
+            }
+        }
+
+        string stored = compressBlock(text);
+        appendUInt64(blockTable, contents.size());
+        appendUInt32(blockTable, static_cast<uint32_t>(stored.size()));
+        appendUInt32(blockTable, static_cast<uint32_t>(text.size()));
+        appendUInt32(blockTable, static_cast<uint32_t>(last - first));
+        appendUInt32(blockTable, crc32(stored));
+        contents += stored;
+        textBytes += text.size();
+        blockCount++;
+    }
+
+    uint64_t footerOffset = contents.size();
+    string footer(SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+    appendUInt32(footer, SEGMENT_VERSION);
+    appendUInt32(footer, blockCount);
+    appendUInt64(footer, textBytes);
+    footer += blockTable;
+
+    for (int key = 0; key < 2; key++) {
+        stable_sort(keyed[key].begin(), keyed[key].end(), [](const KeyedLine& a, const KeyedLine& b) {
+            return a.key < b.key;
+        });
+        appendUInt32(footer, static_cast<uint32_t>(keyed[key].size()));
+        for (const auto& entry : keyed[key]) {
+            size_t length = min<size_t>(entry.key.size(), 0xFFFF);
+            appendUInt16(footer, static_cast<uint16_t>(length));
+            footer.append(entry.key, 0, length);
+            appendUInt32(footer, entry.block);
+            appendUInt32(footer, entry.record);
+        }
+    }
+
+    string serializedFilter = keyFilter.serialize();
+    appendUInt32(footer, static_cast<uint32_t>(serializedFilter.size()));
+    footer += serializedFilter;
+
+    contents += footer;
+    appendUInt64(contents, footerOffset);
+    appendUInt32(contents, crc32(footer));
+    contents.append(SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+
+    return replaceFileContents(file, contents, true);
+}
+
+bool ArchiveSegment::load(bool& exists) {
+    struct stat info;
+    exists = stat(path.c_str(), &info) == 0;
+    if (!exists) {
+        loaded = false;
+        loadedSize = -1;
+        blocks.clear();
+        keys[0].clear();
+        keys[1].clear();
+        filter.clear();
+        rawBytes = 0;
+        return true;
+    }
+
+    // Segments are replaced, never edited, so a new inode, size or time means a new file
+    long long size = static_cast<long long>(info.st_size);
+    long long modified = static_cast<long long>(info.st_mtime);
+    uint64_t inode = static_cast<uint64_t>(info.st_ino);
+    if (loadedSize == size && loadedModified == modified && loadedInode == inode) return loaded;
+
+    loaded = false;
+    loadedSize = size;
+    loadedModified = modified;
+    loadedInode = inode;
+
+    ifstream file(path, ios::binary);
+    if (!file.is_open() || size < static_cast<long long>(TRAILER_BYTES)) return false;
+
+    char trailer[TRAILER_BYTES];
+    file.seekg(size - static_cast<long long>(TRAILER_BYTES));
+    if (!file.read(trailer, TRAILER_BYTES) || !equal(SEGMENT_MAGIC, SEGMENT_MAGIC + 4, trailer + 12)) return false;
+
+    uint64_t footerOffset = getUInt(trailer, 8);
+    uint64_t footerEnd = static_cast<uint64_t>(size) - TRAILER_BYTES;
+    if (footerOffset > footerEnd) return false;
+
+    string footer(static_cast<size_t>(footerEnd - footerOffset), '\0');
+    file.seekg(static_cast<streamoff>(footerOffset));
+    if (!file.read(&footer[0], footer.size()) || crc32(footer) != static_cast<uint32_t>(getUInt(trailer + 8, 4))) {
+        return false;
+    }
+
+    FooterReader reader(footer);
+    if (reader.readBytes(4) != string(SEGMENT_MAGIC, 4) || reader.read(4) != SEGMENT_VERSION) return false;
+
+    vector<Block> readBlocks(static_cast<size_t>(reader.read(4)));
+    uint64_t readRawBytes = reader.read(8);
+    for (auto& block : readBlocks) {
+        block.offset = reader.read(8);
+        block.storedBytes = static_cast<uint32_t>(reader.read(4));
+        block.rawBytes = static_cast<uint32_t>(reader.read(4));
+        block.records = static_cast<uint32_t>(reader.read(4));
+        block.crc = static_cast<uint32_t>(reader.read(4));
+        if (block.offset + block.storedBytes > footerOffset) return false;
+    }
+
+    vector<KeyEntry> readKeys[2];
+    for (int key = 0; key < 2; key++) {
+        size_t count = static_cast<size_t>(reader.read(4));
+        for (size_t i = 0; i < count && reader.ok(); i++) {
+            KeyEntry entry;
+            entry.key = reader.readBytes(static_cast<size_t>(reader.read(2)));
+            entry.block = static_cast<uint32_t>(reader.read(4));
+            entry.record = static_cast<uint32_t>(reader.read(4));
+            if (entry.block >= readBlocks.size()) return false;
+            readKeys[key].push_back(move(entry));
+        }
+    }
+    string readFilter = reader.readBytes(static_cast<size_t>(reader.read(4)));
+    if (!reader.ok()) return false;
+
+    blocks.swap(readBlocks);
+    keys[0].swap(readKeys[0]);
+    keys[1].swap(readKeys[1]);
+    filter.swap(readFilter);
+    rawBytes = readRawBytes;
+    loaded = true;
+    return true;
+}
+
+bool ArchiveSegment::readBlock(ifstream& file, const Block& block, vector<string>& lines) const {
+    string stored(block.storedBytes, '\0');
+    file.clear();
+    file.seekg(static_cast<streamoff>(block.offset));
+    if (!file.read(&stored[0], stored.size()) || crc32(stored) != block.crc) return false;
+
+    string text;
+    if (!decompressBlock(stored.data(), stored.size(), block.rawBytes, text)) return false;
+
+    size_t position = 0;
+    size_t newline;
+    while ((newline = text.find('\n', position)) != string::npos) {
+        lines.push_back(text.substr(position, newline - position));
+        position = newline + 1;
+    }
+    return true;
+}
+
+bool ArchiveSegment::readAll(vector<string>& lines) {
+    bool exists = false;
+    if (!load(exists)) return false;
+    if (!exists) return true;
+
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) return false;
+    for (const auto& block : blocks) {
+        if (!readBlock(file, block, lines)) return false;
+    }
+    return true;
+}
+
+bool ArchiveSegment::find(IndexKey key, const string& value, vector<string>& lines) {
+    bool exists = false;
+    if (!load(exists)) return false;
+    if (!exists || !BloomFilter::mightContain(filter.data(), filter.size(), filterKey(key, value))) return true;
+
+    const vector<KeyEntry>& table = keys[static_cast<int>(key)];
+    auto first = lower_bound(table.begin(), table.end(), value, [](const KeyEntry& entry, const string& wanted) {
+        return entry.key < wanted;
+    });
+
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) return false;
+
+    // Entries with the same key are in stored order, so each block is read once
+    uint32_t openBlock = UINT32_MAX;
+    vector<string> blockLines;
+    for (auto entry = first; entry != table.end() && entry->key == value; ++entry) {
+        if (entry->block != openBlock) {
+            blockLines.clear();
+            if (!readBlock(file, blocks[entry->block], blockLines)) return false;
+            openBlock = entry->block;
+        }
+        if (entry->record >= blockLines.size()) return false;
+        lines.push_back(blockLines[entry->record]);
+    }
+    return true;
+}
+
+uint64_t ArchiveSegment::getStoredBytes() {
+    bool exists = false;
+    return load(exists) && exists ? static_cast<uint64_t>(loadedSize) : 0;
+}
+
+uint64_t ArchiveSegment::getRawBytes() {
+    bool exists = false;
+    return load(exists) && exists ? rawBytes : 0;
+}
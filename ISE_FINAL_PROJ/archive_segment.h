@@ -0,0 +1,107 @@
+#ifndef ARCHIVE_SEGMENT_H
+#define ARCHIVE_SEGMENT_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include "record_index.h"
+
+using namespace std;
+
+/// <summary>
+/// Compressed segment file of archived (decided) applications
+/// Records are stored in blocks of Config::ARCHIVE_BLOCK_RECORDS lines, each
+/// compressed on its own with compressBlock, followed by a footer holding
+/// the block table, a sorted table mapping every application ID and CNIC to
+/// its block and position, and a Bloom filter over both keys. A lookup reads
+/// the footer once, then decompresses only the one block holding the record;
+/// a scan reads a fraction of the bytes the text would take.
+/// Segments are written whole (they change only when records are archived
+/// or an archived record is updated) and checksummed per block and footer.
+/// SE Principles:
+/// - Single Responsibility: storage layout of one segment; which records go
+///   where stays in FileManager
+/// - Information Hiding: block and footer layout are private to archive_segment.cpp
+/// </summary>
+class ArchiveSegment {
+public:
+    typedef function<string(const string& line, IndexKey key)> KeyReader;
+
+private:
+    struct Block {
+        uint64_t offset;
+        uint32_t storedBytes;
+        uint32_t rawBytes;
+        uint32_t records;
+        uint32_t crc;
+    };
+
+    struct KeyEntry {
+        string key;
+        uint32_t block;
+        uint32_t record;        // Line within the block
+    };
+
+    string path;
+    vector<Block> blocks;
+    vector<KeyEntry> keys[2];   // Per IndexKey, sorted by key
+    string filter;              // Serialized BloomFilter
+    uint64_t rawBytes;
+
+    // File as last loaded; reloaded when another process rewrites it
+    bool loaded;
+    long long loadedSize;
+    long long loadedModified;
+    uint64_t loadedInode;
+
+    /// <summary>
+    /// Reads the footer if the file changed since it was last read
+    /// </summary>
+    /// <param name="exists">Output: false if there is no segment file</param>
+    /// <returns>False if the file exists but is not a valid segment</returns>
+    bool load(bool& exists);
+
+    /// <summary>
+    /// Reads, verifies and decompresses one block into its record lines
+    /// </summary>
+    bool readBlock(ifstream& file, const Block& block, vector<string>& lines) const;
+
+public:
+    /// <summary>
+    /// Names the segment file (nothing is read until it is used)
+    /// </summary>
+    explicit ArchiveSegment(const string& file);
+
+    /// <summary>
+    /// Writes a segment holding these record lines, synced before it replaces the old one
+    /// </summary>
+    /// <param name="keyOf">Reads a record line's application ID or CNIC</param>
+    /// <returns>False if the file could not be written</returns>
+    static bool write(const string& file, const vector<string>& lines, const KeyReader& keyOf);
+
+    /// <summary>
+    /// Every record line in the segment, in stored order
+    /// </summary>
+    /// <returns>False if the segment is damaged (a missing segment is empty)</returns>
+    bool readAll(vector<string>& lines);
+
+    /// <summary>
+    /// Appends the record lines stored under an application ID or CNIC
+    /// Only the blocks holding them are read.
+    /// </summary>
+    /// <returns>False if the segment is damaged</returns>
+    bool find(IndexKey key, const string& value, vector<string>& lines);
+
+    /// <summary>
+    /// Compressed size of the records (0 if the segment is missing or damaged)
+    /// </summary>
+    uint64_t getStoredBytes();
+
+    /// <summary>
+    /// Size the records take as text
+    /// </summary>
+    uint64_t getRawBytes();
+};
+
+#endif
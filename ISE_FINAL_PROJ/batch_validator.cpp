@@ -0,0 +1,333 @@
+#include "batch_validator.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+using namespace std;
+
+namespace {
+    // Rules reported by the batch job; each wraps one LoanApplication validator
+    enum RuleId {
+        RULE_COMPLETE_APPLICATION,
+        RULE_EMPLOYMENT_FINANCIAL,
+        RULE_LOAN_TYPE_LIMITS,
+        RULE_INCOME_TO_LOAN,
+        RULE_COUNT
+    };
+
+    const char* const RULE_NAMES[RULE_COUNT] = {
+        "Complete application",
+        "Employment and financial info",
+        "Loan type limits",
+        "Income to loan ratio"
+    };
+
+    /// <summary>
+    /// Maps the stored loan type to the spelling the validators expect
+    /// </summary>
+    const string& canonicalLoanType(LoanKind kind) {
+        static const string NAMES[] = { "", "home", "car", "scooter", "personal", "" };
+        return NAMES[static_cast<int>(kind)];
+    }
+
+    struct FindingTally {
+        ValidationEntry entry;          // First occurrence, used to render the message
+        size_t count;
+        vector<string> sampleIds;
+
+        FindingTally() : count(0) {}
+    };
+
+    struct RuleTally {
+        size_t applicationsFlagged;
+        unordered_map<uint64_t, FindingTally> coded;    // Keyed by the packed entry
+        unordered_map<string, FindingTally> custom;     // Free-text findings, keyed by severity + text
+
+        RuleTally() : applicationsFlagged(0) {}
+    };
+
+    // Codes stay below 0x8000, so the code and severity share the top 16 bits
+    uint64_t packEntry(const ValidationEntry& entry) {
+        return (static_cast<uint64_t>(entry.code) << 49) |
+            (static_cast<uint64_t>(entry.isWarning) << 48) |
+            (static_cast<uint64_t>(entry.index) << 32) |
+            static_cast<uint32_t>(entry.value);
+    }
+
+    /// <summary>
+    /// Per-worker state: tallies plus reusable scratch objects, so workers
+    /// never share anything until the final merge
+    /// </summary>
+    struct ValidationArena {
+        RuleTally rules[RULE_COUNT];
+        ValidationResult scratch;
+        LoanApplication application;
+        size_t validated;
+        size_t skipped;
+        size_t unreadable;
+
+        ValidationArena() : validated(0), skipped(0), unreadable(0) {}
+
+        void tally(FindingTally& finding, const ValidationEntry& entry, const string& applicationId) {
+            if (finding.count == 0) finding.entry = entry;
+            finding.count++;
+            if (finding.sampleIds.size() < Config::BATCH_REPORT_SAMPLE_IDS) {
+                finding.sampleIds.push_back(applicationId);
+            }
+        }
+
+        void record(RuleId rule, const string& applicationId, const ValidationResult& result) {
+            if (result.getEntryCount() == 0) return;
+
+            RuleTally& ruleTally = rules[rule];
+            ruleTally.applicationsFlagged++;
+            for (size_t i = 0; i < result.getEntryCount(); i++) {
+                const ValidationEntry& entry = result.getEntry(i);
+                if (entry.code == static_cast<uint16_t>(ValidationCode::CUSTOM_MESSAGE)) {
+                    // Free text only lives in the result, so these are keyed by the text itself
+                    tally(ruleTally.custom[(entry.isWarning ? "W" : "E") + result.getMessage(entry)],
+                        entry, applicationId);
+                }
+                else {
+                    tally(ruleTally.coded[packEntry(entry)], entry, applicationId);
+                }
+            }
+        }
+
+        void validate(const LoanApplication& app) {
+            const string& id = app.getApplicationId();
+
+            record(RULE_COMPLETE_APPLICATION, id, app.validateCompleteApplication());
+            record(RULE_EMPLOYMENT_FINANCIAL, id, app.validateEmploymentAndFinancialInfo());
+            record(RULE_LOAN_TYPE_LIMITS, id,
+                app.validateForLoanType(canonicalLoanType(app.getLoanKind()), app.getLoanAmount()));
+
+            scratch.clear();
+            app.validateIncomeToLoanRatio(app.getLoanAmount(), scratch);
+            record(RULE_INCOME_TO_LOAN, id, scratch);
+        }
+    };
+
+    /// <summary>
+    /// Bounded hand-off between the file reader and the workers
+    /// </summary>
+    class RecordBatchQueue {
+    private:
+        mutex queueMutex;
+        condition_variable batchAvailable;
+        condition_variable spaceAvailable;
+        deque<vector<string>> batches;
+        size_t capacity;
+        bool closed;
+
+    public:
+        explicit RecordBatchQueue(size_t maxBatches) : capacity(maxBatches), closed(false) {}
+
+        /// <returns>False (the batch is dropped) once the queue is closed</returns>
+        bool push(vector<string>&& batch) {
+            unique_lock<mutex> lock(queueMutex);
+            spaceAvailable.wait(lock, [this]() { return closed || batches.size() < capacity; });
+            if (closed) return false;
+            batches.push_back(move(batch));
+            lock.unlock();
+            batchAvailable.notify_one();
+            return true;
+        }
+
+        bool pop(vector<string>& batch) {
+            unique_lock<mutex> lock(queueMutex);
+            batchAvailable.wait(lock, [this]() { return closed || !batches.empty(); });
+            if (batches.empty()) return false;
+
+            batch = move(batches.front());
+            batches.pop_front();
+            lock.unlock();
+            spaceAvailable.notify_one();
+            return true;
+        }
+
+        /// <summary>
+        /// Ends the hand-off: workers drain what is queued, a blocked reader is released
+        /// </summary>
+        void close() {
+            {
+                lock_guard<mutex> lock(queueMutex);
+                closed = true;
+            }
+            batchAvailable.notify_all();
+            spaceAvailable.notify_all();
+        }
+    };
+
+    /// <summary>
+    /// Closes the queue when the reading scope is left, by return or exception
+    /// </summary>
+    struct QueueCloser {
+        RecordBatchQueue& queue;
+        ~QueueCloser() { queue.close(); }
+    };
+
+    void mergeFinding(const string& message, const FindingTally& source,
+        unordered_map<string, RuleFinding>& merged) {
+        RuleFinding& finding = merged[(source.entry.isWarning ? "W" : "E") + message];
+        if (finding.count == 0) {
+            finding.message = message;
+            finding.isWarning = source.entry.isWarning;
+        }
+        finding.count += source.count;
+        for (const auto& id : source.sampleIds) {
+            if (finding.sampleIds.size() >= Config::BATCH_REPORT_SAMPLE_IDS) break;
+            finding.sampleIds.push_back(id);
+        }
+    }
+
+    /// <summary>
+    /// Renders each distinct finding once and folds it into the per-rule summary
+    /// </summary>
+    void mergeFindings(const RuleTally& source, unordered_map<string, RuleFinding>& merged) {
+        for (const auto& entry : source.coded) {
+            mergeFinding(ValidationResult::getCodedMessage(entry.second.entry), entry.second, merged);
+        }
+        for (const auto& entry : source.custom) {
+            mergeFinding(entry.first.substr(1), entry.second, merged);
+        }
+    }
+}
+
+BatchValidator::BatchValidator(const FileManager& manager, int threads, size_t recordsPerBatch)
+    : fileManager(manager), threadCount(threads), batchSize(recordsPerBatch) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(thread::hardware_concurrency());
+    }
+    if (threadCount <= 0) threadCount = 1;
+    if (batchSize == 0) batchSize = Config::BATCH_VALIDATION_CHUNK;
+}
+
+BatchValidationReport BatchValidator::run() const {
+    BatchValidationReport report;
+    report.threadsUsed = threadCount;
+    auto started = chrono::steady_clock::now();
+
+    vector<ValidationArena> arenas(threadCount);
+    RecordBatchQueue queue(static_cast<size_t>(threadCount) * 2);
+    {
+        ThreadPool pool(threadCount);
+        vector<future<void>> workers;
+        const FileManager& store = fileManager;
+
+        for (int i = 0; i < threadCount; i++) {
+            ValidationArena* arena = &arenas[i];
+            workers.push_back(pool.submit([&queue, &store, arena]() {
+                try {
+                    vector<string> batch;
+                    while (queue.pop(batch)) {
+                        for (const auto& line : batch) {
+                            if (!store.parseApplicationRecord(line, arena->application)) {
+                                arena->unreadable++;
+                                continue;
+                            }
+                            // Partially filled applications would only repeat "required" errors
+                            if (isIncompleteStatus(arena->application.getStatusCode())) {
+                                arena->skipped++;
+                                continue;
+                            }
+                            arena->validate(arena->application);
+                            arena->validated++;
+                        }
+                    }
+                }
+                catch (...) {
+                    // The reader would block on a full queue nobody empties
+                    queue.close();
+                    throw;
+                }
+            }));
+        }
+
+        {
+            QueueCloser closer = { queue };
+            fileManager.forEachRecordBatch(batchSize, [&](vector<string>&& batch) {
+                size_t records = batch.size();
+                if (queue.push(move(batch))) report.recordsRead += records;
+            });
+        }
+
+        for (auto& worker : workers) {
+            worker.get();
+        }
+    }
+
+    // Merge the per-worker tallies into one summary per rule
+    for (int rule = 0; rule < RULE_COUNT; rule++) {
+        RuleSummary summary;
+        summary.ruleName = RULE_NAMES[rule];
+
+        unordered_map<string, RuleFinding> findings;
+        for (const auto& arena : arenas) {
+            summary.applicationsFlagged += arena.rules[rule].applicationsFlagged;
+            mergeFindings(arena.rules[rule], findings);
+        }
+
+        for (auto& entry : findings) summary.findings.push_back(move(entry.second));
+        sort(summary.findings.begin(), summary.findings.end(),
+            [](const RuleFinding& a, const RuleFinding& b) {
+                if (a.isWarning != b.isWarning) return !a.isWarning;
+                if (a.count != b.count) return a.count > b.count;
+                return a.message < b.message;
+            });
+
+        report.rules.push_back(move(summary));
+    }
+
+    for (const auto& arena : arenas) {
+        report.recordsValidated += arena.validated;
+        report.recordsSkipped += arena.skipped;
+        report.unreadableRecords += arena.unreadable;
+    }
+
+    report.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    return report;
+}
+
+string BatchValidationReport::getReport() const {
+    stringstream ss;
+    ss << "========== BATCH VALIDATION ==========" << endl;
+    ss << "Records read: " << recordsRead
+        << " | Validated: " << recordsValidated
+        << " | Skipped (incomplete): " << recordsSkipped
+        << " | Unreadable: " << unreadableRecords << endl;
+    ss << "Completed in " << fixed << setprecision(2) << elapsedSeconds
+        << "s using " << threadsUsed << " thread(s)" << endl;
+
+    for (const auto& rule : rules) {
+        ss << endl << "[" << rule.ruleName << "] ";
+        if (rule.applicationsFlagged == 0) {
+            ss << "all applications pass" << endl;
+            continue;
+        }
+        ss << rule.applicationsFlagged << " application(s) flagged" << endl;
+
+        for (const auto& finding : rule.findings) {
+            ss << "  " << (finding.isWarning ? "[WARNING] " : "[ERROR]   ")
+                << setw(7) << finding.count << "  " << finding.message;
+            if (!finding.sampleIds.empty()) {
+                ss << " (e.g. ";
+                for (size_t i = 0; i < finding.sampleIds.size(); i++) {
+                    if (i > 0) ss << ", ";
+                    ss << finding.sampleIds[i];
+                }
+                ss << ")";
+            }
+            ss << endl;
+        }
+    }
+    ss << "======================================" << endl;
+    return ss.str();
+}
@@ -0,0 +1,87 @@
+#ifndef BATCH_VALIDATOR_H
+#define BATCH_VALIDATOR_H
+
+#include <string>
+#include <vector>
+#include "application.h"
+#include "file_manager.h"
+#include "utilities.h"
+using namespace std;
+
+/// <summary>
+/// One distinct message produced by a rule across the store
+/// </summary>
+struct RuleFinding {
+    string message;
+    bool isWarning;
+    size_t count;
+    vector<string> sampleIds;   // First few applications that raised it
+
+    RuleFinding() : isWarning(false), count(0) {}
+};
+
+/// <summary>
+/// Everything one validator reported during a batch run
+/// </summary>
+struct RuleSummary {
+    string ruleName;
+    size_t applicationsFlagged;
+    vector<RuleFinding> findings;   // Most frequent first
+
+    RuleSummary() : applicationsFlagged(0) {}
+};
+
+/// <summary>
+/// Result of re-running the validators over the stored applications
+/// </summary>
+struct BatchValidationReport {
+    size_t recordsRead;
+    size_t recordsValidated;
+    size_t recordsSkipped;      // Incomplete applications (C1-C3, incomplete_*)
+    size_t unreadableRecords;
+    int threadsUsed;
+    double elapsedSeconds;
+    vector<RuleSummary> rules;
+
+    BatchValidationReport() : recordsRead(0), recordsValidated(0), recordsSkipped(0),
+        unreadableRecords(0), threadsUsed(0), elapsedSeconds(0) {}
+
+    /// <summary>
+    /// Generates the lender-facing report grouped by rule
+    /// </summary>
+    string getReport() const;
+};
+
+/// <summary>
+/// Re-runs the LoanApplication validators over every stored application
+/// Records are streamed from FileManager in batches and parsed/validated on a
+/// thread pool; each worker keeps its own tallies which are merged at the end.
+/// SE Principles:
+/// - Single Responsibility: only schedules validation and aggregates results
+/// - Open/Closed: the validators themselves stay on LoanApplication
+/// </summary>
+class BatchValidator {
+private:
+    const FileManager& fileManager;
+    int threadCount;
+    size_t batchSize;
+
+public:
+    /// <summary>
+    /// Creates a batch validator over a FileManager's store
+    /// </summary>
+    /// <param name="manager">Store to read applications from</param>
+    /// <param name="threads">Worker threads (0 = one per hardware thread)</param>
+    /// <param name="recordsPerBatch">Records handed to a worker at a time</param>
+    BatchValidator(const FileManager& manager,
+        int threads = Config::BATCH_VALIDATION_THREADS,
+        size_t recordsPerBatch = Config::BATCH_VALIDATION_CHUNK);
+
+    /// <summary>
+    /// Validates all submitted, approved and rejected applications
+    /// </summary>
+    /// <returns>Counts and findings grouped by rule</returns>
+    BatchValidationReport run() const;
+};
+
+#endif
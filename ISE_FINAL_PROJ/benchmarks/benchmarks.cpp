@@ -0,0 +1,534 @@
+#include <benchmark/benchmark.h>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "data_generator.h"
+#include "file_manager.h"
+#include "cached_file_manager.h"
+#include "home.h"
+#include "car.h"
+#include "scooter.h"
+#include "personal.h"
+#include "Utterances.h"
+#include "utilities.h"
+
+using namespace std;
+
+/// <summary>
+/// Store and catalog benchmarks over generated data sets
+/// Usage: benchmarks [--sizes=10k,100k,1M,10M] [--data-dir=DIR] [--seed=S] [benchmark flags]
+/// Data sets are generated into DIR/<size> on first use and reused while
+/// their dataset.txt stamp matches. Use --benchmark_format=json or
+/// --benchmark_out=results.json to record results for comparison.
+/// </summary>
+
+namespace {
+    struct BenchmarkData {
+        string label;
+        string directory;
+        long long records;
+        string middleId;            // Found halfway through the file
+        string middleCnic;
+        string middleDate;          // Submission date of that record (DD-MM-YYYY)
+    };
+
+    uint64_t dataSeed = 2025;
+
+    // Heap allocations made by the whole process (counted by operator new below)
+    atomic<uint64_t> allocationCount(0);
+
+    /// <summary>
+    /// Swallows everything written to it; keeps no state, so threads may share it
+    /// </summary>
+    class DiscardBuffer : public streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+        streamsize xsputn(const char*, streamsize count) override { return count; }
+    };
+
+    /// <summary>
+    /// Discards the store's progress messages while a benchmark runs
+    /// </summary>
+    class QuietOutput {
+    private:
+        DiscardBuffer sink;
+        streambuf* savedOut;
+        streambuf* savedErr;
+
+    public:
+        QuietOutput() : savedOut(cout.rdbuf(&sink)), savedErr(cerr.rdbuf(&sink)) {}
+        ~QuietOutput() {
+            cout.rdbuf(savedOut);
+            cerr.rdbuf(savedErr);
+        }
+    };
+
+    string applicationsFile(const BenchmarkData& data) {
+        return data.directory + "/applications.txt";
+    }
+
+    bool copyFile(const string& from, const string& to) {
+        ifstream source(from, ios::binary);
+        ofstream target(to, ios::binary | ios::trunc);
+        target << source.rdbuf();
+        return static_cast<bool>(target);
+    }
+
+    bool prepareData(BenchmarkData& data, const string& dataDirectory) {
+        data.directory = dataDirectory + "/" + data.label;
+
+        DataSetSize size;
+        size.applications = data.records;
+        DataGenerator generator(dataSeed);
+        if (!generator.hasDataSet(data.directory, size)) {
+            cout << "Generating " << data.records << " applications in " << data.directory << "..." << endl;
+            if (!generator.writeDataSet(data.directory, size)) return false;
+        }
+
+        // Lookup keys from the middle record, so scans cover half the file
+        ifstream file(applicationsFile(data));
+        string line;
+        for (long long i = 0; i <= data.records / 2 && getline(file, line); i++) {
+        }
+        vector<string> parts = splitString(line, Config::DELIMITER);
+        if (parts.size() < 10) return false;
+        data.middleId = parts[0];
+        data.middleCnic = parts[9];
+        data.middleDate = parts[2];
+        return true;
+    }
+
+    // ---------------------------------------------------------------- store
+
+    void loadAllApplications(benchmark::State& state, const BenchmarkData& data) {
+        FileManager store(applicationsFile(data));
+        QuietOutput quiet;
+        for (auto _ : state) {
+            vector<LoanApplication> applications = store.loadAllApplications();
+            benchmark::DoNotOptimize(applications.data());
+        }
+        state.SetItemsProcessed(state.iterations() * data.records);
+    }
+
+    void findApplicationById(benchmark::State& state, const BenchmarkData& data) {
+        FileManager store(applicationsFile(data));
+        QuietOutput quiet;
+        for (auto _ : state) {
+            LoanApplication application = store.findApplicationById(data.middleId);
+            benchmark::DoNotOptimize(application);
+        }
+    }
+
+    void findApplicationsByCNIC(benchmark::State& state, const BenchmarkData& data) {
+        FileManager store(applicationsFile(data));
+        QuietOutput quiet;
+        for (auto _ : state) {
+            vector<LoanApplication> applications = store.findApplicationsByCNIC(data.middleCnic);
+            benchmark::DoNotOptimize(applications.data());
+        }
+    }
+
+    // A new store per lookup, as in a freshly started client: the record index
+    // (built before timing starts) is mapped again each time, never rebuilt
+    void coldFindApplicationsByCNIC(benchmark::State& state, const BenchmarkData& data) {
+        QuietOutput quiet;
+        FileManager(applicationsFile(data)).findApplicationsByCNIC(data.middleCnic);
+        for (auto _ : state) {
+            FileManager store(applicationsFile(data));
+            vector<LoanApplication> applications = store.findApplicationsByCNIC(data.middleCnic);
+            benchmark::DoNotOptimize(applications.data());
+        }
+    }
+
+    void removeWorkFile(const string& workFile) {
+        remove(workFile.c_str());
+        remove((workFile + ".wal").c_str());
+        remove((workFile + ".checkpoint").c_str());
+        remove((workFile + ".idx").c_str());
+
+        // Month partitions, if the copy was partitioned
+        const string partitionDirectory = workFile + ".parts/";
+        ifstream manifest(partitionDirectory + "manifest.txt");
+        string line;
+        while (getline(manifest, line)) {
+            string segment = partitionDirectory + splitString(line, Config::DELIMITER)[0] + ".seg";
+            remove(segment.c_str());
+        }
+        manifest.close();
+        remove((partitionDirectory + "manifest.txt").c_str());
+        remove((partitionDirectory + "moving").c_str());
+        remove(partitionDirectory.c_str());
+    }
+
+    // A copy of the data set whose decided applications were archived into
+    // month segments before timing starts; segments are parsed on the
+    // partition pool, so these report real time
+    string partitionedCopy(const BenchmarkData& data) {
+        string workFile = data.directory + "/applications_partitioned.txt";
+        removeWorkFile(workFile);
+        copyFile(applicationsFile(data), workFile);
+        FileManager(workFile).archiveDecidedApplications();
+        return workFile;
+    }
+
+    void partitionedLoadAllApplications(benchmark::State& state, const BenchmarkData& data) {
+        QuietOutput quiet;
+        string workFile = partitionedCopy(data);
+        {
+            FileManager store(workFile);
+            for (auto _ : state) {
+                vector<LoanApplication> applications = store.loadAllApplications();
+                benchmark::DoNotOptimize(applications.data());
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * data.records);
+        removeWorkFile(workFile);
+    }
+
+    // The lender's pending queue: only applications.txt, now without the decided records
+    void pendingApplications(benchmark::State& state, const BenchmarkData& data) {
+        QuietOutput quiet;
+        string workFile = partitionedCopy(data);
+        {
+            FileManager store(workFile);
+            for (auto _ : state) {
+                vector<LoanApplication> applications = store.loadPendingApplications();
+                benchmark::DoNotOptimize(applications.data());
+            }
+        }
+        removeWorkFile(workFile);
+    }
+
+    // One month of submissions: only that month's segment is read
+    void partitionedLoadOneMonth(benchmark::State& state, const BenchmarkData& data) {
+        QuietOutput quiet;
+        string workFile = partitionedCopy(data);
+        string monthStart = "01" + data.middleDate.substr(2);
+        string monthEnd = "31" + data.middleDate.substr(2);
+        {
+            FileManager store(workFile);
+            for (auto _ : state) {
+                vector<LoanApplication> applications = store.loadApplicationsSubmittedBetween(monthStart, monthEnd);
+                benchmark::DoNotOptimize(applications.data());
+            }
+        }
+        removeWorkFile(workFile);
+    }
+
+    void updateApplicationStatus(benchmark::State& state, const BenchmarkData& data) {
+        // Works on a copy so the data set stays as generated. Each approval
+        // moves the record to its archive segment and each reset moves it back
+        string workFile = data.directory + "/applications_update.txt";
+        copyFile(applicationsFile(data), workFile);
+        {
+            FileManager store(workFile);
+            QuietOutput quiet;
+            bool approve = true;
+            for (auto _ : state) {
+                bool updated = store.updateApplicationStatus(data.middleId, approve ? "approved" : "submitted");
+                benchmark::DoNotOptimize(updated);
+                approve = !approve;
+            }
+        }
+        removeWorkFile(workFile);
+    }
+
+    // Concurrent writers on the server store share journal syncs (group commit)
+    CachedFileManager* sharedStore = nullptr;
+
+    void cachedUpdateApplicationStatus(benchmark::State& state, const BenchmarkData& data) {
+        string workFile = data.directory + "/applications_update.txt";
+        unique_ptr<QuietOutput> quiet;
+        if (state.thread_index() == 0) {
+            quiet.reset(new QuietOutput());
+            copyFile(applicationsFile(data), workFile);
+            sharedStore = new CachedFileManager(workFile);
+        }
+        // Threads start their timed loops together, after thread 0's setup
+        bool approve = (state.thread_index() % 2) == 0;
+        for (auto _ : state) {
+            bool updated = sharedStore->updateApplicationStatus(data.middleId, approve ? "approved" : "submitted");
+            benchmark::DoNotOptimize(updated);
+            approve = !approve;
+        }
+        if (state.thread_index() == 0) {
+            delete sharedStore;
+            sharedStore = nullptr;
+            removeWorkFile(workFile);
+        }
+    }
+
+    void generateApplicationId(benchmark::State& state, const BenchmarkData& data) {
+        FileManager store(applicationsFile(data));
+        QuietOutput quiet;
+        for (auto _ : state) {
+            string applicationId = store.generateApplicationId();
+            benchmark::DoNotOptimize(applicationId);
+        }
+    }
+
+    // The in-memory store used by lender_server --serve, for comparison
+    void cachedFindApplicationById(benchmark::State& state, const BenchmarkData& data) {
+        QuietOutput quiet;
+        CachedFileManager store(applicationsFile(data));
+        for (auto _ : state) {
+            LoanApplication application = store.findApplicationById(data.middleId);
+            benchmark::DoNotOptimize(application);
+        }
+    }
+
+    void cachedFindApplicationsByCNIC(benchmark::State& state, const BenchmarkData& data) {
+        QuietOutput quiet;
+        CachedFileManager store(applicationsFile(data));
+        for (auto _ : state) {
+            vector<LoanApplication> applications = store.findApplicationsByCNIC(data.middleCnic);
+            benchmark::DoNotOptimize(applications.data());
+        }
+    }
+
+    // ------------------------------------------------------------ allocations
+    // Each reports heap allocations per record as a counter; only the call
+    // being measured is counted, not copies or frees around it
+
+    void saveApplicationAllocations(benchmark::State& state, const BenchmarkData& data) {
+        QuietOutput quiet;
+        LoanApplication sample = FileManager(applicationsFile(data)).findApplicationById(data.middleId);
+        // Documents are not copied: this measures formatting and writing the record
+        sample.setCnicFrontImagePath("");
+        sample.setCnicBackImagePath("");
+        sample.setElectricityBillImagePath("");
+        sample.setSalarySlipImagePath("");
+
+        string workFile = data.directory + "/applications_save.txt";
+        removeWorkFile(workFile);
+        uint64_t allocations = 0;
+        {
+            FileManager store(workFile);
+            for (auto _ : state) {
+                LoanApplication application = sample;
+                uint64_t before = allocationCount.load(memory_order_relaxed);
+                bool saved = store.saveApplication(application);
+                allocations += allocationCount.load(memory_order_relaxed) - before;
+                benchmark::DoNotOptimize(saved);
+            }
+        }
+        removeWorkFile(workFile);
+        state.counters["allocs_per_record"] = static_cast<double>(allocations) / state.iterations();
+    }
+
+    void loadAllApplicationsAllocations(benchmark::State& state, const BenchmarkData& data) {
+        FileManager store(applicationsFile(data));
+        QuietOutput quiet;
+        uint64_t allocations = 0;
+        for (auto _ : state) {
+            uint64_t before = allocationCount.load(memory_order_relaxed);
+            vector<LoanApplication> applications = store.loadAllApplications();
+            allocations += allocationCount.load(memory_order_relaxed) - before;
+            benchmark::DoNotOptimize(applications.data());
+        }
+        state.counters["allocs_per_record"] = static_cast<double>(allocations) / (state.iterations() * data.records);
+    }
+
+    // What a lender list view reads from each record
+    void getterSweepAllocations(benchmark::State& state, const BenchmarkData& data) {
+        QuietOutput quiet;
+        vector<LoanApplication> applications = FileManager(applicationsFile(data)).loadAllApplications();
+        uint64_t allocations = 0;
+        for (auto _ : state) {
+            uint64_t before = allocationCount.load(memory_order_relaxed);
+            size_t characters = 0;
+            for (const auto& application : applications) {
+                characters += application.getApplicationId().size() + application.getFullName().size() +
+                    application.getCnicNumber().size() + application.getStatus().size() +
+                    application.getLoanType().size() + application.getExistingLoans().size() +
+                    application.getReference1().name.size() + application.getReference2().name.size();
+            }
+            allocations += allocationCount.load(memory_order_relaxed) - before;
+            benchmark::DoNotOptimize(characters);
+        }
+        state.counters["allocs_per_record"] =
+            static_cast<double>(allocations) / (state.iterations() * max<size_t>(applications.size(), 1));
+    }
+
+    // ------------------------------------------------------ catalogs and chat
+
+    template <typename Row>
+    void loadCatalog(benchmark::State& state, int (*loader)(Row[], int, const string&), const string& filename) {
+        vector<Row> rows(Config::MAX_LOANS);
+        QuietOutput quiet;
+        int count = 0;
+        for (auto _ : state) {
+            count = loader(rows.data(), Config::MAX_LOANS, filename);
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    void loadConversationCorpusFile(benchmark::State& state, const string& filename) {
+        size_t pairs = 0;
+        for (auto _ : state) {
+            vector<ConversationPair> corpus = loadConversationCorpus(filename);
+            pairs = corpus.size();
+            benchmark::DoNotOptimize(corpus.data());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<long long>(pairs));
+    }
+
+    void responseByIoU(benchmark::State& state, const string& filename) {
+        vector<ConversationPair> corpus = loadConversationCorpus(filename);
+        const string questions[] = {
+            "What is your favorite holiday?",
+            "Tell me about your car loan",
+            "how was your weekend with family",
+            "I want to talk about cricket and the weather"
+        };
+        size_t next = 0;
+        for (auto _ : state) {
+            string response = getResponseByIoU(corpus, questions[next++ % 4]);
+            benchmark::DoNotOptimize(response);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<long long>(corpus.size()));
+    }
+
+    void registerStoreBenchmarks(const BenchmarkData& data) {
+        const string suffix = "/" + data.label;
+        benchmark::RegisterBenchmark(("loadAllApplications" + suffix).c_str(), loadAllApplications, data)
+            ->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("loadAllApplications/partitioned" + suffix).c_str(), partitionedLoadAllApplications, data)
+            ->Unit(benchmark::kMillisecond)->UseRealTime();
+        benchmark::RegisterBenchmark(("loadPendingApplications" + suffix).c_str(), pendingApplications, data)
+            ->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("loadApplicationsSubmittedBetween/oneMonth" + suffix).c_str(), partitionedLoadOneMonth, data)
+            ->Unit(benchmark::kMillisecond)->UseRealTime();
+        benchmark::RegisterBenchmark(("findApplicationById" + suffix).c_str(), findApplicationById, data)
+            ->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("findApplicationsByCNIC" + suffix).c_str(), findApplicationsByCNIC, data)
+            ->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("findApplicationsByCNIC/newStore" + suffix).c_str(), coldFindApplicationsByCNIC, data)
+            ->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("updateApplicationStatus" + suffix).c_str(), updateApplicationStatus, data)
+            ->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("generateApplicationId" + suffix).c_str(), generateApplicationId, data)
+            ->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("CachedFileManager/findApplicationById" + suffix).c_str(), cachedFindApplicationById, data)
+            ->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("CachedFileManager/findApplicationsByCNIC" + suffix).c_str(), cachedFindApplicationsByCNIC, data)
+            ->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("CachedFileManager/updateApplicationStatus" + suffix).c_str(), cachedUpdateApplicationStatus, data)
+            ->Unit(benchmark::kMillisecond)->Threads(1)->Threads(4)->UseRealTime();
+        benchmark::RegisterBenchmark(("allocations/saveApplication" + suffix).c_str(), saveApplicationAllocations, data)
+            ->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("allocations/loadAllApplications" + suffix).c_str(), loadAllApplicationsAllocations, data)
+            ->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("allocations/getterSweep" + suffix).c_str(), getterSweepAllocations, data)
+            ->Unit(benchmark::kMicrosecond);
+    }
+
+    void registerCatalogBenchmarks(const BenchmarkData& data) {
+        const string prefix = data.directory + "/";
+        benchmark::RegisterBenchmark("loadHomeLoans", [prefix](benchmark::State& state) {
+            loadCatalog(state, loadHomeLoans, prefix + Config::HOME_LOANS_FILE);
+        });
+        benchmark::RegisterBenchmark("loadCarLoans", [prefix](benchmark::State& state) {
+            loadCatalog(state, loadCarLoans, prefix + Config::CAR_LOANS_FILE);
+        });
+        benchmark::RegisterBenchmark("loadScooterLoans", [prefix](benchmark::State& state) {
+            loadCatalog(state, loadScooterLoans, prefix + Config::SCOOTER_LOANS_FILE);
+        });
+        benchmark::RegisterBenchmark("loadPersonalLoans", [prefix](benchmark::State& state) {
+            loadCatalog(state, loadPersonalLoans, prefix + Config::PERSONAL_LOANS_FILE);
+        });
+        benchmark::RegisterBenchmark("loadUtterances", [prefix](benchmark::State& state) {
+            loadCatalog(state, loadUtterances, prefix + Config::UTTERANCES_FILE);
+        });
+        benchmark::RegisterBenchmark("loadConversationCorpus", loadConversationCorpusFile, prefix + Config::CHAT_CORPUS_FILE)
+            ->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("getResponseByIoU", responseByIoU, prefix + Config::CHAT_CORPUS_FILE)
+            ->Unit(benchmark::kMicrosecond);
+    }
+}
+
+// Counts every allocation for the allocations/ benchmarks; new[] and
+// delete[] forward to these
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"    // free() of this operator new's malloc()
+#endif
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* memory = malloc(size != 0 ? size : 1)) return memory;
+    throw bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+int main(int argc, char** argv) {
+    string sizes = "10k,100k";
+    string dataDirectory = "bench_data";
+
+    // Our own flags are removed before Google Benchmark parses the rest
+    vector<char*> remaining;
+    for (int i = 0; i < argc; i++) {
+        string argument = argv[i];
+        long long value = 0;
+        if (argument.compare(0, 8, "--sizes=") == 0) {
+            sizes = argument.substr(8);
+        }
+        else if (argument.compare(0, 11, "--data-dir=") == 0) {
+            dataDirectory = argument.substr(11);
+        }
+        else if (argument.compare(0, 7, "--seed=") == 0 && tryParseNumber(argument.substr(7), value)) {
+            dataSeed = static_cast<uint64_t>(value);
+        }
+        else {
+            remaining.push_back(argv[i]);
+        }
+    }
+    int remainingCount = static_cast<int>(remaining.size());
+
+    benchmark::Initialize(&remainingCount, remaining.data());
+    if (benchmark::ReportUnrecognizedArguments(remainingCount, remaining.data())) {
+        return 1;
+    }
+
+    bool catalogsRegistered = false;
+    for (const auto& label : splitString(sizes, ',')) {
+        BenchmarkData data;
+        data.label = label;
+        if (!parseRecordCount(label, data.records)) {
+            cerr << "Error: Invalid size '" << label << "'" << endl;
+            return 1;
+        }
+        if (!prepareData(data, dataDirectory)) {
+            cerr << "Error: Could not prepare data set " << label << endl;
+            return 1;
+        }
+
+        registerStoreBenchmarks(data);
+        if (!catalogsRegistered) {
+            // Catalogs are the same size in every set
+            registerCatalogBenchmarks(data);
+            catalogsRegistered = true;
+        }
+    }
+
+    benchmark::AddCustomContext("data_seed", to_string(dataSeed));
+    benchmark::AddCustomContext("data_sizes", sizes);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,422 @@
+#include "data_generator.h"
+#include "utilities.h"
+#include "record_schema.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <cerrno>
+#include <cstdio>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+using namespace std;
+
+namespace {
+    const char* FIRST_NAMES[] = {
+        "Ayesha", "Fatima", "Areeba", "Rabia", "Sana", "Hina", "Zainab", "Maryam",
+        "Ali", "Ahmed", "Usman", "Bilal", "Hamza", "Omar", "Saad", "Hassan"
+    };
+    const char* FAMILY_NAMES[] = {
+        "Khan", "Iqbal", "Kamran", "Tanweer", "Malik", "Sheikh", "Qureshi", "Butt",
+        "Chaudhry", "Siddiqui", "Raza", "Javed"
+    };
+    const char* STREETS[] = {
+        "Model Town", "Faisal Town", "Johar Town", "Gulberg", "DHA Phase 5",
+        "Bahria Town", "Garden Town", "Township", "Wapda Town", "Iqbal Town"
+    };
+    const char* CITIES[] = { "Lahore", "Karachi", "Islamabad", "Faisalabad", "Multan", "Peshawar" };
+    const char* BANKS[] = { "HBL", "UBL", "MCB", "Meezan", "Allied", "Bank Alfalah" };
+    const char* EMPLOYMENT[] = { "Salaried", "Salaried", "Self-employed", "Retired", "Unemployed" };
+    const char* MARITAL[] = { "Single", "Married", "Married", "Divorced", "Widowed" };
+    const char* GENDERS[] = { "Male", "Female", "Female", "Other" };
+    const char* REJECTIONS[] = {
+        "Income too low for requested amount",
+        "Debt-to-income ratio above policy limit",
+        "Incomplete documentation",
+        "CNIC expired"
+    };
+    const char* DOCUMENT_TYPES[] = { "cnic_front", "cnic_back", "electricity_bill", "salary_slip" };
+
+    // Status mix of a live store, with the sections each status implies
+    struct StatusShare {
+        const char* status;
+        const char* sections;
+        int weight;
+    };
+    const StatusShare STATUS_MIX[] = {
+        { "submitted", "personal,financial,references,documents", 40 },
+        { "approved", "personal,financial,references,documents", 20 },
+        { "rejected", "personal,financial,references,documents", 10 },
+        { "C1", "", 8 },
+        { "C2", "personal", 8 },
+        { "C3", "personal,financial", 7 },
+        { "incomplete_documents", "personal,financial,references", 7 }
+    };
+
+    template <typename T, size_t N>
+    int countOf(const T(&)[N]) {
+        return static_cast<int>(N);
+    }
+
+    bool makeDirectory(const string& path) {
+#ifdef _WIN32
+        return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+        return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+    }
+
+    /// <summary>
+    /// Creates a directory and any missing parents
+    /// </summary>
+    bool makeDirectories(const string& path) {
+        for (size_t slash = path.find('/', 1); slash != string::npos; slash = path.find('/', slash + 1)) {
+            makeDirectory(path.substr(0, slash));
+        }
+        return makeDirectory(path);
+    }
+
+    const string DATA_SET_STAMP = "dataset.txt";
+
+    string describeDataSet(const DataSetSize& size, uint64_t seed) {
+        stringstream ss;
+        ss << "applications=" << size.applications << " catalog_rows=" << size.catalogRows
+            << " corpus_pairs=" << size.corpusPairs << " seed=" << seed
+            << " format=" << RecordSchema::CURRENT_VERSION;
+        return ss.str();
+    }
+
+    bool openForWriting(ofstream& file, const string& filename) {
+        file.open(filename, ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            cerr << "Error: Could not open " << filename << " for writing" << endl;
+            return false;
+        }
+        return true;
+    }
+}
+
+bool parseRecordCount(const string& text, long long& count) {
+    if (text.empty()) return false;
+
+    long long multiplier = 1;
+    string digits = text;
+    char suffix = static_cast<char>(tolower(static_cast<unsigned char>(digits.back())));
+    if (suffix == 'k') multiplier = 1000;
+    else if (suffix == 'm') multiplier = 1000000;
+    if (multiplier != 1) digits.pop_back();
+
+    long long value = 0;
+    if (!tryParseNumber(digits, value) || value <= 0) return false;
+    count = value * multiplier;
+    return true;
+}
+
+DataGenerator::DataGenerator(uint64_t seed) : random(seed), seed(seed) {
+}
+
+int DataGenerator::pick(int count) {
+    return static_cast<int>(random() % static_cast<uint64_t>(count));
+}
+
+long long DataGenerator::between(long long low, long long high) {
+    return low + static_cast<long long>(random() % static_cast<uint64_t>(high - low + 1));
+}
+
+string DataGenerator::makeCnic(long long person) const {
+    // 13 digits, unique per person
+    stringstream ss;
+    ss << (35201LL * 100000000LL + person);
+    return ss.str();
+}
+
+string DataGenerator::makePhone() {
+    stringstream ss;
+    ss << "03" << setw(9) << setfill('0') << between(0, 999999999);
+    return ss.str();
+}
+
+string DataGenerator::makeDate(int firstYear, int lastYear) {
+    stringstream ss;
+    ss << setw(2) << setfill('0') << between(1, 28) << '-'
+        << setw(2) << setfill('0') << between(1, 12) << '-'
+        << between(firstYear, lastYear);
+    return ss.str();
+}
+
+string DataGenerator::formatAmount(long long amount) const {
+    // Catalog style: 10,000,000
+    string digits = to_string(amount);
+    string formatted;
+    for (size_t i = 0; i < digits.size(); i++) {
+        if (i > 0 && (digits.size() - i) % 3 == 0) formatted += ',';
+        formatted += digits[i];
+    }
+    return formatted;
+}
+
+LoanApplication DataGenerator::makeApplication(long long index, long long people) {
+    LoanApplication app;
+
+    int statusWeight = pick(100);
+    const StatusShare* share = &STATUS_MIX[0];
+    for (const auto& candidate : STATUS_MIX) {
+        if (statusWeight < candidate.weight) {
+            share = &candidate;
+            break;
+        }
+        statusWeight -= candidate.weight;
+    }
+
+    stringstream id;
+    id << setw(4) << setfill('0') << (1001 + index);
+    app.setApplicationId(id.str());
+    app.setStatus(share->status);
+    app.setSubmissionDate(makeDate(2024, 2025));
+    app.setCompletedSections(share->sections);
+
+    // Repeat applicants: several applications per CNIC
+    long long person = static_cast<long long>(random() % static_cast<uint64_t>(people));
+    string first = FIRST_NAMES[person % countOf(FIRST_NAMES)];
+    string family = FAMILY_NAMES[(person / countOf(FIRST_NAMES)) % countOf(FAMILY_NAMES)];
+
+    if (app.isSectionCompleted("personal")) {
+        app.setFullName(first + " " + family);
+        app.setFathersName(string(FIRST_NAMES[8 + pick(8)]) + " " + family);
+        app.setPostalAddress(to_string(between(1, 250)) + "-" + string(1, static_cast<char>('A' + pick(8))) + ", " +
+            STREETS[pick(countOf(STREETS))] + ", " + CITIES[pick(countOf(CITIES))]);
+        app.setContactNumber(makePhone());
+        app.setEmailAddress(toLower(first) + "." + toLower(family) + to_string(person % 1000) + "@gmail.com");
+        app.setCnicNumber(makeCnic(person));
+        app.setCnicExpiryDate(makeDate(2026, 2035));
+        app.setEmploymentStatus(EMPLOYMENT[pick(countOf(EMPLOYMENT))]);
+        app.setMaritalStatus(MARITAL[pick(countOf(MARITAL))]);
+        app.setGender(GENDERS[pick(countOf(GENDERS))]);
+        app.setNumberOfDependents(pick(6));
+    }
+    else {
+        // The CNIC is always known: it is how a user resumes an application
+        app.setCnicNumber(makeCnic(person));
+    }
+
+    if (app.isSectionCompleted("financial")) {
+        app.setAnnualIncome(between(4, 120) * 100000);
+        app.setAvgElectricityBill(between(20, 400) * 100);
+        app.setCurrentElectricityBill(between(20, 400) * 100);
+
+        int loans = pick(3);
+        for (int i = 0; i < loans; i++) {
+            ExistingLoan loan;
+            loan.isActive = pick(2) == 1;
+            loan.totalAmount = between(1, 50) * 100000;
+            loan.amountReturned = loan.totalAmount * pick(10) / 10;
+            loan.amountDue = loan.totalAmount - loan.amountReturned;
+            loan.bankName = BANKS[pick(countOf(BANKS))];
+            loan.loanCategory = pick(2) == 0 ? "Car" : "Personal";
+            app.addExistingLoan(loan);
+        }
+    }
+
+    if (app.isSectionCompleted("references")) {
+        for (int r = 0; r < 2; r++) {
+            Reference reference;
+            reference.name = string(FIRST_NAMES[pick(countOf(FIRST_NAMES))]) + " " + FAMILY_NAMES[pick(countOf(FAMILY_NAMES))];
+            reference.cnic = makeCnic(people + between(0, 999999));
+            reference.cnicIssueDate = makeDate(2015, 2023);
+            reference.phoneNumber = makePhone();
+            reference.email = toLower(reference.name.substr(0, reference.name.find(' '))) + "@yahoo.com";
+            if (r == 0) app.setReference1(reference);
+            else app.setReference2(reference);
+        }
+    }
+
+    if (app.isSectionCompleted("documents")) {
+        app.setCnicFrontImagePath("images/" + app.getApplicationId() + "_" + DOCUMENT_TYPES[0] + ".jpg");
+        app.setCnicBackImagePath("images/" + app.getApplicationId() + "_" + DOCUMENT_TYPES[1] + ".jpg");
+        app.setElectricityBillImagePath("images/" + app.getApplicationId() + "_" + DOCUMENT_TYPES[2] + ".jpg");
+        app.setSalarySlipImagePath("images/" + app.getApplicationId() + "_" + DOCUMENT_TYPES[3] + ".jpg");
+    }
+
+    // Loan selection is made before the form, so every record carries one
+    int kind = pick(4);
+    int months = 36 + 12 * pick(3);
+    long long price = 0;
+    long long downPayment = 0;
+    if (kind == 0) {
+        price = between(80, 200) * 100000;
+        downPayment = price / 10 * between(1, 3);
+        app.setLoanType("Home Loan");
+        app.setLoanCategory("Area " + to_string(between(1, 4)) + " - Option " + to_string(between(1, 6)));
+    }
+    else if (kind == 1) {
+        price = between(20, 60) * 100000;
+        downPayment = price / 5;
+        app.setLoanType("Car Loan");
+        app.setLoanCategory("Make " + to_string(between(1, 3)) + " - Model " + string(1, static_cast<char>('A' + pick(6))));
+    }
+    else if (kind == 2) {
+        price = between(15, 40) * 10000;
+        downPayment = price / 5;
+        app.setLoanType("Scooter Loan");
+        app.setLoanCategory("Make " + to_string(between(1, 3)) + " - Model " + string(1, static_cast<char>('P' + pick(4))));
+    }
+    else {
+        price = between(5, 30) * 100000;
+        downPayment = price / 10;
+        app.setLoanType("Personal Loan");
+        app.setLoanCategory(pick(2) == 0 ? "Standard Personal Loan" : "Education Loan");
+    }
+    app.setLoanAmount(price);
+    app.setDownPayment(downPayment);
+    app.setInstallmentMonths(months);
+    app.setMonthlyPayment((price - downPayment) / months);
+
+    if (share->status == string("approved")) {
+        app.setInstallmentStartMonth(static_cast<int>(between(1, 12)));
+        app.setInstallmentStartYear(2026);
+    }
+    if (share->status == string("rejected")) {
+        app.setRejectionReason(REJECTIONS[pick(countOf(REJECTIONS))]);
+    }
+    return app;
+}
+
+bool DataGenerator::writeApplications(const string& filename, long long count) {
+    ofstream file;
+    if (!openForWriting(file, filename)) return false;
+
+    long long people = count * 2 / 3 > 0 ? count * 2 / 3 : 1;
+    string record = RecordSchema::headerLine() + '\n';
+    file.write(record.data(), record.size());
+    for (long long i = 0; i < count; i++) {
+        record = codec.formatApplicationRecord(makeApplication(i, people));
+        record += '\n';
+        file.write(record.data(), record.size());
+    }
+    return static_cast<bool>(file);
+}
+
+bool DataGenerator::writeHomeCatalog(const string& filename, int rows) {
+    ofstream file;
+    if (!openForWriting(file, filename)) return false;
+
+    const char* sizes[] = { "5 Marla", "10 Marla", "1 Kanal" };
+    file << "Area#Size#Installments#Price#Down Payment\n";
+    for (int i = 0; i < rows; i++) {
+        long long price = (80 + 10 * (i % 12) + pick(10)) * 100000LL;
+        file << "Area " << (1 + i / 12) << '#' << sizes[(i / 3) % 3] << '#' << (36 + 12 * (i % 3)) << '#'
+            << formatAmount(price) << '#' << formatAmount(price / 10) << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+bool DataGenerator::writeCarCatalog(const string& filename, int rows) {
+    ofstream file;
+    if (!openForWriting(file, filename)) return false;
+
+    const char* engines[] = { "660", "1000", "1299", "1500", "1800" };
+    file << "Make#Model#Engine#Used#Manufacturing Year#Installments#Price#Down Payment\n";
+    for (int i = 0; i < rows; i++) {
+        long long price = (20 + pick(40)) * 100000LL;
+        file << "Make " << (1 + i / 10) << "#Model " << static_cast<char>('A' + i % 10) << '#'
+            << engines[i % 5] << '#' << (pick(3) == 0 ? "Yes" : "No") << '#' << (2018 + pick(8)) << '#'
+            << (36 + 12 * (i % 3)) << '#' << formatAmount(price) << '#' << formatAmount(price / 5) << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+bool DataGenerator::writeScooterCatalog(const string& filename, int rows) {
+    ofstream file;
+    if (!openForWriting(file, filename)) return false;
+
+    file << "Make#Model#Distance Per Charge (KM)#Charging Time (Hrs)#Max Speed (KM/H)#Installments#Price#Down Payment\n";
+    for (int i = 0; i < rows; i++) {
+        long long price = (15 + pick(25)) * 10000LL;
+        file << "Make " << (1 + i / 10) << "#Model " << static_cast<char>('P' + i % 10) << '#'
+            << (100 + 10 * pick(20)) << '#' << (2 + pick(5)) << '#' << (45 + 5 * pick(8)) << '#'
+            << (36 + 12 * (i % 3)) << '#' << formatAmount(price) << '#' << formatAmount(price / 5) << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+bool DataGenerator::writePersonalCatalog(const string& filename, int rows) {
+    ofstream file;
+    if (!openForWriting(file, filename)) return false;
+
+    const char* categories[] = { "Standard Personal Loan", "Education Loan", "Medical Loan", "Wedding Loan" };
+    const char* purposes[] = { "General Use", "Tuition Fees", "Treatment", "Ceremony" };
+    file << "Category#Purpose#Description#Installments#Amount#Down Payment\n";
+    for (int i = 0; i < rows; i++) {
+        int kind = i % 4;
+        long long amount = (5 + pick(25)) * 100000LL;
+        file << categories[kind] << '#' << purposes[kind] << "#For " << toLower(purposes[kind]) << " needs#"
+            << (24 + 12 * (i % 3)) << '#' << formatAmount(amount) << '#' << formatAmount(amount / 10) << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+bool DataGenerator::writeUtterances(const string& filename, int rows) {
+    ofstream file;
+    if (!openForWriting(file, filename)) return false;
+
+    const char* greetings[] = { "Hi", "Hello", "AoA", "Salam", "Hey", "Good morning", "Good evening" };
+    for (int i = 0; i < rows; i++) {
+        string input = greetings[i % countOf(greetings)];
+        if (i >= countOf(greetings)) input += " " + to_string(i);
+        file << input << "#Hello! Please press A if you want to apply for a loan. Press X to exit\n";
+    }
+    return static_cast<bool>(file);
+}
+
+bool DataGenerator::writeChatCorpus(const string& filename, int pairs) {
+    ofstream file;
+    if (!openForWriting(file, filename)) return false;
+
+    const char* subjects[] = { "holiday", "loan", "car", "house", "weekend", "job", "family", "food", "cricket", "weather" };
+    const char* openers[] = { "What is your favorite", "Do you like talking about your", "Tell me about your", "How was your" };
+    const char* replies[] = {
+        "I think it was great, thanks for asking",
+        "Not really, but it is fascinating to learn about it",
+        "Hard to say. Maybe next time I will know more",
+        "Yes, it matters a lot to me and my family"
+    };
+    for (int i = 0; i < pairs; i++) {
+        file << "Human 1: " << openers[pick(countOf(openers))] << ' ' << subjects[pick(countOf(subjects))] << "?\n";
+        file << "Human 2: " << replies[pick(countOf(replies))] << ' ' << subjects[pick(countOf(subjects))] << ".\n";
+    }
+    return static_cast<bool>(file);
+}
+
+bool DataGenerator::writeDataSet(const string& directory, const DataSetSize& size) {
+    if (!makeDirectories(directory)) {
+        cerr << "Error: Could not create " << directory << endl;
+        return false;
+    }
+
+    string prefix = directory + "/";
+    remove((prefix + DATA_SET_STAMP).c_str());
+
+    bool written = writeApplications(prefix + "applications.txt", size.applications) &&
+        writeHomeCatalog(prefix + Config::HOME_LOANS_FILE, size.catalogRows) &&
+        writeCarCatalog(prefix + Config::CAR_LOANS_FILE, size.catalogRows) &&
+        writeScooterCatalog(prefix + Config::SCOOTER_LOANS_FILE, size.catalogRows) &&
+        writePersonalCatalog(prefix + Config::PERSONAL_LOANS_FILE, size.catalogRows) &&
+        writeUtterances(prefix + Config::UTTERANCES_FILE, size.catalogRows) &&
+        writeChatCorpus(prefix + Config::CHAT_CORPUS_FILE, size.corpusPairs);
+    if (!written) return false;
+
+    // Written last, so an interrupted run is regenerated next time
+    ofstream stamp(prefix + DATA_SET_STAMP);
+    stamp << describeDataSet(size, seed) << '\n';
+    return static_cast<bool>(stamp);
+}
+
+bool DataGenerator::hasDataSet(const string& directory, const DataSetSize& size) const {
+    ifstream stamp(directory + "/" + DATA_SET_STAMP);
+    string line;
+    return getline(stamp, line) && line == describeDataSet(size, seed);
+}
@@ -0,0 +1,86 @@
+#ifndef DATA_GENERATOR_H
+#define DATA_GENERATOR_H
+
+#include <string>
+#include <random>
+#include <cstdint>
+#include "file_manager.h"
+
+using namespace std;
+
+/// <summary>
+/// Sizes of one synthetic data set
+/// </summary>
+struct DataSetSize {
+    long long applications;     // Records in applications.txt
+    int catalogRows;            // Rows per loan catalog and in Utterances.txt
+    int corpusPairs;            // Human 1 / Human 2 pairs in the chat corpus
+
+    DataSetSize() : applications(10000), catalogRows(100), corpusPairs(10000) {}
+};
+
+/// <summary>
+/// Writes reproducible synthetic data files for benchmarks and load tests
+/// Application records are built as LoanApplication objects and written with
+/// FileManager::formatApplicationRecord, so the layout is exactly what
+/// saveApplication produces. The same seed always gives the same files.
+/// SE Principles:
+/// - Reuse: the real record formatter, not a copy of the file layout
+/// - Determinism: results can be compared across runs and machines
+/// </summary>
+class DataGenerator {
+private:
+    mt19937_64 random;
+    uint64_t seed;
+    FileManager codec;
+
+    int pick(int count);
+    long long between(long long low, long long high);
+
+    string makeCnic(long long person) const;
+    string makePhone();
+    string makeDate(int firstYear, int lastYear);
+    string formatAmount(long long amount) const;
+
+    /// <summary>
+    /// Builds one application as the user client would have collected it
+    /// </summary>
+    /// <param name="index">0-based record number (sets the ID)</param>
+    /// <param name="people">Number of distinct applicants (CNICs)</param>
+    LoanApplication makeApplication(long long index, long long people);
+
+public:
+    explicit DataGenerator(uint64_t seed = 2025);
+
+    /// <summary>
+    /// Writes an applications file; several applications share each CNIC
+    /// </summary>
+    bool writeApplications(const string& filename, long long count);
+
+    bool writeHomeCatalog(const string& filename, int rows);
+    bool writeCarCatalog(const string& filename, int rows);
+    bool writeScooterCatalog(const string& filename, int rows);
+    bool writePersonalCatalog(const string& filename, int rows);
+    bool writeUtterances(const string& filename, int rows);
+    bool writeChatCorpus(const string& filename, int pairs);
+
+    /// <summary>
+    /// Writes a full data set (applications.txt, the catalogs, Utterances.txt
+    /// and human_chat_corpus.txt) into a directory, creating it (and its parents) if needed
+    /// A dataset.txt stamp records the sizes and seed used.
+    /// </summary>
+    bool writeDataSet(const string& directory, const DataSetSize& size);
+
+    /// <summary>
+    /// True if the directory holds a complete data set written with these sizes and this seed
+    /// </summary>
+    bool hasDataSet(const string& directory, const DataSetSize& size) const;
+};
+
+/// <summary>
+/// Parses a record count such as "10000", "10k" or "1M"
+/// </summary>
+/// <returns>False if the text is not a positive count</returns>
+bool parseRecordCount(const string& text, long long& count);
+
+#endif
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include "data_generator.h"
+#include "utilities.h"
+
+using namespace std;
+
+namespace {
+    void printUsage() {
+        cout << "Usage: generate_data [--records N] [--out DIR] [--seed S]\n"
+            << "                     [--catalog-rows N] [--corpus-pairs N] [--standard]\n"
+            << "  --records N        applications to write (10000, 10k, 1M, ...; default 10k)\n"
+            << "  --out DIR          output directory (default bench_data)\n"
+            << "  --seed S           random seed; the same seed gives the same files (default 2025)\n"
+            << "  --catalog-rows N   rows per loan catalog and in Utterances.txt (default "
+            << Config::MAX_LOANS << ", the loaders' limit)\n"
+            << "  --corpus-pairs N   chat corpus size in question/answer pairs (default 10000)\n"
+            << "  --standard         write the 10k, 100k, 1M and 10M sets into DIR/10k ... DIR/10M\n";
+    }
+}
+
+/// <summary>
+/// Writes synthetic data sets for the benchmarks and for load testing the
+/// lender server (copy a set's files next to the executables to use it)
+/// </summary>
+int main(int argc, char* argv[]) {
+    DataSetSize size;
+    string directory = "bench_data";
+    unsigned long long seed = 2025;
+    bool standard = false;
+
+    for (int i = 1; i < argc; i++) {
+        string argument = argv[i];
+        bool hasValue = (i + 1 < argc);
+        long long value = 0;
+
+        if (argument == "--standard") {
+            standard = true;
+        }
+        else if (argument == "--records" && hasValue && parseRecordCount(argv[i + 1], value)) {
+            size.applications = value;
+            i++;
+        }
+        else if (argument == "--out" && hasValue) {
+            directory = argv[++i];
+        }
+        else if (argument == "--seed" && hasValue && tryParseNumber(argv[i + 1], value)) {
+            seed = static_cast<unsigned long long>(value);
+            i++;
+        }
+        else if (argument == "--catalog-rows" && hasValue && parseRecordCount(argv[i + 1], value)) {
+            size.catalogRows = static_cast<int>(value);
+            i++;
+        }
+        else if (argument == "--corpus-pairs" && hasValue && parseRecordCount(argv[i + 1], value)) {
+            size.corpusPairs = static_cast<int>(value);
+            i++;
+        }
+        else {
+            printUsage();
+            return argument == "--help" ? 0 : 1;
+        }
+    }
+
+    vector<pair<string, long long>> sets;
+    if (standard) {
+        sets = { { "10k", 10000 }, { "100k", 100000 }, { "1M", 1000000 }, { "10M", 10000000 } };
+    }
+    else {
+        sets.push_back(make_pair(string(), size.applications));
+    }
+
+    for (const auto& set : sets) {
+        string target = set.first.empty() ? directory : directory + "/" + set.first;
+        DataSetSize setSize = size;
+        setSize.applications = set.second;
+
+        auto start = chrono::steady_clock::now();
+        DataGenerator generator(seed);
+        if (!generator.writeDataSet(target, setSize)) {
+            return 1;
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "Wrote " << setSize.applications << " applications to " << target
+            << " in " << seconds << " s" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include "block_codec.h"
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+namespace {
+    const size_t MIN_MATCH = 4;
+    const size_t LAST_LITERALS = 5;     // The format ends every block with at least this many literals
+    const size_t MATCH_START_LIMIT = 12; // ...and starts no match closer than this to the end
+    const size_t MAX_OFFSET = 65535;
+    const int HASH_BITS = 16;
+    const int MAX_CHAIN = 32;           // Earlier positions tried per match
+
+    uint32_t read32(const char* p) {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    uint32_t hashOf(uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    void writeLength(string& out, size_t length) {
+        while (length >= 255) {
+            out += static_cast<char>(255);
+            length -= 255;
+        }
+        out += static_cast<char>(length);
+    }
+
+    void writeSequence(string& out, const char* literals, size_t literalLength, size_t offset, size_t matchLength) {
+        size_t matchCode = matchLength - MIN_MATCH;
+        uint8_t token = static_cast<uint8_t>((literalLength < 15 ? literalLength : 15) << 4);
+        token |= static_cast<uint8_t>(matchCode < 15 ? matchCode : 15);
+        out += static_cast<char>(token);
+
+        if (literalLength >= 15) writeLength(out, literalLength - 15);
+        out.append(literals, literalLength);
+
+        out += static_cast<char>(offset & 0xFF);
+        out += static_cast<char>((offset >> 8) & 0xFF);
+        if (matchCode >= 15) writeLength(out, matchCode - 15);
+    }
+
+    void writeLastLiterals(string& out, const char* literals, size_t literalLength) {
+        out += static_cast<char>((literalLength < 15 ? literalLength : 15) << 4);
+        if (literalLength >= 15) writeLength(out, literalLength - 15);
+        out.append(literals, literalLength);
+    }
+
+    bool readLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+        uint8_t next;
+        do {
+            if (in >= end) return false;
+            next = *in++;
+            length += next;
+        } while (next == 255);
+        return true;
+    }
+}
+
+string compressBlock(const char* data, size_t length) {
+    string out;
+    out.reserve(length / 2 + 16);
+    if (length <= MATCH_START_LIMIT) {
+        writeLastLiterals(out, data, length);
+        return out;
+    }
+
+    vector<int32_t> head(static_cast<size_t>(1) << HASH_BITS, -1);
+    vector<int32_t> previous(length, -1);     // Earlier position with the same hash
+    auto insert = [&](size_t position) {
+        uint32_t hash = hashOf(read32(data + position));
+        previous[position] = head[hash];
+        head[hash] = static_cast<int32_t>(position);
+    };
+
+    const size_t matchStartLimit = length - MATCH_START_LIMIT;
+    const size_t matchEndLimit = length - LAST_LITERALS;
+    size_t anchor = 0;
+    size_t position = 0;
+
+    while (position < matchStartLimit) {
+        uint32_t sequence = read32(data + position);
+        size_t bestLength = 0;
+        size_t bestOffset = 0;
+
+        int32_t candidate = head[hashOf(sequence)];
+        for (int tries = 0; candidate >= 0 && tries < MAX_CHAIN; tries++) {
+            size_t offset = position - static_cast<size_t>(candidate);
+            if (offset > MAX_OFFSET) break;
+
+            if (read32(data + candidate) == sequence) {
+                size_t matchLength = MIN_MATCH;
+                while (position + matchLength < matchEndLimit &&
+                    data[candidate + matchLength] == data[position + matchLength]) {
+                    matchLength++;
+                }
+                if (matchLength > bestLength) {
+                    bestLength = matchLength;
+                    bestOffset = offset;
+                }
+            }
+            candidate = previous[candidate];
+        }
+
+        if (bestLength < MIN_MATCH) {
+            insert(position);
+            position++;
+            continue;
+        }
+
+        writeSequence(out, data + anchor, position - anchor, bestOffset, bestLength);
+        size_t matchEnd = position + bestLength;
+        for (; position < matchEnd && position < matchStartLimit; position++) {
+            insert(position);
+        }
+        position = matchEnd;
+        anchor = position;
+    }
+
+    writeLastLiterals(out, data + anchor, length - anchor);
+    return out;
+}
+
+bool decompressBlock(const char* block, size_t blockLength, size_t rawLength, string& output) {
+    output.assign(rawLength, '\0');
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(block);
+    const uint8_t* inEnd = in + blockLength;
+    size_t written = 0;
+
+    while (in < inEnd) {
+        uint8_t token = *in++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(in, inEnd, literalLength)) return false;
+        if (literalLength > static_cast<size_t>(inEnd - in) || literalLength > rawLength - written) return false;
+        memcpy(&output[written], in, literalLength);
+        in += literalLength;
+        written += literalLength;
+
+        if (in == inEnd) break;     // The last sequence has no match
+
+        if (inEnd - in < 2) return false;
+        size_t offset = in[0] | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+        size_t matchLength = token & 0x0F;
+        if (matchLength == 15 && !readLength(in, inEnd, matchLength)) return false;
+        matchLength += MIN_MATCH;
+
+        if (offset == 0 || offset > written || matchLength > rawLength - written) return false;
+
+        // A match closer than its length overlaps the bytes it is producing
+        // (a repeated pattern) and has to be copied byte by byte
+        char* target = &output[written];
+        const char* source = target - offset;
+        if (offset >= matchLength) {
+            memcpy(target, source, matchLength);
+        }
+        else {
+            for (size_t i = 0; i < matchLength; i++) target[i] = source[i];
+        }
+        written += matchLength;
+    }
+    return written == rawLength;
+}
@@ -0,0 +1,35 @@
+#ifndef BLOCK_CODEC_H
+#define BLOCK_CODEC_H
+
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+/// <summary>
+/// Compresses one block in the LZ4 block format: runs of literal bytes
+/// alternating with back-references (offset up to 64 KB, length 4 or more)
+/// into the bytes already decoded. Blocks are independent, so any one can be
+/// decompressed without the others.
+/// Matches are found through hash chains (several earlier positions per hash
+/// are tried), which suits the repetitive text of application records better
+/// than LZ4's single-candidate fast mode; decompression is the same either way.
+/// </summary>
+/// <param name="data">Bytes to compress</param>
+/// <param name="length">Number of bytes</param>
+/// <returns>The compressed block (its decompressed size is not stored; keep it alongside)</returns>
+string compressBlock(const char* data, size_t length);
+
+inline string compressBlock(const string& data) {
+    return compressBlock(data.data(), data.size());
+}
+
+/// <summary>
+/// Decompresses a block written by compressBlock
+/// </summary>
+/// <param name="rawLength">Decompressed size recorded when the block was written</param>
+/// <param name="output">Output: exactly rawLength bytes</param>
+/// <returns>False if the block is malformed or does not decode to rawLength bytes</returns>
+bool decompressBlock(const char* block, size_t blockLength, size_t rawLength, string& output);
+
+#endif
@@ -0,0 +1,95 @@
+#include "bloom_filter.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+    const uint32_t MAX_HASHES = 30;
+
+    /// <summary>
+    /// Two independent 64-bit hashes of a key (FNV-1a, then a SplitMix64
+    /// finalizer over it); probe i uses h1 + i * h2 (double hashing)
+    /// </summary>
+    void hashKey(const string& key, uint64_t& h1, uint64_t& h2) {
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : key) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        h1 = hash;
+
+        uint64_t mixed = hash + 0x9E3779B97F4A7C15ull;
+        mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+        mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+        h2 = (mixed ^ (mixed >> 31)) | 1;   // Odd, so the probes do not repeat early
+    }
+
+    bool probe(const uint8_t* bits, uint64_t bitCount, uint32_t hashCount, const string& key) {
+        uint64_t h1 = 0, h2 = 0;
+        hashKey(key, h1, h2);
+        for (uint32_t i = 0; i < hashCount; i++) {
+            uint64_t bit = (h1 + i * h2) % bitCount;
+            if ((bits[bit / 8] & (1u << (bit % 8))) == 0) return false;
+        }
+        return true;
+    }
+
+    uint64_t getUInt64(const char* in) {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; i++) value |= static_cast<uint64_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+        return value;
+    }
+}
+
+BloomFilter::BloomFilter(size_t expectedKeys, double falsePositiveRate) {
+    double keys = static_cast<double>(max<size_t>(expectedKeys, 1));
+    double rate = min(max(falsePositiveRate, 1e-9), 0.5);
+    double ln2 = log(2.0);
+
+    double bitsWanted = ceil(-keys * log(rate) / (ln2 * ln2));
+    bitCount = max<uint64_t>(64, (static_cast<uint64_t>(bitsWanted) + 7) / 8 * 8);
+    hashCount = static_cast<uint32_t>(max(1.0, min<double>(MAX_HASHES, round(bitCount / keys * ln2))));
+    bits.assign(static_cast<size_t>(bitCount / 8), 0);
+}
+
+void BloomFilter::add(const string& key) {
+    uint64_t h1 = 0, h2 = 0;
+    hashKey(key, h1, h2);
+    for (uint32_t i = 0; i < hashCount; i++) {
+        uint64_t bit = (h1 + i * h2) % bitCount;
+        bits[bit / 8] |= static_cast<uint8_t>(1u << (bit % 8));
+    }
+}
+
+bool BloomFilter::mightContain(const string& key) const {
+    return probe(bits.data(), bitCount, hashCount, key);
+}
+
+string BloomFilter::serialize() const {
+    string out(HEADER_BYTES, '\0');
+    for (int i = 0; i < 4; i++) out[i] = static_cast<char>((hashCount >> (8 * i)) & 0xFF);
+    for (int i = 0; i < 8; i++) out[8 + i] = static_cast<char>((bitCount >> (8 * i)) & 0xFF);
+    out.append(reinterpret_cast<const char*>(bits.data()), bits.size());
+    return out;
+}
+
+bool BloomFilter::mightContain(const char* serialized, size_t length, const string& key) {
+    if (length < HEADER_BYTES) return true;
+
+    uint32_t hashes = static_cast<uint32_t>(getUInt64(serialized) & 0xFFFFFFFFu);
+    uint64_t bitTotal = getUInt64(serialized + 8);
+    if (hashes == 0 || hashes > MAX_HASHES || bitTotal == 0 || bitTotal % 8 != 0 ||
+        bitTotal / 8 > length - HEADER_BYTES) {
+        return true;
+    }
+    return probe(reinterpret_cast<const uint8_t*>(serialized + HEADER_BYTES), bitTotal, hashes, key);
+}
+
+uint64_t BloomFilter::getBitCount() const {
+    return bitCount;
+}
+
+uint32_t BloomFilter::getHashCount() const {
+    return hashCount;
+}
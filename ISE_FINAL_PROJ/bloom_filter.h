@@ -0,0 +1,59 @@
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/// <summary>
+/// Bloom filter over string keys
+/// mightContain never misses a key that was added; for other keys it answers
+/// true at about the false-positive rate the filter was sized for, so a
+/// false answer lets a lookup skip the data file entirely.
+/// The serialized form can be probed in place (for example inside a memory
+/// mapped index file) without loading it into a BloomFilter.
+/// Keys cannot be removed; the application store never deletes records, and
+/// changed records are picked up when the filter is rebuilt with its index.
+/// SE Principles:
+/// - Single Responsibility: set membership only; what the keys are is up to the owner
+/// - Information Hiding: hashing and the serialized layout are private to bloom_filter.cpp
+/// </summary>
+class BloomFilter {
+private:
+    vector<uint8_t> bits;
+    uint64_t bitCount;
+    uint32_t hashCount;
+
+public:
+    static const size_t HEADER_BYTES = 16;  // hash count, reserved, bit count
+
+    /// <summary>
+    /// Sizes the filter for a number of keys: m = -n ln p / (ln 2)^2 bits and
+    /// k = (m / n) ln 2 hash functions
+    /// </summary>
+    /// <param name="expectedKeys">Keys that will be added</param>
+    /// <param name="falsePositiveRate">Wanted share of absent keys reported present (0 to 1)</param>
+    BloomFilter(size_t expectedKeys, double falsePositiveRate);
+
+    void add(const string& key);
+    bool mightContain(const string& key) const;
+
+    /// <summary>
+    /// Header followed by the bit array
+    /// </summary>
+    string serialize() const;
+
+    /// <summary>
+    /// Probes a serialized filter without copying it
+    /// </summary>
+    /// <returns>True if the key may be present, or the bytes are not a valid filter</returns>
+    static bool mightContain(const char* serialized, size_t length, const string& key);
+
+    uint64_t getBitCount() const;
+    uint32_t getHashCount() const;
+};
+
+#endif
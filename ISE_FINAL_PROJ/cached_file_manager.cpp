@@ -0,0 +1,378 @@
+#include "cached_file_manager.h"
+#include "utilities.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+    const size_t FILE_TAIL_BYTES = 256;
+
+    string tailOf(const string& text, size_t end) {
+        size_t start = end > FILE_TAIL_BYTES ? end - FILE_TAIL_BYTES : 0;
+        return text.substr(start, end - start);
+    }
+}
+
+CachedFileManager::CachedFileManager(const string& appsFile, const string& imagesDir)
+    : FileManager(appsFile, imagesDir), current(make_shared<Snapshot>()), lastReservedId(0) {
+    reload();
+}
+
+shared_ptr<const CachedFileManager::Snapshot> CachedFileManager::snapshot() const {
+    return atomic_load(&current);
+}
+
+void CachedFileManager::publish(shared_ptr<Snapshot> next) {
+    atomic_store(&current, shared_ptr<const Snapshot>(move(next)));
+}
+
+shared_ptr<CachedFileManager::Snapshot> CachedFileManager::beginUpdate() const {
+    // Copies pointers only; the records themselves are shared with the old snapshot
+    return make_shared<Snapshot>(*snapshot());
+}
+
+void CachedFileManager::appendRecords(Snapshot& next, const string& text, size_t from, long long textOffset) const {
+    size_t position = from;
+    size_t newline;
+    while ((newline = text.find('\n', position)) != string::npos) {
+        if (newline > position) {
+            LoanApplication app;
+            if (parseApplicationRecord(text.substr(position, newline - position), app)) {
+                rememberId(next, app.getApplicationId());
+                next.records.push_back(make_shared<const LoanApplication>(move(app)));
+            }
+        }
+        position = newline + 1;
+    }
+
+    // A line without its newline may still be being written; it is read next time
+    next.fileSize = textOffset + static_cast<long long>(position);
+    next.fileTail = tailOf(text, position);
+}
+
+void CachedFileManager::stampFile(Snapshot& next) const {
+    // Another process appending between our write and this read would be
+    // counted as already loaded; the window is a few microseconds
+    ifstream file(getApplicationsFile(), ios::binary | ios::ate);
+    if (!file.is_open()) return;
+
+    long long size = static_cast<long long>(file.tellg());
+    long long start = size > static_cast<long long>(FILE_TAIL_BYTES) ? size - FILE_TAIL_BYTES : 0;
+    string tail(static_cast<size_t>(size - start), '\0');
+    file.seekg(start);
+    file.read(&tail[0], tail.size());
+
+    next.fileSize = size;
+    next.fileTail = move(tail);
+    next.partitionStamp = getPartitionStamp();
+}
+
+void CachedFileManager::reload() {
+    lock_guard<mutex> lock(writeMutex);
+
+    string contents;
+    ifstream file(getApplicationsFile(), ios::binary);
+    if (file.is_open()) {
+        stringstream buffer;
+        buffer << file.rdbuf();
+        contents = buffer.str();
+    }
+    else {
+        cerr << "Warning: Could not open applications file" << endl;
+    }
+
+    auto next = make_shared<Snapshot>();
+    next->partitionStamp = getPartitionStamp();
+    for (auto& app : loadPartitionedApplications(getPartitionMonths())) {
+        rememberId(*next, app.getApplicationId());
+        next->records.push_back(make_shared<const LoanApplication>(move(app)));
+    }
+    appendRecords(*next, contents, 0, 0);
+    publish(move(next));
+}
+
+bool CachedFileManager::refreshFromFile() {
+    {
+        lock_guard<mutex> lock(writeMutex);
+        shared_ptr<const Snapshot> loaded = snapshot();
+
+        ifstream file(getApplicationsFile(), ios::binary | ios::ate);
+        if (!file.is_open()) return false;
+
+        // Records moved to or between partitions by another process
+        bool partitionsChanged = getPartitionStamp() != loaded->partitionStamp;
+        long long size = static_cast<long long>(file.tellg());
+
+        // Unchanged up to where we stopped reading: only the new lines need parsing
+        long long tailStart = loaded->fileSize - static_cast<long long>(loaded->fileTail.size());
+        if (!partitionsChanged && size >= loaded->fileSize && tailStart >= 0) {
+            string text(static_cast<size_t>(size - tailStart), '\0');
+            file.seekg(tailStart);
+            file.read(&text[0], text.size());
+
+            if (file && text.compare(0, loaded->fileTail.size(), loaded->fileTail) == 0) {
+                if (size == loaded->fileSize) return false;
+
+                auto next = beginUpdate();
+                appendRecords(*next, text, loaded->fileTail.size(), tailStart);
+                bool changed = next->records.size() != loaded->records.size();
+                publish(move(next));
+                return changed;
+            }
+        }
+    }
+
+    // Rewritten (status or section update by another process, edit, truncation, partitioning)
+    reload();
+    return true;
+}
+
+size_t CachedFileManager::getCachedCount() const {
+    return snapshot()->records.size();
+}
+
+void CachedFileManager::rememberId(Snapshot& next, const string& applicationId) {
+    int id = 0;
+    if (tryParseNumber(applicationId, id) && id > next.highestId) {
+        next.highestId = id;
+    }
+}
+
+string CachedFileManager::formatNextId(int highestId) {
+    stringstream ss;
+    ss << setw(4) << setfill('0') << (highestId + 1);
+    return ss.str();
+}
+
+string CachedFileManager::reserveNextId(int highestId) const {
+    lastReservedId = max(lastReservedId, highestId);
+    return formatNextId(lastReservedId++);
+}
+
+string CachedFileManager::generateApplicationId() const {
+    lock_guard<mutex> lock(writeMutex);
+    return reserveNextId(snapshot()->highestId);
+}
+
+bool CachedFileManager::saveApplication(LoanApplication& application) {
+    uint64_t sequence;
+    {
+        // Writers queue on the lock only for the write itself; the journal
+        // sync is waited for after it, so concurrent writers share one fsync
+        lock_guard<mutex> lock(writeMutex);
+        DurabilityDeferral deferral;
+        auto next = beginUpdate();
+
+        // Assigned here so the base class does not rescan the file for an ID
+        if (application.getApplicationId().empty()) {
+            application.setApplicationId(reserveNextId(next->highestId));
+        }
+        if (!FileManager::saveApplication(application)) {
+            return false;
+        }
+        sequence = getLastLoggedSequence();
+
+        rememberId(*next, application.getApplicationId());
+        next->records.push_back(make_shared<const LoanApplication>(application));
+        stampFile(*next);
+        publish(move(next));
+    }
+    return waitUntilDurable(sequence);
+}
+
+bool CachedFileManager::updateApplicationSection(const LoanApplication& application, const string& section) {
+    uint64_t sequence;
+    {
+        lock_guard<mutex> lock(writeMutex);
+        DurabilityDeferral deferral;
+
+        LoanApplication updatedApp = prepareSectionUpdate(application, section);
+        if (!writeApplicationRecord(updatedApp)) {
+            return false;
+        }
+        sequence = getLastLoggedSequence();
+
+        // Same rule as the file: replace every record with this ID, or append
+        auto next = beginUpdate();
+        auto stored = make_shared<const LoanApplication>(move(updatedApp));
+        bool found = false;
+        for (auto& app : next->records) {
+            if (app->getApplicationId() == stored->getApplicationId()) {
+                app = stored;
+                found = true;
+            }
+        }
+        if (!found) {
+            rememberId(*next, stored->getApplicationId());
+            next->records.push_back(stored);
+        }
+        stampFile(*next);
+        publish(move(next));
+    }
+    if (!waitUntilDurable(sequence)) {
+        return false;
+    }
+
+    if (!section.empty()) {
+        cout << "Progress saved at checkpoint: " << section << endl;
+    }
+    return true;
+}
+
+bool CachedFileManager::updateApplicationStatus(const string& applicationId,
+    const string& newStatus, const string& rejectionReason) {
+    shared_ptr<const LoanApplication> updated;
+    function<void(const LoanApplication&)> listener;
+    uint64_t sequence;
+    {
+        lock_guard<mutex> lock(writeMutex);
+        DurabilityDeferral deferral;
+
+        if (!FileManager::updateApplicationStatus(applicationId, newStatus, rejectionReason)) {
+            return false;
+        }
+        sequence = getLastLoggedSequence();
+
+        auto next = beginUpdate();
+        for (auto& app : next->records) {
+            if (app->getApplicationId() == applicationId) {
+                LoanApplication changed = *app;
+                changed.setStatus(newStatus);
+                if (!rejectionReason.empty()) {
+                    changed.setRejectionReason(rejectionReason);
+                }
+                app = make_shared<const LoanApplication>(move(changed));
+                updated = app;
+            }
+        }
+        stampFile(*next);
+        publish(move(next));
+        listener = statusListener;
+    }
+    if (!waitUntilDurable(sequence)) {
+        return false;
+    }
+
+    if (listener && updated) {
+        listener(*updated);
+    }
+    return true;
+}
+
+void CachedFileManager::setStatusListener(function<void(const LoanApplication&)> listener) {
+    lock_guard<mutex> lock(writeMutex);
+    statusListener = move(listener);
+}
+
+vector<LoanApplication> CachedFileManager::loadAllApplications() const {
+    shared_ptr<const Snapshot> view = snapshot();
+    vector<LoanApplication> results;
+    results.reserve(view->records.size());
+    for (const auto& app : view->records) {
+        results.push_back(*app);
+    }
+    return results;
+}
+
+vector<LoanApplication> CachedFileManager::loadPendingApplications() const {
+    shared_ptr<const Snapshot> view = snapshot();
+    vector<LoanApplication> results;
+    for (const auto& app : view->records) {
+        if (!isDecidedStatus(app->getStatusCode())) {
+            results.push_back(*app);
+        }
+    }
+    return results;
+}
+
+vector<LoanApplication> CachedFileManager::queryApplications(const RecordQuery& query) const {
+    // Records are already parsed; only the predicate needs the projected fields
+    shared_ptr<const Snapshot> view = snapshot();
+    vector<LoanApplication> results;
+    RecordView fields;
+    for (const auto& app : view->records) {
+        if (query.matches(*app, fields)) {
+            results.push_back(*app);
+        }
+    }
+    return results;
+}
+
+void CachedFileManager::forEachRecord(const RecordQuery& query,
+    const function<void(const RecordView&)>& onRecord) const {
+    shared_ptr<const Snapshot> view = snapshot();
+    RecordView fields;
+    for (const auto& app : view->records) {
+        if (query.matches(*app, fields)) {
+            onRecord(fields);
+        }
+    }
+}
+
+LoanApplication CachedFileManager::findApplicationById(const string& applicationId) const {
+    shared_ptr<const Snapshot> view = snapshot();
+    for (const auto& app : view->records) {
+        if (app->getApplicationId() == applicationId) {
+            return *app;
+        }
+    }
+
+    cerr << "Application " << applicationId << " not found in file" << endl;
+    return LoanApplication();
+}
+
+vector<LoanApplication> CachedFileManager::findApplicationsByCNIC(const string& cnic) const {
+    shared_ptr<const Snapshot> view = snapshot();
+    vector<LoanApplication> results;
+    for (const auto& app : view->records) {
+        if (app->getCnicNumber() == cnic) {
+            results.push_back(*app);
+        }
+    }
+    return results;
+}
+
+LoanApplication CachedFileManager::findIncompleteApplication(const string& applicationId, const string& cnic) const {
+    shared_ptr<const Snapshot> view = snapshot();
+    for (const auto& app : view->records) {
+        if (app->getApplicationId() == applicationId && app->getCnicNumber() == cnic &&
+            isIncompleteStatus(app->getStatusCode())) {
+            return *app;
+        }
+    }
+    return LoanApplication();
+}
+
+vector<LoanApplication> CachedFileManager::findUserIncompleteApplications(const string& cnic) const {
+    shared_ptr<const Snapshot> view = snapshot();
+    vector<LoanApplication> results;
+    for (const auto& app : view->records) {
+        if (app->getCnicNumber() == cnic && isIncompleteStatus(app->getStatusCode())) {
+            results.push_back(*app);
+        }
+    }
+    return results;
+}
+
+vector<LoanApplication> CachedFileManager::loadApplicationsSubmittedBetween(const string& fromDate,
+    const string& toDate) const {
+    vector<LoanApplication> results;
+    string from, to;
+    if (!ApplicationPartitions::sortableDate(fromDate, from) || !ApplicationPartitions::sortableDate(toDate, to)) {
+        return results;
+    }
+
+    shared_ptr<const Snapshot> view = snapshot();
+    for (const auto& app : view->records) {
+        string submitted;
+        if (ApplicationPartitions::sortableDate(app->getSubmissionDate(), submitted) &&
+            submitted >= from && submitted <= to) {
+            results.push_back(*app);
+        }
+    }
+    return results;
+}
@@ -0,0 +1,131 @@
+#ifndef CACHED_FILE_MANAGER_H
+#define CACHED_FILE_MANAGER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include "file_manager.h"
+
+using namespace std;
+
+/// <summary>
+/// FileManager that keeps every parsed application in memory
+/// Queries are answered from memory; writes go to applications.txt first and
+/// are then applied to the in-memory copy, so the file stays the durable record.
+/// Used by lender_server --serve, where the server owns the store.
+/// The records live in an immutable snapshot that writers replace with an
+/// atomic shared_ptr store: readers never wait for a writer or a reload, they
+/// just keep the snapshot they started with. Writers are serialized, but only
+/// while writing: each waits for its journal record to be synced after letting
+/// the next writer in, so a burst of writers shares one fsync.
+/// refreshFromFile picks up changes made to the file by other processes.
+/// Applications moved to the month partitions are loaded with the rest; a
+/// change to the partition manifest causes a full reload.
+/// SE Principles:
+/// - Liskov Substitution: drop-in replacement wherever a FileManager is expected
+/// - Caching: each record is parsed once per server run instead of once per query
+/// - Immutability: a published snapshot is never modified
+/// </summary>
+class CachedFileManager : public FileManager {
+private:
+    struct Snapshot {
+        vector<shared_ptr<const LoanApplication>> records;  // Same order and entries as loadAllApplications()
+        int highestId;
+        long long fileSize;         // Bytes of applications.txt the records reflect
+        string fileTail;            // Last bytes of that prefix, to tell appends from rewrites
+        string partitionStamp;      // Month partition manifest the records reflect (getPartitionStamp)
+
+        Snapshot() : highestId(1000), fileSize(0) {}
+    };
+
+    shared_ptr<const Snapshot> current;     // Only accessed through atomic_load/atomic_store
+    mutable mutex writeMutex;               // Held by writers and reloads
+    mutable int lastReservedId;             // Highest ID handed out so far (guarded by writeMutex)
+    function<void(const LoanApplication&)> statusListener;
+
+    shared_ptr<const Snapshot> snapshot() const;
+    void publish(shared_ptr<Snapshot> next);
+
+    /// <summary>
+    /// Copies the current snapshot for modification (caller holds writeMutex)
+    /// </summary>
+    shared_ptr<Snapshot> beginUpdate() const;
+
+    /// <summary>
+    /// Parses the complete lines of text[from..] into next and records how
+    /// much of the file next now reflects
+    /// </summary>
+    void appendRecords(Snapshot& next, const string& text, size_t from, long long textOffset) const;
+
+    /// <summary>
+    /// Records the file's current size and tail after this process wrote it
+    /// </summary>
+    void stampFile(Snapshot& next) const;
+
+    /// <summary>
+    /// Next free ID
+    /// </summary>
+    static string formatNextId(int highestId);
+
+    /// <summary>
+    /// Hands out the next ID above both the stored records and every ID
+    /// reserved before, so two callers never get the same one (caller holds writeMutex)
+    /// </summary>
+    string reserveNextId(int highestId) const;
+
+    static void rememberId(Snapshot& next, const string& applicationId);
+
+public:
+    /// <summary>
+    /// Loads applications.txt into memory
+    /// </summary>
+    CachedFileManager(const string& appsFile = "applications.txt",
+        const string& imagesDir = "images/");
+
+    /// <summary>
+    /// Discards the in-memory copy and parses the partitions and applications.txt again
+    /// </summary>
+    void reload();
+
+    /// <summary>
+    /// Brings the in-memory copy up to date with applications.txt
+    /// Records appended since the last read are parsed on their own; any
+    /// other change to the file causes a full reload.
+    /// </summary>
+    /// <returns>True if the in-memory copy changed</returns>
+    bool refreshFromFile();
+
+    /// <summary>
+    /// Number of records held in memory
+    /// </summary>
+    size_t getCachedCount() const;
+
+    /// <summary>
+    /// Called with the updated application after every successful status change
+    /// (from whichever thread made it, after the store lock is released)
+    /// </summary>
+    void setStatusListener(function<void(const LoanApplication&)> listener);
+
+    string generateApplicationId() const override;
+    bool saveApplication(LoanApplication& application) override;
+    bool updateApplicationSection(const LoanApplication& application, const string& section) override;
+    bool updateApplicationStatus(const string& applicationId,
+        const string& newStatus,
+        const string& rejectionReason = "") override;
+
+    vector<LoanApplication> loadAllApplications() const override;
+    vector<LoanApplication> loadPendingApplications() const override;
+    vector<LoanApplication> queryApplications(const RecordQuery& query) const override;
+    void forEachRecord(const RecordQuery& query, const function<void(const RecordView&)>& onRecord) const override;
+    LoanApplication findApplicationById(const string& applicationId) const override;
+    vector<LoanApplication> findApplicationsByCNIC(const string& cnic) const override;
+    LoanApplication findIncompleteApplication(const string& applicationId,
+        const string& cnic) const override;
+    vector<LoanApplication> findUserIncompleteApplications(const string& cnic) const override;
+    vector<LoanApplication> loadApplicationsSubmittedBetween(const string& fromDate,
+        const string& toDate) const override;
+};
+
+#endif
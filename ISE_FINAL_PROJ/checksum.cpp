@@ -0,0 +1,29 @@
+#include "checksum.h"
+#include <mutex>
+
+using namespace std;
+
+namespace {
+    uint32_t crcTable[256];
+
+    void buildCrcTable() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; bit++) {
+                value = (value & 1) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+            }
+            crcTable[i] = value;
+        }
+    }
+}
+
+uint32_t crc32(const char* data, size_t length, uint32_t previous) {
+    static once_flag tableReady;
+    call_once(tableReady, buildCrcTable);
+
+    uint32_t crc = previous ^ 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        crc = crcTable[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
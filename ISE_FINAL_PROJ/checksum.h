@@ -0,0 +1,22 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+using namespace std;
+
+/// <summary>
+/// CRC-32 (IEEE 802.3) used to detect torn or stale on-disk structures
+/// (journal records, index headers); not a fingerprint, see Sha256 for that
+/// </summary>
+/// <param name="data">Bytes to check</param>
+/// <param name="length">Number of bytes</param>
+/// <param name="previous">CRC of the bytes before these, to checksum in pieces</param>
+uint32_t crc32(const char* data, size_t length, uint32_t previous = 0);
+
+inline uint32_t crc32(const string& data) {
+    return crc32(data.data(), data.size());
+}
+
+#endif
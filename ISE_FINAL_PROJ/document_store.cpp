@@ -0,0 +1,341 @@
+#include "document_store.h"
+#include "sha256.h"
+#include "utilities.h"
+#include <cstdio>
+#include <cerrno>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <direct.h>
+#else
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+    bool makeDirectory(const string& path) {
+#ifdef _WIN32
+        return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+        return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+    }
+
+    long long getFileSize(const string& path) {
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) return -1;
+        return static_cast<long long>(info.st_size);
+    }
+
+    bool createHardLink(const string& existingPath, const string& newPath) {
+#ifdef _WIN32
+        return CreateHardLinkA(newPath.c_str(), existingPath.c_str(), NULL) != 0;
+#else
+        return link(existingPath.c_str(), newPath.c_str()) == 0;
+#endif
+    }
+
+    bool replaceFile(const string& from, const string& to) {
+#ifdef _WIN32
+        return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        return rename(from.c_str(), to.c_str()) == 0;
+#endif
+    }
+
+    vector<string> listFiles(const string& directory) {
+        vector<string> names;
+#ifdef _WIN32
+        WIN32_FIND_DATAA entry;
+        HANDLE handle = FindFirstFileA((directory + "*").c_str(), &entry);
+        if (handle == INVALID_HANDLE_VALUE) return names;
+        do {
+            if (!(entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+                names.push_back(entry.cFileName);
+            }
+        } while (FindNextFileA(handle, &entry));
+        FindClose(handle);
+#else
+        DIR* dir = opendir(directory.c_str());
+        if (dir == nullptr) return names;
+        while (dirent* entry = readdir(dir)) {
+            string name = entry->d_name;
+            struct stat info;
+            if (stat((directory + name).c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+                names.push_back(name);
+            }
+        }
+        closedir(dir);
+#endif
+        return names;
+    }
+}
+
+DocumentStore::DocumentStore(const string& imagesDir)
+    : imagesDirectory(imagesDir),
+    blobsDirectory(imagesDir + Config::DOCUMENT_BLOBS_DIRECTORY),
+    manifestFile(imagesDir + Config::DOCUMENT_MANIFEST_FILE),
+    loaded(false) {
+}
+
+string DocumentStore::getBlobPath(const string& hash) const {
+    return blobsDirectory + hash;
+}
+
+string DocumentStore::getDocumentPath(const string& applicationId, const string& documentType) const {
+    return imagesDirectory + applicationId + "_" + documentType + ".jpg";
+}
+
+string DocumentStore::getStagingPath(const string& applicationId, const string& documentType) {
+    lock_guard<recursive_mutex> lock(storeMutex);
+    ensureLoaded();
+    return blobsDirectory + ".staging_" + applicationId + "_" + documentType;
+}
+
+void DocumentStore::load() {
+    lock_guard<recursive_mutex> lock(storeMutex);
+    ensureLoaded();
+}
+
+void DocumentStore::ensureLoaded() {
+    if (loaded) return;
+    loaded = true;
+
+    makeDirectory(imagesDirectory.substr(0, imagesDirectory.length() - 1));
+    makeDirectory(blobsDirectory.substr(0, blobsDirectory.length() - 1));
+
+    ifstream check(manifestFile);
+    if (check.good()) {
+        check.close();
+        loadManifest();
+    }
+    else {
+        // First run with a store: fold the existing copies into blobs
+        int imported = importExistingImages();
+        saveManifest();
+        if (imported > 0) {
+            cout << " Document store initialised with " << imported << " existing images ("
+                << referenceCounts.size() << " unique)" << endl;
+        }
+    }
+}
+
+void DocumentStore::loadManifest() {
+    ifstream file(manifestFile);
+    string line;
+
+    // Skip header line
+    getline(file, line);
+
+    while (getline(file, line)) {
+        if (line.empty()) continue;
+
+        vector<string> parts = splitString(line, Config::DELIMITER);
+        if (parts.size() < 4) {
+            cerr << "Warning: Invalid manifest entry: " << line << endl;
+            continue;
+        }
+
+        StoredDocument document;
+        document.applicationId = parts[0];
+        document.documentType = parts[1];
+        document.hash = parts[2];
+        try {
+            document.size = stoll(parts[3]);
+        }
+        catch (...) {
+            document.size = getFileSize(getBlobPath(document.hash));
+        }
+
+        documents.push_back(document);
+        addToIndexes(document);
+    }
+}
+
+bool DocumentStore::saveManifest() const {
+    string tempFile = manifestFile + ".tmp";
+    ofstream file(tempFile, ios::trunc);
+    if (!file.is_open()) {
+        cerr << "Error: Could not write " << manifestFile << endl;
+        return false;
+    }
+
+    file << "ApplicationID#DocumentType#SHA256#Size\n";
+    for (const auto& document : documents) {
+        file << document.applicationId << Config::DELIMITER
+            << document.documentType << Config::DELIMITER
+            << document.hash << Config::DELIMITER
+            << document.size << '\n';
+    }
+    file.close();
+
+    if (file.fail() || !replaceFile(tempFile, manifestFile)) {
+        cerr << "Error: Could not replace " << manifestFile << endl;
+        return false;
+    }
+    return true;
+}
+
+void DocumentStore::addToIndexes(const StoredDocument& document) {
+    if (referenceCounts[document.hash]++ == 0) {
+        sizeCounts[document.size]++;
+    }
+}
+
+void DocumentStore::removeFromIndexes(const StoredDocument& document) {
+    auto it = referenceCounts.find(document.hash);
+    if (it == referenceCounts.end()) return;
+
+    if (--it->second == 0) {
+        referenceCounts.erase(it);
+        if (--sizeCounts[document.size] == 0) {
+            sizeCounts.erase(document.size);
+        }
+    }
+}
+
+int DocumentStore::findDocument(const string& applicationId, const string& documentType) const {
+    for (size_t i = 0; i < documents.size(); i++) {
+        if (documents[i].applicationId == applicationId &&
+            documents[i].documentType == documentType) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void DocumentStore::releaseDocument(size_t index) {
+    StoredDocument document = documents[index];
+    documents.erase(documents.begin() + index);
+    removeFromIndexes(document);
+
+    if (referenceCounts.find(document.hash) == referenceCounts.end()) {
+        remove(getBlobPath(document.hash).c_str());
+    }
+}
+
+bool DocumentStore::linkDocument(const string& blob, const string& documentPath, string& storedPath) const {
+    // Link under a temporary name first so an existing document is replaced atomically
+    string tempPath = documentPath + ".link";
+    remove(tempPath.c_str());
+
+    bool linked = createHardLink(blob, tempPath) && replaceFile(tempPath, documentPath);
+
+    // rename() leaves the temporary name behind when both already name the blob
+    remove(tempPath.c_str());
+
+    storedPath = linked ? documentPath : blob;
+    return linked;
+}
+
+int DocumentStore::importExistingImages() {
+    int imported = 0;
+
+    for (const auto& name : listFiles(imagesDirectory)) {
+        size_t separator = name.find('_');
+        size_t extension = name.rfind(".jpg");
+        if (separator == string::npos || extension == string::npos ||
+            extension + 4 != name.length() || separator >= extension) {
+            continue;
+        }
+
+        string path = imagesDirectory + name;
+        string hash = Sha256::hashFile(path);
+        if (hash.empty()) continue;
+
+        string blob = getBlobPath(hash);
+        if (referenceCounts.find(hash) == referenceCounts.end()) {
+            // First copy of this content becomes the blob itself
+            if (!createHardLink(path, blob)) {
+                struct stat info;
+                if (stat(blob.c_str(), &info) != 0) continue;
+            }
+        }
+        else {
+            string storedPath;
+            if (!linkDocument(blob, path, storedPath)) continue;
+        }
+
+        StoredDocument document;
+        document.applicationId = name.substr(0, separator);
+        document.documentType = name.substr(separator + 1, extension - separator - 1);
+        document.hash = hash;
+        document.size = getFileSize(path);
+
+        documents.push_back(document);
+        addToIndexes(document);
+        imported++;
+    }
+    return imported;
+}
+
+bool DocumentStore::hasBlobOfSize(long long size) {
+    lock_guard<recursive_mutex> lock(storeMutex);
+    ensureLoaded();
+    return sizeCounts.find(size) != sizeCounts.end();
+}
+
+bool DocumentStore::hasBlob(const string& hash) {
+    lock_guard<recursive_mutex> lock(storeMutex);
+    ensureLoaded();
+    return referenceCounts.find(hash) != referenceCounts.end();
+}
+
+int DocumentStore::getReferenceCount(const string& hash) {
+    lock_guard<recursive_mutex> lock(storeMutex);
+    ensureLoaded();
+    auto it = referenceCounts.find(hash);
+    return (it == referenceCounts.end()) ? 0 : it->second;
+}
+
+bool DocumentStore::addReference(const string& applicationId, const string& documentType,
+    const string& hash, long long size, string& storedPath) {
+    lock_guard<recursive_mutex> lock(storeMutex);
+    ensureLoaded();
+
+    int existing = findDocument(applicationId, documentType);
+    if (existing >= 0 && documents[existing].hash == hash) {
+        // Already recorded; where the link fails the blob path is the reference
+        linkDocument(getBlobPath(hash), getDocumentPath(applicationId, documentType), storedPath);
+        return true;
+    }
+
+    // Record the new reference before releasing the old one so a shared blob survives
+    StoredDocument document;
+    document.applicationId = applicationId;
+    document.documentType = documentType;
+    document.hash = hash;
+    document.size = size;
+    documents.push_back(document);
+    addToIndexes(document);
+
+    if (existing >= 0) {
+        releaseDocument(static_cast<size_t>(existing));
+    }
+
+    linkDocument(getBlobPath(hash), getDocumentPath(applicationId, documentType), storedPath);
+    return saveManifest();
+}
+
+bool DocumentStore::commitStaged(const string& stagedPath, const string& applicationId,
+    const string& documentType, const string& hash, long long size, string& storedPath) {
+    lock_guard<recursive_mutex> lock(storeMutex);
+    ensureLoaded();
+
+    if (hasBlob(hash)) {
+        // Same content already stored: keep the blob, drop the fresh copy
+        remove(stagedPath.c_str());
+    }
+    else if (!replaceFile(stagedPath, getBlobPath(hash))) {
+        cerr << "ERROR: Could not move " << stagedPath << " into the document store" << endl;
+        remove(stagedPath.c_str());
+        return false;
+    }
+
+    return addReference(applicationId, documentType, hash, size, storedPath);
+}
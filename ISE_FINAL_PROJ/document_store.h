@@ -0,0 +1,122 @@
+#ifndef DOCUMENT_STORE_H
+#define DOCUMENT_STORE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+using namespace std;
+
+/// <summary>
+/// One document of one application as recorded in the manifest
+/// </summary>
+struct StoredDocument {
+    string applicationId;
+    string documentType;    // cnic_front, cnic_back, electricity_bill, salary_slip
+    string hash;            // SHA-256 of the content
+    long long size;
+
+    StoredDocument() : size(0) {}
+};
+
+/// <summary>
+/// Content-addressed store for application documents
+/// SE Principles:
+/// - Single Responsibility: owns the images/ layout, blobs and manifest
+/// - Information Hiding: callers only see the per-application file name
+/// - Deduplication: identical uploads share one blob under images/blobs/
+/// - Thread Safety: all public operations are serialised by one mutex
+/// </summary>
+/// <remarks>
+/// Every distinct file is kept once as images/blobs/&lt;sha256&gt;. The familiar
+/// images/&lt;id&gt;_&lt;type&gt;.jpg names are hard links to the blob; if the file
+/// system cannot link, the blob path itself is used as the reference. The
+/// manifest (one appId#type#hash#size line per document) is the source of
+/// truth, and a blob's reference count is the number of lines naming it.
+/// </remarks>
+class DocumentStore {
+private:
+    string imagesDirectory;
+    string blobsDirectory;
+    string manifestFile;
+    bool loaded;
+    recursive_mutex storeMutex;     // Documents are stored from I/O worker threads
+
+    vector<StoredDocument> documents;
+    map<string, int> referenceCounts;       // hash -> manifest entries
+    map<long long, int> sizeCounts;         // size -> distinct blobs
+
+    void ensureLoaded();
+    void loadManifest();
+    bool saveManifest() const;
+    void addToIndexes(const StoredDocument& document);
+    void removeFromIndexes(const StoredDocument& document);
+
+    /// <summary>
+    /// Moves existing images/&lt;id&gt;_&lt;type&gt;.jpg files into the blob store
+    /// </summary>
+    /// <returns>Number of files imported</returns>
+    int importExistingImages();
+
+    /// <summary>
+    /// Points the per-application name at a blob
+    /// </summary>
+    /// <param name="storedPath">Output: document path, or the blob path if linking failed</param>
+    /// <returns>True if a hard link was created</returns>
+    bool linkDocument(const string& blob, const string& documentPath, string& storedPath) const;
+    int findDocument(const string& applicationId, const string& documentType) const;
+
+    /// <summary>
+    /// Drops one manifest entry, deleting the blob when nothing references it
+    /// </summary>
+    void releaseDocument(size_t index);
+
+public:
+    /// <summary>
+    /// Creates a store rooted at the images directory
+    /// </summary>
+    /// <param name="imagesDir">Images directory (with trailing slash)</param>
+    DocumentStore(const string& imagesDir = "images/");
+
+    /// <summary>
+    /// Reads the manifest (importing existing images on first run); idempotent
+    /// </summary>
+    void load();
+
+    string getBlobPath(const string& hash) const;
+    string getDocumentPath(const string& applicationId, const string& documentType) const;
+
+    /// <summary>
+    /// Path where a new upload should be copied before commitStaged()
+    /// </summary>
+    string getStagingPath(const string& applicationId, const string& documentType);
+
+    /// <summary>
+    /// Cheap pre-check: a file can only be a duplicate if a blob has its size
+    /// </summary>
+    bool hasBlobOfSize(long long size);
+
+    bool hasBlob(const string& hash);
+
+    /// <summary>
+    /// References an existing blob for an application document (no copy)
+    /// </summary>
+    /// <param name="storedPath">Output: path to record in the application</param>
+    /// <returns>True if the document is recorded in the manifest (linked, or by its blob path)</returns>
+    bool addReference(const string& applicationId, const string& documentType,
+        const string& hash, long long size, string& storedPath);
+
+    /// <summary>
+    /// Turns a staged copy into a blob (or drops it if the blob already exists)
+    /// and records it for the application
+    /// </summary>
+    /// <param name="stagedPath">File previously copied to getStagingPath()</param>
+    /// <param name="storedPath">Output: path to record in the application</param>
+    /// <returns>True if the document was stored</returns>
+    bool commitStaged(const string& stagedPath, const string& applicationId,
+        const string& documentType, const string& hash, long long size, string& storedPath);
+
+    int getReferenceCount(const string& hash);
+};
+
+#endif
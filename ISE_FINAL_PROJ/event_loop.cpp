@@ -0,0 +1,164 @@
+#include "event_loop.h"
+#include <iostream>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#include <poll.h>
+#endif
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+using namespace std;
+
+namespace {
+    const int MAX_EVENTS_PER_WAIT = 256;
+}
+
+#ifdef __linux__
+
+namespace {
+    uint32_t toEpollEvents(uint8_t interest) {
+        uint32_t events = 0;
+        if (interest & EventLoop::WATCH_READ) events |= EPOLLIN;
+        if (interest & EventLoop::WATCH_WRITE) events |= EPOLLOUT;
+        return events;
+    }
+}
+
+EventLoop::EventLoop() : epollFd(epoll_create1(EPOLL_CLOEXEC)) {
+    if (epollFd < 0) {
+        cerr << "Error: Could not create epoll instance" << endl;
+    }
+}
+
+EventLoop::~EventLoop() {
+    if (epollFd >= 0) close(epollFd);
+}
+
+bool EventLoop::add(SocketHandle handle, uint8_t interest) {
+    epoll_event event = {};
+    event.events = toEpollEvents(interest);
+    event.data.fd = handle;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, handle, &event) != 0) return false;
+
+    interests[handle] = interest;
+    return true;
+}
+
+bool EventLoop::modify(SocketHandle handle, uint8_t interest) {
+    auto found = interests.find(handle);
+    if (found == interests.end()) return false;
+    if (found->second == interest) return true;
+
+    epoll_event event = {};
+    event.events = toEpollEvents(interest);
+    event.data.fd = handle;
+    if (epoll_ctl(epollFd, EPOLL_CTL_MOD, handle, &event) != 0) return false;
+
+    found->second = interest;
+    return true;
+}
+
+void EventLoop::remove(SocketHandle handle) {
+    if (interests.erase(handle) > 0) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, handle, nullptr);
+    }
+}
+
+bool EventLoop::wait(vector<Event>& events, int timeoutMs) {
+    events.clear();
+
+    epoll_event ready[MAX_EVENTS_PER_WAIT];
+    int count = epoll_wait(epollFd, ready, MAX_EVENTS_PER_WAIT, timeoutMs);
+    if (count < 0) {
+        return errno == EINTR;
+    }
+
+    for (int i = 0; i < count; i++) {
+        Event event;
+        event.handle = ready[i].data.fd;
+        event.readable = (ready[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0;
+        event.writable = (ready[i].events & EPOLLOUT) != 0;
+        events.push_back(event);
+    }
+    return true;
+}
+
+#else
+
+EventLoop::EventLoop() {
+}
+
+EventLoop::~EventLoop() {
+}
+
+bool EventLoop::add(SocketHandle handle, uint8_t interest) {
+    interests[handle] = interest;
+    return true;
+}
+
+bool EventLoop::modify(SocketHandle handle, uint8_t interest) {
+    auto found = interests.find(handle);
+    if (found == interests.end()) return false;
+    found->second = interest;
+    return true;
+}
+
+void EventLoop::remove(SocketHandle handle) {
+    interests.erase(handle);
+}
+
+bool EventLoop::wait(vector<Event>& events, int timeoutMs) {
+    events.clear();
+
+    // poll() takes the whole set each time; fine for the client counts of a local server
+#ifdef _WIN32
+    vector<WSAPOLLFD> watched;
+#else
+    vector<pollfd> watched;
+#endif
+    watched.reserve(interests.size());
+    for (const auto& entry : interests) {
+#ifdef _WIN32
+        WSAPOLLFD item = {};
+        item.fd = static_cast<SOCKET>(entry.first);
+#else
+        pollfd item = {};
+        item.fd = entry.first;
+#endif
+        if (entry.second & WATCH_READ) item.events |= POLLIN;
+        if (entry.second & WATCH_WRITE) item.events |= POLLOUT;
+        watched.push_back(item);
+    }
+
+#ifdef _WIN32
+    int count = WSAPoll(watched.data(), static_cast<ULONG>(watched.size()), timeoutMs);
+    if (count < 0) return false;
+#else
+    int count = poll(watched.data(), watched.size(), timeoutMs);
+    if (count < 0) return errno == EINTR;
+#endif
+
+    for (const auto& item : watched) {
+        if (item.revents == 0) continue;
+
+        Event event;
+        event.handle = static_cast<SocketHandle>(item.fd);
+        event.readable = (item.revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+        event.writable = (item.revents & POLLOUT) != 0;
+        events.push_back(event);
+        if (static_cast<int>(events.size()) == MAX_EVENTS_PER_WAIT) break;
+    }
+    return true;
+}
+
+#endif
+
+size_t EventLoop::getWatchedCount() const {
+    return interests.size();
+}
@@ -0,0 +1,67 @@
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <vector>
+#include <unordered_map>
+#include "network_utils.h"
+using namespace std;
+
+/// <summary>
+/// Readiness notification for a set of sockets (and, on POSIX, other descriptors
+/// such as stdin). Uses epoll on Linux and poll()/WSAPoll elsewhere; both are
+/// level-triggered, so a handle keeps being reported until it is drained.
+/// SE Principles:
+/// - Information Hiding: the server never sees which OS mechanism is used
+/// - Single Responsibility: only reports readiness, reading and writing stay with the caller
+/// </summary>
+class EventLoop {
+public:
+    enum Interest : uint8_t { WATCH_READ = 1, WATCH_WRITE = 2 };
+
+    struct Event {
+        SocketHandle handle;
+        bool readable;      // Also set on hang-up/error so the next read reports it
+        bool writable;
+    };
+
+private:
+    unordered_map<SocketHandle, uint8_t> interests;
+#ifdef __linux__
+    int epollFd;
+#endif
+
+public:
+    EventLoop();
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    /// <summary>
+    /// Starts watching a handle
+    /// </summary>
+    /// <returns>False if the handle cannot be watched (e.g. a regular file under epoll)</returns>
+    bool add(SocketHandle handle, uint8_t interest);
+
+    /// <summary>
+    /// Changes what a watched handle is reported for
+    /// </summary>
+    bool modify(SocketHandle handle, uint8_t interest);
+
+    /// <summary>
+    /// Stops watching a handle (call before closing it)
+    /// </summary>
+    void remove(SocketHandle handle);
+
+    /// <summary>
+    /// Waits until at least one handle is ready
+    /// </summary>
+    /// <param name="events">Output: ready handles (cleared first)</param>
+    /// <param name="timeoutMs">-1 waits indefinitely</param>
+    /// <returns>False if the wait itself failed</returns>
+    bool wait(vector<Event>& events, int timeoutMs);
+
+    size_t getWatchedCount() const;
+};
+
+#endif
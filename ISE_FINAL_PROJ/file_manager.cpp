@@ -1,41 +1,219 @@
 ﻿#include "file_manager.h"
 #include "utilities.h"
+#include "sha256.h"
+#include "thread_pool.h"
+#include "network_utils.h"
+#include "text_scanner.h"
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdio>
+#include <cerrno>
+#include <stdexcept>
+#include <algorithm>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
+#include <linux/fs.h>
+#endif
 
 using namespace std;
 
+/// <summary>
+/// Small pool shared by all FileManager instances for document copies
+/// </summary>
+static ThreadPool& documentCopyPool() {
+    static ThreadPool pool(Config::DOCUMENT_COPY_THREADS);
+    return pool;
+}
+
+/// <summary>
+/// Pool shared by all FileManager instances for reading month partitions
+/// </summary>
+static ThreadPool& partitionScanPool() {
+    static ThreadPool pool(Config::PARTITION_SCAN_THREADS > 0 ?
+        Config::PARTITION_SCAN_THREADS : static_cast<int>(thread::hardware_concurrency()));
+    return pool;
+}
+
+/// <summary>
+/// True for the format header line at the top of applications.txt
+/// </summary>
+static bool isFormatHeader(const string& line) {
+    int version = 0;
+    return RecordSchema::parseHeaderLine(line, version);
+}
+
+/// <summary>
+/// True if a record line has the fields every loader requires
+/// (ID, status, date and completed sections)
+/// </summary>
+static bool hasRequiredFields(const string& line) {
+    size_t position = 0;
+    for (int i = 0; i < 3; i++) {
+        position = line.find(Config::DELIMITER, position);
+        if (position == string::npos) return false;
+        position++;
+    }
+    return true;
+}
+
+/// <summary>
+/// Applications parsed from one newline-aligned slice of a data file
+/// Problems are kept with their line number within the slice and printed
+/// once the slices before it have been counted.
+/// </summary>
+struct ParsedChunk {
+    struct Problem {
+        int line;
+        string before;      // Printed as before + file line number + after
+        string after;
+    };
+
+    vector<LoanApplication> applications;
+    vector<Problem> problems;
+    int lineCount = 0;
+};
+
+/// <summary>
+/// The application ID or CNIC field of a record line (empty if it has none)
+/// Only the delimiters up to the field are looked at; the line is not split.
+/// </summary>
+static string recordKey(const string& line, IndexKey key) {
+    int field = RecordSchema::current().position(
+        key == IndexKey::APPLICATION_ID ? RecordField::APPLICATION_ID : RecordField::CNIC_NUMBER);
+
+    size_t start = 0;
+    for (int i = 0; i < field; i++) {
+        start = line.find(Config::DELIMITER, start);
+        if (start == string::npos) return string();
+        start++;
+    }
+    size_t end = line.find(Config::DELIMITER, start);
+    return trim(line.substr(start, end == string::npos ? string::npos : end - start));
+}
+
+/// <summary>
+/// Numeric value of an application ID, as generateApplicationId counts them
+/// </summary>
+static bool parseApplicationNumber(const string& applicationId, long long& number) {
+    try {
+        number = stoi(applicationId);
+        return true;
+    }
+    catch (...) {
+        return false; // Ignore non-numeric IDs
+    }
+}
+
+/// <summary>
+/// True for a record the lender has approved or rejected
+/// </summary>
+static bool isDecidedRecord(const string& line) {
+    size_t start = line.find(Config::DELIMITER);
+    if (start == string::npos) return false;
+    size_t end = line.find(Config::DELIMITER, start + 1);
+
+    ApplicationStatus status;
+    return tryParseStatus(line.substr(start + 1, end == string::npos ? string::npos : end - start - 1), status) &&
+        isDecidedStatus(status);
+}
+
+/// <summary>
+/// Removes the decided records from lines and returns them
+/// </summary>
+static vector<string> takeDecidedRecords(vector<string>& lines) {
+    vector<string> decided;
+    vector<string> pending;
+    for (auto& line : lines) {
+        if (isDecidedRecord(line)) decided.push_back(move(line));
+        else pending.push_back(move(line));
+    }
+    lines.swap(pending);
+    return decided;
+}
+
+/// <summary>
+/// Manifest entry for a segment holding these record lines
+/// </summary>
+static PartitionInfo summarizeSegment(const string& month, const vector<string>& lines) {
+    PartitionInfo partition = { month, lines.size(), 0 };
+    for (const auto& line : lines) {
+        long long number = 0;
+        if (parseApplicationNumber(recordKey(line, IndexKey::APPLICATION_ID), number) &&
+            number > partition.highestId) {
+            partition.highestId = number;
+        }
+    }
+    return partition;
+}
+
+thread_local uint64_t FileManager::lastLoggedSequence = 0;
+thread_local bool FileManager::durabilityDeferred = false;
+
 FileManager::FileManager(const string& appsFile, const string& imagesDir)
-    : applicationsFile(appsFile), imagesDirectory(imagesDir) {
+    : applicationsFile(appsFile), imagesDirectory(imagesDir), documentStore(imagesDir), journalWarned(false),
+    headFile(new IndexedFile(appsFile)), partitions(appsFile), legacyRecords(false) {
+    // Looked at before recovery rewrites the file, which keeps it in its format
+    legacyRecords = hasLegacyRecords();
+
+    // The last writer crashed: repair applications.txt before anything reads it,
+    // then let go of the log so whichever process writes next can take it
+    if (WriteAheadLog::hasRecords(applicationsFile) && openJournal()) {
+        journal.reset();
+    }
+
+    // A move between applications.txt and the archive was interrupted: finish it
+    if (partitions.isMoving() && archiveDecidedApplications()) {
+        journal.reset();
+    }
+
+    // Written by a version before the format header: rewrite it once, so
+    // records are read with one layout from then on
+    if (legacyRecords && migrateRecordFormat()) {
+        journal.reset();
+    }
 }
 
-string FileManager::generateApplicationId() const {
-    static int counter = 1001;
+FileManager::~FileManager() {
+}
 
-    ifstream file(applicationsFile);
-    string line;
-    int maxId = 1000;
+string FileManager::generateApplicationId() const {
+    long long maxId = 1000;
+
+    // The index remembers the highest ID it covers and the manifest each
+    // partition's; only records newer than both are read
+    uint64_t unindexed = 0;
+    uint64_t fileBytes = 0;
+    {
+        lock_guard<mutex> lock(storeMutex);
+        partitions.refresh();
+        for (const auto& partition : partitions.getPartitions()) {
+            maxId = max(maxId, partition.highestId);
+        }
+        if (prepareIndex(*headFile, fileBytes)) {
+            maxId = max(maxId, headFile->index.getHighestId());
+            unindexed = headFile->index.getCoveredBytes();
+        }
+    }
 
-    while (getline(file, line)) {
-        if (!line.empty()) {
-            vector<string> parts = splitString(line, Config::DELIMITER);
-            if (!parts.empty()) {
-                try {
-                    int currentId = stoi(parts[0]);
-                    if (currentId > maxId) {
-                        maxId = currentId;
-                    }
-                }
-                catch (...) {
-                    // Ignore non-numeric IDs
-                }
+    if (unindexed == 0 || unindexed < fileBytes) {
+        scanRecordLines(applicationsFile, unindexed, [&](string& line) {
+            long long currentId = 0;
+            if (parseApplicationNumber(recordKey(line, IndexKey::APPLICATION_ID), currentId) && currentId > maxId) {
+                maxId = currentId;
             }
-        }
+        });
     }
-    file.close();
 
     stringstream ss;
     ss << setw(4) << setfill('0') << (maxId + 1);
@@ -47,54 +225,191 @@ bool FileManager::fileExists(const string& filename) const {
     return file.good();
 }
 
-bool FileManager::copyImageFile(const string& sourcePath, const string& destinationPath) const {
-    // Validate source file exists and is not empty
-    ifstream sourceCheck(sourcePath, ios::binary | ios::ate);
-    if (!sourceCheck.is_open()) {
-        cerr << "ERROR: Cannot open source file: " << sourcePath << endl;
+bool FileManager::copyImageFile(const string& sourcePath, const string& destinationPath,
+    string& checksum, string& message) const {
+    // Prevent circular copying (source == destination)
+    if (sourcePath == destinationPath) {
+        message = "ERROR: Source and destination are the same: " + sourcePath;
+        return false;
+    }
+
+#ifdef __linux__
+    int source = open(sourcePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (source < 0) {
+        message = "ERROR: Cannot open source file: " + sourcePath;
         return false;
     }
 
-    streamsize sourceSize = sourceCheck.tellg();
-    sourceCheck.close();
+    struct stat sourceInfo;
+    if (fstat(source, &sourceInfo) != 0 || !S_ISREG(sourceInfo.st_mode)) {
+        message = "ERROR: Source is not a regular file: " + sourcePath;
+        close(source);
+        return false;
+    }
 
+    off_t sourceSize = sourceInfo.st_size;
     if (sourceSize == 0) {
-        cerr << "ERROR: Source file is empty: " << sourcePath << endl;
+        message = "ERROR: Source file is empty: " + sourcePath;
+        close(source);
         return false;
     }
 
-    // Prevent circular copying (source == destination)
-    if (sourcePath == destinationPath) {
-        cerr << "ERROR: Source and destination are the same: " << sourcePath << endl;
+    // Documents are readable by the store's owner only
+    int destination = open(destinationPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (destination < 0) {
+        message = "ERROR: Failed to create destination: " + destinationPath;
+        close(source);
         return false;
     }
 
-    // Open source file for reading
-    ifstream source(sourcePath, ios::binary);
+    // The mapping feeds the checksum (and the write() fallback) without extra reads
+    void* mapped = mmap(nullptr, static_cast<size_t>(sourceSize), PROT_READ, MAP_PRIVATE, source, 0);
+    if (mapped == MAP_FAILED) {
+        mapped = nullptr;
+    }
+    else {
+        madvise(mapped, static_cast<size_t>(sourceSize), MADV_SEQUENTIAL);
+    }
+    const char* sourceData = static_cast<const char*>(mapped);
+
+    Sha256 hasher;
+    off_t totalCopied = 0;
+    bool failed = false;
+
+#ifdef FICLONE
+    // Reflink: the file system shares extents, no data is copied at all
+    if (ioctl(destination, FICLONE, source) == 0) {
+        totalCopied = sourceSize;
+    }
+#endif
+
+    enum CopyMethod { COPY_FILE_RANGE, SEND_FILE, READ_WRITE };
+    CopyMethod method = COPY_FILE_RANGE;
+    char buffer[65536];
+
+    if (totalCopied == 0) {
+        while (totalCopied < sourceSize) {
+            size_t chunk = static_cast<size_t>(sourceSize - totalCopied);
+            if (chunk > Config::DOCUMENT_COPY_CHUNK) chunk = Config::DOCUMENT_COPY_CHUNK;
+
+            ssize_t copied = -1;
+            if (method == COPY_FILE_RANGE) {
+                loff_t inOffset = totalCopied;
+                copied = copy_file_range(source, &inOffset, destination, nullptr, chunk, 0);
+                if (copied < 0 && errno != EINTR && totalCopied == 0) {
+                    method = SEND_FILE;     // Not supported here (old kernel, cross-device...)
+                    continue;
+                }
+            }
+            else if (method == SEND_FILE) {
+                off_t inOffset = totalCopied;
+                copied = sendfile(destination, source, &inOffset, chunk);
+                if (copied < 0 && errno != EINTR && totalCopied == 0) {
+                    method = READ_WRITE;
+                    continue;
+                }
+            }
+            else if (sourceData != nullptr) {
+                copied = write(destination, sourceData + totalCopied, chunk);
+            }
+            else {
+                // A short write leaves the rest to be read again next time round,
+                // so nothing is hashed here (see below)
+                if (chunk > sizeof(buffer)) chunk = sizeof(buffer);
+                copied = pread(source, buffer, chunk, totalCopied);
+                if (copied > 0) {
+                    copied = write(destination, buffer, static_cast<size_t>(copied));
+                }
+            }
+
+            if (copied < 0 && errno == EINTR) continue;
+            if (copied <= 0) {
+                message = "ERROR: Write failed at byte " + to_string(static_cast<long long>(totalCopied));
+                failed = true;
+                break;
+            }
+
+            // Hash the bytes just written while their pages are hot
+            if (sourceData != nullptr) {
+                hasher.update(sourceData + totalCopied, static_cast<size_t>(copied));
+            }
+            totalCopied += copied;
+        }
+    }
+    else if (sourceData != nullptr) {
+        hasher.update(sourceData, static_cast<size_t>(sourceSize));
+    }
+
+    if (!failed && sourceData == nullptr) {
+        // Not mappable: whichever way it was copied, hash the source with plain reads
+        for (off_t offset = 0; offset < sourceSize && !failed; ) {
+            ssize_t bytesRead = pread(source, buffer, sizeof(buffer), offset);
+            if (bytesRead < 0 && errno == EINTR) continue;
+            if (bytesRead <= 0) {
+                message = "ERROR: Read failed at byte " + to_string(static_cast<long long>(offset));
+                failed = true;
+                break;
+            }
+            hasher.update(buffer, static_cast<size_t>(bytesRead));
+            offset += bytesRead;
+        }
+    }
+
+    // Verify on the descriptor we already hold
+    struct stat destinationInfo;
+    off_t destSize = -1;
+    if (!failed && fstat(destination, &destinationInfo) == 0) {
+        destSize = destinationInfo.st_size;
+    }
+
+    if (mapped != nullptr) {
+        munmap(mapped, static_cast<size_t>(sourceSize));
+    }
+    close(source);
+    if (close(destination) != 0) {
+        failed = true;
+    }
+
+    if (failed) {
+        return false;
+    }
+#else
+    // Open source file once: size, copy and checksum all use this stream
+    ifstream source(sourcePath, ios::binary | ios::ate);
     if (!source.is_open()) {
-        cerr << "ERROR: Failed to open source for reading: " << sourcePath << endl;
+        message = "ERROR: Cannot open source file: " + sourcePath;
+        return false;
+    }
+
+    streamsize sourceSize = source.tellg();
+    source.seekg(0, ios::beg);
+
+    if (sourceSize == 0) {
+        message = "ERROR: Source file is empty: " + sourcePath;
         return false;
     }
 
     // Open destination file for writing
     ofstream destination(destinationPath, ios::binary | ios::trunc);
     if (!destination.is_open()) {
-        cerr << "ERROR: Failed to create destination: " << destinationPath << endl;
+        message = "ERROR: Failed to create destination: " + destinationPath;
         source.close();
         return false;
     }
 
-    // Copy file in chunks
-    const size_t bufferSize = 8192;
-    char buffer[bufferSize];
+    // Copy file in chunks, hashing each chunk as it passes through
+    Sha256 hasher;
+    const size_t bufferSize = 65536;
+    vector<char> buffer(bufferSize);
     streamsize totalCopied = 0;
 
-    while (source.read(buffer, bufferSize) || source.gcount() > 0) {
+    while (source.read(buffer.data(), bufferSize) || source.gcount() > 0) {
         streamsize bytesRead = source.gcount();
-        destination.write(buffer, bytesRead);
+        hasher.update(buffer.data(), static_cast<size_t>(bytesRead));
+        destination.write(buffer.data(), bytesRead);
 
         if (destination.fail()) {
-            cerr << "ERROR: Write failed at byte " << totalCopied << endl;
+            message = "ERROR: Write failed at byte " + to_string(static_cast<long long>(totalCopied));
             source.close();
             destination.close();
             return false;
@@ -103,31 +418,182 @@ bool FileManager::copyImageFile(const string& sourcePath, const string& destinat
         totalCopied += bytesRead;
     }
 
-    // Close files
+    // Verify the copy through the open stream
+    destination.flush();
+    streamsize destSize = destination.tellp();
+
     source.close();
     destination.close();
+    if (destination.fail()) {
+        message = "ERROR: Cannot verify destination file";
+        return false;
+    }
+#endif
 
-    // Verify the copy
-    ifstream verifyDest(destinationPath, ios::binary | ios::ate);
-    if (!verifyDest.is_open()) {
-        cerr << "ERROR: Cannot verify destination file" << endl;
+    if (destSize != sourceSize) {
+        message = "ERROR: File size mismatch. Source: " + to_string(static_cast<long long>(sourceSize)) +
+            " bytes, Destination: " + to_string(static_cast<long long>(destSize)) + " bytes";
         return false;
     }
 
-    streamsize destSize = verifyDest.tellg();
-    verifyDest.close();
+    checksum = hasher.finalHex();
+    message = " Image copied successfully: " + destinationPath +
+        " (" + to_string(static_cast<long long>(destSize)) + " bytes)";
+    return true;
+}
 
-    if (destSize != sourceSize) {
-        cerr << "ERROR: File size mismatch. Source: " << sourceSize
-            << " bytes, Destination: " << destSize << " bytes" << endl;
+bool FileManager::storeDocument(const string& applicationId, const string& documentType,
+    const string& sourcePath, string& storedPath, string& message) {
+    struct stat sourceInfo;
+    if (stat(sourcePath.c_str(), &sourceInfo) != 0) {
+        message = "ERROR: Cannot open source file: " + sourcePath;
+        return false;
+    }
+    long long sourceSize = static_cast<long long>(sourceInfo.st_size);
+
+    // Only hash up front when a blob of the same size exists; otherwise it must be new
+    string hash;
+    if (documentStore.hasBlobOfSize(sourceSize)) {
+        hash = Sha256::hashFile(sourcePath);
+        if (!hash.empty() && documentStore.hasBlob(hash)) {
+            if (!documentStore.addReference(applicationId, documentType, hash, sourceSize, storedPath)) {
+                message = "ERROR: Could not record " + sourcePath + " in the document store";
+                return false;
+            }
+            message = " Document already on file, linked: " + storedPath;
+            return true;
+        }
+    }
+
+    // The checksum is computed by the copy itself, so new files are read once
+    string stagedPath = documentStore.getStagingPath(applicationId, documentType);
+    if (!copyImageFile(sourcePath, stagedPath, hash, message)) {
+        remove(stagedPath.c_str());
+        return false;
+    }
+
+    if (!documentStore.commitStaged(stagedPath, applicationId, documentType,
+        hash, sourceSize, storedPath)) {
+        message = "ERROR: Could not add " + sourcePath + " to the document store";
+        return false;
+    }
+    return true;
+}
+
+bool FileManager::storeUploadedDocument(const string& applicationId, const string& documentType,
+    const string& content, string& storedPath, string& message) {
+    if (content.empty()) {
+        message = "ERROR: Uploaded " + documentType + " is empty";
+        return false;
+    }
+
+    // Always staged and committed: whether the content was already on file is
+    // not the uploader's business, and commitStaged drops a duplicate copy
+    string stagedPath = documentStore.getStagingPath(applicationId, documentType);
+    bool written = false;
+#ifdef __linux__
+    int staged = open(stagedPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (staged >= 0) {
+        size_t offset = 0;
+        while (offset < content.size()) {
+            ssize_t count = write(staged, content.data() + offset, content.size() - offset);
+            if (count < 0 && errno == EINTR) continue;
+            if (count <= 0) break;
+            offset += static_cast<size_t>(count);
+        }
+        written = (close(staged) == 0) && offset == content.size();
+    }
+#else
+    ofstream staged(stagedPath, ios::binary | ios::trunc);
+    if (staged.is_open()) {
+        staged.write(content.data(), static_cast<streamsize>(content.size()));
+        staged.close();
+        written = !staged.fail();
+    }
+#endif
+    if (!written) {
+        remove(stagedPath.c_str());
+        message = "ERROR: Could not store the uploaded " + documentType;
+        return false;
+    }
+
+    Sha256 hasher;
+    hasher.update(content.data(), content.size());
+    if (!documentStore.commitStaged(stagedPath, applicationId, documentType, hasher.finalHex(),
+        static_cast<long long>(content.size()), storedPath)) {
+        message = "ERROR: Could not add the uploaded " + documentType + " to the document store";
         return false;
     }
 
-    cout << " Image copied successfully: " << destinationPath
-        << " (" << destSize << " bytes)" << endl;
+    message = " Document stored: " + storedPath;
     return true;
 }
 
+bool FileManager::needsDocumentCopy(const string& path) const {
+    return !path.empty() && path.find(imagesDirectory) == string::npos &&
+        path.compare(0, Config::DOCUMENT_COPY_FAILED_PREFIX.length(), Config::DOCUMENT_COPY_FAILED_PREFIX) != 0;
+}
+
+void FileManager::storeApplicationDocuments(LoanApplication& application) {
+    string appId = application.getApplicationId();
+
+    // One job per document; copies run concurrently on the I/O pool
+    struct DocumentJob {
+        string documentType;
+        string sourcePath;
+        void (LoanApplication::*setPath)(string);
+        string storedPath;
+        string message;
+        bool success;
+        future<bool> done;
+    };
+
+    DocumentJob jobs[] = {
+        { "cnic_front", application.getCnicFrontImagePath(), &LoanApplication::setCnicFrontImagePath, "", "", false, future<bool>() },
+        { "cnic_back", application.getCnicBackImagePath(), &LoanApplication::setCnicBackImagePath, "", "", false, future<bool>() },
+        { "electricity_bill", application.getElectricityBillImagePath(), &LoanApplication::setElectricityBillImagePath, "", "", false, future<bool>() },
+        { "salary_slip", application.getSalarySlipImagePath(), &LoanApplication::setSalarySlipImagePath, "", "", false, future<bool>() }
+    };
+
+    // Load the store up front so workers never trigger the first-run import
+    documentStore.load();
+
+    for (auto& job : jobs) {
+        // Check if images need copying (not already in images directory)
+        if (!needsDocumentCopy(job.sourcePath)) {
+            continue;
+        }
+
+        DocumentJob* current = &job;
+        job.done = documentCopyPool().submit([this, appId, current]() {
+            return storeDocument(appId, current->documentType, current->sourcePath,
+                current->storedPath, current->message);
+        });
+    }
+
+    // The record is only written once every copy has finished or failed
+    for (auto& job : jobs) {
+        if (!job.done.valid()) continue;
+
+        try {
+            job.success = job.done.get();
+        }
+        catch (const exception& e) {
+            job.success = false;
+            job.message = string("ERROR: ") + e.what();
+        }
+
+        if (job.success) {
+            (application.*job.setPath)(move(job.storedPath));
+            cout << job.message << endl;
+        }
+        else {
+            (application.*job.setPath)(Config::DOCUMENT_COPY_FAILED_PREFIX + job.sourcePath);
+            cerr << job.message << endl;
+        }
+    }
+}
+
 bool FileManager::saveApplication(LoanApplication& application) {
     cout << "DEBUG: saveApplication called for: " << application.getFullName()
         << " | Loan Type: " << application.getLoanType() << endl;
@@ -157,125 +623,25 @@ bool FileManager::saveApplication(LoanApplication& application) {
             application.setSubmissionDate(currentDate);
         }
 
-        // Get source paths
-        string sourceCnicFront = application.getCnicFrontImagePath();
-        string sourceCnicBack = application.getCnicBackImagePath();
-        string sourceElectricityBill = application.getElectricityBillImagePath();
-        string sourceSalarySlip = application.getSalarySlipImagePath();
-
-        // Check if images need copying (not already in images directory)
-        bool cnicFrontNeedsCopy = (sourceCnicFront.find(imagesDirectory) == string::npos);
-        bool cnicBackNeedsCopy = (sourceCnicBack.find(imagesDirectory) == string::npos);
-        bool electricityBillNeedsCopy = (sourceElectricityBill.find(imagesDirectory) == string::npos);
-        bool salarySlipNeedsCopy = (sourceSalarySlip.find(imagesDirectory) == string::npos);
-
-        // Copy CNIC Front
-        if (cnicFrontNeedsCopy) {
-            string newCnicFrontPath = imagesDirectory + appId + "_cnic_front.jpg";
-            if (copyImageFile(sourceCnicFront, newCnicFrontPath)) {
-                application.setCnicFrontImagePath(newCnicFrontPath);
-            }
-            else {
-                application.setCnicFrontImagePath("COPY_FAILED: " + sourceCnicFront);
-            }
-        }
+        storeApplicationDocuments(application);
 
-        // Copy CNIC Back
-        if (cnicBackNeedsCopy) {
-            string newCnicBackPath = imagesDirectory + appId + "_cnic_back.jpg";
-            if (copyImageFile(sourceCnicBack, newCnicBackPath)) {
-                application.setCnicBackImagePath(newCnicBackPath);
-            }
-            else {
-                application.setCnicBackImagePath("COPY_FAILED: " + sourceCnicBack);
-            }
-        }
+        // Format the record, journal it, then append it to the file
+        string record = applicationToFileFormat(application);
 
-        // Copy Electricity Bill
-        if (electricityBillNeedsCopy) {
-            string newElectricityBillPath = imagesDirectory + appId + "_electricity_bill.jpg";
-            if (copyImageFile(sourceElectricityBill, newElectricityBillPath)) {
-                application.setElectricityBillImagePath(newElectricityBillPath);
-            }
-            else {
-                application.setElectricityBillImagePath("COPY_FAILED: " + sourceElectricityBill);
-            }
-        }
+        MessageWriter change;
+        change.writeString(record);
+        uint64_t sequence = logChange(LogRecordType::APPEND_RECORD, change.data());
 
-        // Copy Salary Slip
-        if (salarySlipNeedsCopy) {
-            string newSalarySlipPath = imagesDirectory + appId + "_salary_slip.jpg";
-            if (copyImageFile(sourceSalarySlip, newSalarySlipPath)) {
-                application.setSalarySlipImagePath(newSalarySlipPath);
-            }
-            else {
-                application.setSalarySlipImagePath("COPY_FAILED: " + sourceSalarySlip);
-            }
+        // A new file starts with the format header
+        if (file.tellp() == 0 && !legacyRecords) {
+            file << RecordSchema::headerLine() << '\n';
         }
-
-        // Write application data to file
-        file << application.getApplicationId() << Config::DELIMITER
-            << application.getStatus() << Config::DELIMITER
-            << application.getSubmissionDate() << Config::DELIMITER
-            << application.getFullName() << Config::DELIMITER
-            << application.getFathersName() << Config::DELIMITER
-            << application.getPostalAddress() << Config::DELIMITER
-            << application.getContactNumber() << Config::DELIMITER
-            << application.getEmailAddress() << Config::DELIMITER
-            << application.getCnicNumber() << Config::DELIMITER
-            << application.getCnicExpiryDate() << Config::DELIMITER
-            << application.getEmploymentStatus() << Config::DELIMITER
-            << application.getMaritalStatus() << Config::DELIMITER
-            << application.getGender() << Config::DELIMITER
-            << application.getNumberOfDependents() << Config::DELIMITER
-            << application.getAnnualIncome() << Config::DELIMITER
-            << application.getAvgElectricityBill() << Config::DELIMITER
-            << application.getCurrentElectricityBill() << Config::DELIMITER
-            << application.getLoanType() << Config::DELIMITER
-            << application.getLoanCategory() << Config::DELIMITER
-            << application.getLoanAmount() << Config::DELIMITER
-            << application.getDownPayment() << Config::DELIMITER
-            << application.getInstallmentMonths() << Config::DELIMITER
-            << application.getMonthlyPayment() << Config::DELIMITER
-            << application.getInstallmentStartMonth() << Config::DELIMITER
-            << application.getInstallmentStartYear() << Config::DELIMITER
-            << application.getRejectionReason() << Config::DELIMITER;
-
-        // Existing loans
-        vector<ExistingLoan> existingLoans = application.getExistingLoans();
-        file << existingLoans.size() << Config::DELIMITER;
-        for (size_t i = 0; i < existingLoans.size(); i++) {
-            const auto& loan = existingLoans[i];
-            file << loan.isActive << Config::DELIMITER
-                << loan.totalAmount << Config::DELIMITER
-                << loan.amountReturned << Config::DELIMITER
-                << loan.amountDue << Config::DELIMITER
-                << loan.bankName << Config::DELIMITER
-                << loan.loanCategory << Config::DELIMITER;
-        }
-
-        // References
-        Reference ref1 = application.getReference1();
-        Reference ref2 = application.getReference2();
-
-        file << ref1.name << Config::DELIMITER
-            << ref1.cnic << Config::DELIMITER
-            << ref1.cnicIssueDate << Config::DELIMITER
-            << ref1.phoneNumber << Config::DELIMITER
-            << ref1.email << Config::DELIMITER
-            << ref2.name << Config::DELIMITER
-            << ref2.cnic << Config::DELIMITER
-            << ref2.cnicIssueDate << Config::DELIMITER
-            << ref2.phoneNumber << Config::DELIMITER
-            << ref2.email << Config::DELIMITER;
-
-        // Image paths
-        file << application.getCnicFrontImagePath() << Config::DELIMITER
-            << application.getCnicBackImagePath() << Config::DELIMITER
-            << application.getElectricityBillImagePath() << Config::DELIMITER
-            << application.getSalarySlipImagePath() << endl;
-
+        file << record << endl;
         file.close();
+        if (!file || !commitChange(sequence)) {
+            cerr << "Error: Application " << appId << " could not be written to " << applicationsFile << endl;
+            return false;
+        }
         cout << "Application saved successfully with ID: " << application.getApplicationId() << endl;
         cout << "Submission Date: " << application.getSubmissionDate() << endl;
         return true;
@@ -290,22 +656,18 @@ bool FileManager::saveApplication(LoanApplication& application) {
 
 vector<LoanApplication> FileManager::findApplicationsByCNIC(const string& cnic) const {
     vector<LoanApplication> results;
-    ifstream file(applicationsFile);
+    vector<string> lines;
 
-    if (!file.is_open()) {
+    if (!findRecordLines(IndexKey::CNIC, cnic, lines)) {
         return results;
     }
 
-    string line;
-    while (getline(file, line)) {
-        if (line.empty()) continue;
-
+    for (const auto& line : lines) {
         try {
-            vector<string> parts = splitString(line, Config::DELIMITER);
-            LoanApplication app = applicationFromFileFormat(parts);
+            LoanApplication app = applicationFromFileFormat(splitString(line, Config::DELIMITER));
 
             if (!app.getApplicationId().empty() && app.getCnicNumber() == cnic) {
-                results.push_back(app);
+                results.push_back(move(app));
             }
         }
         catch (const exception& e) {
@@ -313,78 +675,142 @@ vector<LoanApplication> FileManager::findApplicationsByCNIC(const string& cnic)
         }
     }
 
-    file.close();
     return results;
 }
 void FileManager::getApplicationStatsByCNIC(const string& cnic, int& submitted, int& approved, int& rejected) const {
     submitted = approved = rejected = 0;
 
-    vector<LoanApplication> applications = loadAllApplications();
-    for (size_t i = 0; i < applications.size(); i++) {
-        if (applications[i].getCnicNumber().empty()) continue;
+    if (cnic.empty()) return;
 
-        if (applications[i].getCnicNumber() == cnic) {
-            string status = applications[i].getStatus();
-            if (status == "submitted") submitted++;
-            else if (status == "approved") approved++;
-            else if (status == "rejected") rejected++;
-        }
+    vector<LoanApplication> applications = findApplicationsByCNIC(cnic);
+    for (size_t i = 0; i < applications.size(); i++) {
+        ApplicationStatus status = applications[i].getStatusCode();
+        if (status == ApplicationStatus::SUBMITTED) submitted++;
+        else if (status == ApplicationStatus::APPROVED) approved++;
+        else if (status == ApplicationStatus::REJECTED) rejected++;
     }
 }
 
 bool FileManager::updateApplicationStatus(const string& applicationId, const string& newStatus, const string& rejectionReason) {
+    if (!isStorableField(newStatus) || !isStorableField(rejectionReason)) {
+        cerr << "Error: A status or rejection reason cannot contain '" << Config::DELIMITER
+            << "' or a line break" << endl;
+        return false;
+    }
+
     // Read all applications
     vector<string> lines;
-    ifstream file(applicationsFile);
-
-    if (!file.is_open()) {
+    if (!readRecordLines(applicationsFile, lines, false)) {
         cerr << "Error: Could not open " << applicationsFile << " for reading" << endl;
         return false;
     }
 
-    string line;
-    bool found = false;
+    MessageWriter change;
+    change.writeString(applicationId);
+    change.writeString(newStatus);
+    change.writeString(rejectionReason);
+
+    if (setRecordStatus(lines, applicationId, newStatus, rejectionReason)) {
+        uint64_t sequence = logChange(LogRecordType::UPDATE_STATUS, change.data());
+
+        // A decided application leaves applications.txt for its month's archive
+        // segment, so pending views only read what is still in flight
+        vector<string> decided = takeDecidedRecords(lines);
+        bool moved = !decided.empty();
+        vector<string> movedIds;
+        for (const auto& line : decided) {
+            movedIds.push_back(recordKey(line, IndexKey::APPLICATION_ID));
+        }
+        if (moved && !archiveRecordLines(decided)) {
+            return false;
+        }
 
-    while (getline(file, line)) {
-        if (line.empty()) continue;
+        // The segment is synced, so the move itself is journaled and replay
+        // drops the record from applications.txt if the rewrite below is lost
+        for (const auto& movedId : movedIds) {
+            MessageWriter archived;
+            archived.writeString(movedId);
+            uint64_t archivedSequence = logChange(LogRecordType::ARCHIVE_RECORD, archived.data());
+            if (archivedSequence != 0) sequence = archivedSequence;
+        }
+        // Without the journal only a synced rewrite keeps the move
+        if (!writeRecordLines(lines, moved && !journal)) {
+            cerr << "Error: Could not open " << applicationsFile << " for writing" << endl;
+            return false;
+        }
+        if (!commitChange(sequence)) {
+            return false;
+        }
+        if (moved) {
+            partitions.endMove();
+        }
+    }
+    else {
+        // Decided applications live in their submission month's archive segment
+        string month = segmentHolding(applicationId);
+        if (month.empty()) {
+            cerr << "Error: Application ID " << applicationId << " not found" << endl;
+            return false;
+        }
 
-        vector<string> parts = splitString(line, Config::DELIMITER);
-        if (!parts.empty() && parts[0] == applicationId) {
-            parts[1] = newStatus;
+        ApplicationStatus status;
+        bool backInFlight = tryParseStatus(newStatus, status) && !isDecidedStatus(status);
 
-            if (!rejectionReason.empty() && parts.size() > 25) {
-                parts[25] = rejectionReason;
+        uint64_t sequence = logChange(LogRecordType::UPDATE_STATUS, change.data());
+        if (backInFlight) {
+            lock_guard<mutex> lock(storeMutex);
+            if (!partitions.beginMove()) {
+                cerr << "Error: Could not create the archive of " << applicationsFile << endl;
+                return false;
             }
+        }
 
-            string updatedLine;
-            for (size_t i = 0; i < parts.size(); i++) {
-                if (i > 0) updatedLine += Config::DELIMITER;
-                updatedLine += parts[i];
+        // Under the move marker the segment copy turns undecided first, so an
+        // interrupted return is finished at the next start like any other move
+        string record;
+        if (!updateSegment(month, [&](vector<string>& segmentLines) {
+            if (!setRecordStatus(segmentLines, applicationId, newStatus, rejectionReason)) return false;
+            for (const auto& line : segmentLines) {
+                if (recordKey(line, IndexKey::APPLICATION_ID) == applicationId) record = line;
             }
-            lines.push_back(updatedLine);
-            found = true;
-        }
-        else {
-            lines.push_back(line);
+            return true;
+        })) {
+            cerr << "Error: Could not update partition " << month << " of " << applicationsFile << endl;
+            return false;
         }
-    }
-    file.close();
-
-    if (!found) {
-        cerr << "Error: Application ID " << applicationId << " not found" << endl;
-        return false;
-    }
-
-    ofstream outFile(applicationsFile);
-    if (!outFile.is_open()) {
-        cerr << "Error: Could not open " << applicationsFile << " for writing" << endl;
-        return false;
-    }
 
-    for (const auto& l : lines) {
-        outFile << l << endl;
+        if (backInFlight) {
+            // Back in flight: returned to applications.txt (synced) before it leaves the segment
+            lines.push_back(record);
+            if (!writeRecordLines(lines, true)) {
+                cerr << "Error: Could not open " << applicationsFile << " for writing" << endl;
+                return false;
+            }
+            vector<string> remaining;
+            if (!updateSegment(month, [&](vector<string>& segmentLines) {
+                segmentLines.erase(remove_if(segmentLines.begin(), segmentLines.end(), [&](const string& line) {
+                    return recordKey(line, IndexKey::APPLICATION_ID) == applicationId;
+                }), segmentLines.end());
+                remaining = segmentLines;
+                return true;
+            })) {
+                cerr << "Error: Could not update partition " << month << " of " << applicationsFile << endl;
+                return false;
+            }
+            lock_guard<mutex> lock(storeMutex);
+            partitions.setPartition(summarizeSegment(month, remaining));
+            if (!partitions.saveManifest()) {
+                cerr << "Error: Could not write " << partitions.getManifestFile() << endl;
+                return false;
+            }
+        }
+        if (!commitChange(sequence)) {
+            return false;
+        }
+        if (backInFlight) {
+            partitions.endMove();
+        }
     }
-    outFile.close();
 
     cout << "Application " << applicationId << " status updated to: " << newStatus << endl;
     if (!rejectionReason.empty()) {
@@ -394,210 +820,55 @@ bool FileManager::updateApplicationStatus(const string& applicationId, const str
 }
 
 LoanApplication FileManager::findApplicationById(const string& applicationId) const {
-    ifstream file(applicationsFile);
+    vector<string> lines;
 
-    if (!file.is_open()) {
+    if (!findRecordLines(IndexKey::APPLICATION_ID, applicationId, lines)) {
         cerr << "Error: Could not open applications file for reading" << endl;
         return LoanApplication();
     }
 
-    string line;
-    while (getline(file, line)) {
-        if (line.empty()) continue;
-
-        vector<string> parts = splitString(line, Config::DELIMITER);
-        if (!parts.empty() && parts[0] == applicationId) {
-            LoanApplication app;
-            try {
-                // Basic application data
-                app.setApplicationId(parts[0]);
-                app.setStatus(parts[1]);
-                app.setSubmissionDate(parts[2]);
-
-                // Personal information
-                app.setFullName(parts[3]);
-                app.setFathersName(parts[4]);
-                app.setPostalAddress(parts[5]);
-                app.setContactNumber(parts[6]);
-                app.setEmailAddress(parts[7]);
-                app.setCnicNumber(parts[8]);
-                app.setCnicExpiryDate(parts[9]);
-
-                // Employment & Financial
-                app.setEmploymentStatus(parts[10]);
-                app.setMaritalStatus(parts[11]);
-                app.setGender(parts[12]);
-
-                try {
-                    if (!parts[13].empty()) app.setNumberOfDependents(stoi(parts[13]));
-                }
-                catch (...) {
-                    cerr << "Warning: Invalid dependents for application " << applicationId << endl;
-                }
+    if (lines.empty()) {
+        cerr << "Application " << applicationId << " not found in file" << endl;
+        return LoanApplication();
+    }
 
-                try {
-                    if (!parts[14].empty()) app.setAnnualIncome(stoll(parts[14]));
-                }
-                catch (...) {
-                    cerr << "Warning: Invalid annual income for application " << applicationId << endl;
-                }
+    LoanApplication app;
+    if (!parseApplicationRecord(lines[0], app)) {
+        cerr << "Error parsing application " << applicationId << endl;
+        return LoanApplication();
+    }
+    return app;
+}
 
-                try {
-                    if (!parts[15].empty()) app.setAvgElectricityBill(stoll(parts[15]));
-                }
-                catch (...) {
-                    cerr << "Warning: Invalid avg electricity bill for application " << applicationId << endl;
-                }
+vector<LoanApplication> FileManager::loadAllApplicationsDetailed() const {
+    vector<LoanApplication> applications;
+    auto addRecord = [&](const string& line) {
+        LoanApplication app;
+        if (parseApplicationRecord(line, app)) {
+            applications.push_back(move(app));
+        }
+        else {
+            cerr << "Error parsing application: " << line.substr(0, line.find(Config::DELIMITER)) << endl;
+        }
+    };
 
-                try {
-                    if (!parts[16].empty()) app.setCurrentElectricityBill(stoll(parts[16]));
-                }
-                catch (...) {
-                    cerr << "Warning: Invalid current electricity bill for application " << applicationId << endl;
-                }
+    for (const auto& month : getPartitionMonths()) {
+        vector<string> lines;
+        readSegmentLines(month, lines);
+        for (const auto& line : lines) addRecord(line);
+    }
 
-                if (parts.size() > 17 && !parts[17].empty()) {
-                    app.setLoanType(parts[17]);
-                }
-                else {
-                    app.setLoanType("Unknown");
-                }
+    LineReader file(applicationsFile);
+    string line;
+    while (file.next(line)) {
+        if (!line.empty() && !isFormatHeader(line)) addRecord(line);
+    }
 
-                if (parts.size() > 18 && !parts[18].empty()) {
-                    app.setLoanCategory(parts[18]);
-                }
-                else {
-                    app.setLoanCategory("Unknown");
-                }
+    return applications;
+}
 
-                // Loan amount
-                if (parts.size() > 19 && !parts[19].empty()) {
-                    try {
-                        app.setLoanAmount(stoll(parts[19]));
-                    }
-                    catch (...) {
-                        cerr << "Warning: Invalid loan amount for application " << applicationId << endl;
-                        app.setLoanAmount(0);
-                    }
-                }
-                else {
-                    app.setLoanAmount(0);
-                }
-
-                // Down payment
-                if (parts.size() > 20 && !parts[20].empty()) {
-                    try {
-                        app.setDownPayment(stoll(parts[20]));
-                    }
-                    catch (...) {
-                        cerr << "Warning: Invalid down payment for application " << applicationId << endl;
-                        app.setDownPayment(0);
-                    }
-                }
-                else {
-                    app.setDownPayment(0);
-                }
-
-                // Installment months
-                if (parts.size() > 21 && !parts[21].empty()) {
-                    try {
-                        app.setInstallmentMonths(stoi(parts[21]));
-                    }
-                    catch (...) {
-                        cerr << "Warning: Invalid installment months for application " << applicationId << endl;
-                        app.setInstallmentMonths(0);
-                    }
-                }
-                else {
-                    app.setInstallmentMonths(0);
-                }
-
-                // Monthly payment
-                if (parts.size() > 22 && !parts[22].empty()) {
-                    try {
-                        app.setMonthlyPayment(stoll(parts[22]));
-                    }
-                    catch (...) {
-                        cerr << "Warning: Invalid monthly payment for application " << applicationId << endl;
-                        app.setMonthlyPayment(0);
-                    }
-                }
-                else {
-                    // Calculate monthly payment if not stored
-                    if (app.getInstallmentMonths() > 0 && app.getLoanAmount() > 0 && app.getDownPayment() > 0) {
-                        long long monthly = (app.getLoanAmount() - app.getDownPayment()) / app.getInstallmentMonths();
-                        app.setMonthlyPayment(monthly);
-                    }
-                    else {
-                        app.setMonthlyPayment(0);
-                    }
-                }
-
-                file.close();
-                return app;
-
-            }
-            catch (const exception& e) {
-                cerr << "Error parsing application " << applicationId << ": " << e.what() << endl;
-                file.close();
-                return LoanApplication();
-            }
-        }
-    }
-
-    file.close();
-    cerr << "Application " << applicationId << " not found in file" << endl;
-    return LoanApplication();
-}
-
-vector<LoanApplication> FileManager::loadAllApplicationsDetailed() const {
-    vector<LoanApplication> applications;
-    ifstream file(applicationsFile);
-
-    if (!file.is_open()) {
-        return applications;
-    }
-
-    string line;
-    while (getline(file, line)) {
-        if (line.empty()) continue;
-
-        vector<string> parts = splitString(line, Config::DELIMITER);
-        if (parts.size() >= 17) {
-            LoanApplication app;
-            try {
-                app.setApplicationId(parts[0]);
-                app.setStatus(parts[1]);
-                app.setSubmissionDate(parts[2]);
-                app.setFullName(parts[3]);
-                app.setFathersName(parts[4]);
-                app.setPostalAddress(parts[5]);
-                app.setContactNumber(parts[6]);
-                app.setEmailAddress(parts[7]);
-                app.setCnicNumber(parts[8]);
-                app.setCnicExpiryDate(parts[9]);
-                app.setEmploymentStatus(parts[10]);
-                app.setMaritalStatus(parts[11]);
-                app.setGender(parts[12]);
-                app.setNumberOfDependents(stoi(parts[13]));
-                app.setAnnualIncome(stoll(parts[14]));
-                app.setAvgElectricityBill(stoll(parts[15]));
-                app.setCurrentElectricityBill(stoll(parts[16]));
-
-                applications.push_back(app);
-            }
-            catch (const exception& e) {
-                cerr << "Error parsing application: " << e.what() << endl;
-            }
-        }
-    }
-
-    file.close();
-    return applications;
-}
-
-string FileManager::applicationToFileFormat(const LoanApplication& application) const {
-    stringstream ss;
+string FileManager::applicationToFileFormat(const LoanApplication& application) const {
+    stringstream ss;
 
     // Basic application data
     ss << application.getApplicationId() << Config::DELIMITER
@@ -629,7 +900,7 @@ string FileManager::applicationToFileFormat(const LoanApplication& application)
         << application.getRejectionReason() << Config::DELIMITER;
 
     // Existing loans
-    vector<ExistingLoan> existingLoans = application.getExistingLoans();
+    const vector<ExistingLoan>& existingLoans = application.getExistingLoans();
     ss << existingLoans.size() << Config::DELIMITER;
     for (size_t i = 0; i < existingLoans.size(); i++) {
         const auto& loan = existingLoans[i];
@@ -642,8 +913,8 @@ string FileManager::applicationToFileFormat(const LoanApplication& application)
     }
 
     // References
-    Reference ref1 = application.getReference1();
-    Reference ref2 = application.getReference2();
+    const Reference& ref1 = application.getReference1();
+    const Reference& ref2 = application.getReference2();
 
     ss << ref1.name << Config::DELIMITER
         << ref1.cnic << Config::DELIMITER
@@ -664,141 +935,101 @@ string FileManager::applicationToFileFormat(const LoanApplication& application)
 
     return ss.str();
 }
-LoanApplication FileManager::handleOldFormat(const vector<string>& parts) const {
-    LoanApplication app;
-
-    try {
-        // Old format: parts[0]=ID, parts[1]=status, parts[2]=date, parts[3]=name (no completed sections)
-        app.applicationId = parts[0];
-        app.status = parts[1];
-        app.submissionDate = parts[2];
-
-        // Personal information (shifted by 1 because no completed sections field)
-        if (parts.size() > 3) app.fullName = parts[3];
-        if (parts.size() > 4) app.fathersName = parts[4];
-        if (parts.size() > 5) app.postalAddress = parts[5];
-        if (parts.size() > 6) app.contactNumber = parts[6];
-        if (parts.size() > 7) app.emailAddress = parts[7];
-        if (parts.size() > 8) app.cnicNumber = parts[8];
-        if (parts.size() > 9) app.cnicExpiryDate = parts[9];
-        if (parts.size() > 10) app.employmentStatus = parts[10];
-        if (parts.size() > 11) app.maritalStatus = parts[11];
-        if (parts.size() > 12) app.gender = parts[12];
-
-        // Determine completed sections based on available data
-        string completed = "";
-        if (!app.fullName.empty() && !app.cnicNumber.empty()) {
-            completed = "personal";
-            // Try to detect if financial info is also present
-            if (parts.size() > 14 && !parts[14].empty() && parts[14] != "0") {
-                completed += ",financial";
-            }
-        }
-        app.completedSections = completed;
-
-    }
-    catch (const exception& e) {
-        cerr << "Error handling old format: " << e.what() << endl;
-    }
-
-    return app;
+LoanApplication FileManager::applicationFromFileFormat(vector<string> parts) const {
+    // Until the file is migrated its records can be in either layout
+    const RecordSchema& schema = legacyRecords ? RecordSchema::detect(parts) : RecordSchema::current();
+    return decodeRecord(move(parts), schema);
 }
-LoanApplication FileManager::applicationFromFileFormat(const vector<string>& parts) const {
+
+LoanApplication FileManager::decodeRecord(vector<string> parts, const RecordSchema& schema) const {
     LoanApplication app;
 
     if (parts.size() < 4) return app; // At least ID, status, date, completed sections
 
-    try {
-        // Basic application data - set directly to avoid validation errors
-        app.applicationId = parts[0];
-        app.status = parts[1];
-        app.submissionDate = parts[2];
-        app.completedSections = parts[3];
-
-        // Check if this is an old format (without completed sections)
-        bool isOldFormat = (parts.size() >= 17 && parts[3].find(',') == string::npos &&
-            parts[3] != "personal" && parts[3] != "financial" &&
-            parts[3] != "references" && parts[3] != "documents");
-
-        if (isOldFormat) {
-            // Handle old format - shift all fields
-            return handleOldFormat(parts);
-        }
-
-        // New format with completed sections
-        if (parts.size() > 4 && !parts[4].empty()) app.fullName = parts[4];
-        if (parts.size() > 5 && !parts[5].empty()) app.fathersName = parts[5];
-        if (parts.size() > 6 && !parts[6].empty()) app.postalAddress = parts[6];
-        if (parts.size() > 7 && !parts[7].empty()) app.contactNumber = parts[7];
-        if (parts.size() > 8 && !parts[8].empty()) app.emailAddress = parts[8];
-        if (parts.size() > 9 && !parts[9].empty()) app.cnicNumber = parts[9];
-        if (parts.size() > 10 && !parts[10].empty()) app.cnicExpiryDate = parts[10];
-        if (parts.size() > 11 && !parts[11].empty()) app.employmentStatus = parts[11];
-        if (parts.size() > 12 && !parts[12].empty()) app.maritalStatus = parts[12];
-        if (parts.size() > 13 && !parts[13].empty()) app.gender = parts[13];
-
-        // Numeric fields with safe conversion
-        if (parts.size() > 14 && !parts[14].empty()) {
-            try { app.numberOfDependents = stoi(parts[14]); }
-            catch (...) {}
-        }
-        if (parts.size() > 15 && !parts[15].empty()) {
-            try { app.annualIncome = stoll(parts[15]); }
-            catch (...) {}
+    // A field of the record, or null if this layout or record lacks it or it is empty
+    auto field = [&](RecordField name) -> string* {
+        int position = schema.position(name);
+        if (position < 0 || static_cast<size_t>(position) >= parts.size() || parts[position].empty()) {
+            return nullptr;
         }
-        if (parts.size() > 16 && !parts[16].empty()) {
-            try { app.avgElectricityBill = stoll(parts[16]); }
-            catch (...) {}
+        return &parts[position];
+    };
+
+    // A coded field must name a known value: decoding anything else would
+    // default it (an unknown status would enter the review queue as submitted)
+    // and the next write of the record would lose the stored text
+    auto decodeCode = [&](RecordField name, auto parse, auto& code, const char* what) {
+        string* text = field(name);
+        if (text != nullptr && !parse(*text, code)) {
+            throw invalid_argument(string("unknown ") + what + " '" + *text + "'");
         }
-        if (parts.size() > 17 && !parts[17].empty()) {
-            try { app.currentElectricityBill = stoll(parts[17]); }
-            catch (...) {}
+    };
+
+    {
+        // Set directly to avoid validation errors.
+        // Fields are moved out of parts, which is owned by this call.
+        string* value;
+        if ((value = field(RecordField::APPLICATION_ID))) app.applicationId = move(*value);
+        decodeCode(RecordField::STATUS, tryParseStatus, app.status, "status");
+        if ((value = field(RecordField::SUBMISSION_DATE))) app.submissionDate = move(*value);
+        if ((value = field(RecordField::COMPLETED_SECTIONS))) app.setCompletedSections(*value);
+
+        // Personal information
+        if ((value = field(RecordField::FULL_NAME))) app.fullName = move(*value);
+        if ((value = field(RecordField::FATHERS_NAME))) app.fathersName = move(*value);
+        if ((value = field(RecordField::POSTAL_ADDRESS))) app.postalAddress = move(*value);
+        if ((value = field(RecordField::CONTACT_NUMBER))) app.contactNumber = move(*value);
+        if ((value = field(RecordField::EMAIL_ADDRESS))) app.emailAddress = move(*value);
+        if ((value = field(RecordField::CNIC_NUMBER))) app.cnicNumber = move(*value);
+        if ((value = field(RecordField::CNIC_EXPIRY_DATE))) app.cnicExpiryDate = move(*value);
+        decodeCode(RecordField::EMPLOYMENT_STATUS, tryParseEmploymentStatus, app.employmentStatus, "employment status");
+        decodeCode(RecordField::MARITAL_STATUS, tryParseMaritalStatus, app.maritalStatus, "marital status");
+        decodeCode(RecordField::GENDER, tryParseGender, app.gender, "gender");
+
+        // Numeric fields with safe conversion
+        if ((value = field(RecordField::NUMBER_OF_DEPENDENTS))) tryParseNumber(*value, app.numberOfDependents);
+        if ((value = field(RecordField::ANNUAL_INCOME))) tryParseNumber(*value, app.annualIncome);
+        if ((value = field(RecordField::AVG_ELECTRICITY_BILL))) tryParseNumber(*value, app.avgElectricityBill);
+        if ((value = field(RecordField::CURRENT_ELECTRICITY_BILL))) {
+            tryParseNumber(*value, app.currentElectricityBill);
         }
 
         // Loan details
-        if (parts.size() > 18 && !parts[18].empty()) app.loanType = parts[18];
-        if (parts.size() > 19 && !parts[19].empty()) app.loanCategory = parts[19];
-
-        if (parts.size() > 20 && !parts[20].empty()) {
-            try { app.loanAmount = stoll(parts[20]); }
-            catch (...) {}
-        }
-        if (parts.size() > 21 && !parts[21].empty()) {
-            try { app.downPayment = stoll(parts[21]); }
-            catch (...) {}
+        if ((value = field(RecordField::LOAN_TYPE))) app.setLoanType(move(*value));
+        if ((value = field(RecordField::LOAN_CATEGORY))) app.loanCategory = move(*value);
+        if ((value = field(RecordField::LOAN_AMOUNT))) tryParseNumber(*value, app.loanAmount);
+        if ((value = field(RecordField::DOWN_PAYMENT))) tryParseNumber(*value, app.downPayment);
+        if ((value = field(RecordField::INSTALLMENT_MONTHS))) tryParseNumber(*value, app.installmentMonths);
+        if ((value = field(RecordField::MONTHLY_PAYMENT))) {
+            tryParseNumber(*value, app.monthlyPayment);
         }
-        if (parts.size() > 22 && !parts[22].empty()) {
-            try { app.installmentMonths = stoi(parts[22]); }
-            catch (...) {}
-        }
-        if (parts.size() > 23 && !parts[23].empty()) {
-            try { app.monthlyPayment = stoll(parts[23]); }
-            catch (...) {}
+        else if (app.installmentMonths > 0 && app.loanAmount > 0 && app.downPayment > 0) {
+            // Not stored: work it out from the loan terms
+            app.monthlyPayment = (app.loanAmount - app.downPayment) / app.installmentMonths;
         }
+        if ((value = field(RecordField::INSTALLMENT_START_MONTH))) tryParseNumber(*value, app.installmentStartMonth);
+        if ((value = field(RecordField::INSTALLMENT_START_YEAR))) tryParseNumber(*value, app.installmentStartYear);
 
         // Rejection reason
-        if (parts.size() > 26 && !parts[26].empty()) app.rejectionReason = parts[26];
+        if ((value = field(RecordField::REJECTION_REASON))) app.rejectionReason = move(*value);
 
-        // Existing loans
-        if (parts.size() > 27) {
+        // Existing loans, references and documents follow the loan count in every layout
+        size_t countField = static_cast<size_t>(schema.position(RecordField::EXISTING_LOAN_COUNT));
+        if (countField < parts.size()) {
             int loanCount = 0;
-            try { loanCount = stoi(parts[27]); }
-            catch (...) {}
+            tryParseNumber(parts[countField], loanCount);
 
-            int index = 28;
+            size_t index = countField + 1;
             for (int i = 0; i < loanCount && index + 5 < parts.size(); i++) {
                 ExistingLoan loan;
-                try {
+                // Skip invalid loan data
+                if (tryParseNumber(parts[index + 1], loan.totalAmount) &&
+                    tryParseNumber(parts[index + 2], loan.amountReturned) &&
+                    tryParseNumber(parts[index + 3], loan.amountDue)) {
                     loan.isActive = (parts[index] == "1" || toLower(parts[index]) == "true");
-                    loan.totalAmount = stoll(parts[index + 1]);
-                    loan.amountReturned = stoll(parts[index + 2]);
-                    loan.amountDue = stoll(parts[index + 3]);
-                    loan.bankName = parts[index + 4];
-                    loan.loanCategory = parts[index + 5];
-                    app.existingLoans.push_back(loan);
-                }
-                catch (...) {
-                    // Skip invalid loan data
+                    loan.bankName = move(parts[index + 4]);
+                    loan.loanCategory = move(parts[index + 5]);
+                    app.existingLoans.push_back(move(loan));
                 }
                 index += 6;
             }
@@ -806,26 +1037,41 @@ LoanApplication FileManager::applicationFromFileFormat(const vector<string>& par
             // References
             if (index + 9 < parts.size()) {
                 Reference ref1;
-                ref1.name = parts[index];
-                ref1.cnic = parts[index + 1];
-                ref1.cnicIssueDate = parts[index + 2];
-                ref1.phoneNumber = parts[index + 3];
-                ref1.email = parts[index + 4];
-                app.reference1 = ref1;
+                ref1.name = move(parts[index]);
+                ref1.cnic = move(parts[index + 1]);
+                ref1.cnicIssueDate = move(parts[index + 2]);
+                ref1.phoneNumber = move(parts[index + 3]);
+                ref1.email = move(parts[index + 4]);
+                app.reference1 = move(ref1);
 
                 Reference ref2;
-                ref2.name = parts[index + 5];
-                ref2.cnic = parts[index + 6];
-                ref2.cnicIssueDate = parts[index + 7];
-                ref2.phoneNumber = parts[index + 8];
-                ref2.email = parts[index + 9];
-                app.reference2 = ref2;
+                ref2.name = move(parts[index + 5]);
+                ref2.cnic = move(parts[index + 6]);
+                ref2.cnicIssueDate = move(parts[index + 7]);
+                ref2.phoneNumber = move(parts[index + 8]);
+                ref2.email = move(parts[index + 9]);
+                app.reference2 = move(ref2);
+
+                // Document paths (trailing empty ones are not split out)
+                index += 10;
+                if (index < parts.size()) app.cnicFrontImagePath = move(parts[index]);
+                if (index + 1 < parts.size()) app.cnicBackImagePath = move(parts[index + 1]);
+                if (index + 2 < parts.size()) app.electricityBillImagePath = move(parts[index + 2]);
+                if (index + 3 < parts.size()) app.salarySlipImagePath = move(parts[index + 3]);
             }
         }
 
-    }
-    catch (const exception& e) {
-        cerr << "Error parsing application: " << e.what() << endl;
+        // Layouts without a section list: infer it from the data present
+        if (schema.position(RecordField::COMPLETED_SECTIONS) < 0) {
+            string completed;
+            if (!app.fullName.empty() && !app.cnicNumber.empty()) {
+                completed = "personal";
+                if (app.annualIncome != 0) completed += ",financial";
+                if (!app.reference1.name.empty()) completed += ",references";
+                if (!app.cnicFrontImagePath.empty()) completed += ",documents";
+            }
+            app.setCompletedSections(completed);
+        }
     }
 
     return app;
@@ -833,24 +1079,19 @@ LoanApplication FileManager::applicationFromFileFormat(const vector<string>& par
 // Add/Update these methods in file_manager.cpp
 
 LoanApplication FileManager::findIncompleteApplication(const string& applicationId, const string& cnic) const {
-    vector<LoanApplication> allApplications = loadAllApplications();
+    vector<string> lines;
+    findPendingRecordLines(IndexKey::APPLICATION_ID, applicationId, lines);
 
-    for (size_t i = 0; i < allApplications.size(); i++) {
-        const LoanApplication& app = allApplications[i];
+    for (const auto& line : lines) {
+        LoanApplication app;
+        if (!parseApplicationRecord(line, app)) continue;
 
         // Check if IDs match and application is incomplete
         if (app.getApplicationId() == applicationId &&
             app.getCnicNumber() == cnic) {
 
-            string status = app.getStatus();
             // Application is incomplete if status is C1, C2, C3, or incomplete_*
-            bool isIncomplete = (status == "C1" || status == "C2" || status == "C3" ||
-                status == "incomplete_personal" ||
-                status == "incomplete_financial" ||
-                status == "incomplete_references" ||
-                status == "incomplete_documents");
-
-            if (isIncomplete) {
+            if (isIncompleteStatus(app.getStatusCode())) {
                 return app;
             }
         }
@@ -860,22 +1101,17 @@ LoanApplication FileManager::findIncompleteApplication(const string& application
 }
 
 vector<LoanApplication> FileManager::findUserIncompleteApplications(const string& cnic) const {
-    vector<LoanApplication> allApplications = loadAllApplications();
+    vector<string> lines;
+    findPendingRecordLines(IndexKey::CNIC, cnic, lines);
     vector<LoanApplication> incompleteApps;
 
-    for (size_t i = 0; i < allApplications.size(); i++) {
-        const LoanApplication& app = allApplications[i];
+    for (const auto& line : lines) {
+        LoanApplication app;
+        if (!parseApplicationRecord(line, app)) continue;
 
         if (app.getCnicNumber() == cnic) {
-            string status = app.getStatus();
-            bool isIncomplete = (status == "C1" || status == "C2" || status == "C3" ||
-                status == "incomplete_personal" ||
-                status == "incomplete_financial" ||
-                status == "incomplete_references" ||
-                status == "incomplete_documents");
-
-            if (isIncomplete) {
-                incompleteApps.push_back(app);
+            if (isIncompleteStatus(app.getStatusCode())) {
+                incompleteApps.push_back(move(app));
             }
         }
     }
@@ -889,101 +1125,1214 @@ bool FileManager::canUpdateApplication(const string& applicationId, const string
 }
 
 bool FileManager::updateApplicationSection(const LoanApplication& application, const string& section) {
-    vector<string> lines;
-    ifstream file(applicationsFile);
+    if (!writeApplicationRecord(prepareSectionUpdate(application, section))) {
+        return false;
+    }
 
-    if (!file.is_open()) {
+    if (!section.empty()) {
+        cout << "Progress saved at checkpoint: " << section << endl;
+    }
+    return true;
+}
+
+LoanApplication FileManager::prepareSectionUpdate(const LoanApplication& application, const string& section) {
+    LoanApplication updatedApp = application;
+    if (!section.empty()) {
+        updatedApp.markSectionCompleted(section);
+    }
+
+    // A submitted document section brings the uploads into the images directory
+    if (section == "documents" && updatedApp.getStatusCode() == ApplicationStatus::SUBMITTED) {
+        storeApplicationDocuments(updatedApp);
+    }
+    return updatedApp;
+}
+
+bool FileManager::writeApplicationRecord(const LoanApplication& application) {
+    string updatedLine = applicationToFileFormat(application);
+
+    // Read all existing applications
+    vector<string> lines;
+    if (!readRecordLines(applicationsFile, lines, false)) {
         cerr << "Error: Could not open applications file" << endl;
         return false;
     }
 
+    MessageWriter change;
+    change.writeString(application.getApplicationId());
+    change.writeString(updatedLine);
+
+    // A record moved to its month's partition is rewritten there
+    string month;
+    if (!hasRecordLine(lines, application.getApplicationId())) {
+        month = segmentHolding(application.getApplicationId());
+    }
+    if (!month.empty()) {
+        uint64_t sequence = logChange(LogRecordType::REPLACE_RECORD, change.data());
+        if (!updateSegment(month, [&](vector<string>& segmentLines) {
+            return replaceRecordLine(segmentLines, application.getApplicationId(), updatedLine);
+        })) {
+            cerr << "Error: Could not update partition " << month << " of " << applicationsFile << endl;
+            return false;
+        }
+        return commitChange(sequence);
+    }
+
+    // Found records are updated, otherwise it is added as a new application
+    replaceRecordLine(lines, application.getApplicationId(), updatedLine);
+    uint64_t sequence = logChange(LogRecordType::REPLACE_RECORD, change.data());
+
+    // Write back to file
+    if (!writeRecordLines(lines, false)) {
+        cerr << "Error: Could not open applications file for writing" << endl;
+        return false;
+    }
+    return commitChange(sequence);
+}
+// Update loadAllApplications to use new format
+vector<LoanApplication> FileManager::loadAllApplications() const {
+    // Partitions first: they hold the older applications
+    vector<LoanApplication> applications = loadPartitionedApplications(getPartitionMonths());
+    vector<LoanApplication> recent = loadApplicationsFrom(applicationsFile);
+    applications.insert(applications.end(), make_move_iterator(recent.begin()), make_move_iterator(recent.end()));
+    return applications;
+}
+
+vector<LoanApplication> FileManager::loadPendingApplications() const {
+    vector<LoanApplication> applications = loadApplicationsFrom(applicationsFile);
+
+    // A decision whose move to the archive was interrupted is not pending
+    vector<LoanApplication> pending;
+    for (auto& app : applications) {
+        if (!isDecidedStatus(app.getStatusCode())) {
+            pending.push_back(move(app));
+        }
+    }
+    return pending;
+}
+
+vector<LoanApplication> FileManager::loadApplicationsFrom(const string& path) const {
+    vector<LoanApplication> applications;
+    FileBytes file(path);
+
+    if (!file.isOpen()) {
+        cerr << "Warning: Could not open " << path << endl;
+        return applications;
+    }
+
+    auto parseChunk = [this](const char* begin, const char* end) {
+        ParsedChunk chunk;
+        chunk.applications.reserve(TextScanner::countNewlines(begin, end) + 1);
+
+        string line;
+        for (const char* position = begin; position < end; ) {
+            const char* lineEnd = TextScanner::findNewline(position, end);
+            line.assign(position, lineEnd);
+            position = lineEnd + 1;
+
+            int lineNumber = ++chunk.lineCount;
+            if (line.empty() || isFormatHeader(line)) continue;
+
+            try {
+                vector<string> parts = splitString(line, Config::DELIMITER);
+
+                if (parts.size() < 4) { // At least ID, status, date, completed sections
+                    chunk.problems.push_back({ lineNumber, "Warning: Line ",
+                        " has insufficient fields (" + to_string(parts.size()) + ")" });
+                    continue;
+                }
+
+                chunk.applications.push_back(applicationFromFileFormat(move(parts)));
+                if (chunk.applications.back().getApplicationId().empty()) {
+                    chunk.applications.pop_back();
+                }
+            }
+            catch (const exception& e) {
+                chunk.problems.push_back({ lineNumber, "Error parsing application at line ", string(": ") + e.what() });
+            }
+        }
+        return chunk;
+    };
+
+    // Chunks end just after a newline, so no record is split between two workers
+    const char* data = file.data();
+    const char* fileEnd = data + file.size();
+    vector<pair<const char*, const char*>> ranges;
+    for (const char* start = data; start < fileEnd; ) {
+        const char* end = fileEnd;
+        if (static_cast<size_t>(fileEnd - start) > Config::LOAD_CHUNK_BYTES) {
+            const char* newline = TextScanner::findNewline(start + Config::LOAD_CHUNK_BYTES - 1, fileEnd);
+            if (newline != fileEnd) end = newline + 1;
+        }
+        ranges.push_back(make_pair(start, end));
+        start = end;
+    }
+
+    vector<ParsedChunk> chunks;
+    if (ranges.size() == 1) {
+        chunks.push_back(parseChunk(ranges[0].first, ranges[0].second));
+    }
+    else {
+        vector<future<ParsedChunk>> pending;
+        for (const auto& range : ranges) {
+            pending.push_back(partitionScanPool().submit([&parseChunk, range]() {
+                return parseChunk(range.first, range.second);
+            }));
+        }
+        for (auto& chunk : pending) {
+            chunks.push_back(chunk.get());
+        }
+    }
+
+    // Problems are reported in file order, at their line in the file
+    int linesBefore = 0;
+    size_t total = 0;
+    for (const auto& chunk : chunks) {
+        for (const auto& problem : chunk.problems) {
+            cerr << problem.before << (linesBefore + problem.line) << problem.after << endl;
+        }
+        linesBefore += chunk.lineCount;
+        total += chunk.applications.size();
+    }
+    if (chunks.size() == 1) return move(chunks[0].applications);
+
+    applications.reserve(total);
+    for (auto& chunk : chunks) {
+        applications.insert(applications.end(), make_move_iterator(chunk.applications.begin()),
+            make_move_iterator(chunk.applications.end()));
+    }
+    return applications;
+}
+
+bool FileManager::forEachRecordBatch(size_t batchSize, const function<void(vector<string>&&)>& onBatch) const {
+    vector<string> months = getPartitionMonths();
+    if (!fileExists(applicationsFile) && months.empty()) {
+        cerr << "Warning: Could not open applications file" << endl;
+        return false;
+    }
+    if (batchSize == 0) batchSize = 1;
+
+    vector<string> batch;
+    batch.reserve(batchSize);
+    auto addLine = [&](string& line) {
+        batch.push_back(move(line));
+        if (batch.size() == batchSize) {
+            onBatch(move(batch));
+            batch = vector<string>();
+            batch.reserve(batchSize);
+        }
+    };
+
+    for (const auto& month : months) {
+        vector<string> lines;
+        readSegmentLines(month, lines);
+        for (auto& line : lines) addLine(line);
+    }
+
+    LineReader file(applicationsFile);
     string line;
-    bool found = false;
+    while (file.next(line)) {
+        if (!line.empty() && !isFormatHeader(line)) addLine(line);
+    }
 
-    // Read all existing applications
-    while (getline(file, line)) {
-        if (line.empty()) continue;
+    if (!batch.empty()) {
+        onBatch(move(batch));
+    }
+    return true;
+}
+
+bool FileManager::parseApplicationRecord(const string& line, LoanApplication& application) const {
+    try {
+        vector<string> parts = splitString(line, Config::DELIMITER);
+        if (parts.size() < 4) return false; // At least ID, status, date, completed sections
+
+        application = applicationFromFileFormat(move(parts));
+        return !application.getApplicationId().empty();
+    }
+    catch (const exception& e) {
+        cerr << "Error parsing application " << recordKey(line, IndexKey::APPLICATION_ID) << ": " << e.what() << endl;
+        return false;
+    }
+}
 
+bool FileManager::parseApplicationRecord(const string& line, LoanApplication& application,
+    const RecordSchema& schema) const {
+    try {
         vector<string> parts = splitString(line, Config::DELIMITER);
-        if (!parts.empty() && parts[0] == application.getApplicationId()) {
-            // Found the application - update it
-            LoanApplication updatedApp = application;
-            if (!section.empty()) {
-                updatedApp.markSectionCompleted(section);
+        if (parts.size() < 4) return false;
+
+        application = decodeRecord(move(parts), schema);
+        return !application.getApplicationId().empty();
+    }
+    catch (const exception& e) {
+        cerr << "Error parsing application " << recordKey(line, IndexKey::APPLICATION_ID) << ": " << e.what() << endl;
+        return false;
+    }
+}
+
+bool FileManager::parseSubmittedRecord(const string& record, LoanApplication& application) const {
+    if (record.find_first_of("\r\n") != string::npos) return false;
+
+    // formatApplicationRecord writes exactly this many delimiters: up to the loan
+    // count, 6 per existing loan, then 10 reference and 4 document fields. A
+    // stray delimiter adds one, or moves the count so it is off by a multiple of 6.
+    vector<string> parts = splitString(record, Config::DELIMITER);
+    size_t countField = static_cast<size_t>(RecordSchema::current().position(RecordField::EXISTING_LOAN_COUNT));
+    long long loanCount = 0;
+    size_t delimiters = static_cast<size_t>(count(record.begin(), record.end(), Config::DELIMITER));
+    if (parts.size() <= countField || !tryParseNumber(parts[countField], loanCount) ||
+        loanCount < 0 || static_cast<unsigned long long>(loanCount) > delimiters ||
+        delimiters != countField + 6 * static_cast<size_t>(loanCount) + 14) {
+        return false;
+    }
+
+    try {
+        application = decodeRecord(move(parts), RecordSchema::current());
+        return true;
+    }
+    catch (const exception& e) {
+        cerr << "Error parsing submitted application " << recordKey(record, IndexKey::APPLICATION_ID)
+            << ": " << e.what() << endl;
+        return false;
+    }
+}
+
+vector<UnreadableRecord> FileManager::findUnreadableRecords() const {
+    vector<UnreadableRecord> unreadable;
+    auto check = [&](const string& location, int lineNumber, const string& line) {
+        string problem;
+        try {
+            vector<string> parts = splitString(line, Config::DELIMITER);
+            if (parts.size() < 4) {
+                problem = "insufficient fields (" + to_string(parts.size()) + ")";
+            }
+            else if (applicationFromFileFormat(move(parts)).getApplicationId().empty()) {
+                problem = "no application ID";
             }
-            string updatedLine = applicationToFileFormat(updatedApp);
-            lines.push_back(updatedLine);
-            found = true;
         }
-        else {
-            lines.push_back(line);
+        catch (const exception& e) {
+            problem = e.what();
+        }
+        if (!problem.empty()) {
+            unreadable.push_back({ location, lineNumber, line, problem });
         }
+    };
+
+    for (const auto& month : getPartitionMonths()) {
+        vector<string> lines;
+        readSegmentLines(month, lines);
+        for (const auto& line : lines) check("archive " + month, 0, line);
     }
-    file.close();
 
-    // If not found, add as new application
-    if (!found) {
-        LoanApplication newApp = application;
-        if (!section.empty()) {
-            newApp.markSectionCompleted(section);
+    LineReader file(applicationsFile);
+    string line;
+    int lineNumber = 0;
+    while (file.next(line)) {
+        lineNumber++;
+        if (!line.empty() && !isFormatHeader(line)) check(applicationsFile, lineNumber, line);
+    }
+    return unreadable;
+}
+
+const string& FileManager::getApplicationsFile() const {
+    return applicationsFile;
+}
+
+bool FileManager::prepareIndex(IndexedFile& file, uint64_t& fileBytes) const {
+    if (file.failed) return false;
+
+    struct stat info;
+    if (stat(file.path.c_str(), &info) != 0) return false;
+    fileBytes = static_cast<uint64_t>(info.st_size);
+
+    if (!(file.index.isOpen() && file.index.matchesDataFile()) && !file.index.open()) {
+        return rebuildIndex(file);
+    }
+    if (fileBytes - file.index.getCoveredBytes() > Config::INDEX_TAIL_REBUILD_BYTES) {
+        return rebuildIndex(file);
+    }
+    return true;
+}
+
+bool FileManager::rebuildIndex(IndexedFile& file) const {
+    ifstream input(file.path, ios::binary);
+    if (!input.is_open()) return false;
+
+    stringstream buffer;
+    buffer << input.rdbuf();
+    const string contents = buffer.str();
+
+    // Only newline-terminated records are indexed; a torn last line stays in the tail
+    vector<IndexedRecord> records;
+    long long highestId = 0;
+    size_t position = 0;
+    size_t newline;
+    while ((newline = contents.find('\n', position)) != string::npos) {
+        size_t end = (newline > position && contents[newline - 1] == '\r') ? newline - 1 : newline;
+        if (end > position && contents[position] != Config::DELIMITER) {    // Not the format header
+            string line = contents.substr(position, end - position);
+            IndexedRecord record;
+            record.applicationId = recordKey(line, IndexKey::APPLICATION_ID);
+            record.cnic = recordKey(line, IndexKey::CNIC);
+            record.offset = position;
+
+            long long number = 0;
+            if (parseApplicationNumber(record.applicationId, number) && number > highestId) {
+                highestId = number;
+            }
+            records.push_back(move(record));
         }
-        lines.push_back(applicationToFileFormat(newApp));
-        found = true;
+        position = newline + 1;
     }
 
-    // Write back to file
-    ofstream outFile(applicationsFile);
-    if (!outFile.is_open()) {
-        cerr << "Error: Could not open applications file for writing" << endl;
+    if (!file.index.build(records, position, highestId, Config::BLOOM_FALSE_POSITIVE_RATE)) {
+        cerr << "Warning: Could not write the index for " << file.path
+            << "; lookups will read the whole file" << endl;
+        file.failed = true;
         return false;
     }
+    return true;
+}
+
+bool FileManager::rebuildRecordIndex() {
+    // Archive segments carry their own index, written with them
+    lock_guard<mutex> lock(storeMutex);
+    headFile->failed = false;
+    if (!rebuildIndex(*headFile)) return false;
+
+    cout << "Indexed " << headFile->index.getRecordCount() << " application record(s) of " << applicationsFile
+        << " (Bloom filter false-positive rate " << Config::BLOOM_FALSE_POSITIVE_RATE * 100 << "%)" << endl;
+    return true;
+}
+
+bool FileManager::scanRecordLines(const string& path, uint64_t offset, const function<void(string&)>& onLine) {
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) return false;
+    file.seekg(static_cast<streamoff>(offset));
 
-    for (const auto& l : lines) {
-        outFile << l << endl;
+    string line;
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty() && !isFormatHeader(line)) onLine(line);
     }
-    outFile.close();
+    return true;
+}
 
-    if (!section.empty()) {
-        cout << "Progress saved at checkpoint: " << section << endl;
+bool FileManager::readIndexedLines(IndexedFile& file, IndexKey key, const string& value, vector<string>& lines) const {
+    vector<uint64_t> offsets;
+    if (!file.index.mightContain(key, value)) return true;
+    if (!file.index.lookup(key, value, offsets)) return false;
+    if (offsets.empty()) return true;
+
+    ifstream input(file.path, ios::binary);
+    if (!input.is_open()) return false;
+
+    string line;
+    for (uint64_t offset : offsets) {
+        input.seekg(static_cast<streamoff>(offset));
+        if (!getline(input, line)) return false;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        // Keys longer than the index stores can share a truncated key
+        string stored = recordKey(line, key);
+        if (stored == value) lines.push_back(line);
+        else if (stored.compare(0, RecordIndex::KEY_BYTES, value, 0, RecordIndex::KEY_BYTES) != 0) return false;
     }
     return true;
-} 
-// Update loadAllApplications to use new format
-vector<LoanApplication> FileManager::loadAllApplications() const {
+}
+
+bool FileManager::findRecordLinesIn(IndexedFile& file, IndexKey key, const string& value, vector<string>& lines) const {
+    // A key that is not where the index says means the file changed
+    // underneath (another process rewrote it): rebuild once and retry
+    uint64_t unindexed = 0;
+    uint64_t fileBytes = 0;
+    for (int attempt = 0; attempt < 2 && prepareIndex(file, fileBytes); attempt++) {
+        vector<string> found;
+        if (readIndexedLines(file, key, value, found)) {
+            lines.insert(lines.end(), make_move_iterator(found.begin()), make_move_iterator(found.end()));
+            unindexed = file.index.getCoveredBytes();
+
+            // Nothing appended since the index was built: the data file is not read
+            if (unindexed >= fileBytes) return true;
+            break;
+        }
+        if (!rebuildIndex(file)) break;
+    }
+
+    // Records appended since the index was built (the whole file without an index)
+    return scanRecordLines(file.path, unindexed, [&](string& line) {
+        if (recordKey(line, key) == value) lines.push_back(move(line));
+    });
+}
+
+bool FileManager::findRecordLines(IndexKey key, const string& value, vector<string>& lines) const {
+    lock_guard<mutex> lock(storeMutex);
+    partitions.refresh();
+
+    for (const auto& partition : partitions.getPartitions()) {
+        if (!archiveSegment(partition.month).find(key, value, lines)) {
+            cerr << "Warning: Archive segment " << partitions.segmentFile(partition.month) << " is damaged" << endl;
+        }
+    }
+    return findRecordLinesIn(*headFile, key, value, lines);
+}
+
+bool FileManager::findPendingRecordLines(IndexKey key, const string& value, vector<string>& lines) const {
+    lock_guard<mutex> lock(storeMutex);
+    return findRecordLinesIn(*headFile, key, value, lines);
+}
+
+ArchiveSegment& FileManager::archiveSegment(const string& month) const {
+    unique_ptr<ArchiveSegment>& segment = segmentFiles[month];
+    if (!segment) {
+        segment.reset(new ArchiveSegment(partitions.segmentFile(month)));
+    }
+    return *segment;
+}
+
+bool FileManager::readSegmentLines(const string& month, vector<string>& lines) const {
+    // Its own reader, so scans on other threads do not share the cached footer
+    if (ArchiveSegment(partitions.segmentFile(month)).readAll(lines)) return true;
+
+    cerr << "Error: Archive segment " << partitions.segmentFile(month) << " is damaged" << endl;
+    return false;
+}
+
+bool FileManager::writeSegmentLines(const string& month, const vector<string>& lines) const {
+    if (ArchiveSegment::write(partitions.segmentFile(month), lines, recordKey)) return true;
+
+    cerr << "Error: Could not write " << partitions.segmentFile(month) << endl;
+    return false;
+}
+
+string FileManager::segmentHolding(const string& applicationId) const {
+    lock_guard<mutex> lock(storeMutex);
+    partitions.refresh();
+
+    // The segments' Bloom filters rule out all but the right one
+    for (const auto& partition : partitions.getPartitions()) {
+        vector<string> lines;
+        if (archiveSegment(partition.month).find(IndexKey::APPLICATION_ID, applicationId, lines) && !lines.empty()) {
+            return partition.month;
+        }
+    }
+    return string();
+}
+
+bool FileManager::updateSegment(const string& month, const function<bool(vector<string>&)>& change) {
+    lock_guard<mutex> lock(storeMutex);
+    vector<string> lines;
+    return readSegmentLines(month, lines) && change(lines) && writeSegmentLines(month, lines);
+}
+
+vector<string> FileManager::getPartitionMonths() const {
+    lock_guard<mutex> lock(storeMutex);
+    partitions.refresh();
+
+    vector<string> months;
+    for (const auto& partition : partitions.getPartitions()) {
+        months.push_back(partition.month);
+    }
+    return months;
+}
+
+string FileManager::getPartitionStamp() const {
+    struct stat info;
+    if (stat(partitions.getManifestFile().c_str(), &info) != 0) return string();
+    return to_string(static_cast<long long>(info.st_size)) + ":" + to_string(static_cast<long long>(info.st_mtime));
+}
+
+vector<LoanApplication> FileManager::loadPartitionedApplications(const vector<string>& months) const {
+    vector<future<vector<LoanApplication>>> segments;
+    for (const auto& month : months) {
+        segments.push_back(partitionScanPool().submit([this, month]() {
+            vector<string> lines;
+            vector<LoanApplication> applications;
+            readSegmentLines(month, lines);
+            for (const auto& line : lines) {
+                LoanApplication app;
+                if (parseApplicationRecord(line, app)) applications.push_back(move(app));
+            }
+            return applications;
+        }));
+    }
+
     vector<LoanApplication> applications;
-    ifstream file(applicationsFile);
+    for (auto& segment : segments) {
+        vector<LoanApplication> records = segment.get();
+        applications.insert(applications.end(), make_move_iterator(records.begin()), make_move_iterator(records.end()));
+    }
+    return applications;
+}
 
-    if (!file.is_open()) {
-        cerr << "Warning: Could not open applications file" << endl;
-        return applications;
+const RecordSchema& FileManager::schemaOf(const string& line) const {
+    // Until the file is migrated its records can be in either layout
+    return legacyRecords ? RecordSchema::detect(splitString(line, Config::DELIMITER)) : RecordSchema::current();
+}
+
+bool FileManager::queryRecord(const string& line, const RecordQuery& query, RecordView& view,
+    LoanApplication& application) const {
+    if (!hasRequiredFields(line)) return false;
+
+    const RecordSchema& schema = schemaOf(line);
+    view.load(line, schema, query.getFields());
+    if (!query.matches(view)) return false;
+
+    if (query.needsWholeRecord()) return parseApplicationRecord(line, application, schema);
+
+    // Only the projected fields reach the decoder; the others stay empty
+    const vector<RecordField>& fields = query.getFields();
+    vector<string> parts(static_cast<size_t>(max(4, schema.position(fields.back()) + 1)));
+    for (RecordField field : fields) {
+        int position = schema.position(field);
+        if (position >= 0) parts[position] = view.take(field);
+    }
+    try {
+        application = decodeRecord(move(parts), schema);
+    }
+    catch (const exception& e) {
+        cerr << "Error parsing application " << recordKey(line, IndexKey::APPLICATION_ID) << ": " << e.what() << endl;
+        return false;
+    }
+    return !application.getApplicationId().empty();
+}
+
+vector<LoanApplication> FileManager::queryApplications(const RecordQuery& query) const {
+    // Archive segments are decompressed and filtered on the partition pool
+    // while applications.txt is read here
+    vector<future<vector<LoanApplication>>> segments;
+    if (query.getScope() == QueryScope::ALL_APPLICATIONS) {
+        for (const auto& month : getPartitionMonths()) {
+            segments.push_back(partitionScanPool().submit([this, month, &query]() {
+                vector<string> lines;
+                vector<LoanApplication> applications;
+                RecordView view;
+                readSegmentLines(month, lines);
+                applications.reserve(lines.size());     // Growing the vector would move every application
+                for (const auto& line : lines) {
+                    applications.emplace_back();
+                    if (!queryRecord(line, query, view, applications.back())) applications.pop_back();
+                }
+                return applications;
+            }));
+        }
     }
 
+    vector<LoanApplication> recent;
+    LineReader file(applicationsFile);
     string line;
-    int lineNumber = 0;
+    RecordView view;
+    while (file.next(line)) {
+        if (line.empty() || isFormatHeader(line)) continue;
 
-    while (getline(file, line)) {
-        lineNumber++;
-        if (line.empty()) continue;
+        // Built in place: a LoanApplication is costly to move
+        recent.emplace_back();
+        if (!queryRecord(line, query, view, recent.back())) recent.pop_back();
+    }
 
-        try {
-            vector<string> parts = splitString(line, Config::DELIMITER);
+    // Archived applications first, as loadAllApplications returns them
+    vector<vector<LoanApplication>> archived;
+    size_t total = recent.size();
+    for (auto& segment : segments) {
+        archived.push_back(segment.get());
+        total += archived.back().size();
+    }
+    if (archived.empty()) return recent;
+
+    vector<LoanApplication> applications;
+    applications.reserve(total);
+    for (auto& records : archived) {
+        applications.insert(applications.end(), make_move_iterator(records.begin()), make_move_iterator(records.end()));
+    }
+    applications.insert(applications.end(), make_move_iterator(recent.begin()), make_move_iterator(recent.end()));
+    return applications;
+}
+
+void FileManager::forEachRecord(const RecordQuery& query, const function<void(const RecordView&)>& onRecord) const {
+    // Segments are decompressed on the partition pool; records are visited
+    // here, in the order queryApplications returns them
+    vector<future<vector<string>>> segments;
+    if (query.getScope() == QueryScope::ALL_APPLICATIONS) {
+        for (const auto& month : getPartitionMonths()) {
+            segments.push_back(partitionScanPool().submit([this, month]() {
+                vector<string> lines;
+                readSegmentLines(month, lines);
+                return lines;
+            }));
+        }
+    }
+
+    RecordView view;
+    auto visit = [&](const string& line) {
+        if (!hasRequiredFields(line)) return;
+        view.load(line, schemaOf(line), query.getFields());
+        if (view.get(RecordField::APPLICATION_ID).empty()) return;
+
+        // As decodeRecord does, a record whose status is not known is reported and skipped
+        const string& status = view.get(RecordField::STATUS);
+        ApplicationStatus code = ApplicationStatus::SUBMITTED;
+        if (!status.empty() && !tryParseStatus(status, code)) {
+            cerr << "Error parsing application " << view.get(RecordField::APPLICATION_ID)
+                << ": unknown status '" << status << "'" << endl;
+            return;
+        }
+        if (query.matches(view)) onRecord(view);
+    };
 
-            if (parts.size() < 4) { // At least ID, status, date, completed sections
-                cerr << "Warning: Line " << lineNumber << " has insufficient fields (" << parts.size() << ")" << endl;
-                continue;
+    for (auto& segment : segments) {
+        for (const auto& line : segment.get()) visit(line);
+    }
+
+    LineReader file(applicationsFile);
+    string line;
+    while (file.next(line)) {
+        if (!line.empty() && !isFormatHeader(line)) visit(line);
+    }
+}
+
+vector<LoanApplication> FileManager::loadApplicationsSubmittedBetween(const string& fromDate, const string& toDate) const {
+    vector<LoanApplication> results;
+    string from, to;
+    if (!ApplicationPartitions::sortableDate(fromDate, from) || !ApplicationPartitions::sortableDate(toDate, to)) {
+        return results;
+    }
+
+    vector<string> months;
+    {
+        lock_guard<mutex> lock(storeMutex);
+        partitions.refresh();
+        months = partitions.monthsBetween(fromDate, toDate);
+    }
+
+    // Segments hold one month each, but the range may start or end mid-month
+    vector<LoanApplication> candidates = loadPartitionedApplications(months);
+    vector<LoanApplication> recent = loadApplicationsFrom(applicationsFile);
+    candidates.insert(candidates.end(), make_move_iterator(recent.begin()), make_move_iterator(recent.end()));
+
+    for (auto& app : candidates) {
+        string submitted;
+        if (ApplicationPartitions::sortableDate(app.getSubmissionDate(), submitted) &&
+            submitted >= from && submitted <= to) {
+            results.push_back(move(app));
+        }
+    }
+    return results;
+}
+
+bool FileManager::archiveRecordLines(vector<string>& records) {
+    map<string, vector<string>> byMonth;
+    for (auto& line : records) {
+        vector<string> parts = splitString(line, Config::DELIMITER);
+        byMonth[ApplicationPartitions::monthOf(parts.size() > 2 ? parts[2] : string())].push_back(move(line));
+    }
+
+    lock_guard<mutex> lock(storeMutex);
+    partitions.refresh();
+    if (!partitions.beginMove()) {
+        cerr << "Error: Could not create the archive of " << applicationsFile << endl;
+        return false;
+    }
+
+    // A record already in its segment (a repeated move) is replaced, not duplicated
+    for (auto& month : byMonth) {
+        vector<string> segmentLines;
+        if (!readSegmentLines(month.first, segmentLines)) return false;
+
+        unordered_map<string, size_t> positions;
+        for (size_t i = 0; i < segmentLines.size(); i++) {
+            positions[recordKey(segmentLines[i], IndexKey::APPLICATION_ID)] = i;
+        }
+        for (auto& line : month.second) {
+            string applicationId = recordKey(line, IndexKey::APPLICATION_ID);
+            auto existing = positions.find(applicationId);
+            if (existing != positions.end()) {
+                segmentLines[existing->second] = move(line);
+            }
+            else {
+                positions[applicationId] = segmentLines.size();
+                segmentLines.push_back(move(line));
             }
+        }
+
+        if (!writeSegmentLines(month.first, segmentLines)) return false;
+        partitions.setPartition(summarizeSegment(month.first, segmentLines));
+    }
+
+    if (!partitions.saveManifest()) {
+        cerr << "Error: Could not write " << partitions.getManifestFile() << endl;
+        return false;
+    }
+    return true;
+}
 
-            LoanApplication app = applicationFromFileFormat(parts);
-            if (!app.getApplicationId().empty()) {
-                applications.push_back(app);
+bool FileManager::archiveDecidedApplications() {
+    // applications.txt is rewritten without the journal, so the journal has
+    // to be ours to checkpoint afterwards
+    if (!openJournal()) {
+        cerr << "Error: " << applicationsFile << " is in use by another process; records were not moved" << endl;
+        return false;
+    }
+
+    vector<string> lines;
+    readRecordLines(applicationsFile, lines, false);
+    vector<string> decided = takeDecidedRecords(lines);
+    size_t archived = decided.size();
+
+    // Undecided records in the archive (left by an interrupted move) go back
+    // to applications.txt; it is written before they are dropped from the archive
+    map<string, vector<string>> remaining;
+    size_t restored = 0;
+    for (const auto& month : getPartitionMonths()) {
+        vector<string> segmentLines;
+        if (!readSegmentLines(month, segmentLines)) return false;
+        vector<string> segmentDecided = takeDecidedRecords(segmentLines);
+        if (segmentLines.empty()) continue;
+
+        for (auto& line : segmentLines) {
+            if (!hasRecordLine(lines, recordKey(line, IndexKey::APPLICATION_ID))) {
+                lines.push_back(move(line));
+                restored++;
             }
+        }
+        remaining[month] = move(segmentDecided);
+    }
+
+    if (!decided.empty() && !archiveRecordLines(decided)) {
+        return false;
+    }
+    if (!writeRecordLines(lines, true) || !journal->checkpoint()) {
+        cerr << "Error: Could not rewrite " << applicationsFile << " after archiving its records" << endl;
+        return false;
+    }
 
+    for (auto& month : remaining) {
+        if (!updateSegment(month.first, [&](vector<string>& segmentLines) {
+            segmentLines = month.second;
+            return true;
+        })) {
+            cerr << "Error: Could not rewrite archive segment " << month.first << endl;
+            return false;
         }
-        catch (const exception& e) {
-            cerr << "Error parsing application at line " << lineNumber << ": " << e.what() << endl;
+        lock_guard<mutex> lock(storeMutex);
+        partitions.setPartition(summarizeSegment(month.first, month.second));
+    }
+    if (!remaining.empty()) {
+        lock_guard<mutex> lock(storeMutex);
+        if (!partitions.saveManifest()) {
+            cerr << "Error: Could not write " << partitions.getManifestFile() << endl;
+            return false;
+        }
+    }
+    partitions.endMove();
+
+    if (archived > 0 || restored > 0) {
+        uint64_t storedBytes = 0, rawBytes = 0;
+        for (const auto& month : getPartitionMonths()) {
+            ArchiveSegment segment(partitions.segmentFile(month));
+            storedBytes += segment.getStoredBytes();
+            rawBytes += segment.getRawBytes();
         }
+        cout << "Archived " << archived << " decided application(s); " << restored
+            << " undecided application(s) returned to " << applicationsFile << endl;
+        cout << "Archive holds " << rawBytes << " bytes of records in " << storedBytes << " bytes" << endl;
     }
+    return true;
+}
 
-    file.close();
-    return applications;
-}
\ No newline at end of file
+bool FileManager::hasLegacyRecords() const {
+    ifstream file(applicationsFile, ios::binary);
+    string line;
+    if (!getline(file, line)) return false;     // No records yet: they are written in the current format
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+
+    int version = 0;
+    if (!RecordSchema::parseHeaderLine(line, version)) return true;
+    if (version > RecordSchema::CURRENT_VERSION) {
+        cerr << "Warning: " << applicationsFile << " is in record format " << version
+            << ", newer than this program reads (" << RecordSchema::CURRENT_VERSION << ")" << endl;
+    }
+    return version < RecordSchema::CURRENT_VERSION;
+}
+
+bool FileManager::upgradeRecordLine(string& line) const {
+    vector<string> parts = splitString(line, Config::DELIMITER);
+    const RecordSchema& schema = RecordSchema::detect(parts);
+    if (schema.getVersion() == RecordSchema::CURRENT_VERSION) return false;
+
+    LoanApplication app = decodeRecord(move(parts), schema);
+    if (app.getApplicationId().empty()) return false;
+
+    line = applicationToFileFormat(app);
+    return true;
+}
+
+bool FileManager::tryUpgradeRecordLine(string& line, size_t& upgraded) const {
+    try {
+        if (upgradeRecordLine(line)) upgraded++;
+        return true;
+    }
+    catch (const exception& e) {
+        // Rewriting it would lose the text; the file stays in the old format
+        cerr << "Error: Application " << recordKey(line, IndexKey::APPLICATION_ID) << " could not be migrated ("
+            << e.what() << "); " << applicationsFile << " was not migrated" << endl;
+        return false;
+    }
+}
+
+bool FileManager::migrateRecordFormat() {
+    // applications.txt is rewritten without the journal, so the journal has
+    // to be ours to checkpoint afterwards
+    if (!openJournal()) {
+        cerr << "Error: " << applicationsFile << " is in use by another process; it was not migrated" << endl;
+        return false;
+    }
+
+    // Archive segments first: the header on applications.txt marks the migration as done
+    size_t rewritten = 0;
+    for (const auto& month : getPartitionMonths()) {
+        vector<string> lines;
+        if (!readSegmentLines(month, lines)) return false;
+
+        size_t upgraded = 0;
+        for (auto& line : lines) {
+            if (!tryUpgradeRecordLine(line, upgraded)) return false;
+        }
+        if (upgraded > 0) {
+            lock_guard<mutex> lock(storeMutex);
+            if (!writeSegmentLines(month, lines)) return false;
+        }
+        rewritten += upgraded;
+    }
+
+    // applications.txt is streamed one record at a time into its replacement
+    string temporary = applicationsFile + ".migrating";
+    size_t records = 0;
+    {
+        ifstream input(applicationsFile, ios::binary);
+        ofstream output(temporary, ios::binary | ios::trunc);
+        if (!output.is_open()) {
+            cerr << "Error: Could not create " << temporary << endl;
+            return false;
+        }
+        output << RecordSchema::headerLine() << '\n';
+
+        string line;
+        while (getline(input, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty() || isFormatHeader(line)) continue;
+
+            if (!tryUpgradeRecordLine(line, rewritten)) {
+                output.close();
+                remove(temporary.c_str());
+                return false;
+            }
+            output << line << '\n';
+            records++;
+        }
+        output.close();
+        if (!output) {
+            cerr << "Error: Could not write " << temporary << endl;
+            remove(temporary.c_str());
+            return false;
+        }
+    }
+
+    if (!replaceFile(temporary, applicationsFile, true)) {
+        cerr << "Error: Could not replace " << applicationsFile << " with its migrated copy" << endl;
+        remove(temporary.c_str());
+        return false;
+    }
+    {
+        lock_guard<mutex> lock(storeMutex);
+        headFile->index.discard();
+    }
+    legacyRecords = false;
+
+    if (!journal->checkpoint()) {
+        cerr << "Warning: Could not checkpoint " << applicationsFile << " after migrating it" << endl;
+    }
+    cout << "Migrated " << applicationsFile << " to record format " << RecordSchema::CURRENT_VERSION << ": "
+        << rewritten << " old-format record(s) rewritten, " << records << " record(s) in the file" << endl;
+    return true;
+}
+
+bool FileManager::readRecordLines(const string& path, vector<string>& lines, bool dropUnterminated) {
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) return false;
+
+    stringstream buffer;
+    buffer << file.rdbuf();
+    const string contents = buffer.str();
+
+    size_t position = 0;
+    while (position < contents.size()) {
+        size_t newline = contents.find('\n', position);
+        if (newline == string::npos) {
+            if (!dropUnterminated) lines.push_back(contents.substr(position));
+            break;
+        }
+        size_t end = (newline > position && contents[newline - 1] == '\r') ? newline - 1 : newline;
+        if (end > position) {
+            string line = contents.substr(position, end - position);
+            if (position > 0 || !isFormatHeader(line)) lines.push_back(move(line));
+        }
+        position = newline + 1;
+    }
+    return true;
+}
+
+string FileManager::joinRecordLines(const vector<string>& lines, const string& header) {
+    size_t total = header.empty() ? 0 : header.size() + 1;
+    for (const auto& line : lines) total += line.size() + 1;
+
+    string contents;
+    contents.reserve(total);
+    if (!header.empty()) {
+        contents += header;
+        contents += '\n';
+    }
+    for (const auto& line : lines) {
+        contents += line;
+        contents += '\n';
+    }
+    return contents;
+}
+
+bool FileManager::writeRecordLines(const vector<string>& lines, bool durable) {
+    // An unmigrated file keeps its records as they are, so it gets no header yet
+    string contents = joinRecordLines(lines, legacyRecords ? string() : RecordSchema::headerLine());
+
+    lock_guard<mutex> lock(storeMutex);
+    headFile->index.discard();
+    return replaceFileContents(applicationsFile, contents, durable);
+}
+
+bool FileManager::hasRecordLine(const vector<string>& lines, const string& applicationId) {
+    for (const auto& line : lines) {
+        if (line.compare(0, applicationId.size(), applicationId) == 0 &&
+            line.size() > applicationId.size() && line[applicationId.size()] == Config::DELIMITER) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FileManager::replaceRecordLine(vector<string>& lines, const string& applicationId, const string& record) {
+    bool found = false;
+    for (auto& line : lines) {
+        if (line.compare(0, applicationId.size(), applicationId) == 0 &&
+            line.size() > applicationId.size() && line[applicationId.size()] == Config::DELIMITER) {
+            line = record;
+            found = true;
+        }
+    }
+    if (!found) {
+        lines.push_back(record);
+    }
+    return found;
+}
+
+bool FileManager::setRecordStatus(vector<string>& lines, const string& applicationId,
+    const string& newStatus, const string& rejectionReason) {
+    bool found = false;
+    for (auto& line : lines) {
+        // Only the matching record is split into fields
+        if (line.compare(0, applicationId.size(), applicationId) != 0 ||
+            line.size() <= applicationId.size() || line[applicationId.size()] != Config::DELIMITER) continue;
+        vector<string> parts = splitString(line, Config::DELIMITER);
+
+        parts[1] = newStatus;
+        if (!rejectionReason.empty() && parts.size() > 25) {
+            parts[25] = rejectionReason;
+        }
+
+        string updatedLine;
+        for (size_t i = 0; i < parts.size(); i++) {
+            if (i > 0) updatedLine += Config::DELIMITER;
+            updatedLine += parts[i];
+        }
+        line = move(updatedLine);
+        found = true;
+    }
+    return found;
+}
+
+bool FileManager::replayLogRecord(vector<string>& lines, map<string, vector<string>>& segments,
+    const LogRecord& record) const {
+    MessageReader reader(record.payload);
+    string applicationId, text, reason;
+
+    // A change to a record in a month partition is replayed there
+    auto linesHolding = [&](const string& id) -> vector<string>& {
+        if (hasRecordLine(lines, id)) return lines;
+        string month = segmentHolding(id);
+        if (month.empty()) return lines;
+
+        auto segment = segments.find(month);
+        if (segment == segments.end()) {
+            segment = segments.insert(make_pair(month, vector<string>())).first;
+            readSegmentLines(month, segment->second);
+        }
+        return segment->second;
+    };
+
+    switch (record.type) {
+    case LogRecordType::APPEND_RECORD: {
+        if (!reader.readString(text)) return false;
+        // Already written before the crash (saved records always have a new ID)
+        applicationId = text.substr(0, text.find(Config::DELIMITER));
+        vector<string>& target = linesHolding(applicationId);
+        if (!hasRecordLine(target, applicationId)) target.push_back(text);
+        return true;
+    }
+    case LogRecordType::REPLACE_RECORD:
+        if (!reader.readString(applicationId) || !reader.readString(text)) return false;
+        replaceRecordLine(linesHolding(applicationId), applicationId, text);
+        return true;
+    case LogRecordType::UPDATE_STATUS:
+        if (!reader.readString(applicationId) || !reader.readString(text) || !reader.readString(reason)) return false;
+        setRecordStatus(linesHolding(applicationId), applicationId, text, reason);
+        return true;
+    case LogRecordType::ARCHIVE_RECORD:
+        if (!reader.readString(applicationId)) return false;
+        // Logged once the segment copy was synced; a record no segment holds is kept
+        if (!segmentHolding(applicationId).empty()) {
+            lines.erase(remove_if(lines.begin(), lines.end(), [&](const string& line) {
+                return recordKey(line, IndexKey::APPLICATION_ID) == applicationId;
+            }), lines.end());
+        }
+        return true;
+    }
+    return false;
+}
+
+bool FileManager::openJournal() {
+    if (journal) return true;
+
+    unique_ptr<WriteAheadLog> log(new WriteAheadLog(applicationsFile));
+    if (!log->open()) {
+        if (!journalWarned) {
+            cerr << "Warning: " << applicationsFile << " is journaled by another process; "
+                << "changes made here are not crash-safe" << endl;
+            journalWarned = true;
+        }
+        return false;
+    }
+    journal = move(log);
+    journal->setDurableListener(durabilityListener);
+
+    if (!journal->getRecoveredRecords().empty() && !recoverFromJournal()) {
+        // Keep the log for a later attempt rather than journaling on top of it
+        journal.reset();
+        return false;
+    }
+    if (journal->needsCheckpoint()) {
+        journal->checkpoint();
+    }
+    return true;
+}
+
+bool FileManager::recoverFromJournal() {
+    const vector<LogRecord>& records = journal->getRecoveredRecords();
+
+    // Records leave applications.txt in rewrites that are not synced, each
+    // after its ARCHIVE_RECORD; a file shorter than its checkpoint may have lost
+    // one, and the checkpoint with the log replayed over it is complete either way
+    vector<string> checkpointLines;
+    vector<string> fileLines;
+    bool haveCheckpoint = readRecordLines(journal->getCheckpointFile(), checkpointLines, false);
+    bool haveFile = readRecordLines(applicationsFile, fileLines, true);
+    bool fromFile = haveFile && (!haveCheckpoint || fileLines.size() >= checkpointLines.size());
+    vector<string>& lines = fromFile ? fileLines : checkpointLines;
+
+    // Either way, records only the file has were appended by processes without
+    // the journal (those since archived are in their segment already)
+    if (!fromFile) {
+        unordered_set<string> checkpointed;
+        for (const auto& line : checkpointLines) {
+            checkpointed.insert(recordKey(line, IndexKey::APPLICATION_ID));
+        }
+        for (auto& line : fileLines) {
+            string applicationId = recordKey(line, IndexKey::APPLICATION_ID);
+            if (!checkpointed.count(applicationId) && segmentHolding(applicationId).empty()) {
+                checkpointLines.push_back(move(line));
+            }
+        }
+    }
+
+    size_t replayed = 0;
+    map<string, vector<string>> segments;
+    for (const auto& record : records) {
+        if (replayLogRecord(lines, segments, record)) replayed++;
+    }
+
+    // Partitions first: once the log is checkpointed their changes cannot be replayed again
+    for (const auto& segment : segments) {
+        if (!updateSegment(segment.first, [&](vector<string>& segmentLines) {
+            segmentLines = segment.second;
+            return true;
+        })) {
+            cerr << "Error: Could not recover partition " << segment.first << " of " << applicationsFile << endl;
+            return false;
+        }
+    }
+
+    // Decisions replayed above move to the archive like any other
+    vector<string> decided = takeDecidedRecords(lines);
+    if (!decided.empty() && !archiveRecordLines(decided)) {
+        return false;
+    }
+
+    if (!writeRecordLines(lines, true) || !journal->checkpoint()) {
+        cerr << "Error: Could not recover " << applicationsFile << " from its journal" << endl;
+        return false;
+    }
+    cout << "Recovered " << replayed << " journaled change(s) to " << applicationsFile << endl;
+    return true;
+}
+
+uint64_t FileManager::logChange(LogRecordType type, const string& payload) {
+    if (!openJournal()) return 0;
+
+    uint64_t sequence = journal->append(type, payload);
+    if (sequence != 0) {
+        lastLoggedSequence = sequence;
+    }
+    return sequence;
+}
+
+bool FileManager::commitChange(uint64_t sequence) {
+    if (journal && journal->needsCheckpoint()) {
+        journal->checkpoint();
+    }
+    return waitUntilDurable(sequence);
+}
+
+bool FileManager::waitUntilDurable(uint64_t sequence) {
+    if (sequence == 0 || durabilityDeferred || !journal) return true;
+
+    if (!journal->waitDurable(sequence)) {
+        cerr << "Error: The change to " << applicationsFile << " could not be made durable" << endl;
+        return false;
+    }
+    return true;
+}
+
+void FileManager::setDurabilityListener(function<void()> listener) {
+    durabilityListener = move(listener);
+    if (openJournal()) {
+        journal->setDurableListener(durabilityListener);
+    }
+}
+
+uint64_t FileManager::getLastLoggedSequence() {
+    return lastLoggedSequence;
+}
+
+bool FileManager::isDurable(uint64_t sequence) const {
+    return !journal || journal->getDurableSequence() >= sequence;
+}
+
+string FileManager::formatApplicationRecord(const LoanApplication& application) const {
+    return applicationToFileFormat(application);
+}
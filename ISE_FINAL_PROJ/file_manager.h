@@ -3,10 +3,31 @@
 
 #include <string>
 #include <vector>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <map>
 #include "application.h"
+#include "document_store.h"
+#include "write_ahead_log.h"
+#include "record_index.h"
+#include "application_partitions.h"
+#include "archive_segment.h"
+#include "record_schema.h"
+#include "record_query.h"
 
 using namespace std;
 
+/// <summary>
+/// A stored record no reader can decode, kept exactly as it was written
+/// </summary>
+struct UnreadableRecord {
+    string location;        // applications.txt, or the archive month holding it
+    int lineNumber;         // Line in applications.txt (0 for an archive segment)
+    string line;            // The stored text, unchanged
+    string problem;         // Why it could not be decoded
+};
+
 
 /// <summary>
 /// Manages file-based persistence for loan applications
@@ -15,12 +36,259 @@ using namespace std;
 /// - Data Access Layer Pattern: Abstracts storage mechanism from application
 /// - Separation of Concerns: File format and storage separate from domain logic
 /// - CRUD Operations: Provides Create, Read, Update, Delete for applications
+/// - Polymorphism: the store operations are virtual so the same UI code can run
+///   against the in-memory server store (CachedFileManager) or a remote one
+///   (RemoteFileManager)
+/// - Write-Ahead Logging: every change is journaled (WriteAheadLog) before
+///   applications.txt is touched, and rewrites replace the file in one rename,
+///   so a crash can no longer leave a truncated store. A log left by a crash is
+///   replayed when the next FileManager for the file is constructed.
+/// - Indexing: lookups by application ID or CNIC go through a persistent
+///   B+tree index (RecordIndex, applications.txt.idx) plus a scan of the
+///   records appended since it was built, instead of reading the whole file;
+///   its Bloom filter answers most lookups for unknown keys on its own
+/// - Partitioning: decided applications are archived out of
+///   applications.txt into one segment file per submission month
+///   (ApplicationPartitions); date range queries open only the months in
+///   range, full scans read the segments in parallel, and an update rewrites
+///   only the segment holding the record
+/// - Hot/cold tiering: applications.txt keeps only applications still in
+///   flight (submitted or incomplete), so the pending queue and resume
+///   lookups cost time in proportion to the backlog, not the history
 /// </summary>
 class FileManager {
 private:
 
     string applicationsFile;   // Path to applications.txt
     string imagesDirectory;    // Path to images/ folder
+    DocumentStore documentStore; // Deduplicated blobs behind images/
+
+    unique_ptr<WriteAheadLog> journal;  // Opened by the first change
+    bool journalWarned;                 // Told the user changes are not being journaled
+    function<void()> durabilityListener;
+
+    static thread_local uint64_t lastLoggedSequence;
+    static thread_local bool durabilityDeferred;
+
+    /// <summary>
+    /// applications.txt and its record index
+    /// </summary>
+    struct IndexedFile {
+        string path;
+        RecordIndex index;
+        bool failed;        // The index file could not be written; lookups scan
+
+        explicit IndexedFile(const string& file) : path(file), index(file), failed(false) {}
+    };
+
+    mutable mutex storeMutex;               // Guards the indexed files and the partition list
+    unique_ptr<IndexedFile> headFile;       // applications.txt, indexed by the first lookup
+    mutable map<string, unique_ptr<ArchiveSegment>> segmentFiles;  // Archive segments by month
+    mutable ApplicationPartitions partitions;
+
+    // applications.txt has no format header: its records may be in either
+    // layout until migrateRecordFormat runs (set before the store is shared)
+    bool legacyRecords;
+
+    /// <summary>
+    /// Opens a file's record index, rebuilding it when it is missing, no longer
+    /// matches the file or too many records were appended since
+    /// The caller holds storeMutex.
+    /// </summary>
+    /// <param name="fileBytes">Output: size of the data file when it was checked</param>
+    /// <returns>False if there is no usable index (lookups then scan the file)</returns>
+    bool prepareIndex(IndexedFile& file, uint64_t& fileBytes) const;
+
+    /// <summary>
+    /// Rebuilds a file's record index from one read of it (caller holds storeMutex)
+    /// </summary>
+    bool rebuildIndex(IndexedFile& file) const;
+
+    /// <summary>
+    /// Reads the lines a file's index holds for a key (caller holds storeMutex)
+    /// </summary>
+    /// <returns>False if a line is not what the index says (the file changed underneath)</returns>
+    bool readIndexedLines(IndexedFile& file, IndexKey key, const string& value, vector<string>& lines) const;
+
+    /// <summary>
+    /// Calls back with every non-empty record line from a byte offset to the end of a file
+    /// </summary>
+    /// <returns>False if the file could not be opened</returns>
+    static bool scanRecordLines(const string& path, uint64_t offset, const function<void(string&)>& onLine);
+
+    /// <summary>
+    /// Record lines of one data file stored under an application ID or CNIC,
+    /// in file order: the indexed ones plus any appended after the index was
+    /// built (caller holds storeMutex)
+    /// </summary>
+    /// <returns>False if the file could not be opened</returns>
+    bool findRecordLinesIn(IndexedFile& file, IndexKey key, const string& value, vector<string>& lines) const;
+
+    /// <summary>
+    /// Record lines stored under an application ID or CNIC in the partition
+    /// segments (oldest month first), then in applications.txt
+    /// </summary>
+    /// <returns>False if applications.txt could not be opened</returns>
+    bool findRecordLines(IndexKey key, const string& value, vector<string>& lines) const;
+
+    /// <summary>
+    /// Record lines stored under a key in applications.txt only (applications in flight)
+    /// </summary>
+    bool findPendingRecordLines(IndexKey key, const string& value, vector<string>& lines) const;
+
+    /// <summary>
+    /// The cached reader of a month's archive segment (caller holds storeMutex)
+    /// </summary>
+    ArchiveSegment& archiveSegment(const string& month) const;
+
+    /// <summary>
+    /// Every record line of a month's archive segment
+    /// </summary>
+    /// <returns>False (with a message) if the segment is damaged</returns>
+    bool readSegmentLines(const string& month, vector<string>& lines) const;
+
+    /// <summary>
+    /// Replaces a month's archive segment with these record lines (synced)
+    /// </summary>
+    bool writeSegmentLines(const string& month, const vector<string>& lines) const;
+
+    /// <summary>
+    /// Month of the partition segment holding an application
+    /// </summary>
+    /// <returns>Empty if no segment holds it</returns>
+    string segmentHolding(const string& applicationId) const;
+
+    /// <summary>
+    /// Merges records into the archive segments of their submission months
+    /// (synced, with the move marker set) and updates the manifest
+    /// </summary>
+    /// <param name="records">Record lines to archive (moved from)</param>
+    bool archiveRecordLines(vector<string>& records);
+
+    /// <summary>
+    /// Applies a change to the record lines of one segment and writes it back
+    /// (synced, since segments are not covered by the journal's checkpoint)
+    /// </summary>
+    /// <param name="change">Edits the lines; returns false to leave the segment unchanged</param>
+    bool updateSegment(const string& month, const function<bool(vector<string>&)>& change);
+
+    /// <summary>
+    /// Parses every record of one data file
+    /// Large files are split at newlines and the pieces parsed on the
+    /// partition pool; warnings still name the line in the file.
+    /// </summary>
+    vector<LoanApplication> loadApplicationsFrom(const string& path) const;
+
+    /// <summary>
+    /// Layout of a record line from this store
+    /// </summary>
+    const RecordSchema& schemaOf(const string& line) const;
+
+    /// <summary>
+    /// Reads a record line's projected fields and, if the query keeps it,
+    /// builds the application from those fields alone
+    /// </summary>
+    /// <param name="view">Scratch view, reused between lines</param>
+    /// <returns>True if the record matched (application is set)</returns>
+    bool queryRecord(const string& line, const RecordQuery& query, RecordView& view,
+        LoanApplication& application) const;
+
+    /// <summary>
+    /// Locks the journal, replays what a crash left in it and checkpoints if needed
+    /// </summary>
+    /// <returns>False if changes cannot be journaled (another process holds the log)</returns>
+    bool openJournal();
+
+    /// <summary>
+    /// Rebuilds applications.txt from its checkpoint (or itself) plus the journal
+    /// </summary>
+    bool recoverFromJournal();
+
+    /// <summary>
+    /// Journals a change before it is applied to applications.txt
+    /// </summary>
+    /// <returns>Sequence number of the record, 0 if it was not journaled</returns>
+    uint64_t logChange(LogRecordType type, const string& payload);
+
+    /// <summary>
+    /// Finishes a journaled change: checkpoints a full log, then waits for the
+    /// record to be durable unless durability is deferred on this thread
+    /// </summary>
+    bool commitChange(uint64_t sequence);
+
+    /// <summary>
+    /// Reads the non-empty record lines of a file
+    /// </summary>
+    /// <param name="dropUnterminated">Ignore a last line without a newline (a torn append)</param>
+    /// <returns>False if the file could not be opened</returns>
+    static bool readRecordLines(const string& path, vector<string>& lines, bool dropUnterminated);
+
+    /// <summary>
+    /// Replaces applications.txt with these lines (see replaceFileContents)
+    /// and drops the record index, whose offsets no longer apply
+    /// </summary>
+    bool writeRecordLines(const vector<string>& lines, bool durable);
+
+    /// <summary>
+    /// Replaces every line with this application ID, or appends the record
+    /// </summary>
+    /// <returns>True if an existing line was replaced</returns>
+    static bool replaceRecordLine(vector<string>& lines, const string& applicationId, const string& record);
+
+    /// <summary>
+    /// Sets the status (and rejection reason, if given) of every line with this ID
+    /// </summary>
+    /// <returns>False if no line has this ID</returns>
+    static bool setRecordStatus(vector<string>& lines, const string& applicationId,
+        const string& newStatus, const string& rejectionReason);
+
+    /// <summary>
+    /// True if a line in lines has this application ID
+    /// </summary>
+    static bool hasRecordLine(const vector<string>& lines, const string& applicationId);
+
+    /// <summary>
+    /// Joins record lines into file contents, one per line, after the header if there is one
+    /// </summary>
+    static string joinRecordLines(const vector<string>& lines, const string& header);
+
+    /// <summary>
+    /// True if applications.txt was written before the format header (or by an
+    /// older format) and has to be migrated
+    /// </summary>
+    bool hasLegacyRecords() const;
+
+    /// <summary>
+    /// Rewrites a record line in the current layout if it is in an older one
+    /// </summary>
+    /// <returns>True if the line was rewritten</returns>
+    bool upgradeRecordLine(string& line) const;
+
+    /// <summary>
+    /// upgradeRecordLine for the migration: a record that cannot be decoded
+    /// is reported and stops the migration instead of being rewritten
+    /// </summary>
+    /// <param name="upgraded">Incremented if the line was rewritten</param>
+    /// <returns>False if the record could not be decoded</returns>
+    bool tryUpgradeRecordLine(string& line, size_t& upgraded) const;
+
+    /// <summary>
+    /// Builds an application from the fields of a record laid out as the schema says
+    /// The one decoder every reader of stored records goes through.
+    /// Throws invalid_argument if a status, employment status, marital status
+    /// or gender is not one it knows; callers report the record and skip it.
+    /// </summary>
+    /// <param name="parts">Fields of the record (moved from)</param>
+    LoanApplication decodeRecord(vector<string> parts, const RecordSchema& schema) const;
+
+    /// <summary>
+    /// Applies one journaled change during recovery, to the applications.txt
+    /// lines or, for a record that lives in a partition, to that segment's
+    /// lines (loaded into segments on first use)
+    /// Replaying a change the lines already hold leaves them unchanged.
+    /// </summary>
+    bool replayLogRecord(vector<string>& lines, map<string, vector<string>>& segments,
+        const LogRecord& record) const;
 
 
     /// <summary>
@@ -32,11 +300,28 @@ private:
 
     /// <summary>
     /// Copies an image file from source to destination
+    /// On Linux the data is moved kernel-side (FICLONE reflink, copy_file_range,
+    /// then sendfile) and the checksum is taken from a mapping of the source
     /// </summary>
     /// <param name="sourcePath">Original file location</param>
     /// <param name="destinationPath">Where to copy file</param>
+    /// <param name="checksum">Output: SHA-256 of the copied content</param>
+    /// <param name="message">Output: result line for the user (safe to call off the UI thread)</param>
     /// <returns>True if copy successful and verified</returns>
-    bool copyImageFile(const string& sourcePath, const string& destinationPath) const;
+    bool copyImageFile(const string& sourcePath, const string& destinationPath,
+        string& checksum, string& message) const;
+
+    /// <summary>
+    /// Stores one uploaded document in the deduplicated document store
+    /// </summary>
+    /// <param name="applicationId">Owning application</param>
+    /// <param name="documentType">cnic_front, cnic_back, electricity_bill or salary_slip</param>
+    /// <param name="sourcePath">User supplied file</param>
+    /// <param name="storedPath">Output: path to record in the application</param>
+    /// <param name="message">Output: result line for the user</param>
+    /// <returns>True if the document was stored</returns>
+    bool storeDocument(const string& applicationId, const string& documentType,
+        const string& sourcePath, string& storedPath, string& message);
 
     /// <summary>
     /// Converts application object to file format string
@@ -50,16 +335,71 @@ private:
     /// </summary>
     /// <param name="parts">Vector of field values from file</param>
     /// <returns>Reconstructed application object</returns>
-    LoanApplication applicationFromFileFormat(const vector<string>& parts) const;
+    LoanApplication applicationFromFileFormat(vector<string> parts) const;
+
+protected:
+    /// <summary>
+    /// Moves all four documents of an application into the images directory
+    /// The copies run in parallel; paths are updated once all have finished
+    /// </summary>
+    /// <param name="application">Application whose image paths are updated</param>
+    void storeApplicationDocuments(LoanApplication& application);
+
+    /// <summary>
+    /// Applies a completed section to a copy of the application
+    /// (a submitted document section also stores the uploads)
+    /// </summary>
+    /// <param name="application">Application as collected</param>
+    /// <param name="section">Section name that was completed (may be empty)</param>
+    /// <returns>Application exactly as it will be written</returns>
+    LoanApplication prepareSectionUpdate(const LoanApplication& application, const string& section);
+
+    /// <summary>
+    /// Replaces every record with the application's ID (or appends it)
+    /// </summary>
+    /// <returns>True if the applications file was rewritten</returns>
+    bool writeApplicationRecord(const LoanApplication& application);
+
+    /// <summary>
+    /// Waits for a journaled change to be durable (returns at once while
+    /// durability is deferred on this thread or nothing was journaled)
+    /// </summary>
+    /// <returns>False if the journal could not be synced</returns>
+    bool waitUntilDurable(uint64_t sequence);
+
+    /// <summary>
+    /// Months that have a partition segment, oldest first
+    /// </summary>
+    vector<string> getPartitionMonths() const;
+
+    /// <summary>
+    /// Parses the segments of these months in parallel (Config::PARTITION_SCAN_THREADS)
+    /// </summary>
+    /// <returns>The records of every segment, in the order of months</returns>
+    vector<LoanApplication> loadPartitionedApplications(const vector<string>& months) const;
 
     /// <summary>
-    /// Handles old format applications (backward compatibility)
+    /// Changes whenever the partition manifest is rewritten (empty without partitions)
     /// </summary>
-    /// <param name="parts">Vector of field values in old format</param>
-    /// <returns>Application object from old format data</returns>
-    LoanApplication handleOldFormat(const vector<string>& parts) const;
+    string getPartitionStamp() const;
 
 public:
+    /// <summary>
+    /// While alive, changes made on this thread return before their journal
+    /// record is on disk; the caller checks isDurable(getLastLoggedSequence())
+    /// before acknowledging them (the server holds its responses until then)
+    /// </summary>
+    class DurabilityDeferral {
+    private:
+        bool previous;
+
+    public:
+        DurabilityDeferral() : previous(durabilityDeferred) { durabilityDeferred = true; }
+        ~DurabilityDeferral() { durabilityDeferred = previous; }
+
+        DurabilityDeferral(const DurabilityDeferral&) = delete;
+        DurabilityDeferral& operator=(const DurabilityDeferral&) = delete;
+    };
 
     /// <summary>
     /// Constructs FileManager with configurable paths
@@ -69,18 +409,73 @@ public:
     FileManager(const string& appsFile = "applications.txt",
         const string& imagesDir = "images/");
 
+    /// <summary>
+    /// Checkpoints and closes the journal
+    /// </summary>
+    virtual ~FileManager();
+
+    FileManager(const FileManager&) = delete;
+    FileManager& operator=(const FileManager&) = delete;
+
+    /// <summary>
+    /// Path of the applications file this store writes
+    /// </summary>
+    const string& getApplicationsFile() const;
+
+    /// <summary>
+    /// Opens the journal now and calls back (from the journal's commit thread)
+    /// whenever more changes become durable
+    /// </summary>
+    /// <param name="listener">Callback, or nullptr to stop; once this returns the old one is not running</param>
+    void setDurabilityListener(function<void()> listener);
+
+    /// <summary>
+    /// Journal sequence number of the last change made on the calling thread
+    /// </summary>
+    static uint64_t getLastLoggedSequence();
+
+    /// <summary>
+    /// True if the change with this sequence number is on disk
+    /// </summary>
+    bool isDurable(uint64_t sequence) const;
+
+    /// <summary>
+    /// Moves every decided record of applications.txt to the archive segment
+    /// of its submission month, and any undecided record found in the archive
+    /// back to applications.txt (lender_server --archive; status changes
+    /// archive their own record, so this is for older stores and interrupted moves)
+    /// </summary>
+    /// <returns>False if the move could not be completed (it is finished on the next start)</returns>
+    bool archiveDecidedApplications();
+
+    /// <summary>
+    /// Rewrites applications.txt and the archive segments in the current record
+    /// format, streaming one record at a time, and gives applications.txt its
+    /// format header (runs on its own for a file without one; lender_server --migrate)
+    /// </summary>
+    /// <returns>False if the store could not be migrated (it is retried on the next start)</returns>
+    bool migrateRecordFormat();
+
+    /// <summary>
+    /// Rebuilds the record indexes of applications.txt and every partition
+    /// segment now (lender_server --rebuild-index), for example after
+    /// changing Config::BLOOM_FALSE_POSITIVE_RATE
+    /// </summary>
+    /// <returns>False if applications.txt could not be read or the index written</returns>
+    bool rebuildRecordIndex();
+
     /// <summary>
     /// Generates a unique 4-digit application ID
     /// </summary>
     /// <returns>Unique application ID string</returns>
-    string generateApplicationId() const;
+    virtual string generateApplicationId() const;
 
     /// <summary>
     /// Saves a complete application to file
     /// </summary>
     /// <param name="application">Application to save (modified with ID and paths)</param>
     /// <returns>True if saved successfully</returns>
-    bool saveApplication(LoanApplication& application);
+    virtual bool saveApplication(LoanApplication& application);
 
     /// <summary>
     /// Updates a section of an application (multi-session support)
@@ -88,14 +483,54 @@ public:
     /// <param name="application">Application with updated section</param>
     /// <param name="section">Section name that was completed</param>
     /// <returns>True if update successful</returns>
-    bool updateApplicationSection(const LoanApplication& application, const string& section);
+    virtual bool updateApplicationSection(const LoanApplication& application, const string& section);
 
+    /// <summary>
+    /// Stores document content received from a client (the store never opens a
+    /// path the client named); a duplicate is stored exactly like a new upload
+    /// </summary>
+    /// <param name="applicationId">Owning application</param>
+    /// <param name="documentType">cnic_front, cnic_back, electricity_bill or salary_slip</param>
+    /// <param name="content">The file's bytes</param>
+    /// <param name="storedPath">Output: path to record in the application</param>
+    /// <param name="message">Output: result line for the user</param>
+    /// <returns>True if the document was stored</returns>
+    bool storeUploadedDocument(const string& applicationId, const string& documentType,
+        const string& content, string& storedPath, string& message);
+
+    /// <summary>
+    /// True if saving an application would copy the file a document path names
+    /// (false for empty paths, paths into the store and failed-copy markers)
+    /// </summary>
+    bool needsDocumentCopy(const string& path) const;
 
     /// <summary>
     /// Loads all applications from file
     /// </summary>
     /// <returns>Vector of all applications (empty if file not found)</returns>
-    vector<LoanApplication> loadAllApplications() const;
+    virtual vector<LoanApplication> loadAllApplications() const;
+
+    /// <summary>
+    /// Loads the applications still in flight (submitted or incomplete)
+    /// Only applications.txt is read; decided applications are in the archive.
+    /// </summary>
+    virtual vector<LoanApplication> loadPendingApplications() const;
+
+    /// <summary>
+    /// Applications matching a query, with only the projected fields filled in
+    /// Each record is tokenized up to its last projected field and tested
+    /// before an application is built, so views that print a few fields
+    /// do not pay for decoding the rest.
+    /// </summary>
+    /// <returns>Matching applications, archived ones first (as loadAllApplications)</returns>
+    virtual vector<LoanApplication> queryApplications(const RecordQuery& query) const;
+
+    /// <summary>
+    /// Passes the projected fields of each record a query keeps to a callback
+    /// No application is built, so counting or summing a field costs only the
+    /// tokenizing; records arrive in queryApplications order, on this thread.
+    /// </summary>
+    virtual void forEachRecord(const RecordQuery& query, const function<void(const RecordView&)>& onRecord) const;
 
     /// <summary>
     /// Loads all applications with full details
@@ -103,19 +538,74 @@ public:
     /// <returns>Vector of applications with full details</returns>
     vector<LoanApplication> loadAllApplicationsDetailed() const;
 
+    /// <summary>
+    /// Loads the applications submitted between two dates (DD-MM-YYYY, inclusive)
+    /// Only the partition segments of the months in range are read.
+    /// </summary>
+    /// <returns>Matching applications (empty if a date is not DD-MM-YYYY)</returns>
+    virtual vector<LoanApplication> loadApplicationsSubmittedBetween(const string& fromDate,
+        const string& toDate) const;
+
+    /// <summary>
+    /// Streams the raw records of the partition segments and applications.txt in fixed-size batches
+    /// Lines are not parsed here so bulk jobs can parse them on worker threads
+    /// </summary>
+    /// <param name="batchSize">Maximum lines per batch</param>
+    /// <param name="onBatch">Receives each batch (ownership of the lines is handed over)</param>
+    /// <returns>False if the applications file could not be opened</returns>
+    bool forEachRecordBatch(size_t batchSize, const function<void(vector<string>&&)>& onBatch) const;
+
+    /// <summary>
+    /// Parses one stored record line (safe to call from worker threads)
+    /// </summary>
+    /// <param name="line">Record as written in applications.txt</param>
+    /// <param name="application">Output: parsed application</param>
+    /// <returns>True if the line held a usable application</returns>
+    bool parseApplicationRecord(const string& line, LoanApplication& application) const;
+
+    /// <summary>
+    /// Parses a record known to be in a given layout, such as one from
+    /// formatApplicationRecord (always RecordSchema::current())
+    /// </summary>
+    bool parseApplicationRecord(const string& line, LoanApplication& application,
+        const RecordSchema& schema) const;
+
+    /// <summary>
+    /// Parses a record a client built with formatApplicationRecord, refusing one
+    /// that would not be stored as sent: a line break starts another record, and
+    /// a field holding the delimiter shifts every field after it
+    /// </summary>
+    /// <param name="record">Record as received (the ID may still be empty)</param>
+    /// <param name="application">Output: parsed application</param>
+    /// <returns>False if the record is malformed or names an unknown coded value</returns>
+    bool parseSubmittedRecord(const string& record, LoanApplication& application) const;
+
+    /// <summary>
+    /// Lists the stored records that cannot be decoded (every load skips them),
+    /// in applications.txt and every archive segment, with their text as stored
+    /// </summary>
+    vector<UnreadableRecord> findUnreadableRecords() const;
+
+    /// <summary>
+    /// Formats an application as one stored record line (inverse of parseApplicationRecord)
+    /// </summary>
+    /// <param name="application">Application to format</param>
+    /// <returns>Record without a trailing newline</returns>
+    string formatApplicationRecord(const LoanApplication& application) const;
+
     /// <summary>
     /// Finds a specific application by ID
     /// </summary>
     /// <param name="applicationId">Unique application ID</param>
     /// <returns>Application object (empty if not found)</returns>
-    LoanApplication findApplicationById(const string& applicationId) const;
+    virtual LoanApplication findApplicationById(const string& applicationId) const;
 
     /// <summary>
     /// Finds all applications for a specific CNIC
     /// </summary>
     /// <param name="cnic">13-digit CNIC number</param>
     /// <returns>Vector of applications by this person</returns>
-    vector<LoanApplication> findApplicationsByCNIC(const string& cnic) const;
+    virtual vector<LoanApplication> findApplicationsByCNIC(const string& cnic) const;
 
     /// <summary>
     /// Finds incomplete application for resuming
@@ -123,7 +613,7 @@ public:
     /// <param name="applicationId">Application ID</param>
     /// <param name="cnic">User's CNIC for verification</param>
     /// <returns>Incomplete application (empty if not found/complete)</returns>
-    LoanApplication findIncompleteApplication(const string& applicationId,
+    virtual LoanApplication findIncompleteApplication(const string& applicationId,
         const string& cnic) const;
 
     /// <summary>
@@ -131,7 +621,7 @@ public:
     /// </summary>
     /// <param name="cnic">User's CNIC</param>
     /// <returns>Vector of incomplete applications</returns>
-    vector<LoanApplication> findUserIncompleteApplications(const string& cnic) const;
+    virtual vector<LoanApplication> findUserIncompleteApplications(const string& cnic) const;
 
     /// <summary>
     /// Checks if user can update a specific application
@@ -159,7 +649,7 @@ public:
     /// <param name="newStatus">New status (approved/rejected)</param>
     /// <param name="rejectionReason">Reason if rejected (optional)</param>
     /// <returns>True if update successful</returns>
-    bool updateApplicationStatus(const string& applicationId,
+    virtual bool updateApplicationStatus(const string& applicationId,
         const string& newStatus,
         const string& rejectionReason = "");
 };
@@ -0,0 +1,255 @@
+#include "file_watcher.h"
+#include "utilities.h"
+#include <iostream>
+#include <chrono>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <cerrno>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#endif
+
+using namespace std;
+
+namespace {
+    void splitPath(const string& path, string& directory, string& name) {
+        size_t slash = path.find_last_of("/\\");
+        if (slash == string::npos) {
+            directory = ".";
+            name = path;
+        }
+        else {
+            directory = (slash == 0) ? path.substr(0, 1) : path.substr(0, slash);
+            name = path.substr(slash + 1);
+        }
+    }
+
+#ifndef __linux__
+    /// <summary>
+    /// Size and modification time of a file; both -1 if it does not exist
+    /// </summary>
+    void readFileStamp(const string& path, long long& size, long long& modified) {
+#ifdef _WIN32
+        struct _stat64 info;
+        bool exists = (_stat64(path.c_str(), &info) == 0);
+#else
+        struct stat info;
+        bool exists = (stat(path.c_str(), &info) == 0);
+#endif
+        size = exists ? static_cast<long long>(info.st_size) : -1;
+        modified = exists ? static_cast<long long>(info.st_mtime) : -1;
+    }
+#endif
+}
+
+#ifdef __linux__
+
+FileWatcher::FileWatcher() : running(false), inotifyFd(-1), wakeFd(-1) {
+}
+
+#else
+
+FileWatcher::FileWatcher() : running(false) {
+}
+
+#endif
+
+FileWatcher::~FileWatcher() {
+    stop();
+}
+
+void FileWatcher::watch(const string& path, function<void()> onChange) {
+    WatchedFile file;
+    file.path = path;
+    splitPath(path, file.directory, file.name);
+    file.onChange = move(onChange);
+    files.push_back(move(file));
+}
+
+void FileWatcher::notifyChanged() {
+    for (auto& file : files) {
+        if (file.changed) {
+            file.changed = false;
+            file.onChange();
+        }
+    }
+}
+
+#ifdef __linux__
+
+bool FileWatcher::start() {
+    if (running) return true;
+
+    inotifyFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (inotifyFd < 0 || wakeFd < 0) {
+        cerr << "Error: Could not start watching data files" << endl;
+        stop();
+        return false;
+    }
+
+    // Watching the directory also catches files replaced by rename
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE;
+    for (const auto& file : files) {
+        bool alreadyWatched = false;
+        for (const auto& entry : watchedDirectories) {
+            if (entry.second == file.directory) alreadyWatched = true;
+        }
+        if (alreadyWatched) continue;
+
+        int descriptor = inotify_add_watch(inotifyFd, file.directory.c_str(), mask);
+        if (descriptor < 0) {
+            cerr << "Warning: Could not watch " << file.directory << " for changes" << endl;
+            continue;
+        }
+        watchedDirectories.push_back(make_pair(descriptor, file.directory));
+    }
+
+    running = true;
+    worker = thread(&FileWatcher::run, this);
+    return true;
+}
+
+void FileWatcher::stop() {
+    if (running) {
+        running = false;
+        uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof(one)) < 0) {
+            cerr << "Warning: Could not wake the file watcher" << endl;
+        }
+        worker.join();
+    }
+
+    if (inotifyFd >= 0) close(inotifyFd);
+    if (wakeFd >= 0) close(wakeFd);
+    inotifyFd = -1;
+    wakeFd = -1;
+    watchedDirectories.clear();
+}
+
+bool FileWatcher::readEvents() {
+    alignas(inotify_event) char buffer[16 * 1024];
+    bool readAny = false;
+
+    while (true) {
+        ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) break;
+        readAny = true;
+
+        for (ssize_t offset = 0; offset < length; ) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+            if (event->len == 0) continue;
+
+            const string* directory = nullptr;
+            for (const auto& entry : watchedDirectories) {
+                if (entry.first == event->wd) directory = &entry.second;
+            }
+            if (directory == nullptr) continue;
+
+            for (auto& file : files) {
+                if (file.name == event->name && file.directory == *directory) {
+                    file.changed = true;
+                }
+            }
+        }
+    }
+    return readAny;
+}
+
+void FileWatcher::run() {
+    pollfd watched[2] = {};
+    watched[0].fd = inotifyFd;
+    watched[0].events = POLLIN;
+    watched[1].fd = wakeFd;
+    watched[1].events = POLLIN;
+
+    bool pending = false;
+    while (running) {
+        // Once something changed, wait for the burst to settle before reporting
+        int timeoutMs = pending ? Config::WATCH_SETTLE_MS : -1;
+        int ready = poll(watched, 2, timeoutMs);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            cerr << "Error: Watching data files failed" << endl;
+            return;
+        }
+        if (!running || (watched[1].revents & POLLIN)) break;
+
+        if (ready == 0) {
+            pending = false;
+            notifyChanged();
+            continue;
+        }
+        if (readEvents()) {
+            for (const auto& file : files) {
+                if (file.changed) pending = true;
+            }
+        }
+    }
+}
+
+#else
+
+bool FileWatcher::start() {
+    if (running) return true;
+
+    for (auto& file : files) {
+        readFileStamp(file.path, file.size, file.modified);
+    }
+    running = true;
+    worker = thread(&FileWatcher::run, this);
+    return true;
+}
+
+void FileWatcher::stop() {
+    if (!running) return;
+    {
+        lock_guard<mutex> lock(stopMutex);
+        running = false;
+    }
+    stopSignal.notify_all();
+    worker.join();
+}
+
+bool FileWatcher::readEvents() {
+    bool anyChanged = false;
+    for (auto& file : files) {
+        long long size = 0;
+        long long modified = 0;
+        readFileStamp(file.path, size, modified);
+        if (size != file.size || modified != file.modified) {
+            file.size = size;
+            file.modified = modified;
+            file.changed = true;
+            anyChanged = true;
+        }
+    }
+    return anyChanged;
+}
+
+void FileWatcher::run() {
+    bool pending = false;
+    while (true) {
+        {
+            unique_lock<mutex> lock(stopMutex);
+            int waitMs = pending ? Config::WATCH_SETTLE_MS : Config::WATCH_POLL_MS;
+            stopSignal.wait_for(lock, chrono::milliseconds(waitMs), [this]() { return !running; });
+            if (!running) return;
+        }
+
+        // Report only after a poll that saw no further change
+        if (readEvents()) {
+            pending = true;
+        }
+        else if (pending) {
+            pending = false;
+            notifyChanged();
+        }
+    }
+}
+
+#endif
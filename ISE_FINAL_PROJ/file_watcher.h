@@ -0,0 +1,94 @@
+#ifndef FILE_WATCHER_H
+#define FILE_WATCHER_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+using namespace std;
+
+/// <summary>
+/// Calls back when a data file changes on disk, from a background thread
+/// On Linux the parent directories are watched with inotify, so edits made in
+/// place, appends and editors that save by renaming over the file are all
+/// seen. Elsewhere the files' size and modification time are polled.
+/// A burst of changes (truncate + write, several appends) is reported once
+/// after it has settled for Config::WATCH_SETTLE_MS.
+/// SE Principles:
+/// - Observer Pattern: owners register what to do, the watcher only detects
+/// - Information Hiding: callers never see inotify or the polling fallback
+/// </summary>
+class FileWatcher {
+private:
+    struct WatchedFile {
+        string path;
+        string directory;
+        string name;
+        function<void()> onChange;
+        long long size;             // Polling fallback: last seen size
+        long long modified;         // Polling fallback: last seen modification time
+        bool changed;
+
+        WatchedFile() : size(-1), modified(-1), changed(false) {}
+    };
+
+    vector<WatchedFile> files;
+    thread worker;
+    atomic<bool> running;
+
+#ifdef __linux__
+    int inotifyFd;
+    int wakeFd;                     // eventfd that interrupts the worker on stop()
+    vector<pair<int, string>> watchedDirectories;   // inotify watch descriptor -> directory
+#else
+    mutex stopMutex;
+    condition_variable stopSignal;
+#endif
+
+    /// <summary>
+    /// Worker thread body
+    /// </summary>
+    void run();
+
+    /// <summary>
+    /// Marks files named by the queued inotify events as changed
+    /// </summary>
+    /// <returns>False if nothing could be read</returns>
+    bool readEvents();
+
+    /// <summary>
+    /// Calls onChange for every file marked as changed, then clears the marks
+    /// </summary>
+    void notifyChanged();
+
+public:
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /// <summary>
+    /// Registers a file (call before start)
+    /// </summary>
+    /// <param name="path">File to watch; it need not exist yet</param>
+    /// <param name="onChange">Runs on the watcher thread after the file changed</param>
+    void watch(const string& path, function<void()> onChange);
+
+    /// <summary>
+    /// Starts the watcher thread
+    /// </summary>
+    /// <returns>False if change notification is unavailable</returns>
+    bool start();
+
+    /// <summary>
+    /// Stops and joins the watcher thread (no callbacks run afterwards)
+    /// </summary>
+    void stop();
+};
+
+#endif
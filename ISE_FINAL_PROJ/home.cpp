@@ -1,6 +1,8 @@
 #include "home.h"
 #include "utilities.h"
-#include <fstream>
+#include "text_scanner.h"
+#include "installment_schedule.h"
+#include "screen_buffer.h"
 #include <iostream>
 #include <stdexcept>
 #include <iomanip>
@@ -63,9 +65,9 @@ long long HomeLoan::calculateMonthlyInstallment() const {
 }
 
 int loadHomeLoans(HomeLoan loans[], int maxSize, const string& filename) {
-    ifstream file(filename);
+    LineReader file(filename);
 
-    if (!file.is_open()) {
+    if (!file.isOpen()) {
         cerr << "Error: Could not open " << filename << endl;
         return 0;
     }
@@ -75,7 +77,7 @@ int loadHomeLoans(HomeLoan loans[], int maxSize, const string& filename) {
     int lineNumber = 0;
     bool firstLine = true;
 
-    while (getline(file, line) && count < maxSize) {
+    while (count < maxSize && file.next(line)) {
         lineNumber++;
 
         if (firstLine) {
@@ -110,7 +112,6 @@ int loadHomeLoans(HomeLoan loans[], int maxSize, const string& filename) {
         }
     }
 
-    file.close();
     return count;
 }
 
@@ -119,29 +120,29 @@ bool displayHomeLoanOptions(const HomeLoan loans[], int size, const string& area
     bool found = false;
     int optionCount = 0;
 
-    cout << endl << "  Home Loan Options for " << areaName << endl;
-    cout << "+-----+----------+--------------+-------------+---------------+-------------------------+" << endl;
-    cout << "| Opt |   Size   | Installments | Total Price | Down Payment  | Monthly Installment     |" << endl;
-    cout << "+-----+----------+--------------+-------------+---------------+-------------------------+" << endl;
+    screen << '\n' << "  Home Loan Options for " << areaName << '\n';
+    screen << "+-----+----------+--------------+-------------+---------------+-------------------------+" << '\n';
+    screen << "| Opt |   Size   | Installments | Total Price | Down Payment  | Monthly Installment     |" << '\n';
+    screen << "+-----+----------+--------------+-------------+---------------+-------------------------+" << '\n';
 
     for (int i = 0; i < size; i++) {
         if (loans[i].getArea() == areaName) {
             found = true;
             optionCount++;
             long long monthlyInstallment = loans[i].calculateMonthlyInstallment();
-            cout << "| " << setw(3) << optionCount << " | "
+            screen << "| " << setw(3) << optionCount << " | "
                 << setw(8) << loans[i].getSize() << " | "
                 << setw(12) << loans[i].getInstallments() << " | "
                 << "PKR " << setw(8) << loans[i].getPrice() << " | "
                 << "PKR " << setw(10) << loans[i].getDownPayment() << " | "
-                << "PKR " << setw(17) << monthlyInstallment << " |" << endl;
+                << "PKR " << setw(17) << monthlyInstallment << " |" << '\n';
         }
     }
 
-    cout << "+-----+----------+--------------+-------------+---------------+-------------------------+" << endl;
+    screen << "+-----+----------+--------------+-------------+---------------+-------------------------+" << '\n';
 
     if (!found) {
-        cout << "Sorry, no loan options available for this area at the moment." << endl;
+        screen << "Sorry, no loan options available for this area at the moment." << '\n';
     }
 
     return found;
@@ -151,48 +152,31 @@ void HomeLoan::displayInstallmentPlan() const {
     long long monthlyInstallment = calculateMonthlyInstallment();
     long long remainingBalance = getPrice() - getDownPayment();
 
-    cout << endl << "  INSTALLMENT PLAN DETAILS" << endl;
-    cout << "========================================" << endl;
-    cout << "Property Details:" << endl;
-    cout << "  Area: " << getArea() << endl;
-    cout << "  Size: " << getSize() << endl;
-    cout << "  Total Price: PKR " << getPrice() << endl;
-    cout << "  Down Payment: PKR " << getDownPayment() << endl;
-    cout << "  Loan Amount: PKR " << remainingBalance << endl;
-    cout << "  Installment Period: " << getInstallments() << " months" << endl;
-    cout << "  Monthly Installment: PKR " << monthlyInstallment << endl;
-    cout << "========================================" << endl << endl;
-
-    cout << "Monthly Payment Schedule:" << endl;
-    cout << "+-------+----------------+---------------+" << endl;
-    cout << "| Month |  Payment Due   | Remaining Bal |" << endl;
-    cout << "+-------+----------------+---------------+" << endl;
-
-    long long currentBalance = remainingBalance;
-
-    for (int month = 1; month <= getInstallments(); month++) {
-        long long paymentDue = monthlyInstallment;
-
-        if (month == getInstallments()) {
-            paymentDue = currentBalance;
-        }
-
-        cout << "| " << setw(5) << month << " | PKR " << setw(10) << paymentDue
-            << " | PKR " << setw(10) << (currentBalance - paymentDue) << " |" << endl;
+    screen << '\n' << "  INSTALLMENT PLAN DETAILS" << '\n';
+    screen << "========================================" << '\n';
+    screen << "Property Details:" << '\n';
+    screen << "  Area: " << getArea() << '\n';
+    screen << "  Size: " << getSize() << '\n';
+    screen << "  Total Price: PKR " << getPrice() << '\n';
+    screen << "  Down Payment: PKR " << getDownPayment() << '\n';
+    screen << "  Loan Amount: PKR " << remainingBalance << '\n';
+    screen << "  Installment Period: " << getInstallments() << " months" << '\n';
+    screen << "  Monthly Installment: PKR " << monthlyInstallment << '\n';
+    screen << "========================================" << '\n' << '\n';
 
-        currentBalance -= paymentDue;
-        if (currentBalance < 0) currentBalance = 0;
-    }
+    screen << "Monthly Payment Schedule:" << '\n';
 
-    cout << "+-------+----------------+---------------+" << endl << endl;
+    InstallmentSchedule schedule(remainingBalance, getInstallments(), monthlyInstallment);
+    schedule.writeTable(screen);
+    screen << '\n';
 
     long long totalPayment = getDownPayment() + (monthlyInstallment * getInstallments());
     long long totalInstallments = monthlyInstallment * getInstallments();
 
-    cout << "Payment Summary:" << endl;
-    cout << "  Total Payment: PKR " << totalPayment << endl;
-    cout << "  Down Payment: PKR " << getDownPayment() << endl;
-    cout << "  Total Installments: PKR " << totalInstallments << endl;
+    screen << "Payment Summary:" << '\n';
+    screen << "  Total Payment: PKR " << totalPayment << '\n';
+    screen << "  Down Payment: PKR " << getDownPayment() << '\n';
+    screen << "  Total Installments: PKR " << totalInstallments << '\n';
 }
 
 bool displayInstallmentPlanForOption(const HomeLoan loans[], int size,
@@ -210,6 +194,6 @@ bool displayInstallmentPlanForOption(const HomeLoan loans[], int size,
         }
     }
 
-    cout << "Invalid option number. Please try again." << endl;
+    screen << "Invalid option number. Please try again." << '\n';
     return false;
 }
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "installment_schedule.h"
+#include "utilities.h"
+#include <cstdio>
+#include <stdexcept>
+
+using namespace std;
+
+InstallmentSchedule::InstallmentSchedule(long long financed, int months, long long monthly,
+    int firstMonth, int firstYear) {
+    financedAmount = (financed < 0) ? 0 : financed;
+    totalMonths = (months < 0) ? 0 : months;
+    monthlyPayment = (monthly < 0) ? 0 : monthly;
+    startMonth = (firstMonth >= 1 && firstMonth <= 12) ? firstMonth : 0;
+    startYear = firstYear;
+    cursor = 1;
+}
+
+int InstallmentSchedule::getTotalMonths() const { return totalMonths; }
+long long InstallmentSchedule::getFinancedAmount() const { return financedAmount; }
+long long InstallmentSchedule::getMonthlyPayment() const { return monthlyPayment; }
+bool InstallmentSchedule::hasCalendar() const { return startMonth != 0; }
+
+long long InstallmentSchedule::balanceAfter(int month) const {
+    if (month <= 0) return financedAmount;
+    if (month >= totalMonths) return 0;
+
+    long long balance = financedAmount - monthlyPayment * month;
+    return (balance < 0) ? 0 : balance;
+}
+
+InstallmentRow InstallmentSchedule::rowAt(int month) const {
+    if (month < 1 || month > totalMonths) {
+        throw out_of_range("Month " + to_string(month) + " is outside the installment plan");
+    }
+
+    InstallmentRow row;
+    row.monthNumber = month;
+
+    // The final installment settles whatever is left
+    row.paymentDue = (month == totalMonths) ? balanceAfter(month - 1) : monthlyPayment;
+    row.remainingBalance = balanceAfter(month);
+
+    if (hasCalendar()) {
+        int offset = (startMonth - 1) + (month - 1);
+        row.calendarMonth = offset % 12 + 1;
+        row.calendarYear = startYear + offset / 12;
+    }
+    return row;
+}
+
+long long InstallmentSchedule::totalOfPayments() const {
+    if (totalMonths <= 0) return 0;
+    return monthlyPayment * (totalMonths - 1) + balanceAfter(totalMonths - 1);
+}
+
+void InstallmentSchedule::getCompletionDate(int& month, int& year) const {
+    int offset = (startMonth - 1) + totalMonths;
+    month = offset % 12 + 1;
+    year = startYear + offset / 12;
+}
+
+bool InstallmentSchedule::next(InstallmentRow& row) {
+    if (cursor > totalMonths) return false;
+    row = rowAt(cursor);
+    cursor++;
+    return true;
+}
+
+void InstallmentSchedule::seek(int month) {
+    if (month < 1) month = 1;
+    cursor = month;
+}
+
+void InstallmentSchedule::reset() {
+    cursor = 1;
+}
+
+int InstallmentSchedule::getPageCount(int pageSize) const {
+    if (pageSize <= 0 || totalMonths <= 0) return 0;
+    return (totalMonths + pageSize - 1) / pageSize;
+}
+
+void InstallmentSchedule::appendHeader(string& buffer) const {
+    if (hasCalendar()) {
+        buffer += "+-------+------------------+------+------------------+------------------+\n";
+        buffer += "| Month | Month Name       | Year | Payment Due      | Remaining Balance|\n";
+        buffer += "+-------+------------------+------+------------------+------------------+\n";
+    }
+    else {
+        buffer += "+-------+----------------+---------------+\n";
+        buffer += "| Month |  Payment Due   | Remaining Bal |\n";
+        buffer += "+-------+----------------+---------------+\n";
+    }
+}
+
+void InstallmentSchedule::appendFooter(string& buffer) const {
+    if (hasCalendar()) {
+        buffer += "+-------+------------------+------+------------------+------------------+\n";
+    }
+    else {
+        buffer += "+-------+----------------+---------------+\n";
+    }
+}
+
+void InstallmentSchedule::appendRow(string& buffer, const InstallmentRow& row) const {
+    char line[160];
+    int length;
+
+    if (hasCalendar()) {
+        length = snprintf(line, sizeof(line), "| %5d | %-16s | %-4d | PKR %12lld | PKR %12lld |\n",
+            row.monthNumber, getMonthName(row.calendarMonth).c_str(), row.calendarYear,
+            row.paymentDue, row.remainingBalance);
+    }
+    else {
+        length = snprintf(line, sizeof(line), "| %5d | PKR %10lld | PKR %10lld |\n",
+            row.monthNumber, row.paymentDue, row.remainingBalance);
+    }
+
+    if (length > 0) {
+        size_t size = static_cast<size_t>(length);
+        buffer.append(line, (size < sizeof(line)) ? size : sizeof(line) - 1);
+    }
+}
+
+int InstallmentSchedule::writeRows(ostream& out, int firstMonth, int count) const {
+    if (firstMonth < 1) firstMonth = 1;
+    int lastMonth = firstMonth + count - 1;
+    if (lastMonth > totalMonths) lastMonth = totalMonths;
+
+    int rows = (lastMonth >= firstMonth) ? (lastMonth - firstMonth + 1) : 0;
+    string buffer;
+    buffer.reserve(static_cast<size_t>(rows + 4) * 80);
+
+    appendHeader(buffer);
+    int written = 0;
+    for (int month = firstMonth; month <= lastMonth; month++) {
+        appendRow(buffer, rowAt(month));
+        written++;
+    }
+    appendFooter(buffer);
+
+    out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+    return written;
+}
+
+int InstallmentSchedule::writePage(ostream& out, int pageIndex, int pageSize) const {
+    if (pageSize <= 0 || pageIndex < 0) return 0;
+    return writeRows(out, pageIndex * pageSize + 1, pageSize);
+}
+
+void InstallmentSchedule::writeTable(ostream& out) const {
+    writeRows(out, 1, totalMonths);
+}
@@ -0,0 +1,124 @@
+#ifndef INSTALLMENT_SCHEDULE_H
+#define INSTALLMENT_SCHEDULE_H
+
+#include <string>
+#include <ostream>
+using namespace std;
+
+/// <summary>
+/// One row of a monthly repayment schedule
+/// </summary>
+struct InstallmentRow {
+    int monthNumber;            // 1-based position in the plan
+    int calendarMonth;          // 1-12, or 0 when the schedule has no start date
+    int calendarYear;
+    long long paymentDue;
+    long long remainingBalance; // Balance left after this payment
+
+    InstallmentRow() : monthNumber(0), calendarMonth(0), calendarYear(0),
+        paymentDue(0), remainingBalance(0) {}
+};
+
+/// <summary>
+/// Generates repayment schedule rows on demand, shared by all loan types
+/// SE Principles:
+/// - Iterator Pattern: rows are produced lazily with next()
+/// - Single Responsibility: schedule maths and table layout live in one place
+/// - DRY: replaces the four copies of the schedule loop in the catalog classes
+/// </summary>
+class InstallmentSchedule {
+private:
+    long long financedAmount;
+    int totalMonths;
+    long long monthlyPayment;
+    int startMonth;
+    int startYear;
+    int cursor;                 // Month number that next() returns
+
+    void appendRow(string& buffer, const InstallmentRow& row) const;
+    void appendHeader(string& buffer) const;
+    void appendFooter(string& buffer) const;
+
+public:
+    /// <summary>
+    /// Creates a schedule for a financed amount
+    /// </summary>
+    /// <param name="financed">Amount to repay (price minus down payment)</param>
+    /// <param name="months">Number of installments</param>
+    /// <param name="monthly">Regular monthly installment</param>
+    /// <param name="firstMonth">Calendar month of the first payment (1-12), 0 for none</param>
+    /// <param name="firstYear">Calendar year of the first payment</param>
+    InstallmentSchedule(long long financed, int months, long long monthly,
+        int firstMonth = 0, int firstYear = 0);
+
+    int getTotalMonths() const;
+    long long getFinancedAmount() const;
+    long long getMonthlyPayment() const;
+
+    /// <summary>
+    /// Checks if rows carry calendar month/year (user plan layout)
+    /// </summary>
+    bool hasCalendar() const;
+
+    /// <summary>
+    /// Closed-form balance remaining after a given month, O(1)
+    /// </summary>
+    /// <param name="month">Month number (0 = before the first payment)</param>
+    /// <returns>Remaining balance, never negative</returns>
+    long long balanceAfter(int month) const;
+
+    /// <summary>
+    /// Builds the row for any month directly ("jump to month N"), O(1)
+    /// </summary>
+    /// <param name="month">Month number (1..getTotalMonths())</param>
+    /// <exception cref="out_of_range">Thrown if month is outside the plan</exception>
+    InstallmentRow rowAt(int month) const;
+
+    /// <summary>
+    /// Sum of all installments actually paid over the plan
+    /// </summary>
+    long long totalOfPayments() const;
+
+    /// <summary>
+    /// Gets the calendar month following the last installment
+    /// </summary>
+    void getCompletionDate(int& month, int& year) const;
+
+    /// <summary>
+    /// Yields the next row of the schedule
+    /// </summary>
+    /// <param name="row">Output row</param>
+    /// <returns>False once every row has been produced</returns>
+    bool next(InstallmentRow& row);
+
+    /// <summary>
+    /// Positions the generator so next() returns the given month
+    /// </summary>
+    void seek(int month);
+
+    void reset();
+
+    /// <summary>
+    /// Gets the number of pages for a given page size
+    /// </summary>
+    int getPageCount(int pageSize) const;
+
+    /// <summary>
+    /// Writes rows [firstMonth, firstMonth + count) with table borders in one write
+    /// </summary>
+    /// <returns>Number of rows written</returns>
+    int writeRows(ostream& out, int firstMonth, int count) const;
+
+    /// <summary>
+    /// Writes one page of the schedule (pageIndex is 0-based)
+    /// </summary>
+    /// <returns>Number of rows written</returns>
+    int writePage(ostream& out, int pageIndex, int pageSize) const;
+
+    /// <summary>
+    /// Exports the complete table, buffered and written in a single call
+    /// </summary>
+    void writeTable(ostream& out) const;
+};
+
+#endif
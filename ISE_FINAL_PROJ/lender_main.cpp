@@ -3,20 +3,117 @@
 #include "file_manager.h"
 #include "application.h"
 #include "utilities.h"
+#include "screen_buffer.h"
 #include "ui_handler.h"
+#include "cached_file_manager.h"
+#include "application_server.h"
+#include "file_watcher.h"
 
 using namespace std;
 
 // Forward declarations from lender_server.cpp
-void handleLenderCommands(FileManager& fileManager);
+void handleLenderCommands(FileManager& fileManager, ApplicationServer* server = nullptr);
 
-int main() {
-    FileManager fileManager;
+/// <summary>
+/// Usage: lender_server [--serve [socket path | tcp:PORT]] | --rebuild-index | --archive | --migrate
+/// With --serve the store is held in memory and user clients are answered
+/// over the server socket whenever the lender menu is waiting for input;
+/// applications.txt is watched so outside changes are picked up.
+/// --rebuild-index rewrites applications.txt.idx and its Bloom filter, then exits
+/// --archive moves the decided applications in applications.txt to their
+/// submission month's archive segment (as each new decision is), then exits
+/// --migrate rewrites records from before the format header in the current
+/// format (done on its own when a store without the header is opened), then exits
+/// </summary>
+int main(int argc, char* argv[]) {
+    bool serve = false;
+    bool rebuildIndex = false;
+    bool archive = false;
+    bool migrate = false;
+    string address = Config::SERVER_ADDRESS;
+    for (int i = 1; i < argc; i++) {
+        string argument = argv[i];
+        if (argument == "--serve") {
+            serve = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                address = argv[++i];
+            }
+        }
+        else if (argument == "--rebuild-index") {
+            rebuildIndex = true;
+        }
+        else if (argument == "--archive") {
+            archive = true;
+        }
+        else if (argument == "--migrate") {
+            migrate = true;
+        }
+    }
 
-    cout << endl<<"LOAN PROCESSING SYSTEM           " << endl;
-    cout << endl<<"LENDER SERVER                    " << endl<<endl;
+    if (rebuildIndex) {
+        FileManager fileManager;
+        if (!fileManager.rebuildRecordIndex()) {
+            cerr << "Error: Could not index " << fileManager.getApplicationsFile() << endl;
+            return 1;
+        }
+        return 0;
+    }
 
-    handleLenderCommands(fileManager);
+    if (archive) {
+        FileManager fileManager;
+        if (!fileManager.archiveDecidedApplications()) {
+            cerr << "Error: Could not archive " << fileManager.getApplicationsFile() << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (migrate) {
+        FileManager fileManager;
+        if (!fileManager.migrateRecordFormat()) {
+            cerr << "Error: Could not migrate " << fileManager.getApplicationsFile() << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    screen << '\n'<<"LOAN PROCESSING SYSTEM           " << '\n';
+    screen << '\n'<<"LENDER SERVER                    " << '\n'<<'\n';
+
+    if (!serve) {
+        FileManager fileManager;
+        handleLenderCommands(fileManager);
+        return 0;
+    }
+
+    CachedFileManager store;
+    ApplicationServer server(store, address);
+
+    // Clients that fell back to writing applications.txt directly, or edits
+    // made by hand, reach the in-memory store without a restart (archiving
+    // a decision rewrites applications.txt too)
+    FileWatcher storeWatcher;
+    storeWatcher.watch(store.getApplicationsFile(), [&store]() { store.refreshFromFile(); });
+    storeWatcher.start();
+
+    if (server.start()) {
+        // Decisions made here or by any client reach the users waiting on them
+        store.setStatusListener([&server](const LoanApplication& application) {
+            server.publishStatusChange(application);
+        });
+        screen << "Serving " << store.getCachedCount() << " application record(s) on " << address << '\n';
+        if (!server.getLenderAddress().empty()) {
+            screen << "Lender tools connect to " << server.getLenderAddress() << '\n';
+        }
+        handleLenderCommands(store, &server);
+    }
+    else {
+        screen << "Could not start the server on " << address << "; user clients will use the file directly." << '\n';
+        handleLenderCommands(store);
+    }
+    storeWatcher.stop();
+    store.setStatusListener(nullptr);
+    server.stop();
 
     return 0;
 }
\ No newline at end of file
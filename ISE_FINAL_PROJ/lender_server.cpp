@@ -1,67 +1,87 @@
 ﻿#include <iostream>
 #include <string>
+#include <unordered_set>
+#include <algorithm>
 #include "file_manager.h"
 #include "application.h"
 #include "utilities.h"
+#include "screen_buffer.h"
 #include "ui_handler.h"
+#include "batch_validator.h"
+#include "application_server.h"
 
 using namespace std;
 
+// Set while lender_server --serve is running: waiting for the lender's input
+// is when user clients get served
+static ApplicationServer* activeServer = nullptr;
 
-void handleLenderCommands(FileManager& fileManager);
+void handleLenderCommands(FileManager& fileManager, ApplicationServer* server = nullptr);
+bool readLenderInput(string& input);
 void displayLenderMenu();
 void viewAllApplications(FileManager& fileManager);
 void viewApplicationsByStatus(FileManager& fileManager, const string& status);
 void reviewAndProcessApplications(FileManager& fileManager);
 void displayApplicationStatistics(FileManager& fileManager);
 void searchApplicationById(FileManager& fileManager);
+void revalidateAllApplications(FileManager& fileManager);
+void viewApplicationsBySubmissionDate(FileManager& fileManager);
+void viewUnreadableRecords(FileManager& fileManager);
 void displayApplicationDetails(const LoanApplication& app);
 
+bool readLenderInput(string& input) {
+    if (activeServer == nullptr) {
+        return static_cast<bool>(getline(cin, input));
+    }
+
+    screen.present();
+    if (!activeServer->waitForConsoleLine(input)) {
+        input.clear();
+        return false;
+    }
+    return true;
+}
+
 void displayLenderMenu() {
-    cout << endl << "========== LENDER MENU ==========" << endl;
-    cout << "  1. View ALL Applications" << endl;
-    cout << "  2. View Pending Applications" << endl;
-    cout << "  3. View Approved Applications" << endl;
-    cout << "  4. View Rejected Applications" << endl;
-    cout << "  5. Review and Process Applications" << endl;
-    cout << "  6. Application Statistics" << endl;
-    cout << "  7. Search Application by ID" << endl;
-    cout << "  X. Exit" << endl;
-    cout << "=================================" << endl;
+    screen << '\n' << "========== LENDER MENU ==========" << '\n';
+    screen << "  1. View ALL Applications" << '\n';
+    screen << "  2. View Pending Applications" << '\n';
+    screen << "  3. View Approved Applications" << '\n';
+    screen << "  4. View Rejected Applications" << '\n';
+    screen << "  5. Review and Process Applications" << '\n';
+    screen << "  6. Application Statistics" << '\n';
+    screen << "  7. Search Application by ID" << '\n';
+    screen << "  8. Re-validate All Applications" << '\n';
+    screen << "  9. View Applications by Submission Date" << '\n';
+    screen << " 10. View Unreadable Records" << '\n';
+    screen << "  X. Exit" << '\n';
+    screen << "=================================" << '\n';
 }
 
 void viewAllApplications(FileManager& fileManager) {
-    auto allApplications = fileManager.loadAllApplications();
+    // Only the fields the list prints are read from each record
+    auto allApplications = fileManager.queryApplications(RecordQuery({
+        RecordField::FULL_NAME, RecordField::STATUS, RecordField::ANNUAL_INCOME }));
 
     if (allApplications.empty()) {
-        cout << endl << "No applications found." << endl;
+        screen << '\n' << "No applications found." << '\n';
         return;
     }
 
     // Remove duplicate application IDs - keep only the latest one
     vector<LoanApplication> uniqueApps;
-    vector<string> seenIds;
+    unordered_set<string> seenIds;
 
     // Go through in reverse to keep the latest entry for each ID
-    for (int i = allApplications.size() - 1; i >= 0; i--) {
-        string appId = allApplications[i].getApplicationId();
-        bool alreadySeen = false;
-
-        for (const auto& id : seenIds) {
-            if (id == appId) {
-                alreadySeen = true;
-                break;
-            }
-        }
-
-        if (!alreadySeen) {
-            uniqueApps.insert(uniqueApps.begin(), allApplications[i]);
-            seenIds.push_back(appId);
+    for (size_t i = allApplications.size(); i-- > 0;) {
+        if (seenIds.insert(allApplications[i].getApplicationId()).second) {
+            uniqueApps.push_back(move(allApplications[i]));
         }
     }
+    reverse(uniqueApps.begin(), uniqueApps.end());
 
-    cout << endl << "========== ALL APPLICATIONS ==========" << endl;
-    cout << "Total: " << uniqueApps.size() << endl << endl;
+    screen << '\n' << "========== ALL APPLICATIONS ==========" << '\n';
+    screen << "Total: " << uniqueApps.size() << '\n' << '\n';
 
     for (size_t i = 0; i < uniqueApps.size(); i++) {
         const auto& app = uniqueApps[i];
@@ -73,64 +93,63 @@ void viewAllApplications(FileManager& fileManager) {
         else if (displayStatus == "C3") displayStatus = "Incomplete (References)";
         else if (displayStatus == "incomplete_documents") displayStatus = "Incomplete (Documents)";
 
-        cout << (i + 1) << ". ID: " << app.getApplicationId()
+        screen << (i + 1) << ". ID: " << app.getApplicationId()
             << " | " << app.getFullName()
             << " | Status: " << displayStatus
-            << " | Income: PKR " << app.getAnnualIncome() << endl;
+            << " | Income: PKR " << app.getAnnualIncome() << '\n';
     }
 }
 
 void viewApplicationsByStatus(FileManager& fileManager, const string& status) {
-    auto allApplications = fileManager.loadAllApplications();
-    vector<LoanApplication> filteredApps;
-
-    for (const auto& app : allApplications) {
-        if (app.getStatus() == status) {
-            filteredApps.push_back(app);
-        }
-    }
+    // Decided applications are only in the archive; the pending queue is read on its own
+    ApplicationStatus code = ApplicationStatus::SUBMITTED;
+    tryParseStatus(status, code);
+    auto filteredApps = fileManager.queryApplications(RecordQuery(
+        { RecordField::STATUS, RecordField::FULL_NAME, RecordField::ANNUAL_INCOME },
+        [&status](const RecordView& record) { return record.get(RecordField::STATUS) == status; },
+        isDecidedStatus(code) ? QueryScope::ALL_APPLICATIONS : QueryScope::PENDING_APPLICATIONS));
 
     if (filteredApps.empty()) {
-        cout << endl << "No " << status << " applications found." << endl;
+        screen << '\n' << "No " << status << " applications found." << '\n';
         return;
     }
 
-    cout << endl << "========== " << status << " APPLICATIONS ==========" << endl;
+    screen << '\n' << "========== " << status << " APPLICATIONS ==========" << '\n';
     for (size_t i = 0; i < filteredApps.size(); i++) {
         const auto& app = filteredApps[i];
-        cout << (i + 1) << ". ID: " << app.getApplicationId()
+        screen << (i + 1) << ". ID: " << app.getApplicationId()
             << " | " << app.getFullName()
-            << " | Income: PKR " << app.getAnnualIncome() << endl;
+            << " | Income: PKR " << app.getAnnualIncome() << '\n';
     }
 }
 
 void reviewAndProcessApplications(FileManager& fileManager) {
-    auto allApplications = fileManager.loadAllApplications();
+    auto allApplications = fileManager.loadPendingApplications();
     vector<LoanApplication> pendingApps;
 
     for (const auto& app : allApplications) {
-        if (app.getStatus() == "submitted") {
+        if (app.getStatusCode() == ApplicationStatus::SUBMITTED) {
             pendingApps.push_back(app);
         }
     }
 
     if (pendingApps.empty()) {
-        cout << endl << "No pending applications." << endl;
+        screen << '\n' << "No pending applications." << '\n';
         return;
     }
 
     bool reviewing = true;
 
     while (reviewing) {
-        cout << endl << "========== PENDING APPLICATIONS ==========" << endl;
+        screen << '\n' << "========== PENDING APPLICATIONS ==========" << '\n';
         for (size_t i = 0; i < pendingApps.size(); i++) {
-            cout << (i + 1) << ". ID: " << pendingApps[i].getApplicationId()
-                << " | " << pendingApps[i].getFullName() << endl;
+            screen << (i + 1) << ". ID: " << pendingApps[i].getApplicationId()
+                << " | " << pendingApps[i].getFullName() << '\n';
         }
 
-        cout << endl << "Enter application number to review (or '0' to go back): ";
+        screen << '\n' << "Enter application number to review (or '0' to go back): ";
         string input;
-        getline(cin, input);
+        readLenderInput(input);
 
         // Check if user wants to go back
         if (input == "0") {
@@ -141,7 +160,7 @@ void reviewAndProcessApplications(FileManager& fileManager) {
         try {
             int appNum = stoi(input);
             if (appNum < 1 || appNum > static_cast<int>(pendingApps.size())) {
-                cout << "Invalid number. Please enter a valid application number from the list." << endl;
+                screen << "Invalid number. Please enter a valid application number from the list." << '\n';
                 continue; // Continue the loop to ask again
             }
 
@@ -153,8 +172,8 @@ void reviewAndProcessApplications(FileManager& fileManager) {
             // Handle approval/rejection
             bool actionCompleted = false;
             while (!actionCompleted) {
-                cout << endl << "Action: (A)pprove, (R)eject, or (B)ack to list? ";
-                getline(cin, input);
+                screen << '\n' << "Action: (A)pprove, (R)eject, or (B)ack to list? ";
+                readLenderInput(input);
                 input = toLower(trim(input));
 
                 string newStatus;
@@ -162,42 +181,46 @@ void reviewAndProcessApplications(FileManager& fileManager) {
 
                 if (input == "a" || input == "approve") {
                     newStatus = "approved";
-                    cout << " Application APPROVED." << endl;
+                    screen << " Application APPROVED." << '\n';
 
-                    cout << "Confirm? (Y/N): ";
-                    getline(cin, input);
+                    screen << "Confirm? (Y/N): ";
+                    readLenderInput(input);
 
                     if (toLower(trim(input)) == "y") {
                         if (fileManager.updateApplicationStatus(fullApp.getApplicationId(), newStatus, rejectionReason)) {
-                            cout << " Status updated!" << endl;
+                            screen << " Status updated!" << '\n';
                             // Remove from pending apps since it's processed
                             pendingApps.erase(pendingApps.begin() + (appNum - 1));
                         }
                         actionCompleted = true;
                     }
                     else {
-                        cout << "Approval cancelled." << endl;
+                        screen << "Approval cancelled." << '\n';
                         actionCompleted = true;
                     }
                 }
                 else if (input == "r" || input == "reject") {
                     newStatus = "rejected";
-                    cout << "Enter rejection reason: ";
-                    getline(cin, rejectionReason);
+                    screen << "Enter rejection reason: ";
+                    readLenderInput(rejectionReason);
+                    while (!isStorableField(rejectionReason)) {
+                        screen << "The reason cannot contain '" << Config::DELIMITER << "'. Enter rejection reason: ";
+                        if (!readLenderInput(rejectionReason)) break;
+                    }
 
-                    cout << "Confirm rejection? (Y/N): ";
-                    getline(cin, input);
+                    screen << "Confirm rejection? (Y/N): ";
+                    readLenderInput(input);
 
                     if (toLower(trim(input)) == "y") {
                         if (fileManager.updateApplicationStatus(fullApp.getApplicationId(), newStatus, rejectionReason)) {
-                            cout << " Application REJECTED." << endl;
+                            screen << " Application REJECTED." << '\n';
                            
                             pendingApps.erase(pendingApps.begin() + (appNum - 1));
                         }
                         actionCompleted = true;
                     }
                     else {
-                        cout << "Rejection cancelled." << endl;
+                        screen << "Rejection cancelled." << '\n';
                         actionCompleted = true;
                     }
                 }
@@ -205,73 +228,133 @@ void reviewAndProcessApplications(FileManager& fileManager) {
                     actionCompleted = true; 
                 }
                 else {
-                    cout << "Invalid action. Please enter A, R, or B." << endl;
+                    screen << "Invalid action. Please enter A, R, or B." << '\n';
                 }
             }
 
             if (pendingApps.empty()) {
-                cout << endl << "No more pending applications." << endl;
+                screen << '\n' << "No more pending applications." << '\n';
                 reviewing = false;
             }
 
         }
         catch (const exception& e) {
-            cout << "Invalid input. Please enter a valid number." << endl;
+            screen << "Invalid input. Please enter a valid number." << '\n';
         }
     }
 }
 
 void displayApplicationStatistics(FileManager& fileManager) {
-    auto allApplications = fileManager.loadAllApplications();
-    int submitted = 0, approved = 0, rejected = 0;
-
-    for (const auto& app : allApplications) {
-        string status = app.getStatus();
-        if (status == "submitted") submitted++;
-        else if (status == "approved") approved++;
-        else if (status == "rejected") rejected++;
-    }
-
-    int total = allApplications.size();
-    cout << endl << "========== STATISTICS ==========" << endl;
-    cout << "Total: " << total << endl;
-    cout << "Pending: " << submitted << endl;
-    cout << "Approved: " << approved << endl;
-    cout << "Rejected: " << rejected << endl;
+    // Counted from the status field alone; no application is built
+    int total = 0, submitted = 0, approved = 0, rejected = 0;
+    fileManager.forEachRecord(RecordQuery({ RecordField::STATUS }), [&](const RecordView& record) {
+        total++;
+        ApplicationStatus status = ApplicationStatus::SUBMITTED;
+        if (!tryParseStatus(record.get(RecordField::STATUS), status)) return;
+        if (status == ApplicationStatus::SUBMITTED) submitted++;
+        else if (status == ApplicationStatus::APPROVED) approved++;
+        else if (status == ApplicationStatus::REJECTED) rejected++;
+    });
+
+    screen << '\n' << "========== STATISTICS ==========" << '\n';
+    screen << "Total: " << total << '\n';
+    screen << "Pending: " << submitted << '\n';
+    screen << "Approved: " << approved << '\n';
+    screen << "Rejected: " << rejected << '\n';
     if (total > 0) {
-        cout << "Approval Rate: " << (approved * 100.0 / total) << "%" << endl;
+        screen << "Approval Rate: " << (approved * 100.0 / total) << "%" << '\n';
     }
-    cout << "================================" << endl;
+    screen << "================================" << '\n';
 }
 
 void searchApplicationById(FileManager& fileManager) {
-    cout << endl << "Enter Application ID: ";
+    screen << '\n' << "Enter Application ID: ";
     string appId;
-    getline(cin, appId);
+    readLenderInput(appId);
 
     LoanApplication app = fileManager.findApplicationById(trim(appId));
     if (app.getApplicationId().empty()) {
-        cout << "Application not found." << endl;
+        screen << "Application not found." << '\n';
         return;
     }
 
     displayApplicationDetails(app);
 }
 
-void handleLenderCommands(FileManager& fileManager) {
+void revalidateAllApplications(FileManager& fileManager) {
+    screen << '\n' << "Re-running validation rules over all stored applications..." << '\n';
+    screen.present();
+
+    BatchValidator validator(fileManager);
+    BatchValidationReport report = validator.run();
+
+    screen << '\n' << report.getReport();
+}
+
+void viewApplicationsBySubmissionDate(FileManager& fileManager) {
+    string fromDate, toDate;
+    screen << '\n' << "From date (DD-MM-YYYY): ";
+    readLenderInput(fromDate);
+    screen << "To date (DD-MM-YYYY): ";
+    readLenderInput(toDate);
+    fromDate = trim(fromDate);
+    toDate = trim(toDate);
+
+    // Only the partitions for the months in the range are read
+    auto applications = fileManager.loadApplicationsSubmittedBetween(fromDate, toDate);
+    if (applications.empty()) {
+        screen << '\n' << "No applications submitted between " << fromDate << " and " << toDate
+            << " (dates must be DD-MM-YYYY)." << '\n';
+        return;
+    }
+
+    screen << '\n' << "========== SUBMITTED " << fromDate << " TO " << toDate << " ==========" << '\n';
+    screen << "Total: " << applications.size() << '\n' << '\n';
+    for (size_t i = 0; i < applications.size(); i++) {
+        const auto& app = applications[i];
+        screen << (i + 1) << ". ID: " << app.getApplicationId()
+            << " | " << app.getSubmissionDate()
+            << " | " << app.getFullName()
+            << " | Status: " << app.getStatus() << '\n';
+    }
+}
+
+void viewUnreadableRecords(FileManager& fileManager) {
+    // Every list skips these; they stay in the store as written so they can be repaired by hand
+    auto unreadable = fileManager.findUnreadableRecords();
+    if (unreadable.empty()) {
+        screen << '\n' << "Every stored record can be read." << '\n';
+        return;
+    }
+
+    screen << '\n' << "========== UNREADABLE RECORDS ==========" << '\n';
+    screen << "Total: " << unreadable.size() << '\n' << '\n';
+    for (size_t i = 0; i < unreadable.size(); i++) {
+        const auto& record = unreadable[i];
+        screen << (i + 1) << ". " << record.location;
+        if (record.lineNumber > 0) {
+            screen << " line " << record.lineNumber;
+        }
+        screen << " | " << record.problem << '\n';
+        screen << "   " << record.line << '\n';
+    }
+}
+
+void handleLenderCommands(FileManager& fileManager, ApplicationServer* server) {
     bool running = true;
     string input;
+    activeServer = server;
 
-    cout << endl << "" ;
-    cout << "" << endl;
+    screen << '\n' << "" ;
+    screen << "" << '\n';
 
     while (running) {
         displayLenderMenu();
-        cout << "Lender> ";
-        getline(cin, input);
+        screen << "Lender> ";
+        bool haveInput = readLenderInput(input);
         input = toLower(trim(input));
 
-        if (input == "x" || input == "exit") {
+        if (!haveInput || input == "x" || input == "exit") {
             running = false;
         }
         else if (input == "1") {
@@ -295,15 +378,25 @@ void handleLenderCommands(FileManager& fileManager) {
         else if (input == "7") {
             searchApplicationById(fileManager);
         }
+        else if (input == "8") {
+            revalidateAllApplications(fileManager);
+        }
+        else if (input == "9") {
+            viewApplicationsBySubmissionDate(fileManager);
+        }
+        else if (input == "10") {
+            viewUnreadableRecords(fileManager);
+        }
         else {
-            cout << "Invalid option." << endl;
+            screen << "Invalid option." << '\n';
         }
 
         if (running) {
-            cout << endl << "Press Enter to continue...";
-            getline(cin, input);
+            screen << '\n' << "Press Enter to continue...";
+            readLenderInput(input);
         }
     }
 
-    cout << "Lender interface closed." << endl;
+    screen << "Lender interface closed." << '\n';
+    activeServer = nullptr;
 }
@@ -0,0 +1,273 @@
+#include "lending_rules.h"
+#include "utilities.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+    const char* const GROUP_NAMES[] = { "income_for_type", "debt_ratio", "income_to_loan" };
+    const size_t GROUP_COUNT = sizeof(GROUP_NAMES) / sizeof(GROUP_NAMES[0]);
+
+    const char* const METRIC_NAMES[] = { "annual_income", "loan_amount", "loan_to_income", "debt_to_income" };
+
+    const char* const LOAN_RULE_NAMES[] = { "", "home", "car", "scooter", "personal" };
+
+    const string PERCENT_PLACEHOLDER = "{percent}";
+    const string HEADER_PREFIX = "Group#";
+
+    template <size_t Count>
+    int findName(const char* const (&names)[Count], const string& text) {
+        for (size_t i = 0; i < Count; i++) {
+            if (text == names[i]) return static_cast<int>(i);
+        }
+        return -1;
+    }
+}
+
+LendingRules::LendingRules() {
+    buildGroupIndex();
+}
+
+const string& LendingRules::getDefaultRulesText() {
+    static const string DEFAULT_RULES =
+        "Group#Applies To#Metric#Compare#Limit#Severity#Effect#Message\n"
+        "income_for_type#any#annual_income#<=#0#error#reject#Annual income must be positive\n"
+        "income_for_type#loan=home#loan_to_income#>#5.0#error#reject#Home loan amount cannot exceed 5 times annual income\n"
+        "income_for_type#loan=car#loan_to_income#>#2.0#error#reject#Car loan amount cannot exceed 2 times annual income\n"
+        "income_for_type#loan=personal#loan_to_income#>#1.0#error#reject#Personal loan amount cannot exceed annual income\n"
+        "income_for_type#employment=Unemployed#loan_amount#>#500000#error#reject#Loan amount too high for unemployed applicant\n"
+        "income_for_type#employment=Retired#loan_amount#>#1000000#warning#note#Large loan amount for retired applicant\n"
+        "debt_ratio#any#annual_income#<=#0#error#reject#Annual income must be positive to calculate debt ratio\n"
+        "debt_ratio#any#debt_to_income#>#0.5#warning#reject#High debt-to-income ratio: {percent}%\n"
+        "income_to_loan#any#annual_income#<=#0#error#reject#Annual income must be positive\n"
+        "income_to_loan#any#loan_to_income#>#5.0#error#reject#Loan amount cannot exceed 5 times annual income\n"
+        "income_to_loan#any#loan_to_income#>#3.0#warning#note#Loan amount is high relative to income\n";
+    return DEFAULT_RULES;
+}
+
+const LendingRules& LendingRules::getActive() {
+    static const LendingRules active = []() {
+        LendingRules rules;
+        if (!rules.loadFromFile(Config::LENDING_RULES_FILE)) {
+            cerr << "Warning: Using built-in lending rules" << endl;
+            rules.compile(getDefaultRulesText(), "built-in rules");
+        }
+        return rules;
+    }();
+    return active;
+}
+
+bool LendingRules::loadFromFile(const string& filename) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Warning: Could not open " << filename << endl;
+        return false;
+    }
+
+    stringstream contents;
+    contents << file.rdbuf();
+    return compile(contents.str(), filename);
+}
+
+bool LendingRules::compile(const string& text, const string& sourceName) {
+    vector<CompiledCheck> compiled;
+    istringstream lines(text);
+    string line;
+    int lineNumber = 0;
+
+    while (getline(lines, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (trim(line).empty()) continue;
+        if (lineNumber == 1 && line.compare(0, HEADER_PREFIX.length(), HEADER_PREFIX) == 0) continue;
+
+        CompiledCheck check;
+        string error;
+        if (!compileLine(line, check, error)) {
+            cerr << "Error in " << sourceName << " line " << lineNumber << ": " << error << endl;
+            return false;
+        }
+        compiled.push_back(move(check));
+    }
+
+    // Group the table so evaluation walks one contiguous slice per group
+    stable_sort(compiled.begin(), compiled.end(),
+        [](const CompiledCheck& a, const CompiledCheck& b) { return a.group < b.group; });
+
+    checks = move(compiled);
+    source = sourceName;
+    buildGroupIndex();
+    return true;
+}
+
+bool LendingRules::compileLine(const string& line, CompiledCheck& check, string& error) const {
+    vector<string> parts = splitString(line, Config::DELIMITER);
+    if (parts.size() != 8) {
+        error = "expected 8 fields, found " + to_string(parts.size());
+        return false;
+    }
+
+    int group = findName(GROUP_NAMES, parts[0]);
+    if (group < 0) {
+        error = "unknown rule group '" + parts[0] + "'";
+        return false;
+    }
+    check.group = static_cast<RuleGroup>(group);
+
+    // Applies To
+    const string& appliesTo = parts[1];
+    size_t equals = appliesTo.find('=');
+    if (appliesTo == "any") {
+        check.selector = SELECT_ANY;
+        check.selectorValue = 0;
+    }
+    else if (equals != string::npos && appliesTo.compare(0, equals, "loan") == 0) {
+        int kind = findName(LOAN_RULE_NAMES, appliesTo.substr(equals + 1));
+        if (kind <= 0) {
+            error = "unknown loan type in '" + appliesTo + "'";
+            return false;
+        }
+        check.selector = SELECT_LOAN_TYPE;
+        check.selectorValue = static_cast<uint8_t>(kind);
+    }
+    else if (equals != string::npos && appliesTo.compare(0, equals, "employment") == 0) {
+        EmploymentStatus status = EmploymentStatus::NONE;
+        if (!tryParseEmploymentStatus(appliesTo.substr(equals + 1), status) || status == EmploymentStatus::NONE) {
+            error = "unknown employment status in '" + appliesTo + "'";
+            return false;
+        }
+        check.selector = SELECT_EMPLOYMENT;
+        check.selectorValue = static_cast<uint8_t>(status);
+    }
+    else {
+        error = "Applies To must be any, loan=<type> or employment=<status>";
+        return false;
+    }
+
+    int metric = findName(METRIC_NAMES, parts[2]);
+    if (metric < 0) {
+        error = "unknown metric '" + parts[2] + "'";
+        return false;
+    }
+    check.metric = static_cast<Metric>(metric);
+
+    const string& compare = parts[3];
+    if (compare == ">") check.compareBits = ACCEPT_ABOVE;
+    else if (compare == ">=") check.compareBits = ACCEPT_ABOVE | ACCEPT_EQUAL;
+    else if (compare == "<") check.compareBits = ACCEPT_BELOW;
+    else if (compare == "<=") check.compareBits = ACCEPT_BELOW | ACCEPT_EQUAL;
+    else if (compare == "==") check.compareBits = ACCEPT_EQUAL;
+    else {
+        error = "unknown comparison '" + compare + "'";
+        return false;
+    }
+
+    const char* limitText = parts[4].c_str();
+    char* limitEnd = nullptr;
+    check.limit = strtod(limitText, &limitEnd);
+    if (limitEnd == limitText || *limitEnd != '\0') {
+        error = "limit '" + parts[4] + "' is not a number";
+        return false;
+    }
+
+    if (parts[5] == "error") check.isWarning = false;
+    else if (parts[5] == "warning") check.isWarning = true;
+    else {
+        error = "severity must be error or warning";
+        return false;
+    }
+
+    if (parts[6] == "reject") check.rejects = true;
+    else if (parts[6] == "note") check.rejects = false;
+    else {
+        error = "effect must be reject or note";
+        return false;
+    }
+
+    const string& message = parts[7];
+    if (message.empty()) {
+        error = "message is empty";
+        return false;
+    }
+    size_t placeholder = message.find(PERCENT_PLACEHOLDER);
+    check.showsPercent = (placeholder != string::npos);
+    check.messagePrefix = message.substr(0, placeholder);
+    check.messageSuffix = check.showsPercent ? message.substr(placeholder + PERCENT_PLACEHOLDER.length()) : "";
+
+    return true;
+}
+
+void LendingRules::buildGroupIndex() {
+    size_t position = 0;
+    for (size_t group = 0; group < GROUP_COUNT; group++) {
+        groupStart[group] = position;
+        while (position < checks.size() && static_cast<size_t>(checks[position].group) == group) {
+            position++;
+        }
+    }
+    groupStart[GROUP_COUNT] = checks.size();
+}
+
+bool LendingRules::evaluate(RuleGroup group, const RuleInputs& inputs, ValidationResult& result) const {
+    // Every metric is computed once up front; ratios are 0 when income is not positive
+    // (the shipped rules reject that case before any ratio is looked at)
+    double income = static_cast<double>(inputs.annualIncome);
+    bool hasIncome = inputs.annualIncome > 0;
+    double metrics[METRIC_COUNT] = {
+        income,
+        static_cast<double>(inputs.loanAmount),
+        hasIncome ? static_cast<double>(inputs.loanAmount) / income : 0.0,
+        hasIncome ? static_cast<double>(inputs.activeDebt) / income : 0.0
+    };
+    // Indexed by Selector; SELECT_ANY rows carry 0 so they always match
+    uint8_t subjects[] = {
+        0,
+        static_cast<uint8_t>(inputs.loanKind),
+        static_cast<uint8_t>(inputs.employmentStatus)
+    };
+
+    bool passed = true;
+    size_t index = static_cast<size_t>(group);
+    for (size_t i = groupStart[index]; i < groupStart[index + 1]; i++) {
+        const CompiledCheck& check = checks[i];
+        double value = metrics[check.metric];
+
+        // below -> 1, equal -> 2, above -> 4
+        uint8_t outcome = static_cast<uint8_t>(ACCEPT_BELOW << ((value >= check.limit) + (value > check.limit)));
+        bool fires = (subjects[check.selector] == check.selectorValue) & ((outcome & check.compareBits) != 0);
+        if (!fires) continue;
+
+        // Only the row and its number are recorded; the text is built if the result is rendered
+        ValidationEntry entry = { static_cast<uint16_t>(LENDING_RULE_CODE_BASE + i), check.isWarning, 0,
+            check.showsPercent ? static_cast<int32_t>(value * 100) : 0 };
+        result.addEntry(entry);
+
+        if (check.rejects) {
+            passed = false;
+            break;
+        }
+    }
+
+    return passed;
+}
+
+string LendingRules::formatMessage(size_t row, int value) const {
+    if (row >= checks.size()) {
+        return "Unknown lending rule " + to_string(row);
+    }
+
+    const CompiledCheck& check = checks[row];
+    if (!check.showsPercent) return check.messagePrefix;
+    return check.messagePrefix + to_string(value) + check.messageSuffix;
+}
+
+size_t LendingRules::getCheckCount() const {
+    return checks.size();
+}
+
+const string& LendingRules::getSource() const {
+    return source;
+}
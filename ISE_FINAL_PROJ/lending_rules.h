@@ -0,0 +1,121 @@
+#ifndef LENDING_RULES_H
+#define LENDING_RULES_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "application.h"
+using namespace std;
+
+/// <summary>
+/// Rule groups evaluated by the LoanApplication ratio checks
+/// </summary>
+enum class RuleGroup : uint8_t {
+    INCOME_FOR_LOAN_TYPE,   // validateIncomeForLoanType
+    DEBT_TO_INCOME,         // validateDebtToIncomeRatio
+    INCOME_TO_LOAN          // validateIncomeToLoanRatio
+};
+
+/// <summary>
+/// Application values the rules can look at
+/// </summary>
+struct RuleInputs {
+    long long annualIncome;
+    long long loanAmount;
+    long long activeDebt;           // Sum of amountDue over active existing loans
+    LoanKind loanKind;
+    EmploymentStatus employmentStatus;
+
+    RuleInputs() : annualIncome(0), loanAmount(0), activeDebt(0),
+        loanKind(LoanKind::NONE), employmentStatus(EmploymentStatus::NONE) {}
+};
+
+/// <summary>
+/// Lending thresholds loaded from LendingRules.txt and compiled into a flat
+/// decision table (one row per check, enums and doubles only)
+/// File format: Group#Applies To#Metric#Compare#Limit#Severity#Effect#Message
+/// - Applies To: any, loan=home|car|scooter|personal, employment=Self-employed|Salaried|Retired|Unemployed
+/// - Metric: annual_income, loan_amount, loan_to_income, debt_to_income
+/// - Compare: one of  >  >=  <  <=  ==
+/// - Effect: reject (check fails, stop the group) or note (record and continue)
+/// - Message may contain {percent} (metric * 100, truncated)
+/// SE Principles:
+/// - Open/Closed: policy changes are data, the validators stay unchanged
+/// - Fail Safe: a broken rules file falls back to the built-in policy
+/// </summary>
+class LendingRules {
+private:
+    enum Selector : uint8_t { SELECT_ANY, SELECT_LOAN_TYPE, SELECT_EMPLOYMENT };
+    enum Metric : uint8_t { METRIC_ANNUAL_INCOME, METRIC_LOAN_AMOUNT, METRIC_LOAN_TO_INCOME, METRIC_DEBT_TO_INCOME, METRIC_COUNT };
+
+    // Comparison encoded as the outcomes it accepts: below / equal / above the limit
+    enum CompareBits : uint8_t { ACCEPT_BELOW = 1, ACCEPT_EQUAL = 2, ACCEPT_ABOVE = 4 };
+
+    struct CompiledCheck {
+        RuleGroup group;
+        Selector selector;
+        uint8_t selectorValue;      // LoanKind or EmploymentStatus code
+        Metric metric;
+        uint8_t compareBits;
+        bool isWarning;
+        bool rejects;
+        double limit;
+        string messagePrefix;
+        string messageSuffix;
+        bool showsPercent;          // Message has {percent} between prefix and suffix
+    };
+
+    vector<CompiledCheck> checks;   // Ordered by group, then file order
+    size_t groupStart[4];           // checks[groupStart[g] .. groupStart[g + 1]) belong to group g
+    string source;
+
+    bool compileLine(const string& line, CompiledCheck& check, string& error) const;
+    void buildGroupIndex();
+
+public:
+    LendingRules();
+
+    /// <summary>
+    /// Compiles rules text (same format as the rules file)
+    /// </summary>
+    /// <param name="text">Rules, one per line, optional header line</param>
+    /// <param name="sourceName">Name used in error messages</param>
+    /// <returns>False (and rules unchanged) if any line is invalid</returns>
+    bool compile(const string& text, const string& sourceName);
+
+    /// <summary>
+    /// Loads and compiles a rules file
+    /// </summary>
+    /// <returns>False (and rules unchanged) if the file is missing or invalid</returns>
+    bool loadFromFile(const string& filename);
+
+    /// <summary>
+    /// Runs one rule group, adding its errors/warnings to result
+    /// Entries refer to rows of this table, so results are rendered against getActive()
+    /// </summary>
+    /// <returns>False if a rejecting check fired</returns>
+    bool evaluate(RuleGroup group, const RuleInputs& inputs, ValidationResult& result) const;
+
+    /// <summary>
+    /// Renders the message of a rule row recorded by evaluate()
+    /// </summary>
+    /// <param name="row">Rule row (entry code minus LENDING_RULE_CODE_BASE)</param>
+    /// <param name="value">Number recorded with the entry ({percent})</param>
+    string formatMessage(size_t row, int value) const;
+
+    size_t getCheckCount() const;
+    const string& getSource() const;
+
+    /// <summary>
+    /// Built-in policy, identical to the shipped LendingRules.txt
+    /// </summary>
+    static const string& getDefaultRulesText();
+
+    /// <summary>
+    /// Rules used by the validators: Config::LENDING_RULES_FILE if it
+    /// compiles, otherwise the built-in policy (loaded once)
+    /// </summary>
+    static const LendingRules& getActive();
+};
+
+#endif
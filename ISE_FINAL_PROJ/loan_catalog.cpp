@@ -0,0 +1,94 @@
+#include "loan_catalog.h"
+#include <iostream>
+
+using namespace std;
+
+namespace {
+    /// <summary>
+    /// Runs one of the array loaders into a vector sized to what was loaded
+    /// </summary>
+    template <typename Row>
+    vector<Row> loadRows(int (*loader)(Row[], int, const string&), int maxSize, const string& filename) {
+        vector<Row> rows(maxSize);
+        int count = loader(rows.data(), maxSize, filename);
+        rows.resize(count > 0 ? count : 0);
+        return rows;
+    }
+
+    const string& fileOf(CatalogPart part) {
+        switch (part) {
+        case CatalogPart::HOME_LOANS: return Config::HOME_LOANS_FILE;
+        case CatalogPart::CAR_LOANS: return Config::CAR_LOANS_FILE;
+        case CatalogPart::SCOOTER_LOANS: return Config::SCOOTER_LOANS_FILE;
+        case CatalogPart::PERSONAL_LOANS: return Config::PERSONAL_LOANS_FILE;
+        case CatalogPart::UTTERANCES: return Config::UTTERANCES_FILE;
+        default: return Config::CHAT_CORPUS_FILE;
+        }
+    }
+
+    const CatalogPart ALL_PARTS[] = {
+        CatalogPart::HOME_LOANS, CatalogPart::CAR_LOANS, CatalogPart::SCOOTER_LOANS,
+        CatalogPart::PERSONAL_LOANS, CatalogPart::UTTERANCES, CatalogPart::CHAT_CORPUS
+    };
+}
+
+LiveCatalog::LiveCatalog() : current(make_shared<LoanCatalog>()) {
+}
+
+bool LiveCatalog::loadPart(CatalogPart part, LoanCatalog& catalog) {
+    const string& filename = fileOf(part);
+
+    switch (part) {
+    case CatalogPart::HOME_LOANS:
+        catalog.homeLoans = loadRows(loadHomeLoans, Config::MAX_LOANS, filename);
+        return !catalog.homeLoans.empty();
+    case CatalogPart::CAR_LOANS:
+        catalog.carLoans = loadRows(loadCarLoans, Config::MAX_LOANS, filename);
+        return !catalog.carLoans.empty();
+    case CatalogPart::SCOOTER_LOANS:
+        catalog.scooterLoans = loadRows(loadScooterLoans, Config::MAX_LOANS, filename);
+        return !catalog.scooterLoans.empty();
+    case CatalogPart::PERSONAL_LOANS:
+        catalog.personalLoans = loadRows(loadPersonalLoans, Config::MAX_LOANS, filename);
+        return !catalog.personalLoans.empty();
+    case CatalogPart::UTTERANCES:
+        catalog.utterances = loadRows(loadUtterances, Config::MAX_UTTERANCES, filename);
+        return !catalog.utterances.empty();
+    case CatalogPart::CHAT_CORPUS:
+        catalog.conversationCorpus = loadConversationCorpus(filename);
+        return !catalog.conversationCorpus.empty();
+    }
+    return false;
+}
+
+void LiveCatalog::loadAll() {
+    lock_guard<mutex> lock(reloadMutex);
+
+    auto next = make_shared<LoanCatalog>();
+    for (CatalogPart part : ALL_PARTS) {
+        loadPart(part, *next);
+    }
+    atomic_store(&current, shared_ptr<const LoanCatalog>(move(next)));
+}
+
+void LiveCatalog::reload(CatalogPart part) {
+    lock_guard<mutex> lock(reloadMutex);
+
+    // The other parts are copied as they are, not re-read
+    auto next = make_shared<LoanCatalog>(*get());
+    if (!loadPart(part, *next)) {
+        cerr << "Warning: " << fileOf(part) << " could not be reloaded; keeping the previous entries" << endl;
+        return;
+    }
+    atomic_store(&current, shared_ptr<const LoanCatalog>(move(next)));
+}
+
+void LiveCatalog::watchWith(FileWatcher& watcher) {
+    for (CatalogPart part : ALL_PARTS) {
+        watcher.watch(fileOf(part), [this, part]() { reload(part); });
+    }
+}
+
+shared_ptr<const LoanCatalog> LiveCatalog::get() const {
+    return atomic_load(&current);
+}
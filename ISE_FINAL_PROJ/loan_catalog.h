@@ -0,0 +1,87 @@
+#ifndef LOAN_CATALOG_H
+#define LOAN_CATALOG_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include "home.h"
+#include "car.h"
+#include "scooter.h"
+#include "personal.h"
+#include "Utterances.h"
+#include "file_watcher.h"
+#include "utilities.h"
+
+using namespace std;
+
+/// <summary>
+/// Everything user_client reads from the catalog and chat files
+/// </summary>
+struct LoanCatalog {
+    vector<HomeLoan> homeLoans;
+    vector<CarLoan> carLoans;
+    vector<ScooterLoan> scooterLoans;
+    vector<PersonalLoan> personalLoans;
+    vector<Utterance> utterances;
+    vector<ConversationPair> conversationCorpus;
+};
+
+/// <summary>
+/// The catalog files, each of which can be reloaded on its own
+/// </summary>
+enum class CatalogPart {
+    HOME_LOANS,
+    CAR_LOANS,
+    SCOOTER_LOANS,
+    PERSONAL_LOANS,
+    UTTERANCES,
+    CHAT_CORPUS
+};
+
+/// <summary>
+/// Catalog that follows its files while the program runs
+/// Readers take the current snapshot with get() and keep using it for as long
+/// as they like; a reload builds a new snapshot, re-reading only the changed
+/// file, and swaps it in with an atomic shared_ptr store. Readers never block.
+/// SE Principles:
+/// - Immutability: a published LoanCatalog is never modified
+/// - Single Responsibility: knows which loader belongs to which file, nothing more
+/// </summary>
+class LiveCatalog {
+private:
+    shared_ptr<const LoanCatalog> current;  // Only accessed through atomic_load/atomic_store
+    mutex reloadMutex;                      // One rebuild at a time
+
+    /// <summary>
+    /// Loads one part into a catalog
+    /// </summary>
+    /// <returns>False if the file yielded nothing</returns>
+    static bool loadPart(CatalogPart part, LoanCatalog& catalog);
+
+public:
+    LiveCatalog();
+
+    /// <summary>
+    /// Loads every catalog file
+    /// </summary>
+    void loadAll();
+
+    /// <summary>
+    /// Re-reads one file and publishes a new snapshot
+    /// A file that yields nothing (missing, or caught mid-write) keeps its old entries
+    /// </summary>
+    void reload(CatalogPart part);
+
+    /// <summary>
+    /// Registers every catalog file with a watcher so changes are reloaded
+    /// </summary>
+    void watchWith(FileWatcher& watcher);
+
+    /// <summary>
+    /// Current snapshot (safe to hold across reloads)
+    /// </summary>
+    shared_ptr<const LoanCatalog> get() const;
+};
+
+#endif
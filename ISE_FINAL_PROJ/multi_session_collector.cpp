@@ -1,47 +1,48 @@
 ﻿#include "multi_session_collector.h"
 #include "personal.h"
+#include "screen_buffer.h"
 #include <iomanip>
 
 using namespace std;
 
 void MultiSessionCollector::showApplicationMenu() {
-    cout << endl << "========================================" << endl;
-    cout << "   " << Config::CHATBOT_NAME << "'S LOAN APPLICATION CENTER" << endl;
-    cout << "========================================" << endl;
-    cout << Config::CHATBOT_NAME << ": Hello! How can I help you today?" << endl << endl;
-    cout << "1. Start a brand new loan application" << endl;
-    cout << "2. Continue my incomplete application" << endl;
-    cout << "3. Check my application status" << endl;
-    cout << "4. Start general conversation mode" << endl;
-    cout << "5. Return to main menu" << endl;
-    cout << "========================================" << endl;
-    cout << Config::CHATBOT_NAME << ": Please choose an option (1-5): ";
+    screen << '\n' << "========================================" << '\n';
+    screen << "   " << Config::CHATBOT_NAME << "'S LOAN APPLICATION CENTER" << '\n';
+    screen << "========================================" << '\n';
+    screen << Config::CHATBOT_NAME << ": Hello! How can I help you today?" << '\n' << '\n';
+    screen << "1. Start a brand new loan application" << '\n';
+    screen << "2. Continue my incomplete application" << '\n';
+    screen << "3. Check my application status" << '\n';
+    screen << "4. Start general conversation mode" << '\n';
+    screen << "5. Return to main menu" << '\n';
+    screen << "========================================" << '\n';
+    screen << Config::CHATBOT_NAME << ": Please choose an option (1-5): ";
 }
 void MultiSessionCollector::displayApplicationProgress(const LoanApplication& application) {
-    cout << endl << "========================================" << endl;
-    cout << "   APPLICATION PROGRESS REPORT" << endl;
-    cout << "========================================" << endl;
-    cout << Config::CHATBOT_NAME << ": Let me show you where we are with your application!" << endl << endl;
-    cout << "Application ID: " << application.getApplicationId() << endl;
-    cout << "Current Status: " << getStatusDescription(application.getStatus()) << endl << endl;
+    screen << '\n' << "========================================" << '\n';
+    screen << "   APPLICATION PROGRESS REPORT" << '\n';
+    screen << "========================================" << '\n';
+    screen << Config::CHATBOT_NAME << ": Let me show you where we are with your application!" << '\n' << '\n';
+    screen << "Application ID: " << application.getApplicationId() << '\n';
+    screen << "Current Status: " << getStatusDescription(application.getStatus()) << '\n' << '\n';
 
     vector<string> sections = { "personal", "financial", "references", "documents" };
     vector<string> sectionNames = { "Personal Information", "Financial Information", "References", "Documents" };
 
-    cout << "Progress Checklist:" << endl;
+    screen << "Progress Checklist:" << '\n';
     for (size_t i = 0; i < sections.size(); i++) {
         bool completed = application.isSectionCompleted(sections[i]);
-        cout << "  " << (completed ? "[V]" : "[ ]") << " " << sectionNames[i] << endl;
+        screen << "  " << (completed ? "[V]" : "[ ]") << " " << sectionNames[i] << '\n';
     }
 
     string nextSection = application.getNextIncompleteSection();
     if (nextSection != "complete") {
-        cout << endl << Config::CHATBOT_NAME << ": Next step: " << getSectionDisplayName(nextSection) << endl;
+        screen << '\n' << Config::CHATBOT_NAME << ": Next step: " << getSectionDisplayName(nextSection) << '\n';
     }
     else {
-        cout << endl << Config::CHATBOT_NAME << ": Great news! Your application is complete!" << endl;
+        screen << '\n' << Config::CHATBOT_NAME << ": Great news! Your application is complete!" << '\n';
     }
-    cout << "========================================" << endl;
+    screen << "========================================" << '\n';
 }
 string MultiSessionCollector::getStatusDescription(const string& status) const {
     if (status == "incomplete_personal" || status == "C1") return "Personal Info Needed";
@@ -62,22 +63,22 @@ string MultiSessionCollector::getSectionDisplayName(const string& section) const
 }
 void MultiSessionCollector::startNewApplication() {
     try {
-        cout << endl << "========================================" << endl;
-        cout << "   STARTING NEW LOAN APPLICATION" << endl;
-        cout << "========================================" << endl;
-        cout << Config::CHATBOT_NAME << ": Excellent! Let's start your loan application journey." << endl;
-        cout << Config::CHATBOT_NAME << ": I'll guide you through each step carefully." << endl << endl;
-
-        cout << Config::CHATBOT_NAME << ": First, what type of loan are you interested in?" << endl << endl;
-        cout << "1. Home Loan - For purchasing or constructing your dream home" << endl;
-        cout << "2. Car Loan - For buying a new or used vehicle" << endl;
-        cout << "3. Scooter Loan - For eco-friendly transportation" << endl;
-        cout << "4. Personal Loan - For any personal financial needs" << endl << endl;
-        cout << Config::CHATBOT_NAME << ": Please enter your choice (1-4): ";
+        screen << '\n' << "========================================" << '\n';
+        screen << "   STARTING NEW LOAN APPLICATION" << '\n';
+        screen << "========================================" << '\n';
+        screen << Config::CHATBOT_NAME << ": Excellent! Let's start your loan application journey." << '\n';
+        screen << Config::CHATBOT_NAME << ": I'll guide you through each step carefully." << '\n' << '\n';
+
+        screen << Config::CHATBOT_NAME << ": First, what type of loan are you interested in?" << '\n' << '\n';
+        screen << "1. Home Loan - For purchasing or constructing your dream home" << '\n';
+        screen << "2. Car Loan - For buying a new or used vehicle" << '\n';
+        screen << "3. Scooter Loan - For eco-friendly transportation" << '\n';
+        screen << "4. Personal Loan - For any personal financial needs" << '\n' << '\n';
+        screen << Config::CHATBOT_NAME << ": Please enter your choice (1-4): ";
 
         string loanChoice;
         if (!getline(cin, loanChoice)) {
-            cout << Config::CHATBOT_NAME << ": Input error. Returning to menu." << endl;
+            screen << Config::CHATBOT_NAME << ": Input error. Returning to menu." << '\n';
             return;
         }
         loanChoice = trim(loanChoice);
@@ -86,31 +87,31 @@ void MultiSessionCollector::startNewApplication() {
         if (loanChoice == "1") {
             loanType = "home";
             loanDetails = "Home Loan";
-            cout << Config::CHATBOT_NAME << ": Great choice! Home loans are perfect for building your future." << endl;
+            screen << Config::CHATBOT_NAME << ": Great choice! Home loans are perfect for building your future." << '\n';
         }
         else if (loanChoice == "2") {
             loanType = "car";
             loanDetails = "Car Loan";
-            cout << Config::CHATBOT_NAME << ": Wonderful! Let's get you on the road." << endl;
+            screen << Config::CHATBOT_NAME << ": Wonderful! Let's get you on the road." << '\n';
         }
         else if (loanChoice == "3") {
             loanType = "scooter";
             loanDetails = "Scooter Loan";
-            cout << Config::CHATBOT_NAME << ": Smart choice for city commuting!" << endl;
+            screen << Config::CHATBOT_NAME << ": Smart choice for city commuting!" << '\n';
         }
         else if (loanChoice == "4") {
             loanType = "personal";
             loanDetails = "Personal Loan";
-            cout << Config::CHATBOT_NAME << ": Personal loans offer great flexibility!" << endl;
+            screen << Config::CHATBOT_NAME << ": Personal loans offer great flexibility!" << '\n';
 
-            cout << endl << Config::CHATBOT_NAME << ": What type of personal loan do you need?" << endl;
-            cout << "1. Standard Personal Loan - For any personal needs" << endl;
-            cout << "2. Education Loan - For tuition and educational expenses" << endl;
-            cout << "3. Medical Loan - For medical treatments" << endl;
-            cout << "4. Wedding Loan - For marriage expenses" << endl;
-            cout << "5. Emergency Loan - For urgent needs" << endl;
-            cout << "6. Home Renovation - For home improvements" << endl;
-            cout << Config::CHATBOT_NAME << ": Please choose (1-6): ";
+            screen << '\n' << Config::CHATBOT_NAME << ": What type of personal loan do you need?" << '\n';
+            screen << "1. Standard Personal Loan - For any personal needs" << '\n';
+            screen << "2. Education Loan - For tuition and educational expenses" << '\n';
+            screen << "3. Medical Loan - For medical treatments" << '\n';
+            screen << "4. Wedding Loan - For marriage expenses" << '\n';
+            screen << "5. Emergency Loan - For urgent needs" << '\n';
+            screen << "6. Home Renovation - For home improvements" << '\n';
+            screen << Config::CHATBOT_NAME << ": Please choose (1-6): ";
 
             string personalType;
             getline(cin, personalType);
@@ -123,12 +124,12 @@ void MultiSessionCollector::startNewApplication() {
             else if (personalType == "5") loanDetails = "Emergency Loan";
             else if (personalType == "6") loanDetails = "Home Renovation";
             else {
-                cout << Config::CHATBOT_NAME << ": Invalid choice. Using Standard Personal Loan." << endl;
+                screen << Config::CHATBOT_NAME << ": Invalid choice. Using Standard Personal Loan." << '\n';
                 loanDetails = "Standard Personal Loan";
             }
         }
         else {
-            cout << Config::CHATBOT_NAME << ": Hmm, that's not a valid option. Let's try again." << endl;
+            screen << Config::CHATBOT_NAME << ": Hmm, that's not a valid option. Let's try again." << '\n';
             return;
         }
 
@@ -141,30 +142,30 @@ void MultiSessionCollector::startNewApplication() {
         application.setApplicationId(appId);
         application.setSubmissionDate(getCurrentDate());
 
-        cout << endl << "========================================" << endl;
-        cout << "   APPLICATION CREATED" << endl;
-        cout << "========================================" << endl;
-        cout << Config::CHATBOT_NAME << ": Your application has been created!" << endl;
-        cout << endl << "Your Application ID: " << appId << endl;
-        cout << "Loan Type: " << loanType << endl;
-        cout << "Loan Category: " << loanDetails << endl;
-        cout << "Date: " << getCurrentDate() << endl << endl;
-        cout << "IMPORTANT: Please save this Application ID!" << endl;
-        cout << "You'll need it if you want to continue later." << endl;
-        cout << "========================================" << endl << endl;
-
-        cout << Config::CHATBOT_NAME << ": Ready to start with your personal information? (yes/no): ";
+        screen << '\n' << "========================================" << '\n';
+        screen << "   APPLICATION CREATED" << '\n';
+        screen << "========================================" << '\n';
+        screen << Config::CHATBOT_NAME << ": Your application has been created!" << '\n';
+        screen << '\n' << "Your Application ID: " << appId << '\n';
+        screen << "Loan Type: " << loanType << '\n';
+        screen << "Loan Category: " << loanDetails << '\n';
+        screen << "Date: " << getCurrentDate() << '\n' << '\n';
+        screen << "IMPORTANT: Please save this Application ID!" << '\n';
+        screen << "You'll need it if you want to continue later." << '\n';
+        screen << "========================================" << '\n' << '\n';
+
+        screen << Config::CHATBOT_NAME << ": Ready to start with your personal information? (yes/no): ";
         string ready;
         if (!getline(cin, ready)) {
-            cout << Config::CHATBOT_NAME << ": Input error. Application saved with ID: " << appId << endl;
+            screen << Config::CHATBOT_NAME << ": Input error. Application saved with ID: " << appId << '\n';
             fileManager.updateApplicationSection(application, "");
             return;
         }
 
         if (toLower(trim(ready)) != "yes" && toLower(trim(ready)) != "y") {
             fileManager.updateApplicationSection(application, "");
-            cout << Config::CHATBOT_NAME << ": No problem! Your application has been saved." << endl;
-            cout << Config::CHATBOT_NAME << ": Come back anytime with your Application ID: " << appId << endl;
+            screen << Config::CHATBOT_NAME << ": No problem! Your application has been saved." << '\n';
+            screen << Config::CHATBOT_NAME << ": Come back anytime with your Application ID: " << appId << '\n';
             return;
         }
 
@@ -179,9 +180,9 @@ void MultiSessionCollector::startNewApplication() {
                 break;
             }
 
-            cout << endl << "========================================" << endl;
-            cout << "   SECTION: " << getSectionDisplayName(nextSection) << endl;
-            cout << "========================================" << endl;
+            screen << '\n' << "========================================" << '\n';
+            screen << "   SECTION: " << getSectionDisplayName(nextSection) << '\n';
+            screen << "========================================" << '\n';
 
             bool sectionCompleted = false;
 
@@ -196,7 +197,7 @@ void MultiSessionCollector::startNewApplication() {
             }
             else if (nextSection == "documents") {
                 sectionCompleted = collectDocumentsInfo(application);
-                if (sectionCompleted && application.getStatus() == "submitted") {
+                if (sectionCompleted && application.getStatusCode() == ApplicationStatus::SUBMITTED) {
                     applicationWasSubmitted = true;
                     break;
                 }
@@ -207,15 +208,15 @@ void MultiSessionCollector::startNewApplication() {
 
             if (sectionCompleted && !applicationWasSubmitted) {
                 if (application.getNextIncompleteSection() != "complete") {
-                    cout << endl << Config::CHATBOT_NAME << ": Continue to next section? (yes/no): ";
+                    screen << '\n' << Config::CHATBOT_NAME << ": Continue to next section? (yes/no): ";
                     string nextChoice;
                     getline(cin, nextChoice);
                     continueProcessing = (toLower(trim(nextChoice)) == "yes" || toLower(trim(nextChoice)) == "y");
 
                     if (!continueProcessing) {
-                        cout << endl << Config::CHATBOT_NAME << ": Your progress has been saved!" << endl;
-                        cout << "Application ID: " << appId << endl;
-                        cout << "You can continue anytime by selecting 'Continue my incomplete application'" << endl;
+                        screen << '\n' << Config::CHATBOT_NAME << ": Your progress has been saved!" << '\n';
+                        screen << "Application ID: " << appId << '\n';
+                        screen << "You can continue anytime by selecting 'Continue my incomplete application'" << '\n';
                         return;
                     }
                 }
@@ -229,70 +230,70 @@ void MultiSessionCollector::startNewApplication() {
         }
 
         if (applicationWasSubmitted || application.isApplicationComplete()) {
-            cout << endl << "========================================" << endl;
-            cout << "   CONGRATULATIONS!" << endl;
-            cout << "========================================" << endl;
-            cout << Config::CHATBOT_NAME << ": You've successfully completed your application!" << endl;
-            cout << endl << "Application Details:" << endl;
-            cout << "  Application ID: " << application.getApplicationId() << endl;
-            cout << "  Status: Submitted for Review" << endl;
-            cout << "  Submission Date: " << application.getSubmissionDate() << endl << endl;
-            cout << Config::CHATBOT_NAME << ": We'll review your application and get back to you soon!" << endl;
-            cout << "========================================" << endl;
+            screen << '\n' << "========================================" << '\n';
+            screen << "   CONGRATULATIONS!" << '\n';
+            screen << "========================================" << '\n';
+            screen << Config::CHATBOT_NAME << ": You've successfully completed your application!" << '\n';
+            screen << '\n' << "Application Details:" << '\n';
+            screen << "  Application ID: " << application.getApplicationId() << '\n';
+            screen << "  Status: Submitted for Review" << '\n';
+            screen << "  Submission Date: " << application.getSubmissionDate() << '\n' << '\n';
+            screen << Config::CHATBOT_NAME << ": We'll review your application and get back to you soon!" << '\n';
+            screen << "========================================" << '\n';
         }
 
     }
     catch (const exception& e) {
-        cout << Config::CHATBOT_NAME << ": Error: " << e.what() << endl;
-        cout << Config::CHATBOT_NAME << ": Returning to main menu." << endl;
+        screen << Config::CHATBOT_NAME << ": Error: " << e.what() << '\n';
+        screen << Config::CHATBOT_NAME << ": Returning to main menu." << '\n';
     }
 }
 void MultiSessionCollector::resumeExistingApplication() {
-    cout << endl << "========================================" << endl;
-    cout << "   RESUME YOUR APPLICATION" << endl;
-    cout << "========================================" << endl;
-    cout << Config::CHATBOT_NAME << ": Welcome back! Let's continue where you left off." << endl << endl;
+    screen << '\n' << "========================================" << '\n';
+    screen << "   RESUME YOUR APPLICATION" << '\n';
+    screen << "========================================" << '\n';
+    screen << Config::CHATBOT_NAME << ": Welcome back! Let's continue where you left off." << '\n' << '\n';
 
     string applicationId, cnic;
 
-    cout << Config::CHATBOT_NAME << ": Please enter your Application ID: ";
+    screen << Config::CHATBOT_NAME << ": Please enter your Application ID: ";
     getline(cin, applicationId);
     applicationId = trim(applicationId);
 
     if (applicationId.empty()) {
-        cout << Config::CHATBOT_NAME << ": Oops! Application ID cannot be empty." << endl;
+        screen << Config::CHATBOT_NAME << ": Oops! Application ID cannot be empty." << '\n';
         return;
     }
 
-    cout << Config::CHATBOT_NAME << ": Now, please enter your CNIC (13 digits, no dashes): ";
+    screen << Config::CHATBOT_NAME << ": Now, please enter your CNIC (13 digits, no dashes): ";
     getline(cin, cnic);
     cnic = trim(cnic);
 
     if (cnic.length() != 13) {
-        cout << Config::CHATBOT_NAME << ": Sorry, CNIC must be exactly 13 digits." << endl;
-        cout << Config::CHATBOT_NAME << ": Example: 3520212345678" << endl;
+        screen << Config::CHATBOT_NAME << ": Sorry, CNIC must be exactly 13 digits." << '\n';
+        screen << Config::CHATBOT_NAME << ": Example: 3520212345678" << '\n';
         return;
     }
 
     for (char c : cnic) {
         if (!isdigit(static_cast<unsigned char>(c))) {
-            cout << Config::CHATBOT_NAME << ": Sorry, CNIC should contain only numbers." << endl;
+            screen << Config::CHATBOT_NAME << ": Sorry, CNIC should contain only numbers." << '\n';
             return;
         }
     }
 
-    cout << endl << Config::CHATBOT_NAME << ": Let me search for your application..." << endl;
+    screen << '\n' << Config::CHATBOT_NAME << ": Let me search for your application..." << '\n';
 
     LoanApplication application = fileManager.findIncompleteApplication(applicationId, cnic);
 
     if (application.getApplicationId().empty()) {
-        cout << endl << "========================================" << endl;
-        cout << "   APPLICATION NOT FOUND" << endl;
-        cout << "========================================" << endl;
-        cout << Config::CHATBOT_NAME << ": I couldn't find an incomplete application with:" << endl;
-        cout << "  Application ID: " << applicationId << endl;
-        cout << "  CNIC: " << cnic << endl << endl;
-        cout << Config::CHATBOT_NAME << ": Would you like to start a new application instead? (yes/no): ";
+        screen << '\n' << "========================================" << '\n';
+        screen << "   APPLICATION NOT FOUND" << '\n';
+        screen << "========================================" << '\n';
+        screen << Config::CHATBOT_NAME << ": I couldn't find an incomplete application with:" << '\n';
+        screen << "  Application ID: " << applicationId << '\n';
+        screen << "  CNIC: " << cnic << '\n' << '\n';
+        screen << Config::CHATBOT_NAME << ": Would you like to start a new application instead? (yes/no): ";
         string choice;
         getline(cin, choice);
         if (toLower(trim(choice)) == "yes" || toLower(trim(choice)) == "y") {
@@ -301,30 +302,30 @@ void MultiSessionCollector::resumeExistingApplication() {
         return;
     }
 
-    if (application.isApplicationComplete() || application.getStatus() == "submitted") {
-        cout << endl << "========================================" << endl;
-        cout << "   APPLICATION ALREADY SUBMITTED" << endl;
-        cout << "========================================" << endl;
-        cout << Config::CHATBOT_NAME << ": Your application is already submitted!" << endl;
-        cout << "Application ID: " << application.getApplicationId() << endl;
-        cout << "Status: " << application.getStatus() << endl;
-        cout << "Submission Date: " << application.getSubmissionDate() << endl;
-        cout << Config::CHATBOT_NAME << ": No further action is needed." << endl;
+    if (application.isApplicationComplete() || application.getStatusCode() == ApplicationStatus::SUBMITTED) {
+        screen << '\n' << "========================================" << '\n';
+        screen << "   APPLICATION ALREADY SUBMITTED" << '\n';
+        screen << "========================================" << '\n';
+        screen << Config::CHATBOT_NAME << ": Your application is already submitted!" << '\n';
+        screen << "Application ID: " << application.getApplicationId() << '\n';
+        screen << "Status: " << application.getStatus() << '\n';
+        screen << "Submission Date: " << application.getSubmissionDate() << '\n';
+        screen << Config::CHATBOT_NAME << ": No further action is needed." << '\n';
         return;
     }
 
-    cout << Config::CHATBOT_NAME << ": Found it!" << endl;
+    screen << Config::CHATBOT_NAME << ": Found it!" << '\n';
     displayApplicationProgress(application);
 
     while (true) {
-        cout << endl << Config::CHATBOT_NAME << ": Which section would you like to update?" << endl;
-        cout << "1. Personal Information" << endl;
-        cout << "2. Financial Information" << endl;
-        cout << "3. References" << endl;
-        cout << "4. Documents" << endl;
-        cout << "5. Continue from next incomplete section" << endl;
-        cout << "6. Exit" << endl;
-        cout << "Enter your choice (1-6): ";
+        screen << '\n' << Config::CHATBOT_NAME << ": Which section would you like to update?" << '\n';
+        screen << "1. Personal Information" << '\n';
+        screen << "2. Financial Information" << '\n';
+        screen << "3. References" << '\n';
+        screen << "4. Documents" << '\n';
+        screen << "5. Continue from next incomplete section" << '\n';
+        screen << "6. Exit" << '\n';
+        screen << "Enter your choice (1-6): ";
         string choice;
         getline(cin, choice);
         choice = trim(choice);
@@ -346,25 +347,25 @@ void MultiSessionCollector::resumeExistingApplication() {
             break; 
         }
         else if (choice == "6") {
-            cout << Config::CHATBOT_NAME << ": No problem! Your progress is saved. Come back anytime!" << endl;
+            screen << Config::CHATBOT_NAME << ": No problem! Your progress is saved. Come back anytime!" << '\n';
             return;
         }
         else {
-            cout << Config::CHATBOT_NAME << ": Invalid choice. Please select 1-6." << endl;
+            screen << Config::CHATBOT_NAME << ": Invalid choice. Please select 1-6." << '\n';
             continue;
         }
 
-        if (application.isApplicationComplete() || application.getStatus() == "submitted") {
-            cout << endl << "========================================" << endl;
-            cout << "   CONGRATULATIONS!" << endl;
-            cout << "========================================" << endl;
-            cout << Config::CHATBOT_NAME << ": You've successfully completed your application!" << endl;
-            cout << endl << "Application Details:" << endl;
-            cout << "  Application ID: " << application.getApplicationId() << endl;
-            cout << "  Status: Submitted for Review" << endl;
-            cout << "  Submission Date: " << application.getSubmissionDate() << endl << endl;
-            cout << Config::CHATBOT_NAME << ": We'll review your application and get back to you soon!" << endl;
-            cout << "========================================" << endl;
+        if (application.isApplicationComplete() || application.getStatusCode() == ApplicationStatus::SUBMITTED) {
+            screen << '\n' << "========================================" << '\n';
+            screen << "   CONGRATULATIONS!" << '\n';
+            screen << "========================================" << '\n';
+            screen << Config::CHATBOT_NAME << ": You've successfully completed your application!" << '\n';
+            screen << '\n' << "Application Details:" << '\n';
+            screen << "  Application ID: " << application.getApplicationId() << '\n';
+            screen << "  Status: Submitted for Review" << '\n';
+            screen << "  Submission Date: " << application.getSubmissionDate() << '\n' << '\n';
+            screen << Config::CHATBOT_NAME << ": We'll review your application and get back to you soon!" << '\n';
+            screen << "========================================" << '\n';
             return;
         }
     }
@@ -375,9 +376,9 @@ void MultiSessionCollector::resumeExistingApplication() {
 
     while (continueProcessing && !application.isApplicationComplete() && !applicationWasSubmitted) {
         string nextSection = application.getNextIncompleteSection();
-        cout << endl << "========================================" << endl;
-        cout << "   SECTION: " << getSectionDisplayName(nextSection) << endl;
-        cout << "========================================" << endl;
+        screen << '\n' << "========================================" << '\n';
+        screen << "   SECTION: " << getSectionDisplayName(nextSection) << '\n';
+        screen << "========================================" << '\n';
 
         bool sectionCompleted = false;
 
@@ -392,7 +393,7 @@ void MultiSessionCollector::resumeExistingApplication() {
         }
         else if (nextSection == "documents") {
             sectionCompleted = collectDocumentsInfo(application);
-            if (sectionCompleted && application.getStatus() == "submitted") {
+            if (sectionCompleted && application.getStatusCode() == ApplicationStatus::SUBMITTED) {
                 applicationWasSubmitted = true;
                 break;
             }
@@ -408,7 +409,7 @@ void MultiSessionCollector::resumeExistingApplication() {
             }
 
             if (application.getNextIncompleteSection() != "complete") {
-                cout << endl << Config::CHATBOT_NAME << ": Continue to next section? (yes/no): ";
+                screen << '\n' << Config::CHATBOT_NAME << ": Continue to next section? (yes/no): ";
                 string nextChoice;
                 getline(cin, nextChoice);
                 continueProcessing = (toLower(trim(nextChoice)) == "yes" || toLower(trim(nextChoice)) == "y");
@@ -423,27 +424,27 @@ void MultiSessionCollector::resumeExistingApplication() {
     }
 
     if (applicationWasSubmitted || application.isApplicationComplete()) {
-        cout << endl << "========================================" << endl;
-        cout << "   CONGRATULATIONS!" << endl;
-        cout << "========================================" << endl;
-        cout << Config::CHATBOT_NAME << ": You've successfully completed your application!" << endl;
-        cout << endl << "Application Details:" << endl;
-        cout << "  Application ID: " << application.getApplicationId() << endl;
-        cout << "  Status: Submitted for Review" << endl;
-        cout << "  Submission Date: " << application.getSubmissionDate() << endl << endl;
-        cout << Config::CHATBOT_NAME << ": We'll review your application and get back to you soon!" << endl;
-        cout << "========================================" << endl;
+        screen << '\n' << "========================================" << '\n';
+        screen << "   CONGRATULATIONS!" << '\n';
+        screen << "========================================" << '\n';
+        screen << Config::CHATBOT_NAME << ": You've successfully completed your application!" << '\n';
+        screen << '\n' << "Application Details:" << '\n';
+        screen << "  Application ID: " << application.getApplicationId() << '\n';
+        screen << "  Status: Submitted for Review" << '\n';
+        screen << "  Submission Date: " << application.getSubmissionDate() << '\n' << '\n';
+        screen << Config::CHATBOT_NAME << ": We'll review your application and get back to you soon!" << '\n';
+        screen << "========================================" << '\n';
     }
 }
 bool MultiSessionCollector::collectPersonalInfo(LoanApplication& application) {
-    cout << endl << Config::CHATBOT_NAME << ": Let's start with your personal information." << endl;
-    cout << Config::CHATBOT_NAME << ": This helps us understand you better!" << endl << endl;
+    screen << '\n' << Config::CHATBOT_NAME << ": Let's start with your personal information." << '\n';
+    screen << Config::CHATBOT_NAME << ": This helps us understand you better!" << '\n' << '\n';
 
     try {
         string fullName = baseCollector.getValidatedString(
             "What is your full name? ", "Full name", 1, 100);
         application.setFullName(fullName);
-        cout << Config::CHATBOT_NAME << ": Nice to meet you, " << fullName << "!" << endl << endl;
+        screen << Config::CHATBOT_NAME << ": Nice to meet you, " << fullName << "!" << '\n' << '\n';
 
         string fathersName = baseCollector.getValidatedString(
             "What is your father's name? ", "Father's name", 1, 100);
@@ -469,7 +470,7 @@ bool MultiSessionCollector::collectPersonalInfo(LoanApplication& application) {
             "When does your CNIC expire? (DD-MM-YYYY): ");
         application.setCnicExpiryDate(cnicExpiry);
 
-        cout << endl << Config::CHATBOT_NAME << ": Now, let me ask about your employment and family..." << endl << endl;
+        screen << '\n' << Config::CHATBOT_NAME << ": Now, let me ask about your employment and family..." << '\n' << '\n';
 
         vector<string> employmentOptions = { "Self-employed", "Salaried", "Retired", "Unemployed" };
         string employmentStatus = baseCollector.getSelectionFromOptions(
@@ -492,8 +493,8 @@ bool MultiSessionCollector::collectPersonalInfo(LoanApplication& application) {
 
         ValidationResult validation = application.validatePersonalInfo();
         if (!validation.isValid) {
-            cout << endl << Config::CHATBOT_NAME << ": Oops! There are some issues:" << endl;
-            cout << validation.getReport();
+            screen << '\n' << Config::CHATBOT_NAME << ": Oops! There are some issues:" << '\n';
+            screen << validation.getReport();
             return false;
         }
 
@@ -504,13 +505,13 @@ bool MultiSessionCollector::collectPersonalInfo(LoanApplication& application) {
 
     }
     catch (const exception& e) {
-        cout << Config::CHATBOT_NAME << ": Sorry, something went wrong: " << e.what() << endl;
+        screen << Config::CHATBOT_NAME << ": Sorry, something went wrong: " << e.what() << '\n';
         return false;
     }
 }
 bool MultiSessionCollector::collectFinancialInfo(LoanApplication& application) {
-    cout << endl << Config::CHATBOT_NAME << ": Now let's talk about your finances." << endl;
-    cout << Config::CHATBOT_NAME << ": This information helps us determine your loan eligibility." << endl << endl;
+    screen << '\n' << Config::CHATBOT_NAME << ": Now let's talk about your finances." << '\n';
+    screen << Config::CHATBOT_NAME << ": This information helps us determine your loan eligibility." << '\n' << '\n';
 
     try {
         long long annualIncome = baseCollector.getValidatedNumeric(
@@ -518,7 +519,7 @@ bool MultiSessionCollector::collectFinancialInfo(LoanApplication& application) {
             "Annual income", 0, 1000000000);
         application.setAnnualIncome(annualIncome);
 
-        cout << endl << Config::CHATBOT_NAME << ": Great! Now about your electricity bills..." << endl << endl;
+        screen << '\n' << Config::CHATBOT_NAME << ": Great! Now about your electricity bills..." << '\n' << '\n';
 
         long long avgElectricityBill = baseCollector.getValidatedNumeric(
             "What is your average monthly electricity bill? (PKR): ",
@@ -530,13 +531,13 @@ bool MultiSessionCollector::collectFinancialInfo(LoanApplication& application) {
             "Current electricity bill", 0, 100000);
         application.setCurrentElectricityBill(currentElectricityBill);
 
-        cout << endl << Config::CHATBOT_NAME << ": Do you have any existing loans? (yes/no): ";
+        screen << '\n' << Config::CHATBOT_NAME << ": Do you have any existing loans? (yes/no): ";
         string hasLoans;
         getline(cin, hasLoans);
         hasLoans = toLower(trim(hasLoans));
 
         if (hasLoans == "yes" || hasLoans == "y") {
-            cout << Config::CHATBOT_NAME << ": Okay, let me collect details about your existing loans." << endl;
+            screen << Config::CHATBOT_NAME << ": Okay, let me collect details about your existing loans." << '\n';
             application.clearExistingLoans();
 
             bool addMoreLoans = true;
@@ -544,7 +545,7 @@ bool MultiSessionCollector::collectFinancialInfo(LoanApplication& application) {
 
             while (addMoreLoans && loanCount < 10) {
                 loanCount++;
-                cout << endl << "--- Loan #" << loanCount << " ---" << endl;
+                screen << '\n' << "--- Loan #" << loanCount << " ---" << '\n';
                 ExistingLoan loan;
 
                 vector<string> activeOptions = { "Yes - Active", "No - Closed" };
@@ -559,12 +560,12 @@ bool MultiSessionCollector::collectFinancialInfo(LoanApplication& application) {
                     loan.amountReturned = baseCollector.getValidatedNumeric(
                         "Amount already paid (PKR): ", "Amount returned", 0, loan.totalAmount);
                     loan.amountDue = loan.totalAmount - loan.amountReturned;
-                    cout << Config::CHATBOT_NAME << ": Remaining amount: PKR " << loan.amountDue << endl;
+                    screen << Config::CHATBOT_NAME << ": Remaining amount: PKR " << loan.amountDue << '\n';
                 }
                 else {
                     loan.amountReturned = loan.totalAmount;
                     loan.amountDue = 0;
-                    cout << Config::CHATBOT_NAME << ": Marked as fully paid." << endl;
+                    screen << Config::CHATBOT_NAME << ": Marked as fully paid." << '\n';
                 }
 
                 loan.bankName = baseCollector.getValidatedString(
@@ -575,12 +576,12 @@ bool MultiSessionCollector::collectFinancialInfo(LoanApplication& application) {
                     "Loan type:", loanCategories);
 
                 if (loan.validate()) {
-                    application.addExistingLoan(loan);
-                    cout << Config::CHATBOT_NAME << ": Loan #" << loanCount << " recorded!" << endl;
+                    application.addExistingLoan(move(loan));
+                    screen << Config::CHATBOT_NAME << ": Loan #" << loanCount << " recorded!" << '\n';
                 }
 
                 if (loanCount < 10) {
-                    cout << endl << Config::CHATBOT_NAME << ": Do you have another loan to add? (yes/no): ";
+                    screen << '\n' << Config::CHATBOT_NAME << ": Do you have another loan to add? (yes/no): ";
                     string another;
                     getline(cin, another);
                     addMoreLoans = (toLower(trim(another)) == "yes" || toLower(trim(another)) == "y");
@@ -590,8 +591,8 @@ bool MultiSessionCollector::collectFinancialInfo(LoanApplication& application) {
 
         ValidationResult validation = application.validateFinancialInfo();
         if (!validation.isValid) {
-            cout << endl << Config::CHATBOT_NAME << ": There are some issues:" << endl;
-            cout << validation.getReport();
+            screen << '\n' << Config::CHATBOT_NAME << ": There are some issues:" << '\n';
+            screen << validation.getReport();
             return false;
         }
 
@@ -601,16 +602,16 @@ bool MultiSessionCollector::collectFinancialInfo(LoanApplication& application) {
 
     }
     catch (const exception& e) {
-        cout << Config::CHATBOT_NAME << ": Error: " << e.what() << endl;
+        screen << Config::CHATBOT_NAME << ": Error: " << e.what() << '\n';
         return false;
     }
 }
 bool MultiSessionCollector::collectReferencesInfo(LoanApplication& application) {
-    cout << endl << Config::CHATBOT_NAME << ": We need two references who can vouch for you." << endl;
-    cout << Config::CHATBOT_NAME << ": These should be people who know you well." << endl << endl;
+    screen << '\n' << Config::CHATBOT_NAME << ": We need two references who can vouch for you." << '\n';
+    screen << Config::CHATBOT_NAME << ": These should be people who know you well." << '\n' << '\n';
 
     try {
-        cout << "--- REFERENCE 1 ---" << endl;
+        screen << "--- REFERENCE 1 ---" << '\n';
         Reference ref1;
         ref1.name = baseCollector.getValidatedString(
             "Reference 1 - Full name: ", "Reference name", 1, 100);
@@ -622,9 +623,9 @@ bool MultiSessionCollector::collectReferencesInfo(LoanApplication& application)
             "Reference 1 - Phone number: ");
         ref1.email = baseCollector.getValidatedEmail(
             "Reference 1 - Email: ");
-        application.setReference1(ref1);
+        application.setReference1(move(ref1));
 
-        cout << endl << "--- REFERENCE 2 ---" << endl;
+        screen << '\n' << "--- REFERENCE 2 ---" << '\n';
         Reference ref2;
         ref2.name = baseCollector.getValidatedString(
             "Reference 2 - Full name: ", "Reference name", 1, 100);
@@ -636,12 +637,12 @@ bool MultiSessionCollector::collectReferencesInfo(LoanApplication& application)
             "Reference 2 - Phone number: ");
         ref2.email = baseCollector.getValidatedEmail(
             "Reference 2 - Email: ");
-        application.setReference2(ref2);
+        application.setReference2(move(ref2));
 
         ValidationResult validation = application.validateReferences();
         if (!validation.isValid) {
-            cout << endl << Config::CHATBOT_NAME << ": Issues found:" << endl;
-            cout << validation.getReport();
+            screen << '\n' << Config::CHATBOT_NAME << ": Issues found:" << '\n';
+            screen << validation.getReport();
             return false;
         }
 
@@ -651,19 +652,19 @@ bool MultiSessionCollector::collectReferencesInfo(LoanApplication& application)
 
     }
     catch (const exception& e) {
-        cout << Config::CHATBOT_NAME << ": Error: " << e.what() << endl;
+        screen << Config::CHATBOT_NAME << ": Error: " << e.what() << '\n';
         return false;
     }
 }
 bool MultiSessionCollector::collectDocumentsInfo(LoanApplication& application) {
     // Check if application is already submitted
-    if (application.isApplicationComplete() || application.getStatus() == "submitted") {
-        cout << Config::CHATBOT_NAME << ": Your application is already submitted!" << endl;
+    if (application.isApplicationComplete() || application.getStatusCode() == ApplicationStatus::SUBMITTED) {
+        screen << Config::CHATBOT_NAME << ": Your application is already submitted!" << '\n';
         return true;
     }
 
-    cout << endl << Config::CHATBOT_NAME << ": Finally, we need some document scans/photos." << endl;
-    cout << Config::CHATBOT_NAME << ": Please provide the file paths from your computer." << endl << endl;
+    screen << '\n' << Config::CHATBOT_NAME << ": Finally, we need some document scans/photos." << '\n';
+    screen << Config::CHATBOT_NAME << ": Please provide the file paths from your computer." << '\n' << '\n';
 
     try {
         string cnicFront = baseCollector.getImagePath("CNIC Front Side");
@@ -680,8 +681,8 @@ bool MultiSessionCollector::collectDocumentsInfo(LoanApplication& application) {
 
         ValidationResult validation = application.validateDocuments();
         if (!validation.isValid) {
-            cout << endl << Config::CHATBOT_NAME << ": Missing documents:" << endl;
-            cout << validation.getReport();
+            screen << '\n' << Config::CHATBOT_NAME << ": Missing documents:" << '\n';
+            screen << validation.getReport();
 
             // Don't submit if documents are invalid
             application.setStatus("incomplete_documents");
@@ -700,26 +701,26 @@ bool MultiSessionCollector::collectDocumentsInfo(LoanApplication& application) {
 
         // Update the existing record instead of creating new one
         if (fileManager.updateApplicationSection(application, "documents")) {
-            cout << endl << "========================================" << endl;
-            cout << "   APPLICATION SUBMITTED!" << endl;
-            cout << "========================================" << endl;
-            cout << Config::CHATBOT_NAME << ": Congratulations! Your application is complete!" << endl;
-            cout << endl << "Details:" << endl;
-            cout << "  Application ID: " << application.getApplicationId() << endl;
-            cout << "  Date: " << application.getSubmissionDate() << endl;
-            cout << "  Status: Submitted for Review" << endl << endl;
-            cout << Config::CHATBOT_NAME << ": We'll review your application and contact you soon!" << endl;
-            cout << "========================================" << endl;
+            screen << '\n' << "========================================" << '\n';
+            screen << "   APPLICATION SUBMITTED!" << '\n';
+            screen << "========================================" << '\n';
+            screen << Config::CHATBOT_NAME << ": Congratulations! Your application is complete!" << '\n';
+            screen << '\n' << "Details:" << '\n';
+            screen << "  Application ID: " << application.getApplicationId() << '\n';
+            screen << "  Date: " << application.getSubmissionDate() << '\n';
+            screen << "  Status: Submitted for Review" << '\n' << '\n';
+            screen << Config::CHATBOT_NAME << ": We'll review your application and contact you soon!" << '\n';
+            screen << "========================================" << '\n';
             return true;
         }
         else {
-            cout << Config::CHATBOT_NAME << ": Failed to save application." << endl;
+            screen << Config::CHATBOT_NAME << ": Failed to save application." << '\n';
             return false;
         }
 
     }
     catch (const exception& e) {
-        cout << Config::CHATBOT_NAME << ": Error: " << e.what() << endl;
+        screen << Config::CHATBOT_NAME << ": Error: " << e.what() << '\n';
         return false;
     }
 }
@@ -747,12 +748,12 @@ bool MultiSessionCollector::saveSectionAndContinue(LoanApplication& application,
 
     // Save progress
     if (fileManager.updateApplicationSection(application, section)) {
-        cout << endl << Config::CHATBOT_NAME << ": " << getSectionDisplayName(section)
-            << " saved successfully!" << endl;
+        screen << '\n' << Config::CHATBOT_NAME << ": " << getSectionDisplayName(section)
+            << " saved successfully!" << '\n';
         return true;
     }
     else {
-        cout << Config::CHATBOT_NAME << ": Failed to save. Please try again." << endl;
+        screen << Config::CHATBOT_NAME << ": Failed to save. Please try again." << '\n';
         return false;
     }
 }
@@ -0,0 +1,461 @@
+#include "network_utils.h"
+#include "utilities.h"
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <afunix.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#endif
+
+using namespace std;
+
+namespace {
+    const string TCP_PREFIX = "tcp:";
+    const size_t FRAME_HEADER_BYTES = 5;    // uint32 length + uint8 type
+
+#ifdef _WIN32
+    typedef int SocketLength;
+    const int SEND_FLAGS = 0;
+
+    /// <summary>
+    /// Winsock has to be started once per process before any socket call
+    /// </summary>
+    bool startNetworking() {
+        static const bool started = []() {
+            WSADATA data;
+            return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+        }();
+        return started;
+    }
+
+    SocketHandle toHandle(SOCKET socket) {
+        return socket == INVALID_SOCKET ? INVALID_SOCKET_HANDLE : static_cast<SocketHandle>(socket);
+    }
+
+    void releaseSocket(SocketHandle socket) {
+        closesocket(static_cast<SOCKET>(socket));
+    }
+#else
+    typedef socklen_t SocketLength;
+#ifdef MSG_NOSIGNAL
+    const int SEND_FLAGS = MSG_NOSIGNAL;    // A vanished client must not kill the server
+#else
+    const int SEND_FLAGS = 0;
+#endif
+
+    bool startNetworking() {
+        return true;
+    }
+
+    SocketHandle toHandle(int socket) {
+        return socket < 0 ? INVALID_SOCKET_HANDLE : socket;
+    }
+
+    void releaseSocket(SocketHandle socket) {
+        close(socket);
+    }
+#endif
+
+    bool isTcpAddress(const string& address) {
+        return address.compare(0, TCP_PREFIX.length(), TCP_PREFIX) == 0;
+    }
+
+    /// <summary>
+    /// Fills in the socket address for either address form
+    /// </summary>
+    bool resolveAddress(const string& address, sockaddr_storage& storage, SocketLength& length, int& family) {
+        memset(&storage, 0, sizeof(storage));
+
+        if (isTcpAddress(address)) {
+            int port = 0;
+            if (!tryParseNumber(address.substr(TCP_PREFIX.length()), port) || port <= 0 || port > 65535) {
+                cerr << "Error: Invalid server port in '" << address << "'" << endl;
+                return false;
+            }
+            sockaddr_in* inet = reinterpret_cast<sockaddr_in*>(&storage);
+            inet->sin_family = AF_INET;
+            inet->sin_port = htons(static_cast<unsigned short>(port));
+            inet->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            length = sizeof(sockaddr_in);
+            family = AF_INET;
+            return true;
+        }
+
+        sockaddr_un* local = reinterpret_cast<sockaddr_un*>(&storage);
+        if (address.empty() || address.length() >= sizeof(local->sun_path)) {
+            cerr << "Error: Invalid server socket path '" << address << "'" << endl;
+            return false;
+        }
+        local->sun_family = AF_UNIX;
+        memcpy(local->sun_path, address.c_str(), address.length() + 1);
+        length = static_cast<SocketLength>(sizeof(sockaddr_un));
+        family = AF_UNIX;
+        return true;
+    }
+
+    /// <summary>
+    /// What is at a Unix socket path
+    /// </summary>
+    enum class PathKind {
+        MISSING,
+        SOCKET,
+        OTHER           // A file or directory that must not be touched
+    };
+
+    PathKind pathKind(const string& address) {
+#ifdef _WIN32
+        // Windows represents a Unix socket as a reparse point
+        DWORD attributes = GetFileAttributesA(address.c_str());
+        if (attributes == INVALID_FILE_ATTRIBUTES) return PathKind::MISSING;
+        return (attributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0 ? PathKind::SOCKET : PathKind::OTHER;
+#else
+        struct stat info;
+        if (lstat(address.c_str(), &info) != 0) return errno == ENOENT ? PathKind::MISSING : PathKind::OTHER;
+        return S_ISSOCK(info.st_mode) ? PathKind::SOCKET : PathKind::OTHER;
+#endif
+    }
+
+    /// <summary>
+    /// Makes a Unix socket path free to bind: a socket file no server answers
+    /// on is left behind by one that did not shut down cleanly and is removed
+    /// </summary>
+    /// <returns>False (reason printed) if the path is another kind of file or
+    /// a server is (or may be) still listening there</returns>
+    bool claimSocketPath(const string& address, const sockaddr_storage& storage, SocketLength length) {
+        PathKind kind = pathKind(address);
+        if (kind == PathKind::MISSING) return true;
+        if (kind == PathKind::OTHER) {
+            cerr << "Error: Address in use: " << address << " exists and is not a socket" << endl;
+            return false;
+        }
+
+        SocketHandle probe = toHandle(socket(AF_UNIX, SOCK_STREAM, 0));
+        if (probe == INVALID_SOCKET_HANDLE) return false;
+
+        bool connected = connect(probe, reinterpret_cast<const sockaddr*>(&storage), length) == 0;
+#ifdef _WIN32
+        bool stale = !connected && WSAGetLastError() == WSAECONNREFUSED;
+#else
+        bool stale = !connected && errno == ECONNREFUSED;
+#endif
+        releaseSocket(probe);
+
+        if (!stale) {
+            cerr << "Error: A server is already running on " << address << endl;
+            return false;
+        }
+        remove(address.c_str());
+        return true;
+    }
+
+    bool sendAll(SocketHandle socket, const char* data, size_t length) {
+        while (length > 0) {
+#ifdef _WIN32
+            int sent = send(static_cast<SOCKET>(socket), data, static_cast<int>(length), SEND_FLAGS);
+#else
+            ssize_t sent = send(socket, data, length, SEND_FLAGS);
+            if (sent < 0 && errno == EINTR) continue;
+#endif
+            if (sent <= 0) return false;
+            data += sent;
+            length -= static_cast<size_t>(sent);
+        }
+        return true;
+    }
+
+    bool receiveAll(SocketHandle socket, char* data, size_t length) {
+        while (length > 0) {
+#ifdef _WIN32
+            int received = recv(static_cast<SOCKET>(socket), data, static_cast<int>(length), 0);
+#else
+            ssize_t received = recv(socket, data, length, 0);
+            if (received < 0 && errno == EINTR) continue;
+#endif
+            if (received <= 0) return false;
+            data += received;
+            length -= static_cast<size_t>(received);
+        }
+        return true;
+    }
+
+    void encodeUInt32(uint32_t value, char* out) {
+        for (int i = 0; i < 4; i++) {
+            out[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    uint32_t decodeUInt32(const char* in) {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++) {
+            value |= static_cast<uint32_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+        }
+        return value;
+    }
+}
+
+void MessageWriter::writeUInt8(uint8_t value) {
+    buffer.push_back(static_cast<char>(value));
+}
+
+void MessageWriter::writeUInt32(uint32_t value) {
+    char bytes[4];
+    encodeUInt32(value, bytes);
+    buffer.append(bytes, 4);
+}
+
+void MessageWriter::writeString(const string& value) {
+    writeUInt32(static_cast<uint32_t>(value.size()));
+    buffer.append(value);
+}
+
+bool MessageReader::readUInt8(uint8_t& value) {
+    if (buffer.size() - position < 1) return false;
+    value = static_cast<uint8_t>(buffer[position]);
+    position += 1;
+    return true;
+}
+
+bool MessageReader::readUInt32(uint32_t& value) {
+    if (buffer.size() - position < 4) return false;
+    value = decodeUInt32(buffer.data() + position);
+    position += 4;
+    return true;
+}
+
+bool MessageReader::readString(string& value) {
+    uint32_t length = 0;
+    size_t start = position;
+    if (!readUInt32(length)) return false;
+    if (buffer.size() - position < length) {
+        position = start;
+        return false;
+    }
+    value.assign(buffer, position, length);
+    position += length;
+    return true;
+}
+
+namespace Network {
+    SocketHandle listenOn(const string& address, bool ownerOnly) {
+        sockaddr_storage storage;
+        SocketLength length = 0;
+        int family = 0;
+        if (!startNetworking() || !resolveAddress(address, storage, length, family)) {
+            return INVALID_SOCKET_HANDLE;
+        }
+
+        if (family == AF_UNIX && !claimSocketPath(address, storage, length)) {
+            return INVALID_SOCKET_HANDLE;
+        }
+
+        SocketHandle listener = toHandle(socket(family, SOCK_STREAM, 0));
+        if (listener == INVALID_SOCKET_HANDLE) {
+            cerr << "Error: Could not create server socket" << endl;
+            return INVALID_SOCKET_HANDLE;
+        }
+
+        if (family != AF_UNIX) {
+            int reuse = 1;
+            setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+        }
+
+        bool bound = ::bind(listener, reinterpret_cast<sockaddr*>(&storage), length) == 0;
+        string created = bound ? socketFileId(address) : string();
+#ifndef _WIN32
+        // Restricted before listen(), so no one else can connect in between
+        if (bound && ownerOnly && family == AF_UNIX) {
+            bound = chmod(address.c_str(), S_IRUSR | S_IWUSR) == 0;
+        }
+#endif
+        if (!bound || listen(listener, Config::SERVER_LISTEN_BACKLOG) != 0) {
+            cerr << "Error: Could not listen on " << address << endl;
+            releaseSocket(listener);
+            removeAddress(address, created);
+            return INVALID_SOCKET_HANDLE;
+        }
+        return listener;
+    }
+
+    string lenderAddressFor(const string& address) {
+#ifdef _WIN32
+        return "";
+#else
+        return isTcpAddress(address) ? "" : address + Config::LENDER_SOCKET_SUFFIX;
+#endif
+    }
+
+    SocketHandle connectTo(const string& address) {
+        sockaddr_storage storage;
+        SocketLength length = 0;
+        int family = 0;
+        if (!startNetworking() || !resolveAddress(address, storage, length, family)) {
+            return INVALID_SOCKET_HANDLE;
+        }
+
+        SocketHandle connection = toHandle(socket(family, SOCK_STREAM, 0));
+        if (connection == INVALID_SOCKET_HANDLE) return INVALID_SOCKET_HANDLE;
+
+        if (connect(connection, reinterpret_cast<sockaddr*>(&storage), length) != 0) {
+            releaseSocket(connection);
+            return INVALID_SOCKET_HANDLE;
+        }
+
+        if (family == AF_INET) {
+            // Requests are small and answered one at a time, so never wait to coalesce
+            int noDelay = 1;
+            setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+        }
+        return connection;
+    }
+
+    SocketHandle acceptClient(SocketHandle listener) {
+        while (true) {
+            SocketHandle client = toHandle(accept(listener, nullptr, nullptr));
+#ifndef _WIN32
+            if (client == INVALID_SOCKET_HANDLE && errno == EINTR) continue;
+#endif
+            return client;
+        }
+    }
+
+    void interruptSocket(SocketHandle socket) {
+        if (socket == INVALID_SOCKET_HANDLE) return;
+#ifdef _WIN32
+        shutdown(static_cast<SOCKET>(socket), SD_BOTH);
+#else
+        shutdown(socket, SHUT_RDWR);
+#endif
+    }
+
+    void closeSocket(SocketHandle socket) {
+        if (socket == INVALID_SOCKET_HANDLE) return;
+        interruptSocket(socket);
+        releaseSocket(socket);
+    }
+
+    string socketFileId(const string& address) {
+        if (address.empty() || isTcpAddress(address) || pathKind(address) != PathKind::SOCKET) return string();
+#ifdef _WIN32
+        return address;
+#else
+        struct stat info;
+        if (lstat(address.c_str(), &info) != 0) return string();
+        // Inode numbers are reused at once, so the creation time tells a new socket from ours
+        string id = to_string(static_cast<unsigned long long>(info.st_dev)) + ":" +
+            to_string(static_cast<unsigned long long>(info.st_ino)) + ":" +
+            to_string(static_cast<long long>(info.st_ctime));
+#ifdef __linux__
+        id += "." + to_string(static_cast<long long>(info.st_ctim.tv_nsec));
+#endif
+        return id;
+#endif
+    }
+
+    void removeAddress(const string& address, const string& fileId) {
+        // Whatever has replaced the socket since (or a mistyped path) is left alone
+        if (!fileId.empty() && socketFileId(address) == fileId) {
+            remove(address.c_str());
+        }
+    }
+
+    bool setNonBlocking(SocketHandle socket) {
+#ifdef _WIN32
+        u_long enabled = 1;
+        return ioctlsocket(static_cast<SOCKET>(socket), FIONBIO, &enabled) == 0;
+#else
+        int flags = fcntl(socket, F_GETFL, 0);
+        return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+    }
+
+    long sendSome(SocketHandle socket, const char* data, size_t length) {
+        while (true) {
+#ifdef _WIN32
+            int sent = send(static_cast<SOCKET>(socket), data, static_cast<int>(length), SEND_FLAGS);
+            if (sent < 0) return WSAGetLastError() == WSAEWOULDBLOCK ? 0 : -1;
+#else
+            ssize_t sent = send(socket, data, length, SEND_FLAGS);
+            if (sent < 0 && errno == EINTR) continue;
+            if (sent < 0) return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+#endif
+            return static_cast<long>(sent);
+        }
+    }
+
+    long receiveSome(SocketHandle socket, char* data, size_t length) {
+        while (true) {
+#ifdef _WIN32
+            int received = recv(static_cast<SOCKET>(socket), data, static_cast<int>(length), 0);
+            if (received < 0) return WSAGetLastError() == WSAEWOULDBLOCK ? 0 : -1;
+#else
+            ssize_t received = recv(socket, data, length, 0);
+            if (received < 0 && errno == EINTR) continue;
+            if (received < 0) return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+#endif
+            return received == 0 ? -1 : static_cast<long>(received);
+        }
+    }
+
+    void appendFrame(string& buffer, MessageType type, const string& payload) {
+        char header[FRAME_HEADER_BYTES];
+        encodeUInt32(static_cast<uint32_t>(payload.size()), header);
+        header[4] = static_cast<char>(type);
+        buffer.append(header, FRAME_HEADER_BYTES);
+        buffer.append(payload);
+    }
+
+    FrameStatus parseFrame(const string& buffer, size_t& offset, MessageType& type, string& payload, uint32_t maxLength) {
+        if (buffer.size() - offset < FRAME_HEADER_BYTES) return FrameStatus::INCOMPLETE;
+
+        uint32_t length = decodeUInt32(buffer.data() + offset);
+        if (length > maxLength) return FrameStatus::INVALID;
+        if (buffer.size() - offset - FRAME_HEADER_BYTES < length) return FrameStatus::INCOMPLETE;
+
+        type = static_cast<MessageType>(static_cast<uint8_t>(buffer[offset + 4]));
+        payload.assign(buffer, offset + FRAME_HEADER_BYTES, length);
+        offset += FRAME_HEADER_BYTES + length;
+        return FrameStatus::COMPLETE;
+    }
+
+    bool sendFrame(SocketHandle socket, MessageType type, const string& payload, uint32_t maxLength) {
+        if (payload.size() > maxLength) {
+            cerr << "Error: Message of " << payload.size() << " bytes is too large to send" << endl;
+            return false;
+        }
+
+        // Header and payload go out in one buffer so small messages are one send()
+        string frame;
+        frame.reserve(FRAME_HEADER_BYTES + payload.size());
+        appendFrame(frame, type, payload);
+        return sendAll(socket, frame.data(), frame.size());
+    }
+
+    bool receiveFrame(SocketHandle socket, MessageType& type, string& payload, uint32_t maxLength) {
+        char header[FRAME_HEADER_BYTES];
+        if (!receiveAll(socket, header, FRAME_HEADER_BYTES)) return false;
+
+        uint32_t length = decodeUInt32(header);
+        if (length > maxLength) {
+            cerr << "Error: Rejected a " << length << " byte message" << endl;
+            return false;
+        }
+
+        type = static_cast<MessageType>(static_cast<uint8_t>(header[4]));
+        payload.resize(length);
+        return length == 0 || receiveAll(socket, &payload[0], length);
+    }
+}
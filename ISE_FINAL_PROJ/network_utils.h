@@ -0,0 +1,193 @@
+#ifndef NETWORK_UTILS_H
+#define NETWORK_UTILS_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+using namespace std;
+
+#ifdef _WIN32
+typedef uintptr_t SocketHandle;
+#else
+typedef int SocketHandle;
+#endif
+
+const SocketHandle INVALID_SOCKET_HANDLE = static_cast<SocketHandle>(-1);
+
+/// <summary>
+/// Message types of the lender server protocol
+/// Every frame is: payload length (uint32, little endian), type (uint8), payload
+/// </summary>
+enum class MessageType : uint8_t {
+    // Requests (user_client -> lender_server); UPDATE_STATUS and LOAD_ALL
+    // are answered only on the lender socket
+    GENERATE_ID = 1,
+    SAVE_APPLICATION,           // record -> saved record
+    UPDATE_SECTION,             // record, section
+    UPDATE_STATUS,              // id, status, rejection reason
+    FIND_BY_ID,                 // id -> record
+    FIND_BY_CNIC,               // cnic -> record list
+    FIND_INCOMPLETE,            // id, cnic -> record
+    FIND_USER_INCOMPLETE,       // cnic -> record list
+    LOAD_ALL,                   // -> record list
+    SUBSCRIBE,                  // kind (SubscriptionKind), key
+    UNSUBSCRIBE,                // kind (SubscriptionKind), key
+    UPLOAD_DOCUMENT,            // id, document type, content -> stored path
+
+    // Responses
+    RESPONSE_OK = 100,
+    RESPONSE_ERROR,             // message
+
+    // Pushed by the server without a request; may arrive before any response
+    STATUS_EVENT = 110          // id, cnic, status, rejection reason
+};
+
+/// <summary>
+/// What a SUBSCRIBE key names
+/// </summary>
+enum class SubscriptionKind : uint8_t {
+    APPLICATION_ID = 0,
+    CNIC = 1
+};
+
+/// <summary>
+/// Builds a frame payload: integers little endian, strings length-prefixed
+/// </summary>
+class MessageWriter {
+private:
+    string buffer;
+
+public:
+    void writeUInt8(uint8_t value);
+    void writeUInt32(uint32_t value);
+    void writeString(const string& value);
+
+    const string& data() const { return buffer; }
+    void clear() { buffer.clear(); }
+};
+
+/// <summary>
+/// Reads a frame payload written by MessageWriter
+/// Every read returns false (and leaves the output alone) once the payload is exhausted
+/// </summary>
+class MessageReader {
+private:
+    const string& buffer;
+    size_t position;
+
+public:
+    explicit MessageReader(const string& payload) : buffer(payload), position(0) {}
+
+    bool readUInt8(uint8_t& value);
+    bool readUInt32(uint32_t& value);
+    bool readString(string& value);
+    bool atEnd() const { return position == buffer.size(); }
+    size_t remaining() const { return buffer.size() - position; }
+};
+
+/// <summary>
+/// Outcome of looking for a frame in a receive buffer
+/// </summary>
+enum class FrameStatus {
+    COMPLETE,       // type/payload filled in, offset moved past the frame
+    INCOMPLETE,     // more bytes needed
+    INVALID         // oversized frame; the connection should be dropped
+};
+
+/// <summary>
+/// Socket helpers for the lender server
+/// Addresses are a Unix domain socket path, or "tcp:PORT" for the loopback interface
+/// SE Principles:
+/// - Information Hiding: platform socket APIs stay in network_utils.cpp
+/// - Single Responsibility: transport and framing only, no knowledge of applications
+/// </summary>
+namespace Network {
+    /// <summary>
+    /// Creates a listening socket
+    /// A Unix socket file is replaced only when nothing answers on it, so a
+    /// second server cannot take over the socket of one that is running;
+    /// any other kind of file at the path makes this fail.
+    /// </summary>
+    /// <param name="ownerOnly">Only the server's own user may connect (Unix sockets)</param>
+    /// <returns>INVALID_SOCKET_HANDLE on failure (reason printed to cerr)</returns>
+    SocketHandle listenOn(const string& address, bool ownerOnly = false);
+
+    /// <summary>
+    /// Address of the lender socket served next to a user address
+    /// </summary>
+    /// <returns>Empty where file permissions cannot protect it (TCP, Windows)</returns>
+    string lenderAddressFor(const string& address);
+
+    /// <summary>
+    /// Connects to a listening server
+    /// </summary>
+    /// <returns>INVALID_SOCKET_HANDLE if nothing is listening</returns>
+    SocketHandle connectTo(const string& address);
+
+    /// <summary>
+    /// Waits for the next client (blocking)
+    /// </summary>
+    SocketHandle acceptClient(SocketHandle listener);
+
+    /// <summary>
+    /// Shuts the socket down so a thread blocked on it returns (the handle stays valid)
+    /// </summary>
+    void interruptSocket(SocketHandle socket);
+
+    /// <summary>
+    /// Shuts the socket down and releases it
+    /// </summary>
+    void closeSocket(SocketHandle socket);
+
+    /// <summary>
+    /// Identity of the socket file at a Unix address, taken right after
+    /// listenOn so removeAddress can tell it from anything put there later
+    /// </summary>
+    /// <returns>Empty for TCP, or if the path is missing or not a socket</returns>
+    string socketFileId(const string& address);
+
+    /// <summary>
+    /// Removes the socket file created by listenOn, if it is still that socket (no-op for TCP)
+    /// </summary>
+    /// <param name="fileId">socketFileId taken when the socket was created</param>
+    void removeAddress(const string& address, const string& fileId);
+
+    /// <summary>
+    /// Switches a socket to non-blocking mode (for the event-driven server)
+    /// </summary>
+    bool setNonBlocking(SocketHandle socket);
+
+    /// <summary>
+    /// Non-blocking send/receive of whatever fits right now
+    /// </summary>
+    /// <returns>Bytes transferred, 0 if the call would block, -1 on error or
+    /// (for receiveSome) when the peer has closed the connection</returns>
+    long sendSome(SocketHandle socket, const char* data, size_t length);
+    long receiveSome(SocketHandle socket, char* data, size_t length);
+
+    /// <summary>
+    /// Appends one encoded frame to an output buffer
+    /// </summary>
+    void appendFrame(string& buffer, MessageType type, const string& payload);
+
+    /// <summary>
+    /// Decodes the frame starting at offset in a receive buffer
+    /// </summary>
+    /// <param name="maxLength">Payloads longer than this make the frame INVALID</param>
+    FrameStatus parseFrame(const string& buffer, size_t& offset, MessageType& type, string& payload, uint32_t maxLength);
+
+    /// <summary>
+    /// Sends one complete frame
+    /// </summary>
+    /// <param name="maxLength">Largest payload the receiving side accepts</param>
+    bool sendFrame(SocketHandle socket, MessageType type, const string& payload, uint32_t maxLength);
+
+    /// <summary>
+    /// Receives one complete frame
+    /// </summary>
+    /// <param name="maxLength">Largest payload accepted</param>
+    /// <returns>False on disconnect, I/O error or an oversized frame</returns>
+    bool receiveFrame(SocketHandle socket, MessageType& type, string& payload, uint32_t maxLength);
+}
+
+#endif
@@ -1,6 +1,8 @@
 #include "personal.h"
 #include "utilities.h"
-#include <fstream>
+#include "text_scanner.h"
+#include "installment_schedule.h"
+#include "screen_buffer.h"
 #include <iostream>
 #include <stdexcept>
 #include <iomanip>
@@ -72,55 +74,38 @@ void PersonalLoan::displayInstallmentPlan() const {
     long long monthlyInstallment = calculateMonthlyInstallment();
     long long remainingBalance = getAmount() - getDownPayment();
 
-    cout << endl << "  PERSONAL LOAN INSTALLMENT PLAN" << endl;
-    cout << "========================================" << endl;
-    cout << "Loan Details:" << endl;
-    cout << "  Category: " << getCategory() << endl;
-    cout << "  Purpose: " << getPurpose() << endl;
-    cout << "  Description: " << getDescription() << endl;
-    cout << "  Total Amount: PKR " << getAmount() << endl;
-    cout << "  Down Payment: PKR " << getDownPayment() << endl;
-    cout << "  Loan Amount: PKR " << remainingBalance << endl;
-    cout << "  Installment Period: " << getInstallments() << " months" << endl;
-    cout << "  Monthly Installment: PKR " << monthlyInstallment << endl;
-    cout << "========================================" << endl << endl;
-
-    cout << "Monthly Payment Schedule:" << endl;
-    cout << "+-------+----------------+---------------+" << endl;
-    cout << "| Month |  Payment Due   | Remaining Bal |" << endl;
-    cout << "+-------+----------------+---------------+" << endl;
-
-    long long currentBalance = remainingBalance;
-
-    for (int month = 1; month <= getInstallments(); month++) {
-        long long paymentDue = monthlyInstallment;
-
-        if (month == getInstallments()) {
-            paymentDue = currentBalance;
-        }
-
-        cout << "| " << setw(5) << month << " | PKR " << setw(10) << paymentDue
-            << " | PKR " << setw(10) << (currentBalance - paymentDue) << " |" << endl;
-
-        currentBalance -= paymentDue;
-        if (currentBalance < 0) currentBalance = 0;
-    }
-
-    cout << "+-------+----------------+---------------+" << endl << endl;
+    screen << '\n' << "  PERSONAL LOAN INSTALLMENT PLAN" << '\n';
+    screen << "========================================" << '\n';
+    screen << "Loan Details:" << '\n';
+    screen << "  Category: " << getCategory() << '\n';
+    screen << "  Purpose: " << getPurpose() << '\n';
+    screen << "  Description: " << getDescription() << '\n';
+    screen << "  Total Amount: PKR " << getAmount() << '\n';
+    screen << "  Down Payment: PKR " << getDownPayment() << '\n';
+    screen << "  Loan Amount: PKR " << remainingBalance << '\n';
+    screen << "  Installment Period: " << getInstallments() << " months" << '\n';
+    screen << "  Monthly Installment: PKR " << monthlyInstallment << '\n';
+    screen << "========================================" << '\n' << '\n';
+
+    screen << "Monthly Payment Schedule:" << '\n';
+
+    InstallmentSchedule schedule(remainingBalance, getInstallments(), monthlyInstallment);
+    schedule.writeTable(screen);
+    screen << '\n';
 
     long long totalPayment = getDownPayment() + (monthlyInstallment * getInstallments());
     long long totalInstallments = monthlyInstallment * getInstallments();
 
-    cout << "Payment Summary:" << endl;
-    cout << "  Total Payment: PKR " << totalPayment << endl;
-    cout << "  Down Payment: PKR " << getDownPayment() << endl;
-    cout << "  Total Installments: PKR " << totalInstallments << endl;
+    screen << "Payment Summary:" << '\n';
+    screen << "  Total Payment: PKR " << totalPayment << '\n';
+    screen << "  Down Payment: PKR " << getDownPayment() << '\n';
+    screen << "  Total Installments: PKR " << totalInstallments << '\n';
 }
 
 int loadPersonalLoans(PersonalLoan loans[], int maxSize, const string& filename) {
-    ifstream file(filename);
+    LineReader file(filename);
 
-    if (!file.is_open()) {
+    if (!file.isOpen()) {
         cerr << "Error: Could not open " << filename << endl;
         return 0;
     }
@@ -130,7 +115,7 @@ int loadPersonalLoans(PersonalLoan loans[], int maxSize, const string& filename)
     int lineNumber = 0;
     bool firstLine = true;
 
-    while (getline(file, line) && count < maxSize) {
+    while (count < maxSize && file.next(line)) {
         lineNumber++;
 
         if (firstLine) {
@@ -166,7 +151,6 @@ int loadPersonalLoans(PersonalLoan loans[], int maxSize, const string& filename)
         }
     }
 
-    file.close();
     return count;
 }
 
@@ -212,22 +196,22 @@ bool displayPersonalLoanOptionsByCategory(const PersonalLoan loans[], int size,
         catNum = stoi(categoryIndex);
     }
     catch (...) {
-        cout << "Invalid category selection." << endl;
+        screen << "Invalid category selection." << '\n';
         return false;
     }
 
     if (catNum < 1 || catNum > static_cast<int>(categories.size())) {
-        cout << "Invalid category number." << endl;
+        screen << "Invalid category number." << '\n';
         return false;
     }
 
     string selectedCategory = categories[catNum - 1];
     bool found = false;
 
-    cout << endl << "  Personal Loan Options for: " << selectedCategory << endl;
-    cout << "+-----+------------------+---------------------+---------------+-------------+---------------+" << endl;
-    cout << "| Opt | Purpose          | Description         | Installments  | Amount (PKR)| Down Payment  |" << endl;
-    cout << "+-----+------------------+---------------------+---------------+-------------+---------------+" << endl;
+    screen << '\n' << "  Personal Loan Options for: " << selectedCategory << '\n';
+    screen << "+-----+------------------+---------------------+---------------+-------------+---------------+" << '\n';
+    screen << "| Opt | Purpose          | Description         | Installments  | Amount (PKR)| Down Payment  |" << '\n';
+    screen << "+-----+------------------+---------------------+---------------+-------------+---------------+" << '\n';
 
     int optionCount = 0;
     for (int i = 0; i < size; i++) {
@@ -241,18 +225,18 @@ bool displayPersonalLoanOptionsByCategory(const PersonalLoan loans[], int size,
             if (purpose.length() > 16) purpose = purpose.substr(0, 13) + "...";
             if (description.length() > 19) description = description.substr(0, 16) + "...";
 
-            cout << "| " << setw(3) << optionCount << " | "
+            screen << "| " << setw(3) << optionCount << " | "
                 << setw(16) << left << purpose << " | "
                 << setw(19) << left << description << " | "
                 << setw(13) << loans[i].getInstallments() << " | "
                 << setw(11) << loans[i].getAmount() << " | "
-                << "PKR " << setw(10) << loans[i].getDownPayment() << " |" << endl;
+                << "PKR " << setw(10) << loans[i].getDownPayment() << " |" << '\n';
         }
     }
-    cout << "+-----+------------------+---------------------+---------------+-------------+---------------+" << endl;
+    screen << "+-----+------------------+---------------------+---------------+-------------+---------------+" << '\n';
 
     if (!found) {
-        cout << "No personal loan options available for this category." << endl;
+        screen << "No personal loan options available for this category." << '\n';
     }
 
     return found;
@@ -262,7 +246,7 @@ bool displayPersonalInstallmentPlan(const PersonalLoan loans[], int size,
     int optionNumber) {
 
     if (optionNumber < 1 || optionNumber > size) {
-        cout << "Invalid option number. Please try again." << endl;
+        screen << "Invalid option number. Please try again." << '\n';
         return false;
     }
 
@@ -0,0 +1,388 @@
+#include "record_index.h"
+#include "bloom_filter.h"
+#include "checksum.h"
+#include "write_ahead_log.h"
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+
+namespace {
+    const char INDEX_MAGIC[4] = { 'L', 'I', 'D', 'X' };
+    const uint32_t INDEX_VERSION = 2;
+    const size_t HEADER_FIELD_BYTES = 80;   // Header fields covered by the header CRC
+
+    // Node pages: leaf flag, entry count, next leaf, then the entries
+    const size_t NODE_HEADER_BYTES = 16;
+    const size_t LEAF_ENTRY_BYTES = RecordIndex::KEY_BYTES + 8;        // key, record offset
+    const size_t BRANCH_ENTRY_BYTES = RecordIndex::KEY_BYTES + 4;      // smallest key below, child page
+    const size_t LEAF_CAPACITY = (RecordIndex::PAGE_BYTES - NODE_HEADER_BYTES) / LEAF_ENTRY_BYTES;
+    const size_t BRANCH_CAPACITY = (RecordIndex::PAGE_BYTES - NODE_HEADER_BYTES) / BRANCH_ENTRY_BYTES;
+
+    void putUInt32(char* out, uint32_t value) {
+        for (int i = 0; i < 4; i++) out[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    void putUInt64(char* out, uint64_t value) {
+        for (int i = 0; i < 8; i++) out[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    uint32_t getUInt32(const char* in) {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++) value |= static_cast<uint32_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+        return value;
+    }
+
+    uint64_t getUInt64(const char* in) {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; i++) value |= static_cast<uint64_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+        return value;
+    }
+
+    /// <summary>
+    /// Bloom filter entry: IDs and CNICs share one filter, so the key type is part of it
+    /// </summary>
+    string filterKey(IndexKey key, const string& value) {
+        return static_cast<char>('0' + static_cast<int>(key)) + value;
+    }
+
+    /// <summary>
+    /// Key as stored in a page: truncated or zero-padded to KEY_BYTES
+    /// </summary>
+    void putKey(char* out, const string& key) {
+        size_t length = min(key.size(), RecordIndex::KEY_BYTES);
+        memcpy(out, key.data(), length);
+        memset(out + length, 0, RecordIndex::KEY_BYTES - length);
+    }
+
+    struct KeyedOffset {
+        char key[RecordIndex::KEY_BYTES];
+        uint64_t offset;
+    };
+
+    bool keyedOffsetLess(const KeyedOffset& a, const KeyedOffset& b) {
+        int order = memcmp(a.key, b.key, RecordIndex::KEY_BYTES);
+        return order != 0 ? order < 0 : a.offset < b.offset;
+    }
+
+    /// <summary>
+    /// Appends one tree to the page buffer, leaves first, then each level of
+    /// branches above them (bulk load from sorted entries)
+    /// </summary>
+    void buildTree(const vector<KeyedOffset>& entries, string& file, uint32_t& root, uint32_t& height) {
+        struct Child {
+            const char* smallestKey;
+            uint32_t page;
+        };
+        vector<Child> level;
+
+        size_t leafCount = max<size_t>(1, (entries.size() + LEAF_CAPACITY - 1) / LEAF_CAPACITY);
+        uint32_t firstLeaf = static_cast<uint32_t>(file.size() / RecordIndex::PAGE_BYTES);
+        for (size_t leaf = 0; leaf < leafCount; leaf++) {
+            size_t begin = leaf * LEAF_CAPACITY;
+            size_t end = min(entries.size(), begin + LEAF_CAPACITY);
+            uint32_t page = firstLeaf + static_cast<uint32_t>(leaf);
+
+            string node(RecordIndex::PAGE_BYTES, '\0');
+            node[0] = 1;
+            putUInt32(&node[4], static_cast<uint32_t>(end - begin));
+            putUInt32(&node[8], leaf + 1 < leafCount ? page + 1 : 0);
+            for (size_t i = begin; i < end; i++) {
+                char* entry = &node[NODE_HEADER_BYTES + (i - begin) * LEAF_ENTRY_BYTES];
+                memcpy(entry, entries[i].key, RecordIndex::KEY_BYTES);
+                putUInt64(entry + RecordIndex::KEY_BYTES, entries[i].offset);
+            }
+            file += node;
+            level.push_back({ begin < end ? entries[begin].key : nullptr, page });
+        }
+
+        height = 1;
+        while (level.size() > 1) {
+            vector<Child> parents;
+            for (size_t begin = 0; begin < level.size(); begin += BRANCH_CAPACITY) {
+                size_t end = min(level.size(), begin + BRANCH_CAPACITY);
+                uint32_t page = static_cast<uint32_t>(file.size() / RecordIndex::PAGE_BYTES);
+
+                string node(RecordIndex::PAGE_BYTES, '\0');
+                putUInt32(&node[4], static_cast<uint32_t>(end - begin));
+                for (size_t i = begin; i < end; i++) {
+                    char* entry = &node[NODE_HEADER_BYTES + (i - begin) * BRANCH_ENTRY_BYTES];
+                    memcpy(entry, level[i].smallestKey, RecordIndex::KEY_BYTES);
+                    putUInt32(entry + RecordIndex::KEY_BYTES, level[i].page);
+                }
+                file += node;
+                parents.push_back({ level[begin].smallestKey, page });
+            }
+            level.swap(parents);
+            height++;
+        }
+        root = level[0].page;
+    }
+}
+
+RecordIndex::RecordIndex(const string& indexedFile)
+    : dataFile(indexedFile), indexFile(indexedFile + ".idx"), pages(nullptr), mappedBytes(0),
+    coveredBytes(0), firstWindowCrc(0), lastWindowCrc(0), highestId(0), pageCount(0),
+    roots{ 0, 0 }, heights{ 0, 0 }, counts{ 0, 0 }, filterPage(0), filterBytes(0),
+    dataChecked(false), checkedSize(0), checkedModified(0), checkedInode(0) {
+}
+
+RecordIndex::~RecordIndex() {
+    close();
+}
+
+bool RecordIndex::isOpen() const {
+    return pages != nullptr;
+}
+
+uint64_t RecordIndex::getCoveredBytes() const {
+    return coveredBytes;
+}
+
+long long RecordIndex::getHighestId() const {
+    return highestId;
+}
+
+uint64_t RecordIndex::getRecordCount() const {
+    return counts[static_cast<int>(IndexKey::APPLICATION_ID)];
+}
+
+bool RecordIndex::open() {
+    close();
+
+#ifdef _WIN32
+    ifstream file(indexFile, ios::binary | ios::ate);
+    if (!file.is_open()) return false;
+    streamoff size = file.tellg();
+    if (size < static_cast<streamoff>(PAGE_BYTES) || size % PAGE_BYTES != 0) return false;
+    loadedPages.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    if (!file.read(loadedPages.data(), size)) {
+        loadedPages.clear();
+        return false;
+    }
+    pages = loadedPages.data();
+    mappedBytes = loadedPages.size();
+#else
+    int descriptor = ::open(indexFile.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) return false;
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || info.st_size < static_cast<off_t>(PAGE_BYTES) ||
+        info.st_size % PAGE_BYTES != 0) {
+        ::close(descriptor);
+        return false;
+    }
+    void* mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if (mapping == MAP_FAILED) return false;
+    pages = static_cast<const char*>(mapping);
+    mappedBytes = static_cast<size_t>(info.st_size);
+#endif
+
+    if (!readHeader() || !matchesDataFile()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void RecordIndex::close() {
+    if (pages == nullptr) return;
+#ifdef _WIN32
+    loadedPages.clear();
+    loadedPages.shrink_to_fit();
+#else
+    munmap(const_cast<char*>(pages), mappedBytes);
+#endif
+    pages = nullptr;
+    mappedBytes = 0;
+    dataChecked = false;
+}
+
+bool RecordIndex::readHeader() {
+    if (memcmp(pages, INDEX_MAGIC, 4) != 0 || getUInt32(pages + 4) != INDEX_VERSION ||
+        getUInt32(pages + HEADER_FIELD_BYTES) != crc32(pages, HEADER_FIELD_BYTES)) {
+        return false;
+    }
+
+    pageCount = getUInt32(pages + 8);
+    coveredBytes = getUInt64(pages + 16);
+    firstWindowCrc = getUInt32(pages + 24);
+    lastWindowCrc = getUInt32(pages + 28);
+    highestId = static_cast<long long>(getUInt64(pages + 32));
+    for (int tree = 0; tree < 2; tree++) {
+        roots[tree] = getUInt32(pages + 40 + 4 * tree);
+        heights[tree] = getUInt32(pages + 48 + 4 * tree);
+        counts[tree] = getUInt64(pages + 56 + 8 * tree);
+        if (roots[tree] == 0 || roots[tree] >= pageCount || heights[tree] == 0) return false;
+    }
+    filterPage = getUInt32(pages + 72);
+    filterBytes = getUInt32(pages + 76);
+    return static_cast<uint64_t>(pageCount) * PAGE_BYTES == mappedBytes && filterPage > 0 &&
+        static_cast<uint64_t>(filterPage) * PAGE_BYTES + filterBytes <= mappedBytes;
+}
+
+bool RecordIndex::checksumDataWindows(uint64_t covered, uint32_t& first, uint32_t& last) const {
+    ifstream file(dataFile, ios::binary);
+    if (!file.is_open()) return false;
+
+    size_t window = static_cast<size_t>(min<uint64_t>(covered, PAGE_BYTES));
+    string bytes(window, '\0');
+    if (window > 0 && !file.read(&bytes[0], window)) return false;
+    first = crc32(bytes);
+
+    file.seekg(static_cast<streamoff>(covered - window));
+    if (window > 0 && !file.read(&bytes[0], window)) return false;
+    last = crc32(bytes);
+    return true;
+}
+
+bool RecordIndex::matchesDataFile() const {
+    struct stat info;
+    if (pages == nullptr || stat(dataFile.c_str(), &info) != 0 ||
+        static_cast<uint64_t>(info.st_size) < coveredBytes) {
+        return false;
+    }
+
+    // Rewrites replace the file (a new inode) or change its size or time
+    uint64_t size = static_cast<uint64_t>(info.st_size);
+    long long modified = static_cast<long long>(info.st_mtime);
+    uint64_t inode = static_cast<uint64_t>(info.st_ino);
+    if (dataChecked && size == checkedSize && modified == checkedModified && inode == checkedInode) {
+        return true;
+    }
+
+    uint32_t first = 0, last = 0;
+    if (!checksumDataWindows(coveredBytes, first, last) || first != firstWindowCrc || last != lastWindowCrc) {
+        return false;
+    }
+    dataChecked = true;
+    checkedSize = size;
+    checkedModified = modified;
+    checkedInode = inode;
+    return true;
+}
+
+bool RecordIndex::build(const vector<IndexedRecord>& records, uint64_t covered, long long highest,
+    double falsePositiveRate) {
+    close();
+
+    uint32_t first = 0, last = 0;
+    if (!checksumDataWindows(covered, first, last)) return false;
+
+    string file(PAGE_BYTES, '\0');      // Header page, filled in once the trees are laid out
+    uint32_t treeRoots[2] = { 0, 0 };
+    uint32_t treeHeights[2] = { 0, 0 };
+
+    vector<KeyedOffset> entries(records.size());
+    for (int tree = 0; tree < 2; tree++) {
+        for (size_t i = 0; i < records.size(); i++) {
+            putKey(entries[i].key, tree == 0 ? records[i].applicationId : records[i].cnic);
+            entries[i].offset = records[i].offset;
+        }
+        sort(entries.begin(), entries.end(), keyedOffsetLess);
+        buildTree(entries, file, treeRoots[tree], treeHeights[tree]);
+    }
+
+    BloomFilter filter(records.size() * 2, falsePositiveRate);
+    for (const auto& record : records) {
+        filter.add(filterKey(IndexKey::APPLICATION_ID, record.applicationId));
+        filter.add(filterKey(IndexKey::CNIC, record.cnic));
+    }
+    string serializedFilter = filter.serialize();
+    uint32_t firstFilterPage = static_cast<uint32_t>(file.size() / PAGE_BYTES);
+    file += serializedFilter;
+    file.resize((file.size() + PAGE_BYTES - 1) / PAGE_BYTES * PAGE_BYTES, '\0');
+
+    char* header = &file[0];
+    memcpy(header, INDEX_MAGIC, 4);
+    putUInt32(header + 4, INDEX_VERSION);
+    putUInt32(header + 8, static_cast<uint32_t>(file.size() / PAGE_BYTES));
+    putUInt64(header + 16, covered);
+    putUInt32(header + 24, first);
+    putUInt32(header + 28, last);
+    putUInt64(header + 32, static_cast<uint64_t>(highest));
+    for (int tree = 0; tree < 2; tree++) {
+        putUInt32(header + 40 + 4 * tree, treeRoots[tree]);
+        putUInt32(header + 48 + 4 * tree, treeHeights[tree]);
+        putUInt64(header + 56 + 8 * tree, records.size());
+    }
+    putUInt32(header + 72, firstFilterPage);
+    putUInt32(header + 76, static_cast<uint32_t>(serializedFilter.size()));
+    putUInt32(header + HEADER_FIELD_BYTES, crc32(header, HEADER_FIELD_BYTES));
+
+    // The index can always be rebuilt from the data file, so it is not synced
+    if (!replaceFileContents(indexFile, file, false)) return false;
+    return open();
+}
+
+bool RecordIndex::mightContain(IndexKey key, const string& value) const {
+    if (pages == nullptr) return true;
+    return BloomFilter::mightContain(pages + static_cast<size_t>(filterPage) * PAGE_BYTES, filterBytes,
+        filterKey(key, value));
+}
+
+bool RecordIndex::lookup(IndexKey key, const string& value, vector<uint64_t>& offsets) const {
+    if (pages == nullptr) return false;
+
+    int tree = static_cast<int>(key);
+    char probe[KEY_BYTES];
+    putKey(probe, value);
+
+    // Descend to the last child whose smallest key is below the value: equal
+    // keys may begin at the end of that child and continue into the next one
+    uint32_t page = roots[tree];
+    for (uint32_t level = 1; level < heights[tree]; level++) {
+        const char* node = pages + static_cast<size_t>(page) * PAGE_BYTES;
+        uint32_t count = getUInt32(node + 4);
+        if (node[0] != 0 || count == 0 || count > BRANCH_CAPACITY) return false;
+
+        const char* entries = node + NODE_HEADER_BYTES;
+        uint32_t low = 1, high = count;     // First child whose key is not below the value
+        while (low < high) {
+            uint32_t middle = low + (high - low) / 2;
+            if (memcmp(entries + middle * BRANCH_ENTRY_BYTES, probe, KEY_BYTES) < 0) low = middle + 1;
+            else high = middle;
+        }
+        page = getUInt32(entries + (low - 1) * BRANCH_ENTRY_BYTES + KEY_BYTES);
+        if (page == 0 || page >= pageCount) return false;
+    }
+
+    // Walk the leaf chain from there until the keys pass the value
+    size_t firstFound = offsets.size();
+    while (page != 0) {
+        if (page >= pageCount) return false;
+        const char* node = pages + static_cast<size_t>(page) * PAGE_BYTES;
+        uint32_t count = getUInt32(node + 4);
+        if (node[0] != 1 || count > LEAF_CAPACITY) return false;
+
+        const char* entries = node + NODE_HEADER_BYTES;
+        for (uint32_t i = 0; i < count; i++) {
+            int order = memcmp(entries + i * LEAF_ENTRY_BYTES, probe, KEY_BYTES);
+            if (order > 0) {
+                page = 0;
+                break;
+            }
+            if (order == 0) offsets.push_back(getUInt64(entries + i * LEAF_ENTRY_BYTES + KEY_BYTES));
+        }
+        if (page != 0) page = getUInt32(node + 8);
+    }
+
+    // Equal keys are stored by offset already; truncated keys can interleave
+    sort(offsets.begin() + firstFound, offsets.end());
+    return true;
+}
+
+void RecordIndex::discard() {
+    close();
+    remove(indexFile.c_str());
+}
@@ -0,0 +1,147 @@
+#ifndef RECORD_INDEX_H
+#define RECORD_INDEX_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+/// <summary>
+/// Which key of a record an index lookup is for
+/// </summary>
+enum class IndexKey : uint8_t {
+    APPLICATION_ID = 0,
+    CNIC = 1
+};
+
+/// <summary>
+/// One record's keys and where its line starts in the data file
+/// </summary>
+struct IndexedRecord {
+    string applicationId;
+    string cnic;
+    uint64_t offset;
+};
+
+/// <summary>
+/// Persistent B+tree index beside a data file (applications.txt -> applications.txt.idx)
+/// The file is a sequence of 4 KB pages: a header page, then one bulk-loaded
+/// B+tree per key (application ID and CNIC) whose leaves map a key to the
+/// byte offset of its record line. The file is memory mapped, so a lookup in
+/// a cold process touches only the pages on one root-to-leaf path (three
+/// pages for a million records) instead of reading applications.txt.
+/// A Bloom filter over both keys is stored after the trees, so a lookup for
+/// a key that is not in the file usually ends after one probe of the mapped
+/// filter, without descending a tree or reading the data file.
+/// The index describes the data file up to a recorded size. Records appended
+/// after that are found by scanning the uncovered tail, and the header keeps
+/// checksums of the first and last covered pages so a rewritten data file is
+/// noticed and the index rebuilt.
+/// Keys longer than KEY_BYTES are truncated, so callers check the record at
+/// each offset (as they must anyway in case the file changed underneath).
+/// SE Principles:
+/// - Single Responsibility: maps keys to offsets; reading and parsing records stays in FileManager
+/// - Information Hiding: page layout and memory mapping are private to record_index.cpp
+/// </summary>
+class RecordIndex {
+public:
+    static const size_t PAGE_BYTES = 4096;
+    static const size_t KEY_BYTES = 24;
+
+private:
+    string dataFile;
+    string indexFile;
+
+    const char* pages;          // Mapped index file, nullptr when closed
+    size_t mappedBytes;
+#ifdef _WIN32
+    vector<char> loadedPages;   // A mapped file cannot be replaced on Windows, so it is read instead
+#endif
+
+    uint64_t coveredBytes;      // Data file bytes the trees describe
+    uint32_t firstWindowCrc;    // CRC-32 of the first covered page of the data file
+    uint32_t lastWindowCrc;     // CRC-32 of the last covered page
+    long long highestId;        // Largest numeric application ID in the covered bytes
+    uint32_t pageCount;
+    uint32_t roots[2];          // Root page per IndexKey
+    uint32_t heights[2];        // Levels per tree (1 = the root is a leaf)
+    uint64_t counts[2];
+    uint32_t filterPage;        // First page of the serialized BloomFilter
+    uint32_t filterBytes;
+
+    // Data file as last seen by matchesDataFile; while it is unchanged the
+    // covered pages are not read again
+    mutable bool dataChecked;
+    mutable uint64_t checkedSize;
+    mutable long long checkedModified;
+    mutable uint64_t checkedInode;
+
+    /// <summary>
+    /// Checksums the first and last PAGE_BYTES of the data file's first covered bytes
+    /// </summary>
+    bool checksumDataWindows(uint64_t covered, uint32_t& first, uint32_t& last) const;
+
+    /// <summary>
+    /// Reads the header fields from the mapped header page
+    /// </summary>
+    bool readHeader();
+
+public:
+    /// <summary>
+    /// Names the index file for a data file (nothing is opened)
+    /// </summary>
+    explicit RecordIndex(const string& indexedFile);
+    ~RecordIndex();
+
+    RecordIndex(const RecordIndex&) = delete;
+    RecordIndex& operator=(const RecordIndex&) = delete;
+
+    /// <summary>
+    /// Maps the index file if it exists, is intact and still describes the data file
+    /// </summary>
+    /// <returns>False if there is no usable index (build one with build())</returns>
+    bool open();
+
+    void close();
+    bool isOpen() const;
+
+    /// <summary>
+    /// True if the data file still starts with the bytes the open index describes
+    /// (it may have grown since; it must not have been rewritten)
+    /// </summary>
+    bool matchesDataFile() const;
+
+    /// <summary>
+    /// Writes a new index file for the first covered bytes of the data file and opens it
+    /// </summary>
+    /// <param name="records">Every record in those bytes</param>
+    /// <param name="covered">Bytes of the data file the records were read from</param>
+    /// <param name="highest">Largest numeric application ID among them</param>
+    /// <param name="falsePositiveRate">Target rate for the Bloom filter over both keys</param>
+    /// <returns>False if the index file could not be written</returns>
+    bool build(const vector<IndexedRecord>& records, uint64_t covered, long long highest, double falsePositiveRate);
+
+    /// <summary>
+    /// False if no record in the covered bytes has this key (the Bloom filter
+    /// rules it out); true means a lookup may find it
+    /// </summary>
+    bool mightContain(IndexKey key, const string& value) const;
+
+    /// <summary>
+    /// Offsets of the record lines stored under a key, in file order
+    /// </summary>
+    /// <returns>False if the index file is damaged</returns>
+    bool lookup(IndexKey key, const string& value, vector<uint64_t>& offsets) const;
+
+    uint64_t getCoveredBytes() const;
+    long long getHighestId() const;
+    uint64_t getRecordCount() const;
+
+    /// <summary>
+    /// Closes and deletes the index file (after the data file was rewritten)
+    /// </summary>
+    void discard();
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include "record_query.h"
+#include "utilities.h"
+#include <algorithm>
+#include <cctype>
+
+using namespace std;
+
+namespace {
+    /// <summary>
+    /// Stored text of one field of an application in memory
+    /// </summary>
+    string fieldText(const LoanApplication& app, RecordField field) {
+        switch (field) {
+        case RecordField::APPLICATION_ID: return app.getApplicationId();
+        case RecordField::STATUS: return app.getStatus();
+        case RecordField::SUBMISSION_DATE: return app.getSubmissionDate();
+        case RecordField::COMPLETED_SECTIONS: return app.getCompletedSections();
+        case RecordField::FULL_NAME: return app.getFullName();
+        case RecordField::FATHERS_NAME: return app.getFathersName();
+        case RecordField::POSTAL_ADDRESS: return app.getPostalAddress();
+        case RecordField::CONTACT_NUMBER: return app.getContactNumber();
+        case RecordField::EMAIL_ADDRESS: return app.getEmailAddress();
+        case RecordField::CNIC_NUMBER: return app.getCnicNumber();
+        case RecordField::CNIC_EXPIRY_DATE: return app.getCnicExpiryDate();
+        case RecordField::EMPLOYMENT_STATUS: return app.getEmploymentStatus();
+        case RecordField::MARITAL_STATUS: return app.getMaritalStatus();
+        case RecordField::GENDER: return app.getGender();
+        case RecordField::NUMBER_OF_DEPENDENTS: return to_string(app.getNumberOfDependents());
+        case RecordField::ANNUAL_INCOME: return to_string(app.getAnnualIncome());
+        case RecordField::AVG_ELECTRICITY_BILL: return to_string(app.getAvgElectricityBill());
+        case RecordField::CURRENT_ELECTRICITY_BILL: return to_string(app.getCurrentElectricityBill());
+        case RecordField::LOAN_TYPE: return app.getLoanType();
+        case RecordField::LOAN_CATEGORY: return app.getLoanCategory();
+        case RecordField::LOAN_AMOUNT: return to_string(app.getLoanAmount());
+        case RecordField::DOWN_PAYMENT: return to_string(app.getDownPayment());
+        case RecordField::INSTALLMENT_MONTHS: return to_string(app.getInstallmentMonths());
+        case RecordField::MONTHLY_PAYMENT: return to_string(app.getMonthlyPayment());
+        case RecordField::INSTALLMENT_START_MONTH: return to_string(app.getInstallmentStartMonth());
+        case RecordField::INSTALLMENT_START_YEAR: return to_string(app.getInstallmentStartYear());
+        case RecordField::REJECTION_REASON: return app.getRejectionReason();
+        case RecordField::EXISTING_LOAN_COUNT: return to_string(app.getExistingLoans().size());
+        default: return string();
+        }
+    }
+}
+
+void RecordView::load(const string& line, const RecordSchema& schema, const vector<RecordField>& fields) {
+    // Fields are in position order in every layout, so one pass over the
+    // delimiters reaches them all
+    size_t start = 0;
+    int index = 0;
+    for (RecordField field : fields) {
+        string& value = values[static_cast<int>(field)];
+        value.clear();
+
+        int position = schema.position(field);
+        while (index < position && start != string::npos) {
+            start = line.find(Config::DELIMITER, start);
+            if (start != string::npos) start++;
+            index++;
+        }
+        if (position < 0 || start == string::npos) continue;
+
+        size_t end = line.find(Config::DELIMITER, start);
+        size_t first = start;
+        size_t last = end == string::npos ? line.size() : end;
+        while (first < last && isspace(static_cast<unsigned char>(line[first]))) first++;
+        while (last > first && isspace(static_cast<unsigned char>(line[last - 1]))) last--;
+        value.assign(line, first, last - first);
+    }
+}
+
+void RecordView::load(const LoanApplication& application, const vector<RecordField>& fields) {
+    for (RecordField field : fields) {
+        values[static_cast<int>(field)] = fieldText(application, field);
+    }
+}
+
+RecordQuery::RecordQuery(vector<RecordField> projection, function<bool(const RecordView&)> where,
+    QueryScope queryScope)
+    : fields(move(projection)), predicate(move(where)), scope(queryScope) {
+    // The status is always read: it decides the pending scope, and a record
+    // whose status is unknown is skipped like every other loader skips it
+    fields.push_back(RecordField::APPLICATION_ID);
+    fields.push_back(RecordField::STATUS);
+    sort(fields.begin(), fields.end());
+    fields.erase(unique(fields.begin(), fields.end()), fields.end());
+}
+
+bool RecordQuery::needsWholeRecord() const {
+    return !fields.empty() && fields.back() >= RecordField::EXISTING_LOAN_COUNT;
+}
+
+bool RecordQuery::matches(const RecordView& view) const {
+    if (scope == QueryScope::PENDING_APPLICATIONS) {
+        ApplicationStatus status = ApplicationStatus::SUBMITTED;
+        if (tryParseStatus(view.get(RecordField::STATUS), status) && isDecidedStatus(status)) return false;
+    }
+    return !predicate || predicate(view);
+}
+
+bool RecordQuery::matches(const LoanApplication& application, RecordView& view) const {
+    if (scope == QueryScope::PENDING_APPLICATIONS && isDecidedStatus(application.getStatusCode())) return false;
+
+    view.load(application, fields);
+    return !predicate || predicate(view);
+}
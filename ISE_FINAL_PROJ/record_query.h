@@ -0,0 +1,93 @@
+#ifndef RECORD_QUERY_H
+#define RECORD_QUERY_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include "record_schema.h"
+#include "application.h"
+
+using namespace std;
+
+/// <summary>
+/// Which applications a query reads
+/// </summary>
+enum class QueryScope {
+    ALL_APPLICATIONS,       // The archive and applications.txt
+    PENDING_APPLICATIONS    // Undecided applications (applications.txt only)
+};
+
+/// <summary>
+/// The projected fields of one record, as stored text
+/// Loading a record line copies only those fields and stops at the last of
+/// them; the rest of the line is never split.
+/// </summary>
+class RecordView {
+private:
+    string values[static_cast<int>(RecordField::FIELD_COUNT)];
+
+public:
+    /// <summary>
+    /// Text of a field ("" if it is empty or was not projected)
+    /// </summary>
+    const string& get(RecordField field) const { return values[static_cast<int>(field)]; }
+
+    /// <summary>
+    /// Moves a field's text out (used to build the application from the view)
+    /// </summary>
+    string take(RecordField field) { return move(values[static_cast<int>(field)]); }
+
+    /// <summary>
+    /// Reads the fields (in RecordField order) from a record line laid out as the schema says
+    /// </summary>
+    void load(const string& line, const RecordSchema& schema, const vector<RecordField>& fields);
+
+    /// <summary>
+    /// Reads the fields from an application already in memory
+    /// </summary>
+    void load(const LoanApplication& application, const vector<RecordField>& fields);
+};
+
+/// <summary>
+/// A projection and a predicate over stored applications (FileManager::queryApplications)
+/// The predicate sees only the projected fields and runs before an
+/// application is built; matching applications have only those fields set.
+/// Projecting EXISTING_LOAN_COUNT brings in the loans, references and
+/// documents that follow it, which means decoding the whole record.
+/// SE Principles:
+/// - Single Responsibility: describes what to read; FileManager does the reading
+/// - Interface Segregation: list and statistics views ask for the few fields they print
+/// </summary>
+class RecordQuery {
+private:
+    vector<RecordField> fields;     // Sorted, unique, always with the application ID and status
+    function<bool(const RecordView&)> predicate;
+    QueryScope scope;
+
+public:
+    /// <param name="projection">Fields the caller uses (the application ID and status are always read)</param>
+    /// <param name="where">Keeps a record if true; null keeps every record</param>
+    RecordQuery(vector<RecordField> projection, function<bool(const RecordView&)> where = nullptr,
+        QueryScope queryScope = QueryScope::ALL_APPLICATIONS);
+
+    const vector<RecordField>& getFields() const { return fields; }
+    QueryScope getScope() const { return scope; }
+
+    /// <summary>
+    /// True if the projection needs the whole record decoded
+    /// </summary>
+    bool needsWholeRecord() const;
+
+    /// <summary>
+    /// True if a loaded view is in scope and satisfies the predicate
+    /// </summary>
+    bool matches(const RecordView& view) const;
+
+    /// <summary>
+    /// The same test for an application already in memory
+    /// </summary>
+    /// <param name="view">Scratch view, reused between calls; holds the projected fields if this returns true</param>
+    bool matches(const LoanApplication& application, RecordView& view) const;
+};
+
+#endif
@@ -0,0 +1,61 @@
+#include "record_schema.h"
+#include "utilities.h"
+
+using namespace std;
+
+namespace {
+    const string HEADER_TAG = "format";
+
+    /// <summary>
+    /// True if a field holds a completed sections list ("" or "personal,financial,...")
+    /// </summary>
+    bool isSectionList(const string& field) {
+        if (field.empty()) return true;
+        for (const auto& section : splitString(field, ',')) {
+            if (section != "personal" && section != "financial" &&
+                section != "references" && section != "documents") {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+const int RecordSchema::CURRENT_VERSION;
+
+RecordSchema::RecordSchema(int formatVersion, bool hasCompletedSections) : version(formatVersion) {
+    // Fields after the completed sections move up one place when it is missing
+    int completed = static_cast<int>(RecordField::COMPLETED_SECTIONS);
+    for (int field = 0; field < static_cast<int>(RecordField::FIELD_COUNT); field++) {
+        if (field < completed || hasCompletedSections) positions[field] = field;
+        else positions[field] = field == completed ? -1 : field - 1;
+    }
+}
+
+const RecordSchema& RecordSchema::current() {
+    static const RecordSchema schema(CURRENT_VERSION, true);
+    return schema;
+}
+
+const RecordSchema& RecordSchema::legacy() {
+    static const RecordSchema schema(1, false);
+    return schema;
+}
+
+const RecordSchema& RecordSchema::detect(const vector<string>& parts) {
+    int completed = current().position(RecordField::COMPLETED_SECTIONS);
+    if (parts.size() >= 17 && !isSectionList(parts[completed])) return legacy();
+    return current();
+}
+
+string RecordSchema::headerLine() {
+    return string(1, Config::DELIMITER) + HEADER_TAG + Config::DELIMITER + to_string(CURRENT_VERSION);
+}
+
+bool RecordSchema::parseHeaderLine(const string& line, int& version) {
+    if (line.size() < HEADER_TAG.size() + 3 || line[0] != Config::DELIMITER ||
+        line.compare(1, HEADER_TAG.size(), HEADER_TAG) != 0 || line[HEADER_TAG.size() + 1] != Config::DELIMITER) {
+        return false;
+    }
+    return tryParseNumber(trim(line.substr(HEADER_TAG.size() + 2)), version);
+}
@@ -0,0 +1,94 @@
+#ifndef RECORD_SCHEMA_H
+#define RECORD_SCHEMA_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/// <summary>
+/// Fixed fields of an application record, in the order the current format stores them
+/// Every format follows the loan count with the existing loans (6 fields each),
+/// the two references (5 fields each) and the four document paths.
+/// </summary>
+enum class RecordField {
+    APPLICATION_ID,
+    STATUS,
+    SUBMISSION_DATE,
+    COMPLETED_SECTIONS,
+    FULL_NAME,
+    FATHERS_NAME,
+    POSTAL_ADDRESS,
+    CONTACT_NUMBER,
+    EMAIL_ADDRESS,
+    CNIC_NUMBER,
+    CNIC_EXPIRY_DATE,
+    EMPLOYMENT_STATUS,
+    MARITAL_STATUS,
+    GENDER,
+    NUMBER_OF_DEPENDENTS,
+    ANNUAL_INCOME,
+    AVG_ELECTRICITY_BILL,
+    CURRENT_ELECTRICITY_BILL,
+    LOAN_TYPE,
+    LOAN_CATEGORY,
+    LOAN_AMOUNT,
+    DOWN_PAYMENT,
+    INSTALLMENT_MONTHS,
+    MONTHLY_PAYMENT,
+    INSTALLMENT_START_MONTH,
+    INSTALLMENT_START_YEAR,
+    REJECTION_REASON,
+    EXISTING_LOAN_COUNT,
+    FIELD_COUNT
+};
+
+/// <summary>
+/// Field layout of one version of the applications.txt record format
+/// Version 1 records (written before the completed sections field existed)
+/// have no header; a version 2 file starts with a header line naming its
+/// version, so readers pick the layout once per file instead of guessing it
+/// per record. FileManager::migrateRecordFormat rewrites version 1 files.
+/// SE Principles:
+/// - Single Responsibility: where each field is stored; decoding stays in FileManager
+/// - Open/Closed: a new format is a new layout table, not a new parser
+/// </summary>
+class RecordSchema {
+private:
+    int version;
+    int positions[static_cast<int>(RecordField::FIELD_COUNT)];  // -1 if the version lacks the field
+
+    RecordSchema(int formatVersion, bool hasCompletedSections);
+
+public:
+    static const int CURRENT_VERSION = 2;
+
+    static const RecordSchema& current();
+    static const RecordSchema& legacy();
+
+    /// <summary>
+    /// Layout of a record from a file that was not migrated yet
+    /// Version 1 files can hold both layouts, so this looks at the record itself.
+    /// </summary>
+    static const RecordSchema& detect(const vector<string>& parts);
+
+    /// <summary>
+    /// First line of a file in the current format
+    /// </summary>
+    static string headerLine();
+
+    /// <summary>
+    /// True if a line is a format header (records never start with the delimiter)
+    /// </summary>
+    /// <param name="version">Output: the version it names</param>
+    static bool parseHeaderLine(const string& line, int& version);
+
+    int getVersion() const { return version; }
+
+    /// <summary>
+    /// Index of a field in the split record, or -1 if this version has no such field
+    /// </summary>
+    int position(RecordField field) const { return positions[static_cast<int>(field)]; }
+};
+
+#endif
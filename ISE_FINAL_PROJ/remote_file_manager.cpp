@@ -0,0 +1,402 @@
+#include "remote_file_manager.h"
+#include "application_server.h"
+#include "event_loop.h"
+#include <iostream>
+#include <fstream>
+#include <chrono>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+RemoteFileManager::RemoteFileManager() : connection(INVALID_SOCKET_HANDLE) {
+}
+
+RemoteFileManager::~RemoteFileManager() {
+    Network::closeSocket(connection);
+}
+
+bool RemoteFileManager::connect(const string& address) {
+    lock_guard<mutex> lock(connectionMutex);
+    Network::closeSocket(connection);
+    connection = Network::connectTo(address);
+    return connection != INVALID_SOCKET_HANDLE;
+}
+
+bool RemoteFileManager::isConnected() const {
+    lock_guard<mutex> lock(connectionMutex);
+    return connection != INVALID_SOCKET_HANDLE;
+}
+
+bool RemoteFileManager::call(MessageType type, const string& request, string& response) const {
+    lock_guard<mutex> lock(connectionMutex);
+    if (connection == INVALID_SOCKET_HANDLE) {
+        cerr << "Error: Not connected to the lender server" << endl;
+        return false;
+    }
+
+    MessageType responseType;
+    if (!Network::sendFrame(connection, type, request, Config::SERVER_MAX_REQUEST_BYTES) ||
+        !receiveResponse(responseType, response)) {
+        cerr << "Error: Lost connection to the lender server" << endl;
+        return false;
+    }
+
+    if (responseType != MessageType::RESPONSE_OK) {
+        MessageReader reader(response);
+        string message;
+        reader.readString(message);
+        cerr << "Error: Lender server rejected the request: " << message << endl;
+        return false;
+    }
+    return true;
+}
+
+bool RemoteFileManager::receiveResponse(MessageType& type, string& payload) const {
+    while (Network::receiveFrame(connection, type, payload, Config::SERVER_MAX_RESPONSE_BYTES)) {
+        if (type != MessageType::STATUS_EVENT) return true;
+        queueStatusEvent(payload);
+    }
+    return false;
+}
+
+void RemoteFileManager::queueStatusEvent(const string& payload) const {
+    MessageReader reader(payload);
+    ServerProtocol::StatusEvent event;
+    if (ServerProtocol::readStatusEvent(reader, event)) {
+        pendingEvents.push_back(move(event));
+    }
+}
+
+bool RemoteFileManager::subscribe(SubscriptionKind kind, const string& key) {
+    MessageWriter request;
+    request.writeUInt8(static_cast<uint8_t>(kind));
+    request.writeString(key);
+
+    string response;
+    return call(MessageType::SUBSCRIBE, request.data(), response);
+}
+
+bool RemoteFileManager::unsubscribe(SubscriptionKind kind, const string& key) {
+    MessageWriter request;
+    request.writeUInt8(static_cast<uint8_t>(kind));
+    request.writeString(key);
+
+    string response;
+    return call(MessageType::UNSUBSCRIBE, request.data(), response);
+}
+
+RemoteFileManager::WaitResult RemoteFileManager::waitForStatusEvent(ServerProtocol::StatusEvent& event,
+    int timeoutMs, bool watchConsole) {
+    SocketHandle socket;
+    {
+        lock_guard<mutex> lock(connectionMutex);
+        if (!pendingEvents.empty()) {
+            event = move(pendingEvents.front());
+            pendingEvents.pop_front();
+            return WaitResult::STATUS_CHANGED;
+        }
+        if (connection == INVALID_SOCKET_HANDLE) return WaitResult::DISCONNECTED;
+        socket = connection;
+    }
+
+    EventLoop loop;
+    if (!loop.add(socket, EventLoop::WATCH_READ)) return WaitResult::DISCONNECTED;
+
+#ifndef _WIN32
+    if (watchConsole) {
+        // Typed-ahead input already buffered by cin, or stdin that cannot be
+        // watched (a redirected file), means there is input to handle now
+        if (cin.rdbuf()->in_avail() > 0 || !loop.add(STDIN_FILENO, EventLoop::WATCH_READ)) {
+            return WaitResult::CONSOLE_INPUT;
+        }
+    }
+#endif
+
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(timeoutMs);
+    vector<EventLoop::Event> ready;
+    while (true) {
+        int waitMs = -1;
+        if (timeoutMs >= 0) {
+            auto remaining = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now());
+            if (remaining.count() <= 0) return WaitResult::TIMED_OUT;
+            waitMs = static_cast<int>(remaining.count());
+        }
+        if (!loop.wait(ready, waitMs)) return WaitResult::DISCONNECTED;
+
+        for (const auto& item : ready) {
+            if (item.handle != socket) return WaitResult::CONSOLE_INPUT;
+        }
+        if (ready.empty()) continue;
+
+        lock_guard<mutex> lock(connectionMutex);
+        MessageType type;
+        string payload;
+        if (!Network::receiveFrame(connection, type, payload, Config::SERVER_MAX_RESPONSE_BYTES)) {
+            cerr << "Error: Lost connection to the lender server" << endl;
+            Network::closeSocket(connection);
+            connection = INVALID_SOCKET_HANDLE;
+            return WaitResult::DISCONNECTED;
+        }
+        if (type == MessageType::STATUS_EVENT) {
+            queueStatusEvent(payload);
+        }
+        if (!pendingEvents.empty()) {
+            event = move(pendingEvents.front());
+            pendingEvents.pop_front();
+            return WaitResult::STATUS_CHANGED;
+        }
+    }
+}
+
+bool RemoteFileManager::canWatchConsole() {
+#ifdef _WIN32
+    return false;
+#else
+    return true;
+#endif
+}
+
+string RemoteFileManager::generateApplicationId() const {
+    string response;
+    string applicationId;
+    if (call(MessageType::GENERATE_ID, "", response)) {
+        MessageReader reader(response);
+        reader.readString(applicationId);
+    }
+    return applicationId;
+}
+
+void RemoteFileManager::uploadDocuments(LoanApplication& application) const {
+    struct Document {
+        const char* documentType;
+        const string& (LoanApplication::*getPath)() const;
+        void (LoanApplication::*setPath)(string);
+    };
+    static const Document documents[] = {
+        { "cnic_front", &LoanApplication::getCnicFrontImagePath, &LoanApplication::setCnicFrontImagePath },
+        { "cnic_back", &LoanApplication::getCnicBackImagePath, &LoanApplication::setCnicBackImagePath },
+        { "electricity_bill", &LoanApplication::getElectricityBillImagePath, &LoanApplication::setElectricityBillImagePath },
+        { "salary_slip", &LoanApplication::getSalarySlipImagePath, &LoanApplication::setSalarySlipImagePath }
+    };
+
+    for (const auto& document : documents) {
+        string sourcePath = (application.*document.getPath)();
+        if (!needsDocumentCopy(sourcePath)) continue;
+
+        // Read with the user's own rights
+        string content;
+        ifstream source(sourcePath, ios::binary | ios::ate);
+        streamoff size = source.is_open() ? static_cast<streamoff>(source.tellg()) : -1;
+        if (size <= 0 || size > static_cast<streamoff>(Config::DOCUMENT_UPLOAD_MAX_BYTES)) {
+            cerr << "ERROR: " << (size > 0 ? "File is too large to upload: " : "Cannot read file: ")
+                << sourcePath << endl;
+            (application.*document.setPath)(Config::DOCUMENT_COPY_FAILED_PREFIX + sourcePath);
+            continue;
+        }
+        content.resize(static_cast<size_t>(size));
+        source.seekg(0, ios::beg);
+        if (!source.read(&content[0], size)) {
+            cerr << "ERROR: Cannot read file: " << sourcePath << endl;
+            (application.*document.setPath)(Config::DOCUMENT_COPY_FAILED_PREFIX + sourcePath);
+            continue;
+        }
+
+        MessageWriter request;
+        request.writeString(application.getApplicationId());
+        request.writeString(document.documentType);
+        request.writeString(content);
+
+        string response;
+        string storedPath;
+        if (call(MessageType::UPLOAD_DOCUMENT, request.data(), response) &&
+            MessageReader(response).readString(storedPath)) {
+            cout << " Document stored: " << storedPath << endl;
+            (application.*document.setPath)(storedPath);
+        }
+        else {
+            (application.*document.setPath)(Config::DOCUMENT_COPY_FAILED_PREFIX + sourcePath);
+        }
+    }
+}
+
+bool RemoteFileManager::saveApplication(LoanApplication& application) {
+    LoanApplication uploaded = application;
+    if (needsDocumentCopy(uploaded.getCnicFrontImagePath()) || needsDocumentCopy(uploaded.getCnicBackImagePath()) ||
+        needsDocumentCopy(uploaded.getElectricityBillImagePath()) || needsDocumentCopy(uploaded.getSalarySlipImagePath())) {
+        // Uploads belong to an application, so one without an ID gets it now
+        if (uploaded.getApplicationId().empty()) {
+            uploaded.setApplicationId(generateApplicationId());
+            if (uploaded.getApplicationId().empty()) return false;
+        }
+        uploadDocuments(uploaded);
+    }
+
+    MessageWriter request;
+    ServerProtocol::writeApplication(request, *this, uploaded);
+
+    string response;
+    if (!call(MessageType::SAVE_APPLICATION, request.data(), response)) return false;
+
+    // The server assigns the ID, status, date and stored document paths
+    MessageReader reader(response);
+    uint8_t saved = 0;
+    LoanApplication stored;
+    if (!reader.readUInt8(saved) || !ServerProtocol::readApplication(reader, *this, stored)) return false;
+    if (saved != 0) {
+        application = move(stored);
+    }
+    return saved != 0;
+}
+
+bool RemoteFileManager::updateApplicationSection(const LoanApplication& application, const string& section) {
+    LoanApplication uploaded = application;
+    uploadDocuments(uploaded);
+
+    MessageWriter request;
+    ServerProtocol::writeApplication(request, *this, uploaded);
+    request.writeString(section);
+
+    string response;
+    if (!call(MessageType::UPDATE_SECTION, request.data(), response)) return false;
+
+    MessageReader reader(response);
+    uint8_t updated = 0;
+    if (!reader.readUInt8(updated) || updated == 0) return false;
+
+    if (!section.empty()) {
+        cout << "Progress saved at checkpoint: " << section << endl;
+    }
+    return true;
+}
+
+bool RemoteFileManager::updateApplicationStatus(const string& applicationId,
+    const string& newStatus, const string& rejectionReason) {
+    MessageWriter request;
+    request.writeString(applicationId);
+    request.writeString(newStatus);
+    request.writeString(rejectionReason);
+
+    string response;
+    if (!call(MessageType::UPDATE_STATUS, request.data(), response)) return false;
+
+    MessageReader reader(response);
+    uint8_t updated = 0;
+    return reader.readUInt8(updated) && updated != 0;
+}
+
+vector<LoanApplication> RemoteFileManager::loadAllApplications() const {
+    vector<LoanApplication> applications;
+    string response;
+    if (call(MessageType::LOAD_ALL, "", response)) {
+        MessageReader reader(response);
+        ServerProtocol::readApplicationList(reader, *this, applications);
+    }
+    return applications;
+}
+
+vector<LoanApplication> RemoteFileManager::loadPendingApplications() const {
+    vector<LoanApplication> pending;
+    for (auto& app : loadAllApplications()) {
+        if (!isDecidedStatus(app.getStatusCode())) {
+            pending.push_back(move(app));
+        }
+    }
+    return pending;
+}
+
+vector<LoanApplication> RemoteFileManager::queryApplications(const RecordQuery& query) const {
+    // The server sends whole applications; the query is applied to them here
+    vector<LoanApplication> results;
+    RecordView fields;
+    for (auto& app : loadAllApplications()) {
+        if (query.matches(app, fields)) {
+            results.push_back(move(app));
+        }
+    }
+    return results;
+}
+
+void RemoteFileManager::forEachRecord(const RecordQuery& query,
+    const function<void(const RecordView&)>& onRecord) const {
+    RecordView fields;
+    for (const auto& app : loadAllApplications()) {
+        if (query.matches(app, fields)) {
+            onRecord(fields);
+        }
+    }
+}
+
+vector<LoanApplication> RemoteFileManager::loadApplicationsSubmittedBetween(const string& fromDate,
+    const string& toDate) const {
+    // The server's partitions are not visible here; filter its full list
+    vector<LoanApplication> results;
+    string from, to;
+    if (!ApplicationPartitions::sortableDate(fromDate, from) || !ApplicationPartitions::sortableDate(toDate, to)) {
+        return results;
+    }
+
+    for (auto& app : loadAllApplications()) {
+        string submitted;
+        if (ApplicationPartitions::sortableDate(app.getSubmissionDate(), submitted) &&
+            submitted >= from && submitted <= to) {
+            results.push_back(move(app));
+        }
+    }
+    return results;
+}
+
+LoanApplication RemoteFileManager::findApplicationById(const string& applicationId) const {
+    MessageWriter request;
+    request.writeString(applicationId);
+
+    LoanApplication application;
+    string response;
+    if (call(MessageType::FIND_BY_ID, request.data(), response)) {
+        MessageReader reader(response);
+        ServerProtocol::readApplication(reader, *this, application);
+    }
+    return application;
+}
+
+vector<LoanApplication> RemoteFileManager::findApplicationsByCNIC(const string& cnic) const {
+    MessageWriter request;
+    request.writeString(cnic);
+
+    vector<LoanApplication> applications;
+    string response;
+    if (call(MessageType::FIND_BY_CNIC, request.data(), response)) {
+        MessageReader reader(response);
+        ServerProtocol::readApplicationList(reader, *this, applications);
+    }
+    return applications;
+}
+
+LoanApplication RemoteFileManager::findIncompleteApplication(const string& applicationId, const string& cnic) const {
+    MessageWriter request;
+    request.writeString(applicationId);
+    request.writeString(cnic);
+
+    LoanApplication application;
+    string response;
+    if (call(MessageType::FIND_INCOMPLETE, request.data(), response)) {
+        MessageReader reader(response);
+        ServerProtocol::readApplication(reader, *this, application);
+    }
+    return application;
+}
+
+vector<LoanApplication> RemoteFileManager::findUserIncompleteApplications(const string& cnic) const {
+    MessageWriter request;
+    request.writeString(cnic);
+
+    vector<LoanApplication> applications;
+    string response;
+    if (call(MessageType::FIND_USER_INCOMPLETE, request.data(), response)) {
+        MessageReader reader(response);
+        ServerProtocol::readApplicationList(reader, *this, applications);
+    }
+    return applications;
+}
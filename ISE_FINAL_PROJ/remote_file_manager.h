@@ -0,0 +1,125 @@
+#ifndef REMOTE_FILE_MANAGER_H
+#define REMOTE_FILE_MANAGER_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <deque>
+#include "file_manager.h"
+#include "network_utils.h"
+#include "application_server.h"
+#include "utilities.h"
+
+using namespace std;
+
+/// <summary>
+/// FileManager that forwards every store operation to a running lender_server
+/// Used by user_client when the server is up; each call is one request/response
+/// round trip over the server socket. On the user socket the server refuses
+/// status changes and whole-store loads (and so the queries built on them);
+/// connect to Network::lenderAddressFor(address) for those.
+/// It can also subscribe to status changes: the server then pushes them on
+/// the same socket and waitForStatusEvent blocks until one arrives, so a user
+/// waiting for a decision costs the store nothing.
+/// SE Principles:
+/// - Proxy Pattern: same interface as FileManager, storage lives in another process
+/// - Liskov Substitution: the collectors and menus take it as a plain FileManager
+/// </summary>
+class RemoteFileManager : public FileManager {
+public:
+    enum class WaitResult {
+        STATUS_CHANGED,
+        CONSOLE_INPUT,      // The user typed something (only where canWatchConsole)
+        TIMED_OUT,
+        DISCONNECTED
+    };
+
+private:
+    SocketHandle connection;
+    mutable mutex connectionMutex;      // One request in flight at a time
+    mutable deque<ServerProtocol::StatusEvent> pendingEvents;  // Pushed while waiting for a response
+
+    /// <summary>
+    /// Receives the next frame that is not a pushed event (caller holds connectionMutex)
+    /// </summary>
+    bool receiveResponse(MessageType& type, string& payload) const;
+
+    /// <summary>
+    /// Queues a pushed STATUS_EVENT payload (caller holds connectionMutex)
+    /// </summary>
+    void queueStatusEvent(const string& payload) const;
+
+    /// <summary>
+    /// Sends a request and waits for its response
+    /// </summary>
+    /// <param name="response">Output: response payload</param>
+    /// <returns>False if the server is gone or reported an error</returns>
+    bool call(MessageType type, const string& request, string& response) const;
+
+    /// <summary>
+    /// Sends the content of every document the application names as a local
+    /// file (the server never opens a user's path) and records the stored paths
+    /// </summary>
+    /// <param name="application">Application with an ID; failed uploads are marked as failed copies</param>
+    void uploadDocuments(LoanApplication& application) const;
+
+public:
+    RemoteFileManager();
+    ~RemoteFileManager();
+
+    RemoteFileManager(const RemoteFileManager&) = delete;
+    RemoteFileManager& operator=(const RemoteFileManager&) = delete;
+
+    /// <summary>
+    /// Connects to the lender server
+    /// </summary>
+    /// <param name="address">Socket path or "tcp:PORT"</param>
+    /// <returns>False if no server is listening</returns>
+    bool connect(const string& address = Config::SERVER_ADDRESS);
+
+    bool isConnected() const;
+
+    /// <summary>
+    /// Asks the server to push status changes of an application ID or of every
+    /// application under a CNIC
+    /// </summary>
+    bool subscribe(SubscriptionKind kind, const string& key);
+    bool unsubscribe(SubscriptionKind kind, const string& key);
+
+    /// <summary>
+    /// Waits for a pushed status change of a subscribed application
+    /// </summary>
+    /// <param name="event">Output: the change</param>
+    /// <param name="timeoutMs">-1 waits indefinitely</param>
+    /// <param name="watchConsole">Stop waiting when stdin has input (left unread);
+    /// ignored where canWatchConsole is false</param>
+    WaitResult waitForStatusEvent(ServerProtocol::StatusEvent& event, int timeoutMs, bool watchConsole);
+
+    /// <summary>
+    /// True if waitForStatusEvent can notice typed input: stdin can be polled
+    /// with the socket on POSIX, but a Windows console cannot, so callers there
+    /// should not offer to stop on a key press and should wait less
+    /// </summary>
+    static bool canWatchConsole();
+
+    string generateApplicationId() const override;
+    bool saveApplication(LoanApplication& application) override;
+    bool updateApplicationSection(const LoanApplication& application, const string& section) override;
+    bool updateApplicationStatus(const string& applicationId,
+        const string& newStatus,
+        const string& rejectionReason = "") override;
+
+    vector<LoanApplication> loadAllApplications() const override;
+    vector<LoanApplication> loadPendingApplications() const override;
+    vector<LoanApplication> queryApplications(const RecordQuery& query) const override;
+    void forEachRecord(const RecordQuery& query, const function<void(const RecordView&)>& onRecord) const override;
+    LoanApplication findApplicationById(const string& applicationId) const override;
+    vector<LoanApplication> findApplicationsByCNIC(const string& cnic) const override;
+    LoanApplication findIncompleteApplication(const string& applicationId,
+        const string& cnic) const override;
+    vector<LoanApplication> findUserIncompleteApplications(const string& cnic) const override;
+    vector<LoanApplication> loadApplicationsSubmittedBetween(const string& fromDate,
+        const string& toDate) const override;
+};
+
+#endif
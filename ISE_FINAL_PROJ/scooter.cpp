@@ -1,6 +1,8 @@
 #include "scooter.h"
 #include "utilities.h"
-#include <fstream>
+#include "text_scanner.h"
+#include "installment_schedule.h"
+#include "screen_buffer.h"
 #include <iostream>
 #include <stdexcept>
 #include <iomanip>
@@ -77,57 +79,40 @@ void ScooterLoan::displayInstallmentPlan() const {
     long long monthlyInstallment = calculateMonthlyInstallment();
     long long remainingBalance = getPrice() - getDownPayment();
 
-    cout << endl << "  SCOOTER LOAN INSTALLMENT PLAN" << endl;
-    cout << "========================================" << endl;
-    cout << "Scooter Details:" << endl;
-    cout << "  Make: " << getMake() << endl;
-    cout << "  Model: " << getModel() << endl;
-    cout << "  Range: " << getDistancePerCharge() << " KM per charge" << endl;
-    cout << "  Charging Time: " << getChargingTime() << " hours" << endl;
-    cout << "  Max Speed: " << getMaxSpeed() << " KM/H" << endl;
-    cout << "  Total Price: PKR " << getPrice() << endl;
-    cout << "  Down Payment: PKR " << getDownPayment() << endl;
-    cout << "  Loan Amount: PKR " << remainingBalance << endl;
-    cout << "  Installment Period: " << getInstallments() << " months" << endl;
-    cout << "  Monthly Installment: PKR " << monthlyInstallment << endl;
-    cout << "========================================" << endl << endl;
-
-    cout << "Monthly Payment Schedule:" << endl;
-    cout << "+-------+----------------+---------------+" << endl;
-    cout << "| Month |  Payment Due   | Remaining Bal |" << endl;
-    cout << "+-------+----------------+---------------+" << endl;
-
-    long long currentBalance = remainingBalance;
-
-    for (int month = 1; month <= getInstallments(); month++) {
-        long long paymentDue = monthlyInstallment;
-
-        if (month == getInstallments()) {
-            paymentDue = currentBalance;
-        }
-
-        cout << "| " << setw(5) << month << " | PKR " << setw(10) << paymentDue
-            << " | PKR " << setw(10) << (currentBalance - paymentDue) << " |" << endl;
-
-        currentBalance -= paymentDue;
-        if (currentBalance < 0) currentBalance = 0;
-    }
-
-    cout << "+-------+----------------+---------------+" << endl << endl;
+    screen << '\n' << "  SCOOTER LOAN INSTALLMENT PLAN" << '\n';
+    screen << "========================================" << '\n';
+    screen << "Scooter Details:" << '\n';
+    screen << "  Make: " << getMake() << '\n';
+    screen << "  Model: " << getModel() << '\n';
+    screen << "  Range: " << getDistancePerCharge() << " KM per charge" << '\n';
+    screen << "  Charging Time: " << getChargingTime() << " hours" << '\n';
+    screen << "  Max Speed: " << getMaxSpeed() << " KM/H" << '\n';
+    screen << "  Total Price: PKR " << getPrice() << '\n';
+    screen << "  Down Payment: PKR " << getDownPayment() << '\n';
+    screen << "  Loan Amount: PKR " << remainingBalance << '\n';
+    screen << "  Installment Period: " << getInstallments() << " months" << '\n';
+    screen << "  Monthly Installment: PKR " << monthlyInstallment << '\n';
+    screen << "========================================" << '\n' << '\n';
+
+    screen << "Monthly Payment Schedule:" << '\n';
+
+    InstallmentSchedule schedule(remainingBalance, getInstallments(), monthlyInstallment);
+    schedule.writeTable(screen);
+    screen << '\n';
 
     long long totalPayment = getDownPayment() + (monthlyInstallment * getInstallments());
     long long totalInstallments = monthlyInstallment * getInstallments();
 
-    cout << "Payment Summary:" << endl;
-    cout << "  Total Payment: PKR " << totalPayment << endl;
-    cout << "  Down Payment: PKR " << getDownPayment() << endl;
-    cout << "  Total Installments: PKR " << totalInstallments << endl;
+    screen << "Payment Summary:" << '\n';
+    screen << "  Total Payment: PKR " << totalPayment << '\n';
+    screen << "  Down Payment: PKR " << getDownPayment() << '\n';
+    screen << "  Total Installments: PKR " << totalInstallments << '\n';
 }
 
 int loadScooterLoans(ScooterLoan loans[], int maxSize, const string& filename) {
-    ifstream file(filename);
+    LineReader file(filename);
 
-    if (!file.is_open()) {
+    if (!file.isOpen()) {
         cerr << "Error: Could not open " << filename << endl;
         return 0;
     }
@@ -137,7 +122,7 @@ int loadScooterLoans(ScooterLoan loans[], int maxSize, const string& filename) {
     int lineNumber = 0;
     bool firstLine = true;
 
-    while (getline(file, line) && count < maxSize) {
+    while (count < maxSize && file.next(line)) {
         lineNumber++;
 
         if (firstLine) {
@@ -175,7 +160,6 @@ int loadScooterLoans(ScooterLoan loans[], int maxSize, const string& filename) {
         }
     }
 
-    file.close();
     return count;
 }
 
@@ -183,48 +167,48 @@ bool displayScooterLoanOptionsTable(const ScooterLoan loans[], int size, const s
     string makeName = "Make " + makeNumber;
     bool found = false;
 
-    cout << endl << "  Scooter Loan Options for " << makeName << endl;
-    cout << "+-----+-----------+------------------+---------------+-------------+---------------+---------------------+" << endl;
-    cout << "| Opt |   Model   | Range per Charge | Charging Time | Max Speed   | Total Price   | Down Payment        |" << endl;
-    cout << "+-----+-----------+------------------+---------------+-------------+---------------+---------------------+" << endl;
+    screen << '\n' << "  Scooter Loan Options for " << makeName << '\n';
+    screen << "+-----+-----------+------------------+---------------+-------------+---------------+---------------------+" << '\n';
+    screen << "| Opt |   Model   | Range per Charge | Charging Time | Max Speed   | Total Price   | Down Payment        |" << '\n';
+    screen << "+-----+-----------+------------------+---------------+-------------+---------------+---------------------+" << '\n';
 
     int optionCount = 0;
     for (int i = 0; i < size; i++) {
         if (loans[i].getMake() == makeName) {
             found = true;
             optionCount++;
-            cout << "| " << setw(3) << optionCount << " | "
+            screen << "| " << setw(3) << optionCount << " | "
                 << setw(9) << loans[i].getModel() << " | "
                 << setw(16) << loans[i].getDistancePerCharge() << " KM | "
                 << setw(13) << loans[i].getChargingTime() << " Hrs | "
                 << setw(11) << loans[i].getMaxSpeed() << " KM/H | "
                 << "PKR " << setw(8) << loans[i].getPrice() << " | "
-                << "PKR " << setw(15) << loans[i].getDownPayment() << " |" << endl;
+                << "PKR " << setw(15) << loans[i].getDownPayment() << " |" << '\n';
         }
     }
 
-    cout << "+-----+-----------+------------------+---------------+-------------+---------------+---------------------+" << endl;
+    screen << "+-----+-----------+------------------+---------------+-------------+---------------+---------------------+" << '\n';
 
     if (found) {
-        cout << endl << "Monthly Installments:" << endl;
-        cout << "+-----+---------------------+" << endl;
-        cout << "| Opt | Monthly Installment |" << endl;
-        cout << "+-----+---------------------+" << endl;
+        screen << '\n' << "Monthly Installments:" << '\n';
+        screen << "+-----+---------------------+" << '\n';
+        screen << "| Opt | Monthly Installment |" << '\n';
+        screen << "+-----+---------------------+" << '\n';
 
         optionCount = 0;
         for (int i = 0; i < size; i++) {
             if (loans[i].getMake() == makeName) {
                 optionCount++;
                 long long monthlyInstallment = loans[i].calculateMonthlyInstallment();
-                cout << "| " << setw(3) << optionCount << " | "
-                    << "PKR " << setw(15) << monthlyInstallment << " |" << endl;
+                screen << "| " << setw(3) << optionCount << " | "
+                    << "PKR " << setw(15) << monthlyInstallment << " |" << '\n';
             }
         }
-        cout << "+-----+---------------------+" << endl;
+        screen << "+-----+---------------------+" << '\n';
     }
 
     if (!found) {
-        cout << "No scooter options available for this make." << endl;
+        screen << "No scooter options available for this make." << '\n';
     }
 
     return found;
@@ -232,7 +216,7 @@ bool displayScooterLoanOptionsTable(const ScooterLoan loans[], int size, const s
 
 bool displayScooterInstallmentPlan(const ScooterLoan loans[], int size, int optionNumber) {
     if (optionNumber < 1 || optionNumber > size) {
-        cout << "Invalid option number. Please try again." << endl;
+        screen << "Invalid option number. Please try again." << '\n';
         return false;
     }
 
@@ -0,0 +1,168 @@
+#include "screen_buffer.h"
+#include "utilities.h"
+#include <cstdio>
+#include <cerrno>
+#include <iostream>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+ScreenBuffer screen;
+
+namespace {
+    int consoleFd() {
+#ifdef _WIN32
+        return _fileno(stdout);
+#else
+        return STDOUT_FILENO;
+#endif
+    }
+
+    void closeFd(int fd) {
+#ifdef _WIN32
+        _close(fd);
+#else
+        close(fd);
+#endif
+    }
+}
+
+// ScreenStreamBuf Implementation
+
+ScreenStreamBuf::ScreenStreamBuf() : targetFd(consoleFd()), ownsTarget(false) {
+    pending.reserve(Config::SCREEN_BUFFER_RESERVE);
+}
+
+ScreenStreamBuf::~ScreenStreamBuf() {
+    present();
+    if (ownsTarget) {
+        closeFd(targetFd);
+    }
+}
+
+ScreenStreamBuf::int_type ScreenStreamBuf::overflow(int_type ch) {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+        return traits_type::not_eof(ch);
+    }
+
+    pending += traits_type::to_char_type(ch);
+    if (pending.size() >= Config::SCREEN_BUFFER_LIMIT) {
+        present();
+    }
+    return ch;
+}
+
+streamsize ScreenStreamBuf::xsputn(const char* data, streamsize count) {
+    pending.append(data, static_cast<size_t>(count));
+    if (pending.size() >= Config::SCREEN_BUFFER_LIMIT) {
+        present();
+    }
+    return count;
+}
+
+int ScreenStreamBuf::sync() {
+    return present() ? 0 : -1;
+}
+
+bool ScreenStreamBuf::writeAll(const char* data, size_t size) {
+    while (size > 0) {
+#ifdef _WIN32
+        int written = _write(targetFd, data, static_cast<unsigned int>(size));
+#else
+        ssize_t written = write(targetFd, data, size);
+#endif
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool ScreenStreamBuf::present() {
+    // Anything already queued on cout/stdout was produced before this screen
+    cout.rdbuf()->pubsync();
+    fflush(stdout);
+
+    if (pending.empty()) return true;
+
+    bool ok = writeAll(pending.data(), pending.size());
+    pending.clear();
+    return ok;
+}
+
+void ScreenStreamBuf::setTarget(int fd, bool takeOwnership) {
+    present();
+    if (ownsTarget) {
+        closeFd(targetFd);
+    }
+    targetFd = fd;
+    ownsTarget = takeOwnership;
+}
+
+int ScreenStreamBuf::getTarget() const {
+    return targetFd;
+}
+
+size_t ScreenStreamBuf::getPendingSize() const {
+    return pending.size();
+}
+
+// ScreenBuffer Implementation
+
+ScreenBuffer::ScreenBuffer() : ostream(nullptr) {
+    rdbuf(&buffer);
+
+    // Input and other console streams show the pending screen first
+    cin.tie(this);
+    cout.tie(this);
+    cerr.tie(this);
+}
+
+ScreenBuffer::~ScreenBuffer() {
+    buffer.present();
+    cin.tie(&cout);
+    cout.tie(nullptr);
+    cerr.tie(&cout);
+}
+
+bool ScreenBuffer::present() {
+    return buffer.present();
+}
+
+void ScreenBuffer::redirect(int fd) {
+    buffer.setTarget(fd, false);
+}
+
+bool ScreenBuffer::redirectToFile(const string& filePath) {
+#ifdef _WIN32
+    int fd = _open(filePath.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+        _S_IREAD | _S_IWRITE);
+#else
+    int fd = open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    if (fd < 0) {
+        cerr << "Error: Could not open " << filePath << " for screen output" << endl;
+        return false;
+    }
+
+    buffer.setTarget(fd, true);
+    return true;
+}
+
+void ScreenBuffer::restoreConsole() {
+    buffer.setTarget(consoleFd(), false);
+}
+
+size_t ScreenBuffer::getPendingSize() const {
+    return buffer.getPendingSize();
+}
@@ -0,0 +1,91 @@
+#ifndef SCREEN_BUFFER_H
+#define SCREEN_BUFFER_H
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+using namespace std;
+
+/// <summary>
+/// Stream buffer that collects a whole screen in memory
+/// </summary>
+class ScreenStreamBuf : public streambuf {
+private:
+    string pending;
+    int targetFd;
+    bool ownsTarget;
+
+    bool writeAll(const char* data, size_t size);
+
+protected:
+    int_type overflow(int_type ch) override;
+    streamsize xsputn(const char* data, streamsize count) override;
+    int sync() override;
+
+public:
+    ScreenStreamBuf();
+    ~ScreenStreamBuf();
+
+    /// <summary>
+    /// Writes everything collected so far with a single write() call
+    /// </summary>
+    /// <returns>True if the output was written completely</returns>
+    bool present();
+
+    void setTarget(int fd, bool takeOwnership);
+    int getTarget() const;
+    size_t getPendingSize() const;
+};
+
+/// <summary>
+/// Buffered console output used by all display functions
+/// SE Principles:
+/// - Single Responsibility: formatting code no longer decides when to flush
+/// - Dependency Inversion: screens can be sent to stdout, a file or a socket
+/// - Performance: one write() per screen instead of one flush per endl
+/// </summary>
+/// <remarks>
+/// Output is presented automatically before any read from cin and before
+/// anything else is written to cout or cerr, so prompts and messages keep
+/// their order. Use '\n' instead of endl; screen.present() forces output.
+/// </remarks>
+class ScreenBuffer : public ostream {
+private:
+    ScreenStreamBuf buffer;
+
+public:
+    ScreenBuffer();
+    ~ScreenBuffer();
+
+    /// <summary>
+    /// Writes the collected screen to the current target
+    /// </summary>
+    bool present();
+
+    /// <summary>
+    /// Sends future screens to an already open descriptor (file or socket)
+    /// </summary>
+    /// <param name="fd">Descriptor to write to; the caller keeps ownership</param>
+    void redirect(int fd);
+
+    /// <summary>
+    /// Sends future screens to a file, replacing its contents
+    /// </summary>
+    /// <param name="filePath">File to write</param>
+    /// <returns>True if the file could be opened</returns>
+    bool redirectToFile(const string& filePath);
+
+    /// <summary>
+    /// Sends future screens back to standard output
+    /// </summary>
+    void restoreConsole();
+
+    size_t getPendingSize() const;
+};
+
+/// <summary>
+/// Shared screen for the user and lender interfaces
+/// </summary>
+extern ScreenBuffer screen;
+
+#endif
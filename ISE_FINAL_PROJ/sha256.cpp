@@ -0,0 +1,152 @@
+#include "sha256.h"
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+namespace {
+    const uint32_t ROUND_CONSTANTS[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    inline uint32_t rotateRight(uint32_t value, int bits) {
+        return (value >> bits) | (value << (32 - bits));
+    }
+}
+
+Sha256::Sha256() {
+    reset();
+}
+
+void Sha256::reset() {
+    state[0] = 0x6a09e667;
+    state[1] = 0xbb67ae85;
+    state[2] = 0x3c6ef372;
+    state[3] = 0xa54ff53a;
+    state[4] = 0x510e527f;
+    state[5] = 0x9b05688c;
+    state[6] = 0x1f83d9ab;
+    state[7] = 0x5be0cd19;
+    blockLength = 0;
+    totalLength = 0;
+}
+
+void Sha256::processBlock(const uint8_t* data) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = (static_cast<uint32_t>(data[i * 4]) << 24) |
+            (static_cast<uint32_t>(data[i * 4 + 1]) << 16) |
+            (static_cast<uint32_t>(data[i * 4 + 2]) << 8) |
+            static_cast<uint32_t>(data[i * 4 + 3]);
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (int i = 0; i < 64; i++) {
+        uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+        uint32_t choice = (e & f) ^ (~e & g);
+        uint32_t temp1 = h + s1 + choice + ROUND_CONSTANTS[i] + w[i];
+        uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+        uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t temp2 = s0 + majority;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+void Sha256::update(const void* data, size_t length) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    totalLength += length;
+
+    // Top up a partially filled block first
+    if (blockLength > 0) {
+        size_t needed = 64 - blockLength;
+        size_t take = (length < needed) ? length : needed;
+        memcpy(block + blockLength, bytes, take);
+        blockLength += take;
+        bytes += take;
+        length -= take;
+
+        if (blockLength < 64) return;
+        processBlock(block);
+        blockLength = 0;
+    }
+
+    while (length >= 64) {
+        processBlock(bytes);
+        bytes += 64;
+        length -= 64;
+    }
+
+    if (length > 0) {
+        memcpy(block, bytes, length);
+        blockLength = length;
+    }
+}
+
+string Sha256::finalHex() {
+    uint64_t bitLength = totalLength * 8;
+
+    uint8_t padding[72] = { 0x80 };
+    size_t paddingLength = (blockLength < 56) ? (56 - blockLength) : (120 - blockLength);
+    update(padding, paddingLength);
+
+    uint8_t lengthBytes[8];
+    for (int i = 0; i < 8; i++) {
+        lengthBytes[i] = static_cast<uint8_t>(bitLength >> (56 - i * 8));
+    }
+    update(lengthBytes, 8);
+
+    const char* hexDigits = "0123456789abcdef";
+    string digest;
+    digest.reserve(64);
+    for (int i = 0; i < 8; i++) {
+        for (int shift = 28; shift >= 0; shift -= 4) {
+            digest += hexDigits[(state[i] >> shift) & 0xF];
+        }
+    }
+    return digest;
+}
+
+string Sha256::hashFile(const string& filePath) {
+    ifstream file(filePath, ios::binary);
+    if (!file.is_open()) {
+        return "";
+    }
+
+    Sha256 hasher;
+    char buffer[65536];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+        hasher.update(buffer, static_cast<size_t>(file.gcount()));
+    }
+    return hasher.finalHex();
+}
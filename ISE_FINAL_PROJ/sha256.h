@@ -0,0 +1,50 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+using namespace std;
+
+/// <summary>
+/// Incremental SHA-256 hash (FIPS 180-4) used to fingerprint documents
+/// SE Principles:
+/// - Single Responsibility: only computes digests, no file policy
+/// - Streaming: data can be fed in chunks while it is being copied
+/// </summary>
+class Sha256 {
+private:
+    uint32_t state[8];
+    uint8_t block[64];
+    size_t blockLength;
+    uint64_t totalLength;
+
+    void processBlock(const uint8_t* data);
+
+public:
+    Sha256();
+
+    void reset();
+
+    /// <summary>
+    /// Adds more data to the digest
+    /// </summary>
+    /// <param name="data">Bytes to hash</param>
+    /// <param name="length">Number of bytes</param>
+    void update(const void* data, size_t length);
+
+    /// <summary>
+    /// Finishes the digest; the object must be reset before reuse
+    /// </summary>
+    /// <returns>64 character lowercase hex digest</returns>
+    string finalHex();
+
+    /// <summary>
+    /// Hashes a complete file
+    /// </summary>
+    /// <param name="filePath">File to read</param>
+    /// <returns>Hex digest, or empty string if the file cannot be read</returns>
+    static string hashFile(const string& filePath);
+};
+
+#endif
@@ -0,0 +1,269 @@
+#include "text_scanner.h"
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXT_SCANNER_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define TEXT_SCANNER_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+
+const size_t TextScanner::BLOCK_BYTES;
+
+namespace {
+    typedef TextScanner::BlockMasks (*BlockKernel)(const char* block, char delimiter);
+
+    int lowestBit(uint64_t bits) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(bits);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<int>(index);
+#else
+        int index = 0;
+        while ((bits & 1) == 0) {
+            bits >>= 1;
+            index++;
+        }
+        return index;
+#endif
+    }
+
+    int bitCount(uint64_t bits) {
+#if defined(__GNUC__)
+        return __builtin_popcountll(bits);
+#else
+        int count = 0;
+        for (; bits != 0; bits &= bits - 1) count++;
+        return count;
+#endif
+    }
+
+#ifndef TEXT_SCANNER_SSE2
+    TextScanner::BlockMasks scanScalar(const char* block, char delimiter) {
+        TextScanner::BlockMasks masks = { 0, 0 };
+        for (size_t i = 0; i < TextScanner::BLOCK_BYTES; i++) {
+            uint64_t bit = static_cast<uint64_t>(1) << i;
+            if (block[i] == delimiter) masks.delimiters |= bit;
+            if (block[i] == '\n') masks.newlines |= bit;
+        }
+        return masks;
+    }
+#else
+    TextScanner::BlockMasks scanSse2(const char* block, char delimiter) {
+        const __m128i delimiters = _mm_set1_epi8(delimiter);
+        const __m128i newlines = _mm_set1_epi8('\n');
+
+        TextScanner::BlockMasks masks = { 0, 0 };
+        for (int i = 0; i < 4; i++) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+            uint64_t delimiterBits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, delimiters)));
+            uint64_t newlineBits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newlines)));
+            masks.delimiters |= delimiterBits << (16 * i);
+            masks.newlines |= newlineBits << (16 * i);
+        }
+        return masks;
+    }
+#endif
+
+#ifdef TEXT_SCANNER_AVX2
+#if defined(__GNUC__)
+    __attribute__((target("avx2")))
+#endif
+    TextScanner::BlockMasks scanAvx2(const char* block, char delimiter) {
+        const __m256i delimiters = _mm256_set1_epi8(delimiter);
+        const __m256i newlines = _mm256_set1_epi8('\n');
+
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+
+        TextScanner::BlockMasks masks;
+        masks.delimiters = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, delimiters))) |
+            static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, delimiters)))) << 32;
+        masks.newlines = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, newlines))) |
+            static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, newlines)))) << 32;
+        return masks;
+    }
+
+    /// <summary>
+    /// True if the CPU has AVX2 and the OS saves the wide registers
+    /// </summary>
+    bool cpuHasAvx2() {
+#if defined(__GNUC__)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+#else
+        int registers[4];
+        __cpuid(registers, 1);
+        bool osSavesAvx = (registers[2] & (1 << 27)) != 0 && (registers[2] & (1 << 28)) != 0 &&
+            (_xgetbv(0) & 6) == 6;
+        if (!osSavesAvx) return false;
+        __cpuidex(registers, 7, 0);
+        return (registers[1] & (1 << 5)) != 0;
+#endif
+    }
+#endif
+
+    struct Kernel {
+        BlockKernel scan;
+        const char* name;
+    };
+
+    const Kernel& activeKernel() {
+        static const Kernel kernel = []() {
+#ifdef TEXT_SCANNER_AVX2
+            if (cpuHasAvx2()) return Kernel{ scanAvx2, "avx2" };
+#endif
+#ifdef TEXT_SCANNER_SSE2
+            return Kernel{ scanSse2, "sse2" };
+#else
+            return Kernel{ scanScalar, "scalar" };
+#endif
+        }();
+        return kernel;
+    }
+
+    /// <summary>
+    /// Adds text[first, stop) with surrounding whitespace removed
+    /// </summary>
+    void addTrimmedField(vector<string>& fields, const char* first, const char* stop) {
+        while (first < stop && isspace(static_cast<unsigned char>(*first))) first++;
+        while (stop > first && isspace(static_cast<unsigned char>(stop[-1]))) stop--;
+        fields.emplace_back(first, stop);
+    }
+}
+
+TextScanner::BlockMasks TextScanner::scanBlock(const char* text, size_t length, char delimiter) {
+    BlockKernel scan = activeKernel().scan;
+    if (length >= BLOCK_BYTES) return scan(text, delimiter);
+
+    // Kernels always read a whole block; the bytes past the text are zeros and masked off
+    char padded[BLOCK_BYTES] = {};
+    memcpy(padded, text, length);
+    BlockMasks masks = scan(padded, delimiter);
+    uint64_t inText = (static_cast<uint64_t>(1) << length) - 1;
+    masks.delimiters &= inText;
+    masks.newlines &= inText;
+    return masks;
+}
+
+const char* TextScanner::getKernelName() {
+    return activeKernel().name;
+}
+
+const char* TextScanner::findNewline(const char* begin, const char* end) {
+    for (const char* block = begin; block < end; block += BLOCK_BYTES) {
+        uint64_t newlines = scanBlock(block, min(BLOCK_BYTES, static_cast<size_t>(end - block)), '\n').newlines;
+        if (newlines != 0) return block + lowestBit(newlines);
+    }
+    return end;
+}
+
+size_t TextScanner::countNewlines(const char* begin, const char* end) {
+    size_t count = 0;
+    for (const char* block = begin; block < end; block += BLOCK_BYTES) {
+        count += bitCount(scanBlock(block, min(BLOCK_BYTES, static_cast<size_t>(end - block)), '\n').newlines);
+    }
+    return count;
+}
+
+void TextScanner::splitFields(const char* begin, const char* end, char delimiter, vector<string>& fields) {
+    const size_t CACHED_BLOCKS = 16;    // Masks kept from the counting pass (lines up to 1 KB)
+    uint64_t cached[CACHED_BLOCKS];
+
+    size_t length = static_cast<size_t>(end - begin);
+    size_t blocks = (length + BLOCK_BYTES - 1) / BLOCK_BYTES;
+    auto delimitersOf = [&](size_t block) {
+        size_t offset = block * BLOCK_BYTES;
+        return scanBlock(begin + offset, min(BLOCK_BYTES, length - offset), delimiter).delimiters;
+    };
+
+    // Count first so the fields are stored without regrowing the vector
+    size_t fieldCount = 1;
+    for (size_t block = 0; block < blocks; block++) {
+        uint64_t delimiters = delimitersOf(block);
+        if (block < CACHED_BLOCKS) cached[block] = delimiters;
+        fieldCount += bitCount(delimiters);
+    }
+    fields.clear();
+    fields.reserve(fieldCount);
+
+    const char* start = begin;
+    for (size_t block = 0; block < blocks; block++) {
+        uint64_t delimiters = block < CACHED_BLOCKS ? cached[block] : delimitersOf(block);
+        for (; delimiters != 0; delimiters &= delimiters - 1) {
+            const char* delimiterAt = begin + block * BLOCK_BYTES + lowestBit(delimiters);
+            addTrimmedField(fields, start, delimiterAt);
+            start = delimiterAt + 1;
+        }
+    }
+    if (start != end) {
+        addTrimmedField(fields, start, end);    // No trailing empty field
+    }
+}
+
+FileBytes::FileBytes(const string& path) : bytes(nullptr), length(0), opened(false), mapped(false) {
+#ifdef __linux__
+    int descriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) return;
+
+    struct stat info;
+    opened = fstat(descriptor, &info) == 0;
+    length = opened ? static_cast<size_t>(info.st_size) : 0;
+    if (length > 0) {
+        void* view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (view != MAP_FAILED) {
+            madvise(view, length, MADV_WILLNEED);
+            bytes = static_cast<const char*>(view);
+            mapped = true;
+        }
+    }
+    close(descriptor);
+    if (mapped || length == 0) return;
+#endif
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) return;
+    buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    bytes = buffer.data();
+    length = buffer.size();
+    opened = true;
+}
+
+FileBytes::~FileBytes() {
+#ifdef __linux__
+    if (mapped) munmap(const_cast<char*>(bytes), length);
+#endif
+}
+
+LineReader::LineReader(const string& path) : file(path), position(file.data()) {
+}
+
+bool LineReader::next(string& line) {
+    const char* end = file.data() + file.size();
+    if (position == nullptr || position >= end) return false;
+
+    const char* newline = TextScanner::findNewline(position, end);
+    line.assign(position, newline);
+    position = newline == end ? end : newline + 1;
+    return true;
+}
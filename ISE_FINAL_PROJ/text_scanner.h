@@ -0,0 +1,107 @@
+#ifndef TEXT_SCANNER_H
+#define TEXT_SCANNER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+using namespace std;
+
+/// <summary>
+/// Finds the structural bytes of delimited text (field delimiters and newlines)
+/// Text is examined 64 bytes at a time: each block yields one bitmap of its
+/// delimiters and one of its newlines (bit i = byte i), and splitting then
+/// walks the set bits instead of every byte. The block kernel is chosen once
+/// per process: AVX2 where the CPU has it, SSE2 on other x86 builds, plain
+/// C++ elsewhere. Every kernel gives the same bitmaps.
+/// SE Principles:
+/// - Single Responsibility: locates delimiters; trimming and meaning stay with the callers
+/// - Open/Closed: a new instruction set is a new kernel behind the same bitmaps
+/// </summary>
+class TextScanner {
+public:
+    static const size_t BLOCK_BYTES = 64;
+
+    /// <summary>
+    /// Delimiter and newline positions within one block
+    /// </summary>
+    struct BlockMasks {
+        uint64_t delimiters;
+        uint64_t newlines;
+    };
+
+    /// <summary>
+    /// Bitmaps of one block of text
+    /// </summary>
+    /// <param name="length">Bytes to look at (at most BLOCK_BYTES); higher bits are clear</param>
+    static BlockMasks scanBlock(const char* text, size_t length, char delimiter);
+
+    /// <summary>
+    /// Name of the kernel in use ("avx2", "sse2" or "scalar")
+    /// </summary>
+    static const char* getKernelName();
+
+    /// <summary>
+    /// First newline in [begin, end), or end if there is none
+    /// </summary>
+    static const char* findNewline(const char* begin, const char* end);
+
+    /// <summary>
+    /// Number of newlines in [begin, end)
+    /// </summary>
+    static size_t countNewlines(const char* begin, const char* end);
+
+    /// <summary>
+    /// Splits one line into trimmed fields, as splitString does
+    /// (an empty last field is dropped, so "" gives no fields)
+    /// </summary>
+    /// <param name="fields">Output: replaced with the line's fields</param>
+    static void splitFields(const char* begin, const char* end, char delimiter, vector<string>& fields);
+};
+
+/// <summary>
+/// Read-only bytes of a whole file
+/// The file is mapped where possible so readers (and parser threads) use
+/// the page cache directly; otherwise it is read into memory once.
+/// </summary>
+class FileBytes {
+private:
+    const char* bytes;
+    size_t length;
+    bool opened;
+    bool mapped;
+    string buffer;
+
+public:
+    explicit FileBytes(const string& path);
+    ~FileBytes();
+
+    FileBytes(const FileBytes&) = delete;
+    FileBytes& operator=(const FileBytes&) = delete;
+
+    bool isOpen() const { return opened; }
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+/// <summary>
+/// Reads a text file line by line, like getline on an ifstream,
+/// finding the line ends with TextScanner
+/// </summary>
+class LineReader {
+private:
+    FileBytes file;
+    const char* position;
+
+public:
+    explicit LineReader(const string& path);
+
+    bool isOpen() const { return file.isOpen(); }
+
+    /// <summary>
+    /// Next line without its newline; false at the end of the file
+    /// </summary>
+    bool next(string& line);
+};
+
+#endif
@@ -0,0 +1,43 @@
+#include "thread_pool.h"
+
+using namespace std;
+
+ThreadPool::ThreadPool(int threadCount) : stopping(false) {
+    if (threadCount < 1) threadCount = 1;
+
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(queueMutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(queueMutex);
+            taskAvailable.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+            if (stopping && tasks.empty()) return;
+
+            task = move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+int ThreadPool::getThreadCount() const {
+    return static_cast<int>(workers.size());
+}
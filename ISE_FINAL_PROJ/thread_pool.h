@@ -0,0 +1,67 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+using namespace std;
+
+/// <summary>
+/// Fixed-size pool of worker threads running queued tasks
+/// SE Principles:
+/// - Single Responsibility: only schedules work, callers own the results
+/// - Resource Management: threads are created once and joined on destruction
+/// </summary>
+class ThreadPool {
+private:
+    vector<thread> workers;
+    queue<function<void()>> tasks;
+    mutex queueMutex;
+    condition_variable taskAvailable;
+    bool stopping;
+
+    void workerLoop();
+
+public:
+    /// <summary>
+    /// Starts the worker threads
+    /// </summary>
+    /// <param name="threadCount">Number of workers (at least one is started)</param>
+    explicit ThreadPool(int threadCount);
+
+    /// <summary>
+    /// Finishes queued tasks and joins all workers
+    /// </summary>
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// <summary>
+    /// Queues a task for execution
+    /// </summary>
+    /// <param name="task">Callable taking no arguments</param>
+    /// <returns>Future holding the task's result (or its exception)</returns>
+    template <typename Task>
+    future<typename result_of<Task()>::type> submit(Task task) {
+        typedef typename result_of<Task()>::type Result;
+
+        auto packaged = make_shared<packaged_task<Result()>>(move(task));
+        future<Result> result = packaged->get_future();
+        {
+            lock_guard<mutex> lock(queueMutex);
+            tasks.push([packaged]() { (*packaged)(); });
+        }
+        taskAvailable.notify_one();
+        return result;
+    }
+
+    int getThreadCount() const;
+};
+
+#endif
@@ -8,6 +8,8 @@
 #include "personal.h"
 #include "file_manager.h"
 #include "utilities.h"
+#include "installment_schedule.h"
+#include "screen_buffer.h"
 #include <iostream>
 #include <iomanip>
 #include <string>
@@ -17,53 +19,53 @@ using namespace std;
 
 
 inline void displayApplicationDetails(const LoanApplication& app) {
-    cout << endl << "========================================" << endl;
-    cout << "APPLICATION DETAILS" << endl;
-    cout << "========================================" << endl;
-    cout << "Application ID: " << app.getApplicationId() << endl;
-    cout << "Status: " << app.getStatus() << endl;
-
-    if (app.getStatus() == "rejected" && !app.getRejectionReason().empty()) {
-        cout << "Rejection Reason: " << app.getRejectionReason() << endl;
+    screen << '\n' << "========================================" << '\n';
+    screen << "APPLICATION DETAILS" << '\n';
+    screen << "========================================" << '\n';
+    screen << "Application ID: " << app.getApplicationId() << '\n';
+    screen << "Status: " << app.getStatus() << '\n';
+
+    if (app.getStatusCode() == ApplicationStatus::REJECTED && !app.getRejectionReason().empty()) {
+        screen << "Rejection Reason: " << app.getRejectionReason() << '\n';
     }
 
-    cout << "Submission Date: " << app.getSubmissionDate() << endl;
-    cout << endl << "PERSONAL INFORMATION:" << endl;
-    cout << "  Full Name: " << app.getFullName() << endl;
-    cout << "  Father's Name: " << app.getFathersName() << endl;
-    cout << "  CNIC: " << app.getCnicNumber() << endl;
-    cout << "  Contact: " << app.getContactNumber() << endl;
-    cout << "  Email: " << app.getEmailAddress() << endl;
-    cout << "  Address: " << app.getPostalAddress() << endl;
-    cout << endl << "EMPLOYMENT & FINANCIAL:" << endl;
-    cout << "  Employment: " << app.getEmploymentStatus() << endl;
-    cout << "  Marital Status: " << app.getMaritalStatus() << endl;
-    cout << "  Gender: " << app.getGender() << endl;
-    cout << "  Dependents: " << app.getNumberOfDependents() << endl;
-    cout << "  Annual Income: PKR " << app.getAnnualIncome() << endl;
-    cout << "  Avg Electricity Bill: PKR " << app.getAvgElectricityBill() << endl;
-    cout << "  Current Electricity Bill: PKR " << app.getCurrentElectricityBill() << endl;
-
-    cout << endl << "LOAN DETAILS:" << endl;
+    screen << "Submission Date: " << app.getSubmissionDate() << '\n';
+    screen << '\n' << "PERSONAL INFORMATION:" << '\n';
+    screen << "  Full Name: " << app.getFullName() << '\n';
+    screen << "  Father's Name: " << app.getFathersName() << '\n';
+    screen << "  CNIC: " << app.getCnicNumber() << '\n';
+    screen << "  Contact: " << app.getContactNumber() << '\n';
+    screen << "  Email: " << app.getEmailAddress() << '\n';
+    screen << "  Address: " << app.getPostalAddress() << '\n';
+    screen << '\n' << "EMPLOYMENT & FINANCIAL:" << '\n';
+    screen << "  Employment: " << app.getEmploymentStatus() << '\n';
+    screen << "  Marital Status: " << app.getMaritalStatus() << '\n';
+    screen << "  Gender: " << app.getGender() << '\n';
+    screen << "  Dependents: " << app.getNumberOfDependents() << '\n';
+    screen << "  Annual Income: PKR " << app.getAnnualIncome() << '\n';
+    screen << "  Avg Electricity Bill: PKR " << app.getAvgElectricityBill() << '\n';
+    screen << "  Current Electricity Bill: PKR " << app.getCurrentElectricityBill() << '\n';
+
+    screen << '\n' << "LOAN DETAILS:" << '\n';
 
     string loanType = app.getLoanType();
     if (loanType.empty() || loanType == "0" || loanType == "Unknown") {
         loanType = "Personal Loan";
     }
-    cout << "  Loan Type: " << loanType << endl;
+    screen << "  Loan Type: " << loanType << '\n';
 
-    cout << "  Category: " << app.getLoanCategory() << endl;
-    cout << "  Total Amount: PKR " << app.getLoanAmount() << endl;
-    cout << "  Down Payment: PKR " << app.getDownPayment() << endl;
-    cout << "  Installment Period: " << app.getInstallmentMonths() << " months" << endl;
-    cout << "  Monthly Payment: PKR " << app.getMonthlyPayment() << endl;
+    screen << "  Category: " << app.getLoanCategory() << '\n';
+    screen << "  Total Amount: PKR " << app.getLoanAmount() << '\n';
+    screen << "  Down Payment: PKR " << app.getDownPayment() << '\n';
+    screen << "  Installment Period: " << app.getInstallmentMonths() << " months" << '\n';
+    screen << "  Monthly Payment: PKR " << app.getMonthlyPayment() << '\n';
 
-    cout << endl << "EXISTING LOANS: " << app.getExistingLoansCount() << " loan(s)" << endl;
-    cout << "========================================" << endl;
+    screen << '\n' << "EXISTING LOANS: " << app.getExistingLoansCount() << " loan(s)" << '\n';
+    screen << "========================================" << '\n';
 }
 
 inline void displayGoodbyeMessage() {
-    cout << Config::CHATBOT_NAME << ": Thank you for using our service. Goodbye!" << endl;
+    screen << Config::CHATBOT_NAME << ": Thank you for using our service. Goodbye!" << '\n';
 }
 
 inline bool isValidAreaInput(const string& input) {
@@ -77,36 +79,36 @@ inline bool isValidMakeInput(const string& input, const string& loanType) {
 }
 
 inline void displayCarMakes() {
-    cout << Config::CHATBOT_NAME << ": Please select the car make:" << endl;
-    cout << "  Press 1 for Make 1" << endl;
-    cout << "  Press 2 for Make 2" << endl;
-    cout << "  Press X to exit" << endl;
+    screen << Config::CHATBOT_NAME << ": Please select the car make:" << '\n';
+    screen << "  Press 1 for Make 1" << '\n';
+    screen << "  Press 2 for Make 2" << '\n';
+    screen << "  Press X to exit" << '\n';
 }
 
 inline void displayScooterMakes() {
-    cout << Config::CHATBOT_NAME << ": Please select the scooter make:" << endl;
-    cout << "  Press 1 for Make 1" << endl;
-    cout << "  Press X to exit" << endl;
+    screen << Config::CHATBOT_NAME << ": Please select the scooter make:" << '\n';
+    screen << "  Press 1 for Make 1" << '\n';
+    screen << "  Press X to exit" << '\n';
 }
 
 inline void displayPersonalLoanCategories(const PersonalLoan loans[], int size) {
     vector<string> categories = getPersonalLoanCategories(loans, size);
 
-    cout << Config::CHATBOT_NAME << ": Please select a personal loan category:" << endl;
+    screen << Config::CHATBOT_NAME << ": Please select a personal loan category:" << '\n';
     for (size_t i = 0; i < categories.size(); i++) {
-        cout << "  " << (i + 1) << ". " << categories[i] << endl;
+        screen << "  " << (i + 1) << ". " << categories[i] << '\n';
     }
-    cout << "  X - Exit" << endl;
+    screen << "  X - Exit" << '\n';
 }
 
 inline bool displayCarLoanOptionsByMake(const CarLoan loans[], int size, const string& makeNumber) {
     string makeName = "Make " + makeNumber;
     bool found = false;
 
-    cout << endl << "  Car Loan Options for " << makeName << endl;
-    cout << "+-----+-----------+---------+----------+-------------+-------------+---------------+---------------------+" << endl;
-    cout << "| Opt |   Model   | Engine  | Condition| Year        | Total Price | Down Payment  | Monthly Installment |" << endl;
-    cout << "+-----+-----------+---------+----------+-------------+-------------+---------------+---------------------+" << endl;
+    screen << '\n' << "  Car Loan Options for " << makeName << '\n';
+    screen << "+-----+-----------+---------+----------+-------------+-------------+---------------+---------------------+" << '\n';
+    screen << "| Opt |   Model   | Engine  | Condition| Year        | Total Price | Down Payment  | Monthly Installment |" << '\n';
+    screen << "+-----+-----------+---------+----------+-------------+-------------+---------------+---------------------+" << '\n';
 
     int optionCount = 0;
     for (int i = 0; i < size; i++) {
@@ -114,28 +116,28 @@ inline bool displayCarLoanOptionsByMake(const CarLoan loans[], int size, const s
             found = true;
             optionCount++;
             long long monthlyInstallment = loans[i].calculateMonthlyInstallment();
-            cout << "| " << setw(3) << optionCount << " | "
+            screen << "| " << setw(3) << optionCount << " | "
                 << setw(9) << loans[i].getModel() << " | "
                 << setw(7) << loans[i].getEngine() << "cc | "
                 << setw(8) << loans[i].getUsed() << " | "
                 << setw(11) << loans[i].getManufacturingYear() << " | "
                 << "PKR " << setw(8) << loans[i].getPrice() << " | "
                 << "PKR " << setw(10) << loans[i].getDownPayment() << " | "
-                << "PKR " << setw(15) << monthlyInstallment << " |" << endl;
+                << "PKR " << setw(15) << monthlyInstallment << " |" << '\n';
         }
     }
-    cout << "+-----+-----------+---------+----------+-------------+-------------+---------------+---------------------+" << endl;
+    screen << "+-----+-----------+---------+----------+-------------+-------------+---------------+---------------------+" << '\n';
 
     if (!found) {
-        cout << "No car options available for this make." << endl;
+        screen << "No car options available for this make." << '\n';
     }
 
     return found;
 }
 
 inline void generateUserInstallmentPlan(const LoanApplication& application) {
-    cout << endl << " " << Config::CHATBOT_NAME
-        << ": Generating your monthly installment plan..." << endl;
+    screen << '\n' << " " << Config::CHATBOT_NAME
+        << ": Generating your monthly installment plan..." << '\n';
 
     long long loanAmount = application.getLoanAmount();
     long long downPayment = application.getDownPayment();
@@ -161,104 +163,117 @@ inline void generateUserInstallmentPlan(const LoanApplication& application) {
 
     int startMonth = 0;
     while (startMonth < 1 || startMonth > 12) {
-        cout << Config::CHATBOT_NAME << ": When would you like to start payments?" << endl;
-        cout << "Enter starting month (1=January, ..., 12=December): ";
+        screen << Config::CHATBOT_NAME << ": When would you like to start payments?" << '\n';
+        screen << "Enter starting month (1=January, ..., 12=December): ";
         string monthInput;
         getline(cin, monthInput);
 
         try {
             startMonth = stoi(trim(monthInput));
             if (startMonth < 1 || startMonth > 12) {
-                cout << " Please enter a valid month (1-12)." << endl;
+                screen << " Please enter a valid month (1-12)." << '\n';
             }
         }
         catch (...) {
-            cout << " Please enter a number between 1 and 12." << endl;
+            screen << " Please enter a number between 1 and 12." << '\n';
             startMonth = 0;
         }
     }
 
     int startYear = 0;
     while (startYear < 2024 || startYear > 2100) {
-        cout << Config::CHATBOT_NAME << ": Enter starting year (e.g., 2024, 2025): ";
+        screen << Config::CHATBOT_NAME << ": Enter starting year (e.g., 2024, 2025): ";
         string yearInput;
         getline(cin, yearInput);
 
         try {
             startYear = stoi(trim(yearInput));
             if (startYear < 2024 || startYear > 2100) {
-                cout << " Please enter a year between 2024 and 2100." << endl;
+                screen << " Please enter a year between 2024 and 2100." << '\n';
             }
         }
         catch (...) {
-            cout << " Please enter a valid year." << endl;
+            screen << " Please enter a valid year." << '\n';
             startYear = 0;
         }
     }
 
     long long financedAmount = loanAmount - downPayment;
-    long long remainingBalance = financedAmount;
-
-    cout << endl << "===============================================" << endl;
-    cout << "         MONTHLY INSTALLMENT PLAN" << endl;
-    cout << "===============================================" << endl;
-    cout << "Applicant: " << application.getFullName() << endl;
-    cout << "CNIC: " << application.getCnicNumber() << endl;
-    cout << "Loan Type: " << loanType << endl;
-    cout << "Total Loan Amount: PKR " << loanAmount << endl;
-    cout << "Down Payment: PKR " << downPayment << endl;
-    cout << "Amount to Finance: PKR " << financedAmount << endl;
-    cout << "Installment Period: " << totalMonths << " months" << endl;
-    cout << "Monthly Installment: PKR " << monthlyPayment << endl;
-    cout << "Starting: " << getMonthName(startMonth) << " " << startYear << endl;
-    cout << "===============================================" << endl << endl;
-
-    cout << Config::CHATBOT_NAME << ": Here is your complete payment schedule:" << endl << endl;
-
-    cout << "+-------+------------------+------+------------------+------------------+" << endl;
-    cout << "| Month | Month Name       | Year | Payment Due      | Remaining Balance|" << endl;
-    cout << "+-------+------------------+------+------------------+------------------+" << endl;
-
-    int currentMonth = startMonth;
-    int currentYear = startYear;
-    long long totalPaid = 0;
-
-    for (int monthNum = 1; monthNum <= totalMonths; monthNum++) {
-        long long paymentDue = monthlyPayment;
-
-        if (monthNum == totalMonths) {
-            paymentDue = remainingBalance;
+    InstallmentSchedule schedule(financedAmount, totalMonths, monthlyPayment, startMonth, startYear);
+
+    screen << '\n' << "===============================================" << '\n';
+    screen << "         MONTHLY INSTALLMENT PLAN" << '\n';
+    screen << "===============================================" << '\n';
+    screen << "Applicant: " << application.getFullName() << '\n';
+    screen << "CNIC: " << application.getCnicNumber() << '\n';
+    screen << "Loan Type: " << loanType << '\n';
+    screen << "Total Loan Amount: PKR " << loanAmount << '\n';
+    screen << "Down Payment: PKR " << downPayment << '\n';
+    screen << "Amount to Finance: PKR " << financedAmount << '\n';
+    screen << "Installment Period: " << totalMonths << " months" << '\n';
+    screen << "Monthly Installment: PKR " << monthlyPayment << '\n';
+    screen << "Starting: " << getMonthName(startMonth) << " " << startYear << '\n';
+    screen << "===============================================" << '\n' << '\n';
+
+    // Rows are generated per page, so long plans no longer flood the console
+    int pageSize = Config::SCHEDULE_PAGE_SIZE;
+    int pageCount = schedule.getPageCount(pageSize);
+    int nextMonth = 1;
+
+    screen << Config::CHATBOT_NAME << ": Here is your payment schedule ("
+        << pageCount << (pageCount == 1 ? " page" : " pages") << "):" << '\n' << '\n';
+
+    while (nextMonth <= totalMonths) {
+        nextMonth += schedule.writeRows(screen, nextMonth, pageSize);
+        if (nextMonth > totalMonths) break;
+
+        screen << "[Enter] next page, month number to jump, (A)ll remaining, (X) summary: ";
+        string choice;
+        getline(cin, choice);
+        choice = toLower(trim(choice));
+
+        if (choice == "x") {
+            break;
+        }
+        else if (choice == "a") {
+            schedule.writeRows(screen, nextMonth, totalMonths - nextMonth + 1);
+            break;
+        }
+        else if (!choice.empty()) {
+            try {
+                int jumpTo = stoi(choice);
+                if (jumpTo < 1 || jumpTo > totalMonths) {
+                    screen << " Please enter a month between 1 and " << totalMonths << "." << '\n';
+                }
+                else {
+                    nextMonth = jumpTo;
+                }
+            }
+            catch (...) {
+                screen << " Invalid choice, showing next page." << '\n';
+            }
         }
-
-        totalPaid += paymentDue;
-        remainingBalance -= paymentDue;
-        if (remainingBalance < 0) remainingBalance = 0;
-
-        cout << "| " << setw(5) << monthNum << " | "
-            << setw(16) << left << getMonthName(currentMonth) << " | "
-            << setw(4) << currentYear << " | "
-            << "PKR " << setw(12) << right << paymentDue << " | "
-            << "PKR " << setw(12) << remainingBalance << " |" << endl;
-
-        getNextMonth(currentMonth, currentYear);
     }
 
-    cout << "+-------+------------------+------+------------------+------------------+" << endl;
-
-    cout << endl << "===============================================" << endl;
-    cout << "PAYMENT SUMMARY" << endl;
-    cout << "===============================================" << endl;
-    cout << "Total Loan Amount:    PKR " << setw(12) << loanAmount << endl;
-    cout << "Down Payment:         PKR " << setw(12) << downPayment << endl;
-    cout << "Amount Financed:      PKR " << setw(12) << financedAmount << endl;
-    cout << "Total Installments:   PKR " << setw(12) << totalPaid << endl;
-    cout << "Total Amount Paid:    PKR " << setw(12) << (downPayment + totalPaid) << endl;
-    cout << "Completion Date:      " << getMonthName(currentMonth) << " " << currentYear << endl;
-    cout << "===============================================" << endl;
-
-    cout << endl << Config::CHATBOT_NAME << ": Your installment plan is ready! ";
-    cout << "First payment of PKR " << monthlyPayment << " is due "
-        << getMonthName(startMonth) << " " << startYear << "." << endl;
+    long long totalPaid = schedule.totalOfPayments();
+    int completionMonth = 0;
+    int completionYear = 0;
+    schedule.getCompletionDate(completionMonth, completionYear);
+
+    screen << '\n' << "===============================================" << '\n';
+    screen << "PAYMENT SUMMARY" << '\n';
+    screen << "===============================================" << '\n';
+    screen << "Total Loan Amount:    PKR " << setw(12) << loanAmount << '\n';
+    screen << "Down Payment:         PKR " << setw(12) << downPayment << '\n';
+    screen << "Amount Financed:      PKR " << setw(12) << financedAmount << '\n';
+    screen << "Total Installments:   PKR " << setw(12) << totalPaid << '\n';
+    screen << "Total Amount Paid:    PKR " << setw(12) << (downPayment + totalPaid) << '\n';
+    screen << "Completion Date:      " << getMonthName(completionMonth) << " " << completionYear << '\n';
+    screen << "===============================================" << '\n';
+
+    screen << '\n' << Config::CHATBOT_NAME << ": Your installment plan is ready! ";
+    screen << "First payment of PKR " << monthlyPayment << " is due "
+        << getMonthName(startMonth) << " " << startYear << "." << '\n';
 }
 
 #endif 
\ No newline at end of file
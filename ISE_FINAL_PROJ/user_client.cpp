@@ -2,16 +2,19 @@
 #include <string>
 #include<iomanip>
 #include "utilities.h"
+#include "screen_buffer.h"
 #include "home.h"
 #include "car.h"
 #include "scooter.h"
 #include "application.h"
 #include "application_collector.h"
 #include "file_manager.h"
-#include "utterances.h"
+#include "Utterances.h"
 #include "ui_handler.h"
 #include "multi_session_collector.h"
 #include "personal.h"
+#include "remote_file_manager.h"
+#include "loan_catalog.h"
 
 using namespace std;
 
@@ -20,28 +23,29 @@ void handlePersonalLoanSelection(const PersonalLoan[], int, bool&, ApplicationCo
 void handleHomeLoanSelection(const HomeLoan[], int, bool&, ApplicationCollector&, FileManager&);
 void handleCarLoanSelection(const CarLoan[], int, bool&, ApplicationCollector&, FileManager&);
 void handleScooterLoanSelection(const ScooterLoan[], int, bool&, ApplicationCollector&, FileManager&);
-void checkApplicationStatusByCNIC(FileManager&);
+void checkApplicationStatusByCNIC(FileManager&, RemoteFileManager*);
+void waitForDecisions(RemoteFileManager&, const string&, vector<LoanApplication>&);
 void displayLoanCategories();
 
 void displayLoanCategories() {
-    cout << Config::CHATBOT_NAME << ": Please select loan category:" << endl;
-    cout << "  H - Home Loan" << endl;
-    cout << "  C - Car Loan" << endl;
-    cout << "  S - Scooter Loan" << endl;
-    cout << "  P - Personal Loan" << endl;
-    cout << "  X - Exit" << endl;
+    screen << Config::CHATBOT_NAME << ": Please select loan category:" << '\n';
+    screen << "  H - Home Loan" << '\n';
+    screen << "  C - Car Loan" << '\n';
+    screen << "  S - Scooter Loan" << '\n';
+    screen << "  P - Personal Loan" << '\n';
+    screen << "  X - Exit" << '\n';
 }
 
 // SE Principles: Strategy Pattern, Composition, Separation of Concerns
 void handleHomeLoanSelection(const HomeLoan loans[], int loanCount, bool& running,
     ApplicationCollector& collector, FileManager& fileManager) {
-    cout << Config::CHATBOT_NAME << ": You selected home loan. Please select area (1-4):" << endl;
+    screen << Config::CHATBOT_NAME << ": You selected home loan. Please select area (1-4):" << '\n';
 
     bool validArea = false;
     string userInput;
 
     while (!validArea && running) {
-        cout << "You: ";
+        screen << "You: ";
         getline(cin, userInput);
         string areaInput = trim(userInput);
 
@@ -52,7 +56,7 @@ void handleHomeLoanSelection(const HomeLoan loans[], int loanCount, bool& runnin
         }
 
         if (!isValidAreaInput(areaInput)) {
-            cout << Config::CHATBOT_NAME << ": Invalid area. Please enter 1, 2, 3, or 4:" << endl;
+            screen << Config::CHATBOT_NAME << ": Invalid area. Please enter 1, 2, 3, or 4:" << '\n';
             continue;
         }
 
@@ -60,7 +64,7 @@ void handleHomeLoanSelection(const HomeLoan loans[], int loanCount, bool& runnin
 
         if (!hasData) continue;
 
-        cout << endl << Config::CHATBOT_NAME << ": Would you like to see the detailed installment plan? (Y/N): ";
+        screen << '\n' << Config::CHATBOT_NAME << ": Would you like to see the detailed installment plan? (Y/N): ";
         getline(cin, userInput);
         string planInput = toLower(trim(userInput));
 
@@ -73,7 +77,7 @@ void handleHomeLoanSelection(const HomeLoan loans[], int loanCount, bool& runnin
         int optionNumber = 0;
 
         if (planInput == "y" || planInput == "yes") {
-            cout << Config::CHATBOT_NAME << ": Enter option number: ";
+            screen << Config::CHATBOT_NAME << ": Enter option number: ";
             getline(cin, userInput);
 
             if (toLower(trim(userInput)) == Config::EXIT_COMMAND) {
@@ -87,12 +91,12 @@ void handleHomeLoanSelection(const HomeLoan loans[], int loanCount, bool& runnin
                 displayInstallmentPlanForOption(loans, loanCount, areaInput, optionNumber);
             }
             catch (const exception&) {
-                cout << Config::CHATBOT_NAME << ": Invalid option number." << endl;
+                screen << Config::CHATBOT_NAME << ": Invalid option number." << '\n';
                 continue;
             }
         }
 
-        cout << endl << Config::CHATBOT_NAME << ": Would you like to start the loan application? (Y/N): ";
+        screen << '\n' << Config::CHATBOT_NAME << ": Would you like to start the loan application? (Y/N): ";
         getline(cin, userInput);
         string applyInput = toLower(trim(userInput));
 
@@ -104,7 +108,7 @@ void handleHomeLoanSelection(const HomeLoan loans[], int loanCount, bool& runnin
 
         if (applyInput == "y" || applyInput == "yes") {
             if (optionNumber == 0) {
-                cout << Config::CHATBOT_NAME << ": Which option would you like to apply for? Enter number: ";
+                screen << Config::CHATBOT_NAME << ": Which option would you like to apply for? Enter number: ";
                 getline(cin, userInput);
 
                 if (toLower(trim(userInput)) == Config::EXIT_COMMAND) {
@@ -117,7 +121,7 @@ void handleHomeLoanSelection(const HomeLoan loans[], int loanCount, bool& runnin
                     optionNumber = stoi(trim(userInput));
                 }
                 catch (const exception&) {
-                    cout << Config::CHATBOT_NAME << ": Invalid option number." << endl;
+                    screen << Config::CHATBOT_NAME << ": Invalid option number." << '\n';
                     continue;
                 }
             }
@@ -149,7 +153,7 @@ void handleHomeLoanSelection(const HomeLoan loans[], int loanCount, bool& runnin
                 }
 
                 if (!loanFound) {
-                    cout << Config::CHATBOT_NAME << ": Error: Could not retrieve loan details." << endl;
+                    screen << Config::CHATBOT_NAME << ": Error: Could not retrieve loan details." << '\n';
                     continue;
                 }
 
@@ -160,7 +164,7 @@ void handleHomeLoanSelection(const HomeLoan loans[], int loanCount, bool& runnin
                 application.setStatus("C1");
                 fileManager.updateApplicationSection(application, "");
 
-                cout << endl << "Application created! ID: " << appId << endl;
+                screen << '\n' << "Application created! ID: " << appId << '\n';
 
                 // Use multi-session collector
                 MultiSessionCollector multiCollector(fileManager);
@@ -177,7 +181,7 @@ void handleHomeLoanSelection(const HomeLoan loans[], int loanCount, bool& runnin
                     else if (nextSection == "references") sectionCompleted = multiCollector.collectReferencesInfo(application);
                     else if (nextSection == "documents") {
                         sectionCompleted = multiCollector.collectDocumentsInfo(application);
-                        if (sectionCompleted && application.getStatus() == "submitted") {
+                        if (sectionCompleted && application.getStatusCode() == ApplicationStatus::SUBMITTED) {
                             applicationWasSubmitted = true;
                             break;
                         }
@@ -185,12 +189,12 @@ void handleHomeLoanSelection(const HomeLoan loans[], int loanCount, bool& runnin
 
                     if (sectionCompleted && !applicationWasSubmitted) {
                         if (application.getNextIncompleteSection() != "complete") {
-                            cout << endl << Config::CHATBOT_NAME << ": Continue to next section? (yes/no): ";
+                            screen << '\n' << Config::CHATBOT_NAME << ": Continue to next section? (yes/no): ";
                             string nextChoice;
                             getline(cin, nextChoice);
                             continueProcessing = (toLower(trim(nextChoice)) == "yes" || toLower(trim(nextChoice)) == "y");
                             if (!continueProcessing) {
-                                cout << endl << "Progress saved! Application ID: " << appId << endl;
+                                screen << '\n' << "Progress saved! Application ID: " << appId << '\n';
                                 return;
                             }
                         }
@@ -201,19 +205,19 @@ void handleHomeLoanSelection(const HomeLoan loans[], int loanCount, bool& runnin
                 }
 
                 if (applicationWasSubmitted || application.isApplicationComplete()) {
-                    cout << endl << "Application submitted! ID: " << application.getApplicationId() << endl;
-                    cout << endl << "Press any key to return to main menu...";
+                    screen << '\n' << "Application submitted! ID: " << application.getApplicationId() << '\n';
+                    screen << '\n' << "Press any key to return to main menu...";
                     getline(cin, userInput);
                     return;
                 }
             }
             catch (const exception& e) {
-                cout << Config::CHATBOT_NAME << ": Application failed: " << e.what() << endl;
+                screen << Config::CHATBOT_NAME << ": Application failed: " << e.what() << '\n';
             }
         }
 
         validArea = true;
-        cout << endl << "Press X to exit or any key for main menu: ";
+        screen << '\n' << "Press X to exit or any key for main menu: ";
         getline(cin, userInput);
         if (toLower(trim(userInput)) == Config::EXIT_COMMAND) {
             running = false;
@@ -225,11 +229,11 @@ void handleHomeLoanSelection(const HomeLoan loans[], int loanCount, bool& runnin
 void handleCarLoanSelection(const CarLoan loans[], int loanCount, bool& running,
     ApplicationCollector& collector, FileManager& fileManager) {
 
-    cout << Config::CHATBOT_NAME << ": You selected car loan." << endl;
+    screen << Config::CHATBOT_NAME << ": You selected car loan." << '\n';
     displayCarMakes();
 
     string userInput;
-    cout << "You: ";
+    screen << "You: ";
     getline(cin, userInput);
     string makeInput = trim(userInput);
 
@@ -240,7 +244,7 @@ void handleCarLoanSelection(const CarLoan loans[], int loanCount, bool& running,
     }
 
     if (!isValidMakeInput(makeInput, "car")) {
-        cout << Config::CHATBOT_NAME << ": Invalid make selection." << endl;
+        screen << Config::CHATBOT_NAME << ": Invalid make selection." << '\n';
         return;
     }
 
@@ -249,7 +253,7 @@ void handleCarLoanSelection(const CarLoan loans[], int loanCount, bool& running,
 
     int optionNumber = 0;
 
-    cout << endl << Config::CHATBOT_NAME << ": View detailed installment plan? (Y/N): ";
+    screen << '\n' << Config::CHATBOT_NAME << ": View detailed installment plan? (Y/N): ";
     getline(cin, userInput);
     string planInput = toLower(trim(userInput));
 
@@ -260,7 +264,7 @@ void handleCarLoanSelection(const CarLoan loans[], int loanCount, bool& running,
     }
 
     if (planInput == "y" || planInput == "yes") {
-        cout << Config::CHATBOT_NAME << ": Enter option number: ";
+        screen << Config::CHATBOT_NAME << ": Enter option number: ";
         getline(cin, userInput);
 
         if (toLower(trim(userInput)) == Config::EXIT_COMMAND) {
@@ -274,24 +278,24 @@ void handleCarLoanSelection(const CarLoan loans[], int loanCount, bool& running,
             displayCarInstallmentPlan(loans, loanCount, optionNumber);
         }
         catch (const exception&) {
-            cout << Config::CHATBOT_NAME << ": Invalid option number." << endl;
+            screen << Config::CHATBOT_NAME << ": Invalid option number." << '\n';
         }
     }
 
-    cout << endl << Config::CHATBOT_NAME << ": Start the loan application? (Y/N): ";
+    screen << '\n' << Config::CHATBOT_NAME << ": Start the loan application? (Y/N): ";
     getline(cin, userInput);
     string applyInput = toLower(trim(userInput));
 
     if (applyInput == "y" || applyInput == "yes") {
         if (optionNumber == 0) {
-            cout << Config::CHATBOT_NAME << ": Which option to apply for? Enter number: ";
+            screen << Config::CHATBOT_NAME << ": Which option to apply for? Enter number: ";
             getline(cin, userInput);
 
             try {
                 optionNumber = stoi(trim(userInput));
             }
             catch (const exception&) {
-                cout << Config::CHATBOT_NAME << ": Invalid option number." << endl;
+                screen << Config::CHATBOT_NAME << ": Invalid option number." << '\n';
                 return;
             }
         }
@@ -323,7 +327,7 @@ void handleCarLoanSelection(const CarLoan loans[], int loanCount, bool& running,
             }
 
             if (!loanFound) {
-                cout << Config::CHATBOT_NAME << ": Error: Could not retrieve loan details." << endl;
+                screen << Config::CHATBOT_NAME << ": Error: Could not retrieve loan details." << '\n';
                 return;
             }
 
@@ -334,7 +338,7 @@ void handleCarLoanSelection(const CarLoan loans[], int loanCount, bool& running,
             application.setStatus("C1");
             fileManager.updateApplicationSection(application, "");
 
-            cout << endl << "Application created! ID: " << appId << endl;
+            screen << '\n' << "Application created! ID: " << appId << '\n';
 
             // Use multi-session collector
             MultiSessionCollector multiCollector(fileManager);
@@ -351,7 +355,7 @@ void handleCarLoanSelection(const CarLoan loans[], int loanCount, bool& running,
                 else if (nextSection == "references") sectionCompleted = multiCollector.collectReferencesInfo(application);
                 else if (nextSection == "documents") {
                     sectionCompleted = multiCollector.collectDocumentsInfo(application);
-                    if (sectionCompleted && application.getStatus() == "submitted") {
+                    if (sectionCompleted && application.getStatusCode() == ApplicationStatus::SUBMITTED) {
                         applicationWasSubmitted = true;
                         break;
                     }
@@ -359,13 +363,13 @@ void handleCarLoanSelection(const CarLoan loans[], int loanCount, bool& running,
 
                 if (sectionCompleted && !applicationWasSubmitted) {
                     if (application.getNextIncompleteSection() != "complete") {
-                        cout << endl << Config::CHATBOT_NAME << ": Continue to next section? (yes/no): ";
+                        screen << '\n' << Config::CHATBOT_NAME << ": Continue to next section? (yes/no): ";
                         string nextChoice;
                         getline(cin, nextChoice);
                         continueProcessing = (toLower(trim(nextChoice)) == "yes" || toLower(trim(nextChoice)) == "y");
                         if (!continueProcessing) {
-                            cout << endl << "Progress saved! Application ID: " << appId << endl;
-                            cout << endl << "Press any key to return to main menu...";
+                            screen << '\n' << "Progress saved! Application ID: " << appId << '\n';
+                            screen << '\n' << "Press any key to return to main menu...";
                             getline(cin, userInput);
                             return;
                         }
@@ -377,28 +381,28 @@ void handleCarLoanSelection(const CarLoan loans[], int loanCount, bool& running,
             }
 
             if (applicationWasSubmitted || application.isApplicationComplete()) {
-                cout << endl << "Application submitted! ID: " << application.getApplicationId() << endl;
-                cout << endl << "Press any key to return to main menu...";
+                screen << '\n' << "Application submitted! ID: " << application.getApplicationId() << '\n';
+                screen << '\n' << "Press any key to return to main menu...";
                 getline(cin, userInput);
                 return;
             }
         }
         catch (const exception& e) {
-            cout << Config::CHATBOT_NAME << ": Application failed: " << e.what() << endl;
+            screen << Config::CHATBOT_NAME << ": Application failed: " << e.what() << '\n';
         }
     }
 
-    cout << endl << "Returning to main menu..." << endl;
+    screen << '\n' << "Returning to main menu..." << '\n';
 }
 
 void handleScooterLoanSelection(const ScooterLoan loans[], int loanCount, bool& running,
     ApplicationCollector& collector, FileManager& fileManager) {
 
-    cout << Config::CHATBOT_NAME << ": You selected scooter loan." << endl;
+    screen << Config::CHATBOT_NAME << ": You selected scooter loan." << '\n';
     displayScooterMakes();
 
     string userInput;
-    cout << "You: ";
+    screen << "You: ";
     getline(cin, userInput);
     string makeInput = trim(userInput);
 
@@ -409,7 +413,7 @@ void handleScooterLoanSelection(const ScooterLoan loans[], int loanCount, bool&
     }
 
     if (!isValidMakeInput(makeInput, "scooter")) {
-        cout << Config::CHATBOT_NAME << ": Invalid make selection." << endl;
+        screen << Config::CHATBOT_NAME << ": Invalid make selection." << '\n';
         return;
     }
 
@@ -418,11 +422,11 @@ void handleScooterLoanSelection(const ScooterLoan loans[], int loanCount, bool&
 
     int optionNumber = 0;
 
-    cout << endl << Config::CHATBOT_NAME << ": View detailed installment plan? (Y/N): ";
+    screen << '\n' << Config::CHATBOT_NAME << ": View detailed installment plan? (Y/N): ";
     getline(cin, userInput);
 
     if (toLower(trim(userInput)) == "y" || toLower(trim(userInput)) == "yes") {
-        cout << Config::CHATBOT_NAME << ": Enter option number: ";
+        screen << Config::CHATBOT_NAME << ": Enter option number: ";
         getline(cin, userInput);
 
         try {
@@ -430,23 +434,23 @@ void handleScooterLoanSelection(const ScooterLoan loans[], int loanCount, bool&
             displayScooterInstallmentPlan(loans, loanCount, optionNumber);
         }
         catch (const exception&) {
-            cout << Config::CHATBOT_NAME << ": Invalid option number." << endl;
+            screen << Config::CHATBOT_NAME << ": Invalid option number." << '\n';
         }
     }
 
-    cout << endl << Config::CHATBOT_NAME << ": Start the loan application? (Y/N): ";
+    screen << '\n' << Config::CHATBOT_NAME << ": Start the loan application? (Y/N): ";
     getline(cin, userInput);
 
     if (toLower(trim(userInput)) == "y" || toLower(trim(userInput)) == "yes") {
         if (optionNumber == 0) {
-            cout << Config::CHATBOT_NAME << ": Which option to apply for? Enter number: ";
+            screen << Config::CHATBOT_NAME << ": Which option to apply for? Enter number: ";
             getline(cin, userInput);
 
             try {
                 optionNumber = stoi(trim(userInput));
             }
             catch (const exception&) {
-                cout << Config::CHATBOT_NAME << ": Invalid option number." << endl;
+                screen << Config::CHATBOT_NAME << ": Invalid option number." << '\n';
                 return;
             }
         }
@@ -478,7 +482,7 @@ void handleScooterLoanSelection(const ScooterLoan loans[], int loanCount, bool&
             }
 
             if (!loanFound) {
-                cout << Config::CHATBOT_NAME << ": Error: Could not retrieve loan details." << endl;
+                screen << Config::CHATBOT_NAME << ": Error: Could not retrieve loan details." << '\n';
                 return;
             }
 
@@ -489,7 +493,7 @@ void handleScooterLoanSelection(const ScooterLoan loans[], int loanCount, bool&
             application.setStatus("C1");
             fileManager.updateApplicationSection(application, "");
 
-            cout << endl << "Application created! ID: " << appId << endl;
+            screen << '\n' << "Application created! ID: " << appId << '\n';
 
             // Use multi-session collector
             MultiSessionCollector multiCollector(fileManager);
@@ -506,7 +510,7 @@ void handleScooterLoanSelection(const ScooterLoan loans[], int loanCount, bool&
                 else if (nextSection == "references") sectionCompleted = multiCollector.collectReferencesInfo(application);
                 else if (nextSection == "documents") {
                     sectionCompleted = multiCollector.collectDocumentsInfo(application);
-                    if (sectionCompleted && application.getStatus() == "submitted") {
+                    if (sectionCompleted && application.getStatusCode() == ApplicationStatus::SUBMITTED) {
                         applicationWasSubmitted = true;
                         break;
                     }
@@ -514,13 +518,13 @@ void handleScooterLoanSelection(const ScooterLoan loans[], int loanCount, bool&
 
                 if (sectionCompleted && !applicationWasSubmitted) {
                     if (application.getNextIncompleteSection() != "complete") {
-                        cout << endl << Config::CHATBOT_NAME << ": Continue to next section? (yes/no): ";
+                        screen << '\n' << Config::CHATBOT_NAME << ": Continue to next section? (yes/no): ";
                         string nextChoice;
                         getline(cin, nextChoice);
                         continueProcessing = (toLower(trim(nextChoice)) == "yes" || toLower(trim(nextChoice)) == "y");
                         if (!continueProcessing) {
-                            cout << endl << "Progress saved! Application ID: " << appId << endl;
-                            cout << endl << "Press any key to return to main menu...";
+                            screen << '\n' << "Progress saved! Application ID: " << appId << '\n';
+                            screen << '\n' << "Press any key to return to main menu...";
                             getline(cin, userInput);
                             return;
                         }
@@ -532,14 +536,14 @@ void handleScooterLoanSelection(const ScooterLoan loans[], int loanCount, bool&
             }
 
             if (applicationWasSubmitted || application.isApplicationComplete()) {
-                cout << endl << "Application submitted! ID: " << application.getApplicationId() << endl;
-                cout << endl << "Press any key to return to main menu...";
+                screen << '\n' << "Application submitted! ID: " << application.getApplicationId() << '\n';
+                screen << '\n' << "Press any key to return to main menu...";
                 getline(cin, userInput);
                 return;
             }
         }
         catch (const exception& e) {
-            cout << Config::CHATBOT_NAME << ": Application failed: " << e.what() << endl;
+            screen << Config::CHATBOT_NAME << ": Application failed: " << e.what() << '\n';
         }
     }
 }
@@ -547,11 +551,11 @@ void handleScooterLoanSelection(const ScooterLoan loans[], int loanCount, bool&
 void handlePersonalLoanSelection(const PersonalLoan loans[], int loanCount, bool& running,
     ApplicationCollector& collector, FileManager& fileManager) {
 
-    cout << Config::CHATBOT_NAME << ": You selected personal loan." << endl;
+    screen << Config::CHATBOT_NAME << ": You selected personal loan." << '\n';
     displayPersonalLoanCategories(loans, loanCount);
 
     string userInput;
-    cout << "You: ";
+    screen << "You: ";
     getline(cin, userInput);
     string categoryInput = trim(userInput);
 
@@ -566,7 +570,7 @@ void handlePersonalLoanSelection(const PersonalLoan loans[], int loanCount, bool
 
     int optionNumber = 0;
 
-    cout << endl << Config::CHATBOT_NAME << ": View detailed installment plan? (Y/N): ";
+    screen << '\n' << Config::CHATBOT_NAME << ": View detailed installment plan? (Y/N): ";
     getline(cin, userInput);
     string planInput = toLower(trim(userInput));
 
@@ -577,7 +581,7 @@ void handlePersonalLoanSelection(const PersonalLoan loans[], int loanCount, bool
     }
 
     if (planInput == "y" || planInput == "yes") {
-        cout << Config::CHATBOT_NAME << ": Enter option number: ";
+        screen << Config::CHATBOT_NAME << ": Enter option number: ";
         getline(cin, userInput);
 
         if (toLower(trim(userInput)) == Config::EXIT_COMMAND) {
@@ -591,24 +595,24 @@ void handlePersonalLoanSelection(const PersonalLoan loans[], int loanCount, bool
             displayPersonalInstallmentPlan(loans, loanCount, optionNumber);
         }
         catch (const exception&) {
-            cout << Config::CHATBOT_NAME << ": Invalid option number." << endl;
+            screen << Config::CHATBOT_NAME << ": Invalid option number." << '\n';
         }
     }
 
-    cout << endl << Config::CHATBOT_NAME << ": Start the loan application? (Y/N): ";
+    screen << '\n' << Config::CHATBOT_NAME << ": Start the loan application? (Y/N): ";
     getline(cin, userInput);
     string applyInput = toLower(trim(userInput));
 
     if (applyInput == "y" || applyInput == "yes") {
         if (optionNumber == 0) {
-            cout << Config::CHATBOT_NAME << ": Which option to apply for? Enter number: ";
+            screen << Config::CHATBOT_NAME << ": Which option to apply for? Enter number: ";
             getline(cin, userInput);
 
             try {
                 optionNumber = stoi(trim(userInput));
             }
             catch (const exception&) {
-                cout << Config::CHATBOT_NAME << ": Invalid option number." << endl;
+                screen << Config::CHATBOT_NAME << ": Invalid option number." << '\n';
                 return;
             }
         }
@@ -626,12 +630,12 @@ void handlePersonalLoanSelection(const PersonalLoan loans[], int loanCount, bool
                 catNum = stoi(trim(categoryInput));
             }
             catch (...) {
-                cout << Config::CHATBOT_NAME << ": Invalid category." << endl;
+                screen << Config::CHATBOT_NAME << ": Invalid category." << '\n';
                 return;
             }
 
             if (catNum < 1 || catNum > static_cast<int>(categories.size())) {
-                cout << Config::CHATBOT_NAME << ": Invalid category number." << endl;
+                screen << Config::CHATBOT_NAME << ": Invalid category number." << '\n';
                 return;
             }
 
@@ -656,7 +660,7 @@ void handlePersonalLoanSelection(const PersonalLoan loans[], int loanCount, bool
             }
 
             if (!loanFound) {
-                cout << Config::CHATBOT_NAME << ": Error: Could not retrieve loan details." << endl;
+                screen << Config::CHATBOT_NAME << ": Error: Could not retrieve loan details." << '\n';
                 return;
             }
 
@@ -667,7 +671,7 @@ void handlePersonalLoanSelection(const PersonalLoan loans[], int loanCount, bool
             application.setStatus("C1");
             fileManager.updateApplicationSection(application, "");
 
-            cout << endl << "Application created! ID: " << appId << endl;
+            screen << '\n' << "Application created! ID: " << appId << '\n';
 
             // Use multi-session collector (SAME AS HOME/CAR/SCOOTER)
             MultiSessionCollector multiCollector(fileManager);
@@ -684,7 +688,7 @@ void handlePersonalLoanSelection(const PersonalLoan loans[], int loanCount, bool
                 else if (nextSection == "references") sectionCompleted = multiCollector.collectReferencesInfo(application);
                 else if (nextSection == "documents") {
                     sectionCompleted = multiCollector.collectDocumentsInfo(application);
-                    if (sectionCompleted && application.getStatus() == "submitted") {
+                    if (sectionCompleted && application.getStatusCode() == ApplicationStatus::SUBMITTED) {
                         applicationWasSubmitted = true;
                         break;
                     }
@@ -692,13 +696,13 @@ void handlePersonalLoanSelection(const PersonalLoan loans[], int loanCount, bool
 
                 if (sectionCompleted && !applicationWasSubmitted) {
                     if (application.getNextIncompleteSection() != "complete") {
-                        cout << endl << Config::CHATBOT_NAME << ": Continue to next section? (yes/no): ";
+                        screen << '\n' << Config::CHATBOT_NAME << ": Continue to next section? (yes/no): ";
                         string nextChoice;
                         getline(cin, nextChoice);
                         continueProcessing = (toLower(trim(nextChoice)) == "yes" || toLower(trim(nextChoice)) == "y");
                         if (!continueProcessing) {
-                            cout << endl << "Progress saved! Application ID: " << appId << endl;
-                            cout << endl << "Press any key to return to main menu...";
+                            screen << '\n' << "Progress saved! Application ID: " << appId << '\n';
+                            screen << '\n' << "Press any key to return to main menu...";
                             getline(cin, userInput);
                             return;
                         }
@@ -710,27 +714,117 @@ void handlePersonalLoanSelection(const PersonalLoan loans[], int loanCount, bool
             }
 
             if (applicationWasSubmitted || application.isApplicationComplete()) {
-                cout << endl << "Application submitted! ID: " << application.getApplicationId() << endl;
-                cout << endl << "Press any key to return to main menu...";
+                screen << '\n' << "Application submitted! ID: " << application.getApplicationId() << '\n';
+                screen << '\n' << "Press any key to return to main menu...";
                 getline(cin, userInput);
                 return;
             }
         }
         catch (const exception& e) {
-            cout << Config::CHATBOT_NAME << ": Application failed: " << e.what() << endl;
+            screen << Config::CHATBOT_NAME << ": Application failed: " << e.what() << '\n';
         }
     }
 
-    cout << endl << "Returning to main menu..." << endl;
+    screen << '\n' << "Returning to main menu..." << '\n';
 }
 
-void checkApplicationStatusByCNIC(FileManager& fileManager) {
+string describeStatus(const string& status) {
+    if (status == "C1") return "Incomplete (Personal)";
+    if (status == "C2") return "Incomplete (Financial)";
+    if (status == "C3") return "Incomplete (References)";
+    if (status == "incomplete_documents") return "Incomplete (Documents)";
+    return status;
+}
+
+/// <summary>
+/// Shows decisions on a CNIC's pending applications as the lender makes them
+/// The server pushes each status change, so nothing is re-read while waiting.
+/// Stops when nothing is pending any more, the user presses Enter, or the
+/// wait times out.
+/// </summary>
+void waitForDecisions(RemoteFileManager& statusFeed, const string& cnic, vector<LoanApplication>& applications) {
+    if (!statusFeed.subscribe(SubscriptionKind::CNIC, cnic)) {
+        screen << Config::CHATBOT_NAME << ": Status updates are not available right now." << '\n';
+        return;
+    }
+
+    auto countPending = [&applications]() {
+        int pending = 0;
+        for (const auto& app : applications) {
+            if (app.getStatusCode() == ApplicationStatus::SUBMITTED) pending++;
+        }
+        return pending;
+    };
+
+    auto applyChange = [&applications](const string& applicationId, const string& status, const string& reason) {
+        for (auto& app : applications) {
+            if (app.getApplicationId() != applicationId || app.getStatus() == status) continue;
+
+            app.setStatus(status);
+            screen << Config::CHATBOT_NAME << ": Update - application " << applicationId
+                << " is now " << describeStatus(status) << "." << '\n';
+            if (!reason.empty()) {
+                screen << "  Reason: " << reason << '\n';
+            }
+        }
+    };
+
+    // A decision made between the status query and the subscription is not pushed
+    for (const auto& app : statusFeed.findApplicationsByCNIC(cnic)) {
+        applyChange(app.getApplicationId(), app.getStatus(), app.getRejectionReason());
+    }
+
+    // Without a watchable console Enter would go unnoticed, so the wait is short instead
+    bool watchConsole = RemoteFileManager::canWatchConsole();
+    int timeoutMs = watchConsole ? Config::STATUS_WAIT_TIMEOUT_MS : Config::STATUS_WAIT_UNWATCHED_MS;
+
+    if (countPending() > 0) {
+        screen << Config::CHATBOT_NAME << ": Waiting for a decision on " << countPending() << " application(s).";
+        if (watchConsole) {
+            screen << " Press Enter to stop waiting." << '\n';
+        }
+        else {
+            screen << " Updates will show here for the next " << timeoutMs / 60000 << " minutes." << '\n';
+        }
+    }
+
+    while (countPending() > 0) {
+        screen.present();
+
+        ServerProtocol::StatusEvent event;
+        RemoteFileManager::WaitResult result = statusFeed.waitForStatusEvent(event, timeoutMs, watchConsole);
+
+        if (result == RemoteFileManager::WaitResult::STATUS_CHANGED) {
+            applyChange(event.applicationId, event.status, event.rejectionReason);
+        }
+        else if (result == RemoteFileManager::WaitResult::CONSOLE_INPUT) {
+            string ignored;
+            getline(cin, ignored);
+            break;
+        }
+        else if (result == RemoteFileManager::WaitResult::TIMED_OUT) {
+            screen << Config::CHATBOT_NAME << ": Still under review. Please check again later." << '\n';
+            break;
+        }
+        else {
+            screen << Config::CHATBOT_NAME << ": Lost contact with the lender server." << '\n';
+            return;
+        }
+    }
+
+    if (countPending() == 0) {
+        screen << Config::CHATBOT_NAME << ": All your submitted applications have been reviewed." << '\n';
+    }
+    statusFeed.unsubscribe(SubscriptionKind::CNIC, cnic);
+}
+
+void checkApplicationStatusByCNIC(FileManager& fileManager, RemoteFileManager* statusFeed) {
     bool keepChecking = true;
 
     while (keepChecking) {
         try {
-            cout << endl << "=== CHECK APPLICATION STATUS ===" << endl;
-            cout << Config::CHATBOT_NAME << ": Enter your CNIC (13 digits without dashes) or 'X' to exit:" << endl;
+            screen << '\n' << "=== CHECK APPLICATION STATUS ===" << '\n';
+            screen << Config::CHATBOT_NAME << ": Enter your CNIC (13 digits without dashes) or 'X' to exit:" << '\n';
 
             string cnic;
             if (!getline(cin, cnic)) {
@@ -740,15 +834,15 @@ void checkApplicationStatusByCNIC(FileManager& fileManager) {
             cnic = trim(cnic);
 
             if (toLower(cnic) == "x" || toLower(cnic) == "exit") {
-                cout << Config::CHATBOT_NAME << ": Returning to main menu." << endl;
+                screen << Config::CHATBOT_NAME << ": Returning to main menu." << '\n';
                 return;
             }
 
             // Validate CNIC format
             if (cnic.length() != 13) {
-                cout << Config::CHATBOT_NAME << ": Invalid CNIC format. Must be exactly 13 digits." << endl;
-                cout << "Example: 1234567891234" << endl;
-                cout << endl << Config::CHATBOT_NAME << ": Try again? (Y/N): ";
+                screen << Config::CHATBOT_NAME << ": Invalid CNIC format. Must be exactly 13 digits." << '\n';
+                screen << "Example: 1234567891234" << '\n';
+                screen << '\n' << Config::CHATBOT_NAME << ": Try again? (Y/N): ";
                 string retry;
                 getline(cin, retry);
                 if (toLower(trim(retry)) != "y" && toLower(trim(retry)) != "yes") {
@@ -767,9 +861,9 @@ void checkApplicationStatusByCNIC(FileManager& fileManager) {
             }
 
             if (!allDigits) {
-                cout << Config::CHATBOT_NAME << ": Invalid CNIC. Enter only digits (no dashes or spaces)." << endl;
-                cout << "Example: 1234567891234" << endl;
-                cout << endl << Config::CHATBOT_NAME << ": Try again? (Y/N): ";
+                screen << Config::CHATBOT_NAME << ": Invalid CNIC. Enter only digits (no dashes or spaces)." << '\n';
+                screen << "Example: 1234567891234" << '\n';
+                screen << '\n' << Config::CHATBOT_NAME << ": Try again? (Y/N): ";
                 string retry;
                 getline(cin, retry);
                 if (toLower(trim(retry)) != "y" && toLower(trim(retry)) != "yes") {
@@ -781,16 +875,16 @@ void checkApplicationStatusByCNIC(FileManager& fileManager) {
             vector<LoanApplication> userApplications = fileManager.findApplicationsByCNIC(cnic);
             int total = userApplications.size();
 
-            cout << endl << "========================================" << endl;
-            cout << "APPLICATION STATUS FOR CNIC: " << cnic << endl;
-            cout << "========================================" << endl;
+            screen << '\n' << "========================================" << '\n';
+            screen << "APPLICATION STATUS FOR CNIC: " << cnic << '\n';
+            screen << "========================================" << '\n';
 
             if (total == 0) {
-                cout << Config::CHATBOT_NAME << ": No applications found for this CNIC." << endl;
-                cout << Config::CHATBOT_NAME << ": Would you like to:" << endl;
-                cout << "  1. Try another CNIC" << endl;
-                cout << "  2. Return to main menu (Type 'X')" << endl;
-                cout << Config::CHATBOT_NAME << ": Your choice: ";
+                screen << Config::CHATBOT_NAME << ": No applications found for this CNIC." << '\n';
+                screen << Config::CHATBOT_NAME << ": Would you like to:" << '\n';
+                screen << "  1. Try another CNIC" << '\n';
+                screen << "  2. Return to main menu (Type 'X')" << '\n';
+                screen << Config::CHATBOT_NAME << ": Your choice: ";
 
                 string choice;
                 getline(cin, choice);
@@ -806,19 +900,20 @@ void checkApplicationStatusByCNIC(FileManager& fileManager) {
             else {
                 int submitted = 0, approved = 0, rejected = 0, incomplete = 0;
 
-                cout << "Your Applications:" << endl;
-                cout << "+-----+--------+---------------------+------------------------+---------------------+" << endl;
-                cout << "| No  | App ID | Status              | Loan Type              | Submission Date     |" << endl;
-                cout << "+-----+--------+---------------------+------------------------+---------------------+" << endl;
+                screen << "Your Applications:" << '\n';
+                screen << "+-----+--------+---------------------+------------------------+---------------------+" << '\n';
+                screen << "| No  | App ID | Status              | Loan Type              | Submission Date     |" << '\n';
+                screen << "+-----+--------+---------------------+------------------------+---------------------+" << '\n';
 
                 for (size_t i = 0; i < userApplications.size(); i++) {
                     const LoanApplication& app = userApplications[i];
-                    string status = app.getStatus();
+                    ApplicationStatus statusCode = app.getStatusCode();
+                    const string& status = app.getStatus();
 
                     // Count by status
-                    if (status == "submitted") submitted++;
-                    else if (status == "approved") approved++;
-                    else if (status == "rejected") rejected++;
+                    if (statusCode == ApplicationStatus::SUBMITTED) submitted++;
+                    else if (statusCode == ApplicationStatus::APPROVED) approved++;
+                    else if (statusCode == ApplicationStatus::REJECTED) rejected++;
                     else incomplete++; // C1, C2, C3, incomplete_*
 
                     string displayLoanType = app.getLoanType();
@@ -827,31 +922,39 @@ void checkApplicationStatusByCNIC(FileManager& fileManager) {
                     }
 
                     // Display status in user-friendly format
-                    string displayStatus = status;
-                    if (status == "C1") displayStatus = "Incomplete (Personal)";
-                    else if (status == "C2") displayStatus = "Incomplete (Financial)";
-                    else if (status == "C3") displayStatus = "Incomplete (References)";
-                    else if (status == "incomplete_documents") displayStatus = "Incomplete (Documents)";
+                    string displayStatus = describeStatus(status);
 
-                    cout << "| " << setw(3) << (i + 1) << " | "
+                    screen << "| " << setw(3) << (i + 1) << " | "
                         << setw(6) << app.getApplicationId() << " | "
                         << setw(19) << left << displayStatus << " | "
                         << setw(22) << displayLoanType << " | "
-                        << setw(19) << app.getSubmissionDate() << " |" << endl;
+                        << setw(19) << app.getSubmissionDate() << " |" << '\n';
                 }
 
-                cout << "+-----+--------+---------------------+------------------------+---------------------+" << endl;
+                screen << "+-----+--------+---------------------+------------------------+---------------------+" << '\n';
 
-                cout << endl << "Summary:" << endl;
-                cout << "  Incomplete: " << incomplete << " application(s)" << endl;
-                cout << "  Pending Review: " << submitted << " application(s)" << endl;
-                cout << "  Approved: " << approved << " application(s)" << endl;
-                cout << "  Rejected: " << rejected << " application(s)" << endl;
-                cout << "========================================" << endl;
+                screen << '\n' << "Summary:" << '\n';
+                screen << "  Incomplete: " << incomplete << " application(s)" << '\n';
+                screen << "  Pending Review: " << submitted << " application(s)" << '\n';
+                screen << "  Approved: " << approved << " application(s)" << '\n';
+                screen << "  Rejected: " << rejected << " application(s)" << '\n';
+                screen << "========================================" << '\n';
+
+                // Waiting is only offered when the server can push the decision
+                bool canWait = (statusFeed != nullptr && submitted > 0);
+                if (canWait) {
+                    screen << '\n' << Config::CHATBOT_NAME << ": Type 'W' to wait here for a decision." << '\n';
+                }
 
-                cout << endl << Config::CHATBOT_NAME << ": Check another CNIC? (Y/N): ";
+                screen << '\n' << Config::CHATBOT_NAME << ": Check another CNIC? (Y/N): ";
                 string another;
                 getline(cin, another);
+                if (canWait && toLower(trim(another)) == "w") {
+                    waitForDecisions(*statusFeed, cnic, userApplications);
+
+                    screen << '\n' << Config::CHATBOT_NAME << ": Check another CNIC? (Y/N): ";
+                    getline(cin, another);
+                }
                 if (toLower(trim(another)) == "y" || toLower(trim(another)) == "yes") {
                     continue;
                 }
@@ -861,31 +964,26 @@ void checkApplicationStatusByCNIC(FileManager& fileManager) {
             }
         }
         catch (const exception& e) {
-            cout << Config::CHATBOT_NAME << ": Error: " << e.what() << endl;
-            cout << Config::CHATBOT_NAME << ": Let's try again." << endl;
+            screen << Config::CHATBOT_NAME << ": Error: " << e.what() << '\n';
+            screen << Config::CHATBOT_NAME << ": Let's try again." << '\n';
         }
     }
 }
 
-void handleUserMode(const HomeLoan homeLoans[], int homeLoanCount,
-    const CarLoan carLoans[], int carLoanCount,
-    const ScooterLoan scooterLoans[], int scooterLoanCount,
-    const PersonalLoan personalLoans[], int personalLoanCount, 
-    const Utterance utterances[], int utteranceCount,
-    ApplicationCollector& collector, FileManager& fileManager) {
+void handleUserMode(const LiveCatalog& catalog,
+    ApplicationCollector& collector, FileManager& fileManager, RemoteFileManager* statusFeed) {
 
-    vector<ConversationPair> conversationCorpus = loadConversationCorpus("human_chat_corpus.txt");
     MultiSessionCollector multiSessionCollector(fileManager);
     bool running = true;
     string userInput;
 
-    cout << endl << Config::CHATBOT_NAME << ": Hello! I'm your loan assistant." << endl;
-    cout << "I can help you with new loan applications or resume incomplete ones." << endl;
+    screen << '\n' << Config::CHATBOT_NAME << ": Hello! I'm your loan assistant." << '\n';
+    screen << "I can help you with new loan applications or resume incomplete ones." << '\n';
 
     while (running) {
         try {
             multiSessionCollector.showApplicationMenu();
-            cout << "You: ";
+            screen << "You: ";
 
             if (!getline(cin, userInput)) {
                 running = false;
@@ -898,9 +996,23 @@ void handleUserMode(const HomeLoan homeLoans[], int homeLoanCount,
                 continue;
             }
 
+            // Catalog as of this request; files edited meanwhile show up on the next one
+            shared_ptr<const LoanCatalog> current = catalog.get();
+            const HomeLoan* homeLoans = current->homeLoans.data();
+            int homeLoanCount = static_cast<int>(current->homeLoans.size());
+            const CarLoan* carLoans = current->carLoans.data();
+            int carLoanCount = static_cast<int>(current->carLoans.size());
+            const ScooterLoan* scooterLoans = current->scooterLoans.data();
+            int scooterLoanCount = static_cast<int>(current->scooterLoans.size());
+            const PersonalLoan* personalLoans = current->personalLoans.data();
+            int personalLoanCount = static_cast<int>(current->personalLoans.size());
+            const Utterance* utterances = current->utterances.data();
+            int utteranceCount = static_cast<int>(current->utterances.size());
+            const vector<ConversationPair>& conversationCorpus = current->conversationCorpus;
+
             if (lowerInput == "1" || lowerInput == "start new" || lowerInput == "new") {
                 displayLoanCategories();
-                cout << "You: ";
+                screen << "You: ";
 
                 if (!getline(cin, userInput)) {
                     running = false;
@@ -922,10 +1034,10 @@ void handleUserMode(const HomeLoan homeLoans[], int homeLoanCount,
                     handlePersonalLoanSelection(personalLoans, personalLoanCount, running, collector, fileManager);
                 }
                 else if (loanChoice == "x" || loanChoice == "exit") {
-                    cout << Config::CHATBOT_NAME << ": Returning to main menu..." << endl;
+                    screen << Config::CHATBOT_NAME << ": Returning to main menu..." << '\n';
                 }
                 else {
-                    cout << Config::CHATBOT_NAME << ": Invalid loan category. Please try again." << endl;
+                    screen << Config::CHATBOT_NAME << ": Invalid loan category. Please try again." << '\n';
                 }
             }
 
@@ -935,44 +1047,44 @@ void handleUserMode(const HomeLoan homeLoans[], int homeLoanCount,
                     multiSessionCollector.resumeExistingApplication();
                 }
                 catch (const exception& e) {
-                    cout << Config::CHATBOT_NAME << ": Sorry, an error occurred: " << e.what() << endl;
+                    screen << Config::CHATBOT_NAME << ": Sorry, an error occurred: " << e.what() << '\n';
                 }
             }
 
             else if (lowerInput == "3" || lowerInput == "check" || lowerInput == "status") {
                 try {
-                    checkApplicationStatusByCNIC(fileManager);
+                    checkApplicationStatusByCNIC(fileManager, statusFeed);
                 }
                 catch (const exception& e) {
-                    cout << Config::CHATBOT_NAME << ": Sorry, an error occurred: " << e.what() << endl;
+                    screen << Config::CHATBOT_NAME << ": Sorry, an error occurred: " << e.what() << '\n';
                 }
             }
 
             else if (lowerInput == "4" || lowerInput == "chat" || lowerInput == "conversation") {
-                cout << Config::CHATBOT_NAME << ": I'm now in general conversation mode! Feel free to chat with me." << endl;
-                cout << "Type 'exit' to return to the main menu." << endl;
+                screen << Config::CHATBOT_NAME << ": I'm now in general conversation mode! Feel free to chat with me." << '\n';
+                screen << "Type 'exit' to return to the main menu." << '\n';
 
                 bool inChatMode = true;
                 while (inChatMode) {
-                    cout << "You: ";
+                    screen << "You: ";
                     getline(cin, userInput);
 
                     string chatInput = toLower(trim(userInput));
 
                     if (chatInput == "exit" || chatInput == "quit" || chatInput == "back") {
-                        cout << Config::CHATBOT_NAME << ": Returning to main menu." << endl;
+                        screen << Config::CHATBOT_NAME << ": Returning to main menu." << '\n';
                         inChatMode = false;
                     }
                     else if (!chatInput.empty()) {
                         // Use IoU matching for response
                         string response = getResponseByIoU(conversationCorpus, userInput);
-                        cout << Config::CHATBOT_NAME << ": " << response << endl;
+                        screen << Config::CHATBOT_NAME << ": " << response << '\n';
                     }
                 }
             }
 
             else if (lowerInput == "5" || lowerInput == "exit" || lowerInput == "x") {
-                cout << Config::CHATBOT_NAME << ": Thank you for using our service. Goodbye!" << endl;
+                screen << Config::CHATBOT_NAME << ": Thank you for using our service. Goodbye!" << '\n';
                 running = false;
             }
 
@@ -980,7 +1092,7 @@ void handleUserMode(const HomeLoan homeLoans[], int homeLoanCount,
                 // Try to match natural language inputs
                 if (lowerInput.find("new") != string::npos || lowerInput.find("apply") != string::npos) {
                     displayLoanCategories();
-                    cout << "You: ";
+                    screen << "You: ";
                     getline(cin, userInput);
                     string loanChoice = toLower(trim(userInput));
 
@@ -993,18 +1105,18 @@ void handleUserMode(const HomeLoan homeLoans[], int homeLoanCount,
                     multiSessionCollector.resumeExistingApplication();
                 }
                 else if (lowerInput.find("status") != string::npos || lowerInput.find("check") != string::npos) {
-                    checkApplicationStatusByCNIC(fileManager);
+                    checkApplicationStatusByCNIC(fileManager, statusFeed);
                 }
                 else {
                     // Use utterances for general responses
                     string response = getResponse(utterances, utteranceCount, userInput);
-                    cout << Config::CHATBOT_NAME << ": " << response << endl;
+                    screen << Config::CHATBOT_NAME << ": " << response << '\n';
                 }
             }
         }
         catch (const exception& e) {
-            cout << endl << "ERROR: " << e.what() << endl;
-            cout << Config::CHATBOT_NAME << ": Something went wrong. Let's start over." << endl;
+            screen << '\n' << "ERROR: " << e.what() << '\n';
+            screen << Config::CHATBOT_NAME << ": Something went wrong. Let's start over." << '\n';
 
             cin.clear();
             if (cin.fail()) {
@@ -1012,8 +1124,8 @@ void handleUserMode(const HomeLoan homeLoans[], int homeLoanCount,
             }
         }
         catch (...) {
-            cout << endl << "ERROR: Unknown error occurred" << endl;
-            cout << Config::CHATBOT_NAME << ": Something went wrong. Let's start over." << endl;
+            screen << '\n' << "ERROR: Unknown error occurred" << '\n';
+            screen << Config::CHATBOT_NAME << ": Something went wrong. Let's start over." << '\n';
 
             cin.clear();
             if (cin.fail()) {
@@ -6,42 +6,47 @@
 #include "car.h"
 #include "scooter.h"
 #include "personal.h" 
+#include "screen_buffer.h"
 #include "application.h"
 #include "application_collector.h"
 #include "file_manager.h"
-#include "utterances.h"
+#include "Utterances.h"
 #include "ui_handler.h"
+#include "remote_file_manager.h"
+#include "loan_catalog.h"
+#include "file_watcher.h"
 
 using namespace std;
 
-void handleUserMode(const HomeLoan[], int, const CarLoan[], int,
-    const ScooterLoan[], int, const PersonalLoan[], int,  
-    const Utterance[], int,
-    ApplicationCollector&, FileManager&);
+void handleUserMode(const LiveCatalog&,
+    ApplicationCollector&, FileManager&, RemoteFileManager*);
 
 int main() {
     // Initialize data
-    Utterance utterances[Config::MAX_UTTERANCES];
-    HomeLoan homeLoans[Config::MAX_LOANS];
-    CarLoan carLoans[Config::MAX_LOANS];
-    ScooterLoan scooterLoans[Config::MAX_LOANS];
-    PersonalLoan personalLoans[Config::MAX_LOANS];  
-    FileManager fileManager;
+    LiveCatalog catalog;
+    FileWatcher catalogWatcher;
+    FileManager localStore;
+    RemoteFileManager serverStore;
     ApplicationCollector collector;
 
-    int utteranceCount = loadUtterances(utterances, Config::MAX_UTTERANCES, Config::UTTERANCES_FILE);
-    int homeLoanCount = loadHomeLoans(homeLoans, Config::MAX_LOANS, Config::HOME_LOANS_FILE);
-    int carLoanCount = loadCarLoans(carLoans, Config::MAX_LOANS, Config::CAR_LOANS_FILE);
-    int scooterLoanCount = loadScooterLoans(scooterLoans, Config::MAX_LOANS, Config::SCOOTER_LOANS_FILE);
-    int personalLoanCount = loadPersonalLoans(personalLoans, Config::MAX_LOANS, Config::PERSONAL_LOANS_FILE);  
+    // Prefer the running lender server; without one, work on applications.txt directly
+    bool connected = serverStore.connect(Config::SERVER_ADDRESS);
+    FileManager& fileManager = connected ? static_cast<FileManager&>(serverStore) : localStore;
 
-    cout << endl<<"LOAN PROCESSING SYSTEM          " << endl<<endl;
-    cout << "USER CLIENT                     " << endl<<endl;
+    // Loan catalogs and chat files are re-read whenever they are edited
+    catalog.loadAll();
+    catalog.watchWith(catalogWatcher);
+    catalogWatcher.start();
 
-    handleUserMode(homeLoans, homeLoanCount, carLoans, carLoanCount,
-        scooterLoans, scooterLoanCount, personalLoans, personalLoanCount, 
-        utterances, utteranceCount,
-        collector, fileManager);
+    screen << '\n'<<"LOAN PROCESSING SYSTEM          " << '\n'<<'\n';
+    screen << "USER CLIENT                     " << '\n'<<'\n';
+    if (connected) {
+        screen << "Connected to lender server at " << Config::SERVER_ADDRESS << '\n' << '\n';
+    }
+
+    handleUserMode(catalog, collector, fileManager, connected ? &serverStore : nullptr);
+
+    catalogWatcher.stop();
 
     return 0;
 }
\ No newline at end of file
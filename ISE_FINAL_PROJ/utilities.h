@@ -8,6 +8,11 @@
 #include <ctime>
 #include <sstream>
 #include <fstream>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include "text_scanner.h"
 using namespace std;
 
 /// <summary>
@@ -21,12 +26,43 @@ namespace Config {
     const string CAR_LOANS_FILE = "Car.txt";
     const string SCOOTER_LOANS_FILE = "Scooter.txt";
     const string PERSONAL_LOANS_FILE = "Personal.txt";
+    const string CHAT_CORPUS_FILE = "human_chat_corpus.txt";
+    const string LENDING_RULES_FILE = "LendingRules.txt";
     const int MAX_UTTERANCES = 100;
     const int MAX_LOANS = 100;
     const char DELIMITER = '#';
     const string EXIT_COMMAND = "x";
     const string APPLICATIONS_FILE = "applications.txt";
     const string IMAGES_DIRECTORY = "images/";
+    const string DOCUMENT_BLOBS_DIRECTORY = "blobs/";
+    const string DOCUMENT_MANIFEST_FILE = "manifest.txt";
+    const string DOCUMENT_COPY_FAILED_PREFIX = "COPY_FAILED: ";   // Recorded in place of a document that could not be stored
+    const uint32_t DOCUMENT_UPLOAD_MAX_BYTES = 8 * 1024 * 1024;     // Largest document a user client may send the server
+    const size_t DOCUMENT_COPY_CHUNK = 4 * 1024 * 1024;
+    const int DOCUMENT_COPY_THREADS = 4;
+    const int SCHEDULE_PAGE_SIZE = 12;
+    const size_t SCREEN_BUFFER_RESERVE = 16 * 1024;
+    const size_t SCREEN_BUFFER_LIMIT = 1024 * 1024;
+    const size_t BATCH_VALIDATION_CHUNK = 4096;      // Records handed to a worker at a time
+    const int BATCH_VALIDATION_THREADS = 0;          // 0 = one per hardware thread
+    const size_t BATCH_REPORT_SAMPLE_IDS = 5;
+    const string SERVER_ADDRESS = "lender.sock";     // Unix socket path, or "tcp:PORT" for loopback
+    const string LENDER_SOCKET_SUFFIX = ".lender";   // Owner-only socket next to SERVER_ADDRESS for lender tools
+    const uint32_t SERVER_MAX_REQUEST_BYTES = DOCUMENT_UPLOAD_MAX_BYTES + 64 * 1024;  // Largest frame the server buffers from a client (one document upload)
+    const uint32_t SERVER_MAX_RESPONSE_BYTES = 256 * 1024 * 1024;  // Largest frame a client accepts (whole-store lists)
+    const int SERVER_LISTEN_BACKLOG = 128;
+    const size_t SERVER_READ_CHUNK = 64 * 1024;
+    const size_t SERVER_OUTPUT_HIGH_WATER = 4 * 1024 * 1024; // Stop reading a client that is not draining its responses
+    const int STATUS_WAIT_TIMEOUT_MS = 30 * 60 * 1000;      // Longest a user client waits for a pushed decision
+    const int STATUS_WAIT_UNWATCHED_MS = 2 * 60 * 1000;     // The same where the console cannot be watched (Windows)
+    const int WATCH_SETTLE_MS = 50;                         // Quiet time before a changed data file is re-read
+    const int WATCH_POLL_MS = 500;                          // Change check interval where inotify is unavailable
+    const uint64_t WAL_CHECKPOINT_BYTES = 8 * 1024 * 1024;  // Log size at which applications.txt is checkpointed
+    const uint64_t INDEX_TAIL_REBUILD_BYTES = 256 * 1024;   // Unindexed applications.txt bytes at which the record index is rebuilt
+    const double BLOOM_FALSE_POSITIVE_RATE = 0.01;          // Share of absent IDs/CNICs the index filter lets through (applies from the next rebuild)
+    const int PARTITION_SCAN_THREADS = 0;                   // Partitions read at once by a full scan; 0 = one per hardware thread
+    const size_t ARCHIVE_BLOCK_RECORDS = 256;               // Records per compressed block of an archive segment (a lookup decompresses one block)
+    const size_t LOAD_CHUNK_BYTES = 1024 * 1024;            // applications.txt bytes parsed per task by a full load; smaller files are parsed on the calling thread
 }
 
 /// <summary>
@@ -71,6 +107,16 @@ inline string toLower(const string& str) {
     return result;
 }
 
+/// <summary>
+/// Checks that text can be stored as one field of an applications.txt record
+/// </summary>
+/// <param name="text">Field value as entered</param>
+/// <returns>False if it holds the field delimiter or a line break, which would
+/// shift the fields after it or start another record</returns>
+inline bool isStorableField(const string& text) {
+    return text.find(Config::DELIMITER) == string::npos && text.find_first_of("\r\n") == string::npos;
+}
+
 /// <summary>
 /// Splits a string into tokens using specified delimiter
 /// </summary>
@@ -78,24 +124,36 @@ inline string toLower(const string& str) {
 /// <param name="delimiter">Character used to separate tokens</param>
 /// <returns>Vector of trimmed token strings</returns>
 inline vector<string> splitString(const string& line, char delimiter) {
+    // Delimiters are located a block at a time (TextScanner), not byte by byte
     vector<string> tokens;
-    string current = "";
+    TextScanner::splitFields(line.data(), line.data() + line.size(), delimiter, tokens);
+    return tokens;
+}
 
-    for (char ch : line) {
-        if (ch == delimiter) {
-            tokens.push_back(trim(current));
-            current = "";
-        }
-        else {
-            current += ch;
-        }
-    }
+/// <summary>
+/// Reads a whole number like stoll, but reports failure instead of throwing
+/// (used on bulk load paths where malformed fields are common)
+/// </summary>
+/// <param name="text">Text starting with the number</param>
+/// <param name="value">Output: parsed number (unchanged on failure)</param>
+/// <returns>True if a number was read and fits</returns>
+inline bool tryParseNumber(const string& text, long long& value) {
+    const char* begin = text.c_str();
+    char* end = nullptr;
+    errno = 0;
+    long long parsed = strtoll(begin, &end, 10);
+    if (end == begin || errno == ERANGE) return false;
+
+    value = parsed;
+    return true;
+}
 
-    if (!current.empty()) {
-        tokens.push_back(trim(current));
-    }
+inline bool tryParseNumber(const string& text, int& value) {
+    long long parsed = 0;
+    if (!tryParseNumber(text, parsed) || parsed < INT_MIN || parsed > INT_MAX) return false;
 
-    return tokens;
+    value = static_cast<int>(parsed);
+    return true;
 }
 
 /// <summary>
@@ -259,12 +317,12 @@ inline double calculateIoU(const string& text1, const string& text2) {
 /// <returns>Vector of conversation pairs</returns>
 inline vector<ConversationPair> loadConversationCorpus(const string& filename) {
     vector<ConversationPair> corpus;
-    ifstream file(filename);
+    LineReader file(filename);
     string line;
 
     ConversationPair currentPair;
 
-    while (getline(file, line)) {
+    while (file.next(line)) {
         if (line.find("Human 1:") == 0) {
             if (!currentPair.human1.empty()) {
                 corpus.push_back(currentPair);
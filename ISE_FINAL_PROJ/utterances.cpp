@@ -1,6 +1,6 @@
-#include "utterances.h"
+#include "Utterances.h"
 #include "utilities.h"
-#include <fstream>
+#include "text_scanner.h"
 #include <iostream>
 
 Utterance::Utterance() {
@@ -16,9 +16,9 @@ string Utterance::getResponse() const { return response; }
 void Utterance::setInput(const string& inp) { input = inp; }
 void Utterance::setResponse(const string& resp) { response = resp; }
 int loadUtterances(Utterance utterances[], int maxSize, const string& filename) {
-    ifstream file(filename);
+    LineReader file(filename);
 
-    if (!file.is_open()) {
+    if (!file.isOpen()) {
         cerr << "Error: Could not open " << filename << endl;
         return 0;
     }
@@ -27,7 +27,7 @@ int loadUtterances(Utterance utterances[], int maxSize, const string& filename)
     int count = 0;
     int lineNumber = 0;
 
-    while (getline(file, line) && count < maxSize) {
+    while (count < maxSize && file.next(line)) {
         lineNumber++;
 
         if (line.empty()) {
@@ -47,7 +47,6 @@ int loadUtterances(Utterance utterances[], int maxSize, const string& filename)
         }
     }
 
-    file.close();
     return count;
 }
 string getResponse(const Utterance utterances[], int size, const string& input) {
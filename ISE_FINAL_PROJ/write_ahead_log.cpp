@@ -0,0 +1,474 @@
+#include "write_ahead_log.h"
+#include "utilities.h"
+#include "checksum.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#include <sys/file.h>
+#endif
+
+using namespace std;
+
+namespace {
+    const char LOG_MAGIC[4] = { 'L', 'W', 'A', 'L' };
+    const uint32_t LOG_VERSION = 1;
+    const size_t HEADER_BYTES = 32;     // magic, version, checkpoint size, checkpoint time, reserved
+    const size_t RECORD_HEADER_BYTES = 17;  // length, CRC, sequence, type
+
+    void putUInt32(string& out, uint32_t value) {
+        for (int i = 0; i < 4; i++) out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    void putUInt64(string& out, uint64_t value) {
+        for (int i = 0; i < 8; i++) out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    uint32_t getUInt32(const string& in, size_t at) {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++) value |= static_cast<uint32_t>(static_cast<uint8_t>(in[at + i])) << (8 * i);
+        return value;
+    }
+
+    uint64_t getUInt64(const string& in, size_t at) {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; i++) value |= static_cast<uint64_t>(static_cast<uint8_t>(in[at + i])) << (8 * i);
+        return value;
+    }
+
+    bool statFile(const string& path, uint64_t& size, long long& modified) {
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) return false;
+        size = static_cast<uint64_t>(info.st_size);
+        modified = static_cast<long long>(info.st_mtime);
+        return true;
+    }
+
+    string directoryOf(const string& path) {
+        size_t slash = path.find_last_of("/\\");
+        return slash == string::npos ? "." : path.substr(0, slash);
+    }
+
+#ifdef _WIN32
+    int openLog(const string& path) {
+        int descriptor = -1;
+        _sopen_s(&descriptor, path.c_str(), _O_RDWR | _O_CREAT | _O_APPEND | _O_BINARY, _SH_DENYNO, _S_IREAD | _S_IWRITE);
+        return descriptor;
+    }
+
+    bool lockLog(int descriptor) {
+        OVERLAPPED whole = {};
+        HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(descriptor));
+        return LockFileEx(handle, LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0, MAXDWORD, MAXDWORD, &whole) != 0;
+    }
+
+    bool syncDescriptor(int descriptor) { return _commit(descriptor) == 0; }
+    bool truncateDescriptor(int descriptor, uint64_t size) { return _chsize_s(descriptor, static_cast<__int64>(size)) == 0; }
+    long writeDescriptor(int descriptor, const char* data, size_t length) {
+        return _write(descriptor, data, static_cast<unsigned int>(length));
+    }
+    long readDescriptor(int descriptor, char* data, size_t length) {
+        return _read(descriptor, data, static_cast<unsigned int>(length));
+    }
+    void closeDescriptor(int descriptor) { _close(descriptor); }
+    bool seekStart(int descriptor) { return _lseeki64(descriptor, 0, SEEK_SET) == 0; }
+    bool syncDirectory(const string&) { return true; }     // NTFS journals the rename itself
+#else
+    int openLog(const string& path) {
+        return ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    }
+
+    bool lockLog(int descriptor) { return flock(descriptor, LOCK_EX | LOCK_NB) == 0; }
+
+    bool syncDescriptor(int descriptor) {
+#if defined(__linux__)
+        return fdatasync(descriptor) == 0;
+#else
+        return fsync(descriptor) == 0;
+#endif
+    }
+    bool truncateDescriptor(int descriptor, uint64_t size) { return ftruncate(descriptor, static_cast<off_t>(size)) == 0; }
+    long writeDescriptor(int descriptor, const char* data, size_t length) {
+        return static_cast<long>(::write(descriptor, data, length));
+    }
+    long readDescriptor(int descriptor, char* data, size_t length) {
+        return static_cast<long>(::read(descriptor, data, length));
+    }
+    void closeDescriptor(int descriptor) { ::close(descriptor); }
+    bool seekStart(int descriptor) { return lseek(descriptor, 0, SEEK_SET) == 0; }
+
+    bool syncDirectory(const string& path) {
+        int descriptor = ::open(directoryOf(path).c_str(), O_RDONLY | O_CLOEXEC);
+        if (descriptor < 0) return false;
+        bool synced = fsync(descriptor) == 0;
+        ::close(descriptor);
+        return synced;
+    }
+#endif
+
+    bool writeAll(int descriptor, const string& data) {
+        size_t written = 0;
+        while (written < data.size()) {
+            long count = writeDescriptor(descriptor, data.data() + written, data.size() - written);
+            if (count < 0 && errno == EINTR) continue;
+            if (count <= 0) return false;
+            written += static_cast<size_t>(count);
+        }
+        return true;
+    }
+
+    bool renameOver(const string& from, const string& to, bool durable) {
+#ifdef _WIN32
+        DWORD flags = MOVEFILE_REPLACE_EXISTING | (durable ? MOVEFILE_WRITE_THROUGH : 0);
+        return MoveFileExA(from.c_str(), to.c_str(), flags) != 0;
+#else
+        (void)durable;
+        return rename(from.c_str(), to.c_str()) == 0;
+#endif
+    }
+}
+
+bool syncFile(const string& path) {
+#ifdef _WIN32
+    int descriptor = -1;
+    _sopen_s(&descriptor, path.c_str(), _O_RDWR | _O_BINARY, _SH_DENYNO, 0);
+#else
+    int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+    if (descriptor < 0) return false;
+    bool synced = syncDescriptor(descriptor);
+    closeDescriptor(descriptor);
+    return synced;
+}
+
+bool replaceFileContents(const string& path, const string& contents, bool durable) {
+    string temporary = path + ".tmp";
+    {
+        ofstream file(temporary, ios::binary | ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(contents.data(), static_cast<streamsize>(contents.size()));
+        if (!file) {
+            file.close();
+            remove(temporary.c_str());
+            return false;
+        }
+    }
+
+    if (!replaceFile(temporary, path, durable)) {
+        remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool replaceFile(const string& temporary, const string& path, bool durable) {
+    if ((durable && !syncFile(temporary)) || !renameOver(temporary, path, durable)) return false;
+    return !durable || syncDirectory(path);
+}
+
+WriteAheadLog::WriteAheadLog(const string& journaledFile)
+    : dataFile(journaledFile), logFile(journaledFile + ".wal"), checkpointFile(journaledFile + ".checkpoint"),
+    fd(-1), opened(false), logBytes(0), nextSequence(1), appendedSequence(0), durableSequence(0),
+    failed(false), baseStale(false), stopping(false) {
+}
+
+WriteAheadLog::~WriteAheadLog() {
+    close();
+}
+
+bool WriteAheadLog::hasRecords(const string& journaledFile) {
+    uint64_t size = 0;
+    long long modified = 0;
+    return statFile(journaledFile + ".wal", size, modified) && size > HEADER_BYTES;
+}
+
+bool WriteAheadLog::isOpen() const {
+    return opened;
+}
+
+const vector<LogRecord>& WriteAheadLog::getRecoveredRecords() const {
+    return recovered;
+}
+
+const string& WriteAheadLog::getCheckpointFile() const {
+    return checkpointFile;
+}
+
+bool WriteAheadLog::open() {
+    if (opened) return true;
+
+    fd = openLog(logFile);
+    if (fd < 0) {
+        cerr << "Warning: Could not open " << logFile << "; writes are not journaled" << endl;
+        return false;
+    }
+    if (!lockLog(fd)) {
+        // Another process is journaling this store and will replay its own log
+        closeDescriptor(fd);
+        fd = -1;
+        return false;
+    }
+
+    uint64_t stampedSize = 0;
+    long long stampedModified = 0;
+    bool readable = readLog(stampedSize, stampedModified);
+
+    if (!readable) {
+        // New, empty or unreadable log: start a fresh one from a new checkpoint
+        if (!resetLog()) {
+            closeDescriptor(fd);
+            fd = -1;
+            return false;
+        }
+        baseStale = true;
+    }
+    else if (recovered.empty()) {
+        // Clean shutdown: the checkpoint is only usable if the data file is as it was left
+        uint64_t size = 0;
+        long long modified = 0;
+        uint64_t checkpointSize = 0;
+        long long checkpointModified = 0;
+        bool dataPresent = statFile(dataFile, size, modified);
+        bool checkpointPresent = statFile(checkpointFile, checkpointSize, checkpointModified);
+        baseStale = !checkpointPresent || !dataPresent ||
+            size != stampedSize || modified != stampedModified || checkpointSize != size;
+    }
+
+    if (!recovered.empty()) {
+        nextSequence = recovered.back().sequence + 1;
+        appendedSequence = durableSequence = recovered.back().sequence;
+    }
+
+    opened = true;
+    stopping = false;
+    failed = false;
+    committer = thread(&WriteAheadLog::runCommitter, this);
+    return true;
+}
+
+bool WriteAheadLog::readLog(uint64_t& checkpointSize, long long& checkpointModified) {
+    recovered.clear();
+
+    string contents;
+    char buffer[64 * 1024];
+    long count;
+    if (!seekStart(fd)) return false;
+    while ((count = readDescriptor(fd, buffer, sizeof(buffer))) > 0) {
+        contents.append(buffer, static_cast<size_t>(count));
+    }
+
+    if (contents.size() < HEADER_BYTES || contents.compare(0, 4, LOG_MAGIC, 4) != 0 ||
+        getUInt32(contents, 4) != LOG_VERSION) {
+        if (!contents.empty()) {
+            cerr << "Warning: " << logFile << " has no valid header and was ignored" << endl;
+        }
+        return false;
+    }
+    checkpointSize = getUInt64(contents, 8);
+    checkpointModified = static_cast<long long>(getUInt64(contents, 16));
+
+    size_t offset = HEADER_BYTES;
+    uint64_t lastSequence = 0;
+    while (contents.size() - offset >= RECORD_HEADER_BYTES) {
+        uint32_t length = getUInt32(contents, offset);
+        uint32_t checksum = getUInt32(contents, offset + 4);
+        if (length > contents.size() - offset - RECORD_HEADER_BYTES) break;     // Torn write
+
+        const char* covered = contents.data() + offset + 8;
+        if (crc32(covered, 9 + static_cast<size_t>(length)) != checksum) break;
+
+        LogRecord record;
+        record.sequence = getUInt64(contents, offset + 8);
+        record.type = static_cast<LogRecordType>(static_cast<uint8_t>(contents[offset + 16]));
+        if (record.sequence <= lastSequence) break;
+        record.payload.assign(contents, offset + RECORD_HEADER_BYTES, length);
+
+        lastSequence = record.sequence;
+        recovered.push_back(move(record));
+        offset += RECORD_HEADER_BYTES + length;
+    }
+
+    if (offset < contents.size()) {
+        cerr << "Warning: Ignoring " << (contents.size() - offset) << " byte(s) of incomplete log records in "
+            << logFile << endl;
+        // New records must not land behind the damaged ones
+        if (!truncateDescriptor(fd, offset)) return false;
+    }
+    logBytes = offset;
+    return true;
+}
+
+bool WriteAheadLog::resetLog() {
+    uint64_t size = 0;
+    long long modified = 0;
+    statFile(dataFile, size, modified);
+
+    string header(LOG_MAGIC, 4);
+    putUInt32(header, LOG_VERSION);
+    putUInt64(header, size);
+    putUInt64(header, static_cast<uint64_t>(modified));
+    putUInt64(header, 0);
+
+    if (!truncateDescriptor(fd, 0) || !writeAll(fd, header) || !syncDescriptor(fd)) {
+        cerr << "Error: Could not reset " << logFile << endl;
+        return false;
+    }
+    logBytes = HEADER_BYTES;
+    return true;
+}
+
+void WriteAheadLog::close() {
+    if (!opened) return;
+
+    // Unreplayed records are left for the next open; an untouched store needs no new copy
+    if (recovered.empty() && (baseStale || logBytes > HEADER_BYTES)) {
+        checkpoint();
+    }
+
+    {
+        lock_guard<mutex> lock(logMutex);
+        stopping = true;
+    }
+    workSignal.notify_all();
+    committer.join();
+
+    closeDescriptor(fd);
+    fd = -1;
+    opened = false;
+}
+
+bool WriteAheadLog::needsCheckpoint() {
+    lock_guard<mutex> lock(logMutex);
+    return opened && (baseStale || logBytes >= Config::WAL_CHECKPOINT_BYTES);
+}
+
+bool WriteAheadLog::checkpoint() {
+    if (!opened) return false;
+
+    // The copy is synced before the log is emptied, so a crash in between
+    // replays records the checkpoint already holds (replay is idempotent)
+    string temporary = checkpointFile + ".tmp";
+    {
+        ifstream source(dataFile, ios::binary);
+        ofstream target(temporary, ios::binary | ios::trunc);
+        if (!target.is_open()) {
+            cerr << "Error: Could not write " << temporary << endl;
+            return false;
+        }
+        if (source.is_open() && source.peek() != ifstream::traits_type::eof()) {
+            target << source.rdbuf();
+        }
+        if (!target) {
+            cerr << "Error: Could not copy " << dataFile << " to " << temporary << endl;
+            return false;
+        }
+    }
+    if (!syncFile(temporary) || !renameOver(temporary, checkpointFile, true) || !syncDirectory(checkpointFile)) {
+        cerr << "Error: Could not write checkpoint " << checkpointFile << endl;
+        remove(temporary.c_str());
+        return false;
+    }
+
+    {
+        lock_guard<mutex> lock(logMutex);
+        if (!resetLog()) return false;
+
+        // Everything appended so far is in the synced checkpoint
+        durableSequence = appendedSequence;
+        recovered.clear();
+        baseStale = false;
+    }
+    durableSignal.notify_all();
+    notifyListener();
+    return true;
+}
+
+uint64_t WriteAheadLog::append(LogRecordType type, const string& payload) {
+    string record;
+    record.reserve(RECORD_HEADER_BYTES + payload.size());
+
+    lock_guard<mutex> lock(logMutex);
+    if (!opened || failed) return 0;
+
+    uint64_t sequence = nextSequence;
+    putUInt32(record, static_cast<uint32_t>(payload.size()));
+    putUInt32(record, 0);                   // CRC, filled in below
+    putUInt64(record, sequence);
+    record += static_cast<char>(type);
+    record += payload;
+
+    uint32_t checksum = crc32(record.data() + 8, record.size() - 8);
+    for (int i = 0; i < 4; i++) record[4 + i] = static_cast<char>((checksum >> (8 * i)) & 0xFF);
+
+    // One write per record: a crash leaves at most the last record torn
+    if (!writeAll(fd, record)) {
+        cerr << "Error: Could not append to " << logFile << endl;
+        return 0;
+    }
+
+    nextSequence++;
+    appendedSequence = sequence;
+    logBytes += record.size();
+    workSignal.notify_one();
+    return sequence;
+}
+
+bool WriteAheadLog::waitDurable(uint64_t sequence) {
+    unique_lock<mutex> lock(logMutex);
+    durableSignal.wait(lock, [this, sequence]() { return durableSequence >= sequence || failed || !opened; });
+    return durableSequence >= sequence;
+}
+
+uint64_t WriteAheadLog::getDurableSequence() {
+    lock_guard<mutex> lock(logMutex);
+    return durableSequence;
+}
+
+void WriteAheadLog::setDurableListener(function<void()> listener) {
+    lock_guard<mutex> lock(listenerMutex);
+    durableListener = move(listener);
+}
+
+void WriteAheadLog::notifyListener() {
+    lock_guard<mutex> lock(listenerMutex);
+    if (durableListener) durableListener();
+}
+
+void WriteAheadLog::runCommitter() {
+    unique_lock<mutex> lock(logMutex);
+    while (true) {
+        workSignal.wait(lock, [this]() { return stopping || (!failed && appendedSequence > durableSequence); });
+        if (failed || appendedSequence <= durableSequence) {
+            if (stopping) break;
+            continue;
+        }
+
+        // Writers arriving during this sync are covered by the next one
+        uint64_t target = appendedSequence;
+        lock.unlock();
+        bool synced = syncDescriptor(fd);
+        lock.lock();
+
+        if (!synced) {
+            cerr << "Error: Could not sync " << logFile << "; later writes are not durable" << endl;
+            failed = true;
+        }
+        else if (target > durableSequence) {
+            durableSequence = target;
+        }
+
+        durableSignal.notify_all();
+        lock.unlock();
+        notifyListener();
+        lock.lock();
+    }
+}
@@ -0,0 +1,182 @@
+#ifndef WRITE_AHEAD_LOG_H
+#define WRITE_AHEAD_LOG_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+using namespace std;
+
+/// <summary>
+/// Kinds of store mutation kept in the log
+/// </summary>
+enum class LogRecordType : uint8_t {
+    APPEND_RECORD = 1,      // saveApplication: the record line
+    REPLACE_RECORD = 2,     // updateApplicationSection: application ID, record line
+    UPDATE_STATUS = 3,      // updateApplicationStatus: application ID, status, rejection reason
+    ARCHIVE_RECORD = 4      // updateApplicationStatus: application ID now held by its (synced) archive segment
+};
+
+/// <summary>
+/// One mutation read back from the log
+/// </summary>
+struct LogRecord {
+    uint64_t sequence;
+    LogRecordType type;
+    string payload;         // MessageWriter encoding of the fields listed above
+};
+
+/// <summary>
+/// Write-ahead log for a data file (applications.txt -> applications.txt.wal)
+/// Every mutation is appended as a CRC-32 checked record before the data file
+/// is touched. A commit thread makes the appended records durable with one
+/// fsync for every writer that arrived while the previous fsync ran (group
+/// commit), so concurrent writers share the cost instead of paying one each.
+/// A checkpoint copies the data file to applications.txt.checkpoint and empties
+/// the log; after a crash the checkpoint (or the data file) plus the records
+/// in the log rebuild the store. Records after a torn or corrupt one are
+/// ignored, as their writers were never told they were durable.
+/// The log file is locked, so only one process journals a data file at a time.
+/// SE Principles:
+/// - Single Responsibility: framing, syncing and checkpoint files only; what a
+///   record means is up to the owner (FileManager replays them)
+/// - Information Hiding: callers never see fsync, file locks or the record layout
+/// </summary>
+class WriteAheadLog {
+private:
+    string dataFile;
+    string logFile;
+    string checkpointFile;
+    int fd;                         // Log file, opened for appending
+    bool opened;
+
+    vector<LogRecord> recovered;    // Valid records found by open()
+    uint64_t logBytes;              // Current log size including the header
+    uint64_t nextSequence;
+    uint64_t appendedSequence;      // Last record written to the log file
+    uint64_t durableSequence;       // Last record known to be on disk
+    bool failed;                    // An fsync failed; nothing more is durable
+    bool baseStale;                 // The checkpoint does not match the data file yet
+
+    mutex logMutex;
+    condition_variable workSignal;      // Records waiting for the commit thread
+    condition_variable durableSignal;   // durableSequence moved
+    thread committer;
+    bool stopping;
+
+    mutex listenerMutex;            // Held while the listener runs, so replacing it waits for the call
+    function<void()> durableListener;
+
+    /// <summary>
+    /// Calls the durable listener (from the commit thread or a checkpoint)
+    /// </summary>
+    void notifyListener();
+
+    /// <summary>
+    /// Commit thread body: syncs whatever has been appended since the last pass
+    /// </summary>
+    void runCommitter();
+
+    /// <summary>
+    /// Reads the header and every valid record into recovered
+    /// </summary>
+    bool readLog(uint64_t& checkpointSize, long long& checkpointModified);
+
+    /// <summary>
+    /// Replaces the log with an empty one stamped with the data file's size and time
+    /// </summary>
+    bool resetLog();
+
+public:
+    /// <summary>
+    /// Names the log and checkpoint files for a data file (nothing is opened)
+    /// </summary>
+    explicit WriteAheadLog(const string& journaledFile);
+
+    /// <summary>
+    /// Checkpoints and closes the log if it is open
+    /// </summary>
+    ~WriteAheadLog();
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    /// <summary>
+    /// True if a log with records exists for the data file (the last writer did not close cleanly)
+    /// </summary>
+    static bool hasRecords(const string& journaledFile);
+
+    /// <summary>
+    /// Locks and reads the log, then starts the commit thread
+    /// Records left by a crash are available from getRecoveredRecords until
+    /// the owner has replayed them and called checkpoint().
+    /// </summary>
+    /// <returns>False if another process holds the log or it cannot be created</returns>
+    bool open();
+
+    /// <summary>
+    /// Stops the commit thread and unlocks the log (after a final checkpoint)
+    /// </summary>
+    void close();
+
+    bool isOpen() const;
+
+    const vector<LogRecord>& getRecoveredRecords() const;
+    const string& getCheckpointFile() const;
+
+    /// <summary>
+    /// True once the log has grown past Config::WAL_CHECKPOINT_BYTES, or the
+    /// checkpoint file no longer matches the data file it was copied from
+    /// </summary>
+    bool needsCheckpoint();
+
+    /// <summary>
+    /// Copies the data file to the checkpoint file (synced) and empties the log
+    /// The caller must not be changing the data file meanwhile.
+    /// </summary>
+    bool checkpoint();
+
+    /// <summary>
+    /// Appends a record (not yet durable)
+    /// </summary>
+    /// <returns>Sequence number to wait for, 0 if the record could not be written</returns>
+    uint64_t append(LogRecordType type, const string& payload);
+
+    /// <summary>
+    /// Blocks until the record with this sequence number is on disk
+    /// </summary>
+    /// <returns>False if syncing the log failed</returns>
+    bool waitDurable(uint64_t sequence);
+
+    uint64_t getDurableSequence();
+
+    /// <summary>
+    /// Called from the commit thread each time more records become durable
+    /// Once this returns the previous listener is no longer running.
+    /// </summary>
+    void setDurableListener(function<void()> listener);
+};
+
+/// <summary>
+/// Syncs a file's contents to disk
+/// </summary>
+bool syncFile(const string& path);
+
+/// <summary>
+/// Replaces a file with new contents in one step: readers see the old or the
+/// new file, never a half-written one
+/// </summary>
+/// <param name="durable">Also sync the contents and the rename to disk</param>
+bool replaceFileContents(const string& path, const string& contents, bool durable);
+
+/// <summary>
+/// Renames a finished file over another in one step, for contents too large
+/// to build in memory (the file is synced first when durable)
+/// </summary>
+bool replaceFile(const string& temporary, const string& path, bool durable);
+
+#endif